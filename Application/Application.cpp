@@ -1,11 +1,13 @@
 #include "Application.h"
 
 #include "Camera/Camera.h"
+#include "DirectX/RenderBackend.h"
 #include "Engine/Engine.h"
 #include "Exception.h"
 
 #include <DirectXMath.h>
 #include <Windowsx.h>
+#include <charconv>
 
 using namespace Microsoft::WRL;
 OApplication* OApplication::Get()
@@ -62,6 +64,12 @@ void OApplication::InitApplication(HINSTANCE hInstance)
 	AppInstance = hInstance;
 	ConfigReader = make_unique<OConfigReader>(RootDirPath.GetPath() + "/Resources/Config/Config.json");
 
+	// Off by default, parsing the current configs takes about as long as validating and reading their snapshots
+	if (const auto snapshotPath = ConfigReader->GetRoot<string>("ConfigSnapshotPath"); !snapshotPath.empty())
+	{
+		OConfigReader::SetSnapshotDirectory(RootDirPath.GetPath() + snapshotPath);
+	}
+
 	// Enable run-time memory check for debug builds.
 #if defined(DEBUG) | defined(_DEBUG)
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -72,6 +80,103 @@ void OApplication::InitApplication(HINSTANCE hInstance)
 	Engine->Initialize();
 }
 
+// False if the whole argument isn't a number, Value is left untouched then
+template<typename T>
+static bool ParseNumber(const wstring& Argument, T& Value)
+{
+	const string text = WStringToUTF8(Argument);
+	T result{};
+	const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), result);
+	if (error != std::errc() || end != text.data() + text.size())
+	{
+		return false;
+	}
+	Value = result;
+	return true;
+}
+
+void OApplication::ParseCommandLine(PWSTR CmdLine)
+{
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(CmdLine, &argc);
+	if (argv == nullptr)
+	{
+		return;
+	}
+
+	for (int i = 0; i < argc; i++)
+	{
+		const wstring arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == L"-record" && hasValue)
+		{
+			RecordPath = WStringToUTF8(argv[++i]);
+		}
+		else if (arg == L"-replay" && hasValue)
+		{
+			ReplayPath = WStringToUTF8(argv[++i]);
+		}
+		else if (arg == L"-fixeddt" && hasValue)
+		{
+			const wstring value = argv[++i];
+			if (!ParseNumber(value, ReplayFixedDeltaTime))
+			{
+				LOG(Engine, Warning, "-fixeddt expects a step in seconds, got {}, replaying with {} s", value, ReplayFixedDeltaTime);
+			}
+		}
+		else if (arg == L"-headless")
+		{
+			SRenderBackend::Backend = ERenderBackend::Headless;
+		}
+		else if (arg == L"-recordthreads" && hasValue)
+		{
+			const wstring value = argv[++i];
+			uint32_t numThreads = 0;
+			if (ParseNumber(value, numThreads))
+			{
+				NumRecordingThreads = numThreads;
+			}
+			else
+			{
+				LOG(Engine, Warning, "-recordthreads expects a thread count, got {}", value);
+			}
+		}
+		else if (arg == L"-recordbench")
+		{
+			bRunRecordingBenchmark = true;
+		}
+		else if (arg == L"-shaderthreads" && hasValue)
+		{
+			const wstring value = argv[++i];
+			if (!ParseNumber(value, OShaderCompiler::NumThreads))
+			{
+				LOG(Engine, Warning, "-shaderthreads expects a thread count, got {}", value);
+			}
+		}
+		else if (arg == L"-shaderbench")
+		{
+			bRunShaderBenchmark = true;
+		}
+		else if (arg == L"-bindbench")
+		{
+			bRunBindingBenchmark = true;
+		}
+		else if (arg == L"-configbench")
+		{
+			bRunConfigBenchmark = true;
+		}
+		else if (arg == L"-noshaderreload")
+		{
+			OGraphicsPipelineManager::bShaderHotReload = false;
+		}
+		else if (arg == L"-noconfigreload")
+		{
+			OEngine::bConfigHotReload = false;
+		}
+	}
+	LocalFree(argv);
+}
+
 HINSTANCE OApplication::GetAppInstance() const
 {
 	return AppInstance;
@@ -163,6 +268,20 @@ static MouseButtonEventArgs::EMouseButton DecodeMouseButton(UINT messageID)
 	return mouseButton;
 }
 
+static SInputEvent MakeInputEvent(EInputEventType Type, HWND Hwnd, bool LeftButton, bool MiddleButton, bool RightButton, bool Control, bool Shift, bool Alt)
+{
+	SInputEvent event;
+	event.Type = Type;
+	event.Window = reinterpret_cast<uint64_t>(Hwnd);
+	event.Flags = (LeftButton ? SInputEvent::LeftButton : 0)
+	              | (MiddleButton ? SInputEvent::MiddleButton : 0)
+	              | (RightButton ? SInputEvent::RightButton : 0)
+	              | (Control ? SInputEvent::Control : 0)
+	              | (Shift ? SInputEvent::Shift : 0)
+	              | (Alt ? SInputEvent::Alt : 0);
+	return event;
+}
+
 LRESULT CALLBACK OApplication::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 {
 	auto app = Get();
@@ -216,16 +335,16 @@ LRESULT CALLBACK OApplication::WndProc(HWND hwnd, UINT message, WPARAM wParam, L
 				c = static_cast<unsigned int>(charMsg.wParam);
 			}
 			bool alt = (GetAsyncKeyState(VK_MENU) & 0x8000) != 0;
-			KeyCode::Key key = static_cast<KeyCode::Key>(wParam);
-			KeyEventArgs keyEventArgs(key, c, KeyEventArgs::Pressed, asyncShift, asyncControl, alt, hwnd);
-			engine->OnKeyPressed(keyEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::KeyPressed, hwnd, false, false, false, asyncControl, asyncShift, alt);
+			event.Key = static_cast<uint32_t>(wParam);
+			event.Char = c;
+			engine->PushInputEvent(event);
 		}
 		break;
 		case WM_SYSKEYUP:
 		case WM_KEYUP:
 		{
 			bool alt = (GetAsyncKeyState(VK_MENU) & 0x8000) != 0;
-			KeyCode::Key key = static_cast<KeyCode::Key>(wParam);
 			unsigned int c = 0;
 			unsigned int scanCode = (lParam & 0x00FF0000) >> 16;
 
@@ -241,8 +360,10 @@ LRESULT CALLBACK OApplication::WndProc(HWND hwnd, UINT message, WPARAM wParam, L
 				c = translatedCharacters[0];
 			}
 
-			KeyEventArgs keyEventArgs(key, c, KeyEventArgs::Released, asyncControl, asyncShift, alt, hwnd);
-			engine->OnKeyReleased(keyEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::KeyReleased, hwnd, false, false, false, asyncControl, asyncShift, alt);
+			event.Key = static_cast<uint32_t>(wParam);
+			event.Char = c;
+			engine->PushInputEvent(event);
 		}
 		break;
 		// The default window procedure will play a system notification sound
@@ -252,24 +373,32 @@ LRESULT CALLBACK OApplication::WndProc(HWND hwnd, UINT message, WPARAM wParam, L
 			break;
 		case WM_MOUSEMOVE:
 		{
-			MouseMotionEventArgs mouseMotionEventArgs(lButton, mButton, rButton, control, shift, x, y, hwnd);
-			engine->OnMouseMoved(mouseMotionEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::MouseMoved, hwnd, lButton, mButton, rButton, control, shift, false);
+			event.X = x;
+			event.Y = y;
+			engine->PushInputEvent(event);
 		}
 		break;
 		case WM_LBUTTONDOWN:
 		case WM_RBUTTONDOWN:
 		case WM_MBUTTONDOWN:
 		{
-			MouseButtonEventArgs mouseButtonEventArgs(DecodeMouseButton(message), MouseButtonEventArgs::Pressed, lButton, mButton, rButton, control, shift, x, y, hwnd);
-			engine->OnMouseButtonPressed(mouseButtonEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::MouseButtonPressed, hwnd, lButton, mButton, rButton, control, shift, false);
+			event.Button = static_cast<uint8_t>(DecodeMouseButton(message));
+			event.X = x;
+			event.Y = y;
+			engine->PushInputEvent(event);
 		}
 		break;
 		case WM_LBUTTONUP:
 		case WM_RBUTTONUP:
 		case WM_MBUTTONUP:
 		{
-			MouseButtonEventArgs mouseButtonEventArgs(DecodeMouseButton(message), MouseButtonEventArgs::Released, lButton, mButton, rButton, control, shift, x, y, hwnd);
-			engine->OnMouseButtonReleased(mouseButtonEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::MouseButtonReleased, hwnd, lButton, mButton, rButton, control, shift, false);
+			event.Button = static_cast<uint8_t>(DecodeMouseButton(message));
+			event.X = x;
+			event.Y = y;
+			engine->PushInputEvent(event);
 		}
 		break;
 		case WM_MOUSEWHEEL:
@@ -285,8 +414,11 @@ LRESULT CALLBACK OApplication::WndProc(HWND hwnd, UINT message, WPARAM wParam, L
 			clientToScreenPoint.y = y;
 			ScreenToClient(hwnd, &clientToScreenPoint);
 
-			MouseWheelEventArgs mouseWheelEventArgs(zDelta, lButton, mButton, rButton, control, shift, static_cast<int>(clientToScreenPoint.x), static_cast<int>(clientToScreenPoint.y), hwnd);
-			engine->OnMouseWheel(mouseWheelEventArgs);
+			SInputEvent event = MakeInputEvent(EInputEventType::MouseWheel, hwnd, lButton, mButton, rButton, control, shift, false);
+			event.WheelDelta = zDelta;
+			event.X = static_cast<int>(clientToScreenPoint.x);
+			event.Y = static_cast<int>(clientToScreenPoint.y);
+			engine->PushInputEvent(event);
 		}
 		break;
 		case WM_SIZE:
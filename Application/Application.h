@@ -5,6 +5,7 @@
 #include "Window/Window.h"
 
 #include <filesystem>
+#include <optional>
 
 class OConfigReader;
 class OTest;
@@ -23,6 +24,7 @@ public:
 
 	void Quit(int ExitCode);
 	void InitApplication(HINSTANCE hInstance);
+	void ParseCommandLine(PWSTR CmdLine);
 
 	template<typename TestType = OTest>
 	int Run();
@@ -59,6 +61,16 @@ private:
 	SPath CurrentPath;
 
 	unique_ptr<OConfigReader> ConfigReader;
+
+	// -record <file> / -replay <file> [-fixeddt <seconds>] / -headless / -recordthreads <count> / -recordbench / -bindbench / -shaderthreads <count> / -shaderbench / -configbench / -noshaderreload / -noconfigreload
+	string RecordPath;
+	string ReplayPath;
+	float ReplayFixedDeltaTime = 1.0f / 60.0f;
+	std::optional<uint32_t> NumRecordingThreads;
+	bool bRunRecordingBenchmark = false;
+	bool bRunBindingBenchmark = false;
+	bool bRunShaderBenchmark = false;
+	bool bRunConfigBenchmark = false;
 };
 
 template<typename TestType>
@@ -67,6 +79,45 @@ int OApplication::Run()
 	auto test = make_shared<TestType>(Engine->GetWindow());
 	Engine->InitTests(test);
 
+	if (NumRecordingThreads)
+	{
+		Engine->SetNumRecordingThreads(*NumRecordingThreads);
+	}
+
+	if (bRunShaderBenchmark)
+	{
+		Engine->RunShaderCompileBenchmark();
+		Quit(0);
+	}
+
+	if (bRunBindingBenchmark)
+	{
+		Engine->RunBindingBenchmark();
+		Quit(0);
+	}
+
+	if (bRunConfigBenchmark)
+	{
+		Engine->RunConfigBenchmark();
+		Quit(0);
+	}
+
+	if (bRunRecordingBenchmark)
+	{
+		Timer.Reset();
+		Engine->RunRecordingBenchmark(Timer);
+		Quit(0);
+	}
+
+	if (!ReplayPath.empty())
+	{
+		Engine->StartReplay(ReplayPath, ReplayFixedDeltaTime);
+	}
+	else if (!RecordPath.empty())
+	{
+		Engine->StartRecording(RecordPath);
+	}
+
 	Timer.Reset();
 	MSG msg = { 0 };
 	while (msg.message != WM_QUIT)
@@ -76,6 +127,17 @@ int OApplication::Run()
 			TranslateMessage(&msg);
 			DispatchMessage(&msg);
 		}
+		else if (Engine->IsReplaying())
+		{
+			if (!Engine->PrepareReplayFrame())
+			{
+				Engine->StopReplay();
+				Quit(0);
+				continue;
+			}
+			UpdateEventArgs args(Engine->GetReplayTimer(), Engine->GetWindow()->GetHWND());
+			Engine->Draw(args);
+		}
 		else
 		{
 			Timer.Tick();
@@ -91,6 +153,7 @@ int OApplication::Run()
 			}
 		}
 	}
+	Engine->StopRecording();
 	Engine->OnEnd(test);
 	return static_cast<int>(msg.wParam);
 }
@@ -0,0 +1,31 @@
+#pragma once
+#include "DirectX/DXHelper.h"
+#include "Types.h"
+
+struct SPSODescriptionBase;
+class ORenderTargetBase;
+
+/**
+ * @brief Command list together with the state recorded into it. Redundancy tracking lives here instead of the queue
+ * so that several lists may be recorded at the same time, each on its own thread.
+ * Allocator and list are only owned while the context is open, they return to the queue pools on submission.
+ */
+struct SCommandContext
+{
+	ComPtr<ID3D12CommandAllocator> CommandAllocator;
+	ComPtr<ID3D12GraphicsCommandList> CommandList;
+
+	ORenderTargetBase* CurrentRenderTarget = nullptr;
+	SPSODescriptionBase* CurrentPSO = nullptr;
+
+	// Last value bound to each root parameter of CurrentPSO, zero if nothing has been bound yet
+	vector<UINT64> RootValues;
+	bool bIsReset = false;
+
+	void ResetState()
+	{
+		CurrentRenderTarget = nullptr;
+		CurrentPSO = nullptr;
+		RootValues.clear();
+	}
+};
@@ -0,0 +1,50 @@
+#include "CommandLog.h"
+
+#include "Logger.h"
+#include "Stats/Stats.h"
+
+void SCommandLog::Record(ECommandType Type)
+{
+	Counters[static_cast<size_t>(Type)].fetch_add(1, std::memory_order_relaxed);
+	STAT_INC(CommandsRecorded);
+}
+
+bool SCommandLog::Validate(bool bCondition, const string& Message)
+{
+	if (!bCondition)
+	{
+		ValidationErrors.fetch_add(1, std::memory_order_relaxed);
+		STAT_INC(CommandValidationErrors);
+		LOG(Engine, Warning, "Command validation failed: {}", TEXT(Message));
+	}
+	return bCondition;
+}
+
+void SCommandLog::Reset()
+{
+	for (auto& counter : Counters)
+	{
+		counter.store(0, std::memory_order_relaxed);
+	}
+	ValidationErrors.store(0, std::memory_order_relaxed);
+}
+
+uint64_t SCommandLog::Get(ECommandType Type) const
+{
+	return Counters[static_cast<size_t>(Type)].load(std::memory_order_relaxed);
+}
+
+uint64_t SCommandLog::GetTotal() const
+{
+	uint64_t result = 0;
+	for (const auto& counter : Counters)
+	{
+		result += counter.load(std::memory_order_relaxed);
+	}
+	return result;
+}
+
+uint64_t SCommandLog::GetValidationErrors() const
+{
+	return ValidationErrors.load(std::memory_order_relaxed);
+}
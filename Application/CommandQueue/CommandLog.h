@@ -0,0 +1,40 @@
+#pragma once
+#include "Types.h"
+
+#include <array>
+#include <atomic>
+
+ENUM(ECommandType,
+     SetPipelineState,
+     SetResource,
+     ResourceBarrier,
+     CopyResource,
+     SetRenderTarget,
+     Draw,
+     Dispatch,
+     ExecuteCommandList,
+     Signal,
+     Present,
+     Num)
+
+inline constexpr size_t NumCommandTypes = static_cast<size_t>(ECommandType::Num);
+
+/**
+ * @brief Counts the commands issued through a command queue and validates their order.
+ * The headless backend never submits its command lists, in regular mode the log just mirrors what has been recorded.
+ * Command lists may be recorded from several threads, the counters are atomic.
+ */
+struct SCommandLog
+{
+	void Record(ECommandType Type);
+	bool Validate(bool bCondition, const string& Message);
+	void Reset();
+
+	uint64_t Get(ECommandType Type) const;
+	uint64_t GetTotal() const;
+	uint64_t GetValidationErrors() const;
+
+private:
+	std::array<std::atomic<uint64_t>, NumCommandTypes> Counters = {};
+	std::atomic<uint64_t> ValidationErrors = 0;
+};
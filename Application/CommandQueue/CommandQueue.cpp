@@ -1,64 +1,172 @@
 #include "CommandQueue.h"
 
+#include "DirectX/RenderBackend.h"
 #include "DirectX/ShaderTypes.h"
 #include "Logger.h"
+#include "Stats/Stats.h"
+#include "Window/Window.h"
 
 #include <Exception.h>
+#include <chrono>
 
 OCommandQueue::OCommandQueue(Microsoft::WRL::ComPtr<ID3D12Device2> Device, D3D12_COMMAND_LIST_TYPE Type)
     : FenceValue(0)
     , CommandListType(Type)
     , Device(Device)
+    , bIsHeadless(SRenderBackend::IsHeadless())
 {
 	D3D12_COMMAND_QUEUE_DESC desc = {};
 	desc.Type = Type;
 	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
 
 	THROW_IF_FAILED(Device->CreateCommandQueue(&desc, IID_PPV_ARGS(&CommandQueue)));
-	THROW_IF_FAILED(Device->CreateCommandAllocator(Type, IID_PPV_ARGS(CommandAllocator.GetAddressOf())));
-	THROW_IF_FAILED(Device->CreateCommandList(0, Type, CommandAllocator.Get(), nullptr, IID_PPV_ARGS(CommandList.GetAddressOf())));
 
 	FenceEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
 	CHECK(FenceEvent);
 
-	CommandList->Close();
-	IsReset = false;
 	THROW_IF_FAILED(Device->CreateFence(FenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&Fence)));
 }
 
 OCommandQueue::~OCommandQueue()
 {
+	::CloseHandle(FenceEvent);
 }
 
 Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> OCommandQueue::GetCommandList()
 {
-	return CommandList;
+	return GetContext().CommandList;
 }
 
 Microsoft::WRL::ComPtr<ID3D12CommandAllocator> OCommandQueue::GetCommandAllocator()
 {
-	return CommandAllocator;
+	return GetContext().CommandAllocator;
 }
 
 uint64_t OCommandQueue::ExecuteCommandList()
 {
-	if (!IsReset)
+	if (!MainContext->bIsReset)
 	{
 		LOG(Engine, Warning, "Command list has to be reset before closing!");
 		return 0;
 	}
 
-	IsReset = false;
-	CommandList->Close();
-	ID3D12CommandList* const commandLists[] = {
-		CommandList.Get()
-	};
-
-	CommandQueue->ExecuteCommandLists(1, commandLists);
+	CloseContext(*MainContext);
+	PendingContexts.push_back(MainContext);
+	CommandLog.Record(ECommandType::ExecuteCommandList);
+	if (!bIsHeadless)
+	{
+		vector<ID3D12CommandList*> commandLists;
+		commandLists.reserve(PendingContexts.size());
+		for (const auto context : PendingContexts)
+		{
+			commandLists.push_back(context->CommandList.Get());
+		}
+		CommandQueue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+	}
 	uint64_t fenceValue = Signal();
+
+	{
+		SLockGuard lock(ContextMutex);
+		for (const auto context : PendingContexts)
+		{
+			CommandAllocatorQueue.push({ fenceValue, move(context->CommandAllocator) });
+			CommandListQueue.push(move(context->CommandList));
+			if (context != &DefaultContext)
+			{
+				FreeContexts.push_back(context);
+			}
+		}
+	}
+	PendingContexts.clear();
+	MainContext = &DefaultContext;
 	return fenceValue;
 }
 
+SCommandContext* OCommandQueue::AcquireContext()
+{
+	SCommandContext* context = nullptr;
+	{
+		SLockGuard lock(ContextMutex);
+		if (FreeContexts.empty())
+		{
+			FreeContexts.push_back(Contexts.emplace_back(make_unique<SCommandContext>()).get());
+		}
+		context = FreeContexts.back();
+		FreeContexts.pop_back();
+	}
+	OpenContext(*context);
+	return context;
+}
+
+void OCommandQueue::OpenContext(SCommandContext& Context)
+{
+	{
+		SLockGuard lock(ContextMutex);
+		Context.CommandAllocator = AcquireCommandAllocator();
+		Context.CommandList = AcquireCommandList(Context.CommandAllocator);
+	}
+	Context.ResetState();
+	Context.bIsReset = true;
+}
+
+Microsoft::WRL::ComPtr<ID3D12CommandAllocator> OCommandQueue::AcquireCommandAllocator()
+{
+	if (!CommandAllocatorQueue.empty() && IsFenceComplete(CommandAllocatorQueue.front().FenceValue))
+	{
+		auto allocator = move(CommandAllocatorQueue.front().CommandAllocator);
+		CommandAllocatorQueue.pop();
+		THROW_IF_FAILED(allocator->Reset());
+		return allocator;
+	}
+
+	// Every allocator in the pool is still used by the GPU, growing the pool is cheaper than waiting
+	STAT_INC(CommandAllocatorsCreated);
+	return CreateCommandAllocator();
+}
+
+Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> OCommandQueue::AcquireCommandList(const ComPtr<ID3D12CommandAllocator>& Allocator)
+{
+	if (!CommandListQueue.empty())
+	{
+		auto list = move(CommandListQueue.front());
+		CommandListQueue.pop();
+		THROW_IF_FAILED(list->Reset(Allocator.Get(), nullptr));
+		return list;
+	}
+	return CreateCommandList(Allocator);
+}
+
+void OCommandQueue::BindThreadContext(SCommandContext* Context) const
+{
+	ThreadContext = { Context ? this : nullptr, Context };
+}
+
+void OCommandQueue::EnqueueContexts(std::span<SCommandContext* const> InContexts)
+{
+	CloseContext(*MainContext);
+	PendingContexts.push_back(MainContext);
+	for (const auto context : InContexts)
+	{
+		CloseContext(*context);
+		PendingContexts.push_back(context);
+	}
+	MainContext = AcquireContext();
+}
+
+SCommandContext& OCommandQueue::GetContext() const
+{
+	return ThreadContext.Queue == this ? *ThreadContext.Context : *MainContext;
+}
+
+void OCommandQueue::CloseContext(SCommandContext& Context) const
+{
+	if (Context.bIsReset)
+	{
+		THROW_IF_FAILED(Context.CommandList->Close());
+		Context.bIsReset = false;
+	}
+}
+
 void OCommandQueue::ExecuteCommandListAndWait()
 {
 	WaitForFenceValue(ExecuteCommandList());
@@ -78,6 +186,14 @@ void OCommandQueue::ExecuteCommandListAndWait()
 uint64_t OCommandQueue::Signal()
 {
 	uint64_t fenceValueForSignal = ++FenceValue;
+	CommandLog.Record(ECommandType::Signal);
+	if (bIsHeadless)
+	{
+		// Nothing has been submitted, complete the fence right away from the CPU side.
+		THROW_IF_FAILED(Fence->Signal(fenceValueForSignal));
+		return fenceValueForSignal;
+	}
+
 	// Put the fence in the command queue, exlicitly telling up to what point we consider those command to get done.
 	THROW_IF_FAILED(CommandQueue->Signal(Fence.Get(), fenceValueForSignal));
 
@@ -96,11 +212,12 @@ void OCommandQueue::WaitForFenceValue(uint64_t FenceValue)
 {
 	if (Fence->GetCompletedValue() < FenceValue)
 	{
-		FenceEvent = ::CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
-
+		const auto waitStart = std::chrono::high_resolution_clock::now();
 		THROW_IF_FAILED(Fence->SetEventOnCompletion(FenceValue, FenceEvent));
 		::WaitForSingleObject(FenceEvent, INFINITE);
-		::CloseHandle(FenceEvent);
+
+		STAT_INC(CPUWaitsOnGPU);
+		STAT_SAMPLE(CPUWaitTimeUs, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - waitStart).count());
 	}
 }
 
@@ -115,13 +232,13 @@ void OCommandQueue::Flush()
 
 void OCommandQueue::TryResetCommandList()
 {
-	if (IsReset)
+	if (MainContext->bIsReset)
 	{
 		LOG(Engine, Warning, "Command list is already reset!");
 		return;
 	}
-	IsReset = true;
-	THROW_IF_FAILED(CommandList->Reset(CommandAllocator.Get(), nullptr));
+	MainContext = &DefaultContext;
+	OpenContext(DefaultContext);
 }
 
 Microsoft::WRL::ComPtr<ID3D12Fence> OCommandQueue::GetFence() const
@@ -131,75 +248,126 @@ Microsoft::WRL::ComPtr<ID3D12Fence> OCommandQueue::GetFence() const
 
 void OCommandQueue::SetPipelineState(SPSODescriptionBase* PSOInfo)
 {
-	if (CurrentPSO == PSOInfo)
+	auto& context = GetContext();
+	if (context.CurrentPSO == PSOInfo)
 	{
 		return;
 	}
 
-	CurrentPSO = PSOInfo;
-	SetResources.clear();
+	context.CurrentPSO = PSOInfo;
+	context.RootValues.assign(PSOInfo->RootSignature->GetNumRootParameters(), 0);
+	STAT_INC(PSOSwitches);
+	CommandLog.Record(ECommandType::SetPipelineState);
+	CommandLog.Validate(context.bIsReset, "SetPipelineState on a closed command list");
 	LOG(Engine, Log, "Setting pipeline state for PSO: {}", TEXT(PSOInfo->Name));
-	CommandList->SetPipelineState(PSOInfo->PSO.Get());
+	context.CommandList->SetPipelineState(PSOInfo->PSO.Get());
 
-	if (CurrentPSO->Type == EPSOType::Graphics)
+	if (PSOInfo->Type == EPSOType::Graphics)
 	{
-		CommandList->SetGraphicsRootSignature(PSOInfo->RootSignature->RootSignatureParams.RootSignature.Get());
+		context.CommandList->SetGraphicsRootSignature(PSOInfo->RootSignature->RootSignatureParams.RootSignature.Get());
 	}
 	else
 	{
-		CommandList->SetComputeRootSignature(PSOInfo->RootSignature->RootSignatureParams.RootSignature.Get());
+		context.CommandList->SetComputeRootSignature(PSOInfo->RootSignature->RootSignatureParams.RootSignature.Get());
 	}
 }
 
-void OCommandQueue::SetResource(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Resource, SPSODescriptionBase* PSO)
+int32_t OCommandQueue::PrepareRootBinding(SCommandContext& Context, TShaderSlot Slot, UINT64 Value, SPSODescriptionBase* PSO)
 {
-	if (CurrentPSO != PSO)
+	if (Context.CurrentPSO != PSO)
 	{
 		LOG(Engine, Warning, "Trying to set resource view for a different PSO!")
 		SetPipelineState(PSO);
 	}
 
-	if (SetResources.contains(Name) && SetResources[Name] == Resource)
+	const int32_t rootIndex = PSO->RootSignature->GetRootIndex(Slot);
+	if (rootIndex == -1)
 	{
-		LOG(Engine, Warning, "Resource {} already set!", TEXT(Name));
-		return;
+		LOG(Render, Warning, "Descriptor table name not found: {}", TEXT(SShaderSlots::GetName(Slot)));
+		return -1;
+	}
+
+	if (Context.RootValues[rootIndex] == Value)
+	{
+		LOG(Engine, Warning, "Resource {} already set!", TEXT(SShaderSlots::GetName(Slot)));
+		STAT_INC(RedundantResourceSetsSkipped);
+		return -1;
 	}
 
-	PSO->RootSignature->SetResource(Name, Resource, CommandList.Get());
-	SetResources[Name]= Resource;
+	CommandLog.Record(ECommandType::SetResource);
+	if (Value == 0)
+	{
+		CommandLog.Validate(false, "Null resource bound to " + SShaderSlots::GetName(Slot));
+	}
+	Context.RootValues[rootIndex] = Value;
+	return rootIndex;
 }
 
-void OCommandQueue::SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Resource, SPSODescriptionBase* PSO)
+void OCommandQueue::SetResource(TShaderSlot Slot, D3D12_GPU_VIRTUAL_ADDRESS Resource, SPSODescriptionBase* PSO)
 {
-	if (CurrentPSO != PSO)
+	auto& context = GetContext();
+	const int32_t rootIndex = PrepareRootBinding(context, Slot, Resource, PSO);
+	if (rootIndex != -1)
 	{
-		LOG(Engine, Error, "Trying to set resource view for a different PSO!")
-		SetPipelineState(PSO);
+		PSO->RootSignature->SetRootDescriptor(rootIndex, Resource, context.CommandList.Get());
 	}
+}
 
-	if (SetResources.contains(Name) && SetResources[Name] == Resource.ptr)
+void OCommandQueue::SetResource(TShaderSlot Slot, D3D12_GPU_DESCRIPTOR_HANDLE Resource, SPSODescriptionBase* PSO)
+{
+	auto& context = GetContext();
+	const int32_t rootIndex = PrepareRootBinding(context, Slot, Resource.ptr, PSO);
+	if (rootIndex != -1)
 	{
-		LOG(Engine, Warning, "Resource {} already set!", TEXT(Name));
-		return;
+		PSO->RootSignature->SetRootDescriptorTable(rootIndex, Resource, context.CommandList.Get());
+	}
+}
+
+void OCommandQueue::SetResource(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Resource, SPSODescriptionBase* PSO)
+{
+	SetResource(SShaderSlots::Intern(Name), Resource, PSO);
+}
+
+void OCommandQueue::SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Resource, SPSODescriptionBase* PSO)
+{
+	SetResource(SShaderSlots::Intern(Name), Resource, PSO);
+}
+
+void OCommandQueue::SetRootConstant(uint32_t RootIndex, uint32_t Value, SPSODescriptionBase* PSO)
+{
+	auto& context = GetContext();
+	if (context.CurrentPSO != PSO)
+	{
+		LOG(Engine, Error, "Trying to set root constant for a different PSO!")
+		SetPipelineState(PSO);
 	}
 
-	PSO->RootSignature->SetResource(Name, Resource, CommandList.Get());
-	SetResources[Name] = Resource.ptr;
+	CommandLog.Record(ECommandType::SetResource);
+	PSO->RootSignature->SetRootConstant(RootIndex, Value, context.CommandList.Get());
 }
 
 void OCommandQueue::ResourceBarrier(ORenderTargetBase* Resource, D3D12_RESOURCE_STATES StateBefore, D3D12_RESOURCE_STATES StateAfter) const
 {
-	Utils::ResourceBarrier(CommandList.Get(), Resource->GetResource(), StateBefore, StateAfter);
+	CommandLog.Record(ECommandType::ResourceBarrier);
+	Utils::ResourceBarrier(GetContext().CommandList.Get(), Resource->GetResource(), StateBefore, StateAfter);
 }
 
 void OCommandQueue::ResourceBarrier(ORenderTargetBase* Resource, D3D12_RESOURCE_STATES StateAfter) const
 {
-	Utils::ResourceBarrier(CommandList.Get(), Resource->GetResource(), StateAfter);
+	CommandLog.Record(ECommandType::ResourceBarrier);
+	Utils::ResourceBarrier(GetContext().CommandList.Get(), Resource->GetResource(), StateAfter);
 }
 
 void OCommandQueue::ResourceBarrier(SResourceInfo* Resource, D3D12_RESOURCE_STATES StateAfter) const
 {
-	Utils::ResourceBarrier(CommandList.Get(), Resource, StateAfter);
+	CommandLog.Record(ECommandType::ResourceBarrier);
+	Utils::ResourceBarrier(GetContext().CommandList.Get(), Resource, StateAfter);
+}
+
+void OCommandQueue::ResourceBarriers(std::span<const SResourceTransition> Transitions, std::span<ID3D12Resource* const> AliasedResources) const
+{
+	CommandLog.Record(ECommandType::ResourceBarrier);
+	Utils::ResourceBarriers(GetContext().CommandList.Get(), Transitions, AliasedResources);
 }
 
 void OCommandQueue::CopyResourceTo(ORenderTargetBase* Dest, ORenderTargetBase* Src) const
@@ -211,29 +379,82 @@ void OCommandQueue::CopyResourceTo(ORenderTargetBase* Dest, ORenderTargetBase* S
 	}
 
 	ResourceBarrier(Dest, D3D12_RESOURCE_STATE_COPY_DEST);
-	ResourceBarrier(Src, D3D12_RESOURCE_STATE_COPY_SOURCE);
-	CommandList->CopyResource(Dest->GetResource()->Resource.Get(), Src->GetResource()->Resource.Get());
+
+	// A combined read state which includes copy source is kept, the render graph may have put the source there
+	if ((Src->GetResource()->CurrentState & D3D12_RESOURCE_STATE_COPY_SOURCE) == 0)
+	{
+		ResourceBarrier(Src, D3D12_RESOURCE_STATE_COPY_SOURCE);
+	}
+	CommandLog.Record(ECommandType::CopyResource);
+	GetContext().CommandList->CopyResource(Dest->GetResource()->Resource.Get(), Src->GetResource()->Resource.Get());
 	ResourceBarrier(Dest, D3D12_RESOURCE_STATE_RENDER_TARGET);
 }
 
 ORenderTargetBase* OCommandQueue::SetRenderTarget(ORenderTargetBase* RenderTarget, uint32_t Subtarget)
 {
-	if (CurrentRenderTarget && CurrentRenderTarget != RenderTarget)
+	auto& context = GetContext();
+	if (context.CurrentRenderTarget && context.CurrentRenderTarget != RenderTarget)
 	{
-		CurrentRenderTarget->UnsetRenderTarget(this);
+		context.CurrentRenderTarget->UnsetRenderTarget(this);
 	}
 
-	RenderTarget->PrepareRenderTarget(CommandList.Get(),Subtarget);
-	CurrentRenderTarget = RenderTarget;
+	CommandLog.Record(ECommandType::SetRenderTarget);
+	RenderTarget->PrepareRenderTarget(context.CommandList.Get(), Subtarget);
+	context.CurrentRenderTarget = RenderTarget;
 	return RenderTarget;
 }
 
+void OCommandQueue::BindRenderTarget(ORenderTargetBase* RenderTarget, uint32_t Subtarget)
+{
+	auto& context = GetContext();
+	CommandLog.Record(ECommandType::SetRenderTarget);
+	RenderTarget->BindRenderTarget(context.CommandList.Get(), Subtarget);
+	context.CurrentRenderTarget = RenderTarget;
+}
+
+
+void OCommandQueue::DrawIndexedInstanced(UINT IndexCount, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation)
+{
+	CommandLog.Record(ECommandType::Draw);
+	const auto& context = GetContext();
+	CommandLog.Validate(context.CurrentPSO != nullptr, "Draw without a pipeline state");
+	CommandLog.Validate(context.CurrentRenderTarget != nullptr, "Draw without a render target");
+	context.CommandList->DrawIndexedInstanced(IndexCount, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
+	STAT_INC(DrawCalls);
+}
+
+void OCommandQueue::DrawInstanced(UINT VertexCount, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation)
+{
+	CommandLog.Record(ECommandType::Draw);
+	const auto& context = GetContext();
+	CommandLog.Validate(context.CurrentPSO != nullptr, "Draw without a pipeline state");
+	CommandLog.Validate(context.CurrentRenderTarget != nullptr, "Draw without a render target");
+	context.CommandList->DrawInstanced(VertexCount, InstanceCount, StartVertexLocation, StartInstanceLocation);
+	STAT_INC(DrawCalls);
+}
+
+void OCommandQueue::Present(OWindow* Window)
+{
+	CommandLog.Record(ECommandType::Present);
+	CommandLog.Validate(!MainContext->bIsReset, "Present with an open command list");
+	Window->Present();
+}
+
+const SCommandLog& OCommandQueue::GetCommandLog() const
+{
+	return CommandLog;
+}
 
 void OCommandQueue::ResetQueueState()
 {
-	CurrentRenderTarget->UnsetRenderTarget(this);
-	CurrentRenderTarget = nullptr;
-	CurrentPSO = nullptr;
+	for (auto* context : { &DefaultContext, MainContext })
+	{
+		if (context->CurrentRenderTarget)
+		{
+			context->CurrentRenderTarget->UnsetRenderTarget(this);
+		}
+		context->ResetState();
+	}
 }
 
 Microsoft::WRL::ComPtr<ID3D12CommandQueue> OCommandQueue::GetCommandQueue()
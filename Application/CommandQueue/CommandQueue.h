@@ -1,10 +1,15 @@
 #pragma once
+#include "Async.h"
+#include "CommandContext.h"
+#include "CommandLog.h"
 #include "DirectX/DXHelper.h"
+#include "DirectX/ShaderTypes.h"
 #include "Engine/RenderTarget/RenderTarget.h"
 #include "Types.h"
 
 struct SPSODescriptionBase;
 struct SShaderPipelineDesc;
+class OWindow;
 class OCommandQueue
 {
 public:
@@ -15,9 +20,17 @@ public:
 	ComPtr<ID3D12CommandAllocator> GetCommandAllocator();
 	ComPtr<ID3D12CommandQueue> GetCommandQueue();
 
+	// Submits the enqueued contexts followed by the main command list with a single ExecuteCommandLists call
 	uint64_t ExecuteCommandList();
 	void ExecuteCommandListAndWait();
 
+	// Opened context from the pool, record into it from any thread after binding it there
+	SCommandContext* AcquireContext();
+	void BindThreadContext(SCommandContext* Context) const;
+
+	// Closes the main command list and then the given contexts, they are submitted in this order. Recording continues in a fresh context.
+	void EnqueueContexts(std::span<SCommandContext* const> Contexts);
+
 	uint64_t Signal();
 
 	bool IsFenceComplete(uint64_t FenceValue) const;
@@ -30,18 +43,53 @@ public:
 	void ResourceBarrier(ORenderTargetBase* Resource, D3D12_RESOURCE_STATES StateAfter) const;
 
 	void ResourceBarrier(SResourceInfo* Resource, D3D12_RESOURCE_STATES StateAfter) const;
+	void ResourceBarriers(std::span<const SResourceTransition> Transitions, std::span<ID3D12Resource* const> AliasedResources = {}) const;
 
 	void CopyResourceTo(ORenderTargetBase* Dest, ORenderTargetBase* Src) const;
 	ORenderTargetBase* SetRenderTarget(ORenderTargetBase* RenderTarget, uint32_t Subtarget = 0);
+
+	// Binds a target which has already been prepared in another context of this frame
+	void BindRenderTarget(ORenderTargetBase* RenderTarget, uint32_t Subtarget = 0);
 	void ResetQueueState();
+
+	// Slots are interned once by the caller, see SShaderSlots. The string overloads intern on every call.
+	void SetResource(TShaderSlot Slot, D3D12_GPU_VIRTUAL_ADDRESS Resource, SPSODescriptionBase* PSO);
+	void SetResource(TShaderSlot Slot, D3D12_GPU_DESCRIPTOR_HANDLE Resource, SPSODescriptionBase* PSO);
 	void SetResource(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Resource, SPSODescriptionBase* PSO);
 	void SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Resource, SPSODescriptionBase* PSO);
 
+	// Per draw values, the root index is resolved once per pipeline by the caller
+	void SetRootConstant(uint32_t RootIndex, uint32_t Value, SPSODescriptionBase* PSO);
+
+	void DrawIndexedInstanced(UINT IndexCount, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation);
+	void DrawInstanced(UINT VertexCount, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation);
+	void Present(OWindow* Window);
+
+	const SCommandLog& GetCommandLog() const;
+
 protected:
 	ComPtr<ID3D12CommandAllocator> CreateCommandAllocator();
 	ComPtr<ID3D12GraphicsCommandList> CreateCommandList(ComPtr<ID3D12CommandAllocator> Allocator);
 
 private:
+	// Context bound to the calling thread, the main context otherwise
+	SCommandContext& GetContext() const;
+	void OpenContext(SCommandContext& Context);
+	void CloseContext(SCommandContext& Context) const;
+
+	// Root index of the slot in the bound PSO, -1 if the value is already bound or the PSO doesn't use the slot
+	int32_t PrepareRootBinding(SCommandContext& Context, TShaderSlot Slot, UINT64 Value, SPSODescriptionBase* PSO);
+
+	// Both expect ContextMutex to be held
+	ComPtr<ID3D12CommandAllocator> AcquireCommandAllocator();
+	ComPtr<ID3D12GraphicsCommandList> AcquireCommandList(const ComPtr<ID3D12CommandAllocator>& Allocator);
+
+	struct SThreadContext
+	{
+		const OCommandQueue* Queue = nullptr;
+		SCommandContext* Context = nullptr;
+	};
+
 	struct CommandAllocatorEntry
 	{
 		uint64_t FenceValue;
@@ -55,18 +103,25 @@ private:
 	ComPtr<ID3D12Device2> Device = nullptr;
 	ComPtr<ID3D12CommandQueue> CommandQueue = nullptr;
 	ComPtr<ID3D12Fence> Fence = nullptr;
-	ComPtr<ID3D12CommandAllocator> CommandAllocator;
-	ComPtr<ID3D12GraphicsCommandList> CommandList;
+	SCommandContext DefaultContext;
+	SCommandContext* MainContext = &DefaultContext;
+	vector<SCommandContext*> PendingContexts;
 
-	ORenderTargetBase* CurrentRenderTarget = nullptr;
+	vector<unique_ptr<SCommandContext>> Contexts;
+	vector<SCommandContext*> FreeContexts;
+	SMutex ContextMutex;
+	inline static thread_local SThreadContext ThreadContext;
 
 	HANDLE FenceEvent;
 	uint64_t FenceValue;
 
+	// Submitted allocators in fence order, each is reset once the GPU passed its fence value
 	TCommandAllocatorQueue CommandAllocatorQueue;
+
+	// Closed lists, a list may be reset right after submission so these are reusable at once
 	TCommandListQueue CommandListQueue;
 
-	bool IsReset = false;
-	SPSODescriptionBase* CurrentPSO = nullptr;
-	unordered_map<string,UINT64> SetResources;
+	// Headless backend closes its command lists but never submits them, the log is the only record of what was issued
+	bool bIsHeadless = false;
+	mutable SCommandLog CommandLog;
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+ODescriptorAllocator::ODescriptorAllocator(uint32_t PersistentCapacity, uint32_t TransientCapacityPerFrame, uint32_t NumFrames)
+    : PersistentCapacity(PersistentCapacity), TransientCapacityPerFrame(TransientCapacityPerFrame), NumFrames(NumFrames)
+{
+	FreeLists.resize(GetSizeClass(std::max(PersistentCapacity, 1u)) + 1);
+}
+
+uint32_t ODescriptorAllocator::GetSizeClass(uint32_t Count)
+{
+	return Count <= 1 ? 0 : std::bit_width(Count - 1);
+}
+
+SDescriptorRange ODescriptorAllocator::Allocate(uint32_t Count)
+{
+	Count = std::max(Count, 1u);
+	const uint32_t sizeClass = GetSizeClass(Count);
+	if (sizeClass >= FreeLists.size())
+	{
+		return {};
+	}
+
+	const uint32_t blockSize = 1u << sizeClass;
+	auto& freeList = FreeLists[sizeClass];
+	uint32_t index = SDescriptorRange::InvalidIndex;
+	if (!freeList.empty())
+	{
+		index = freeList.back();
+		freeList.pop_back();
+	}
+	else if (Top + blockSize <= PersistentCapacity)
+	{
+		index = Top;
+		Top += blockSize;
+	}
+	else
+	{
+		// Split the smallest larger free block, the unused halves go to the smaller classes
+		for (uint32_t larger = sizeClass + 1; larger < FreeLists.size(); larger++)
+		{
+			if (FreeLists[larger].empty())
+			{
+				continue;
+			}
+			index = FreeLists[larger].back();
+			FreeLists[larger].pop_back();
+			for (uint32_t split = sizeClass; split < larger; split++)
+			{
+				FreeLists[split].push_back(index + (1u << split));
+			}
+			break;
+		}
+	}
+
+	if (index == SDescriptorRange::InvalidIndex)
+	{
+		return {};
+	}
+	NumAllocated += blockSize;
+	return { index, Count };
+}
+
+void ODescriptorAllocator::Free(const SDescriptorRange& Range, uint64_t FenceValue)
+{
+	if (Range.IsValid() && Range.Index < PersistentCapacity)
+	{
+		PendingFrees.push({ FenceValue, Range });
+	}
+}
+
+void ODescriptorAllocator::ReleaseCompleted(uint64_t CompletedFenceValue)
+{
+	while (!PendingFrees.empty() && PendingFrees.front().FenceValue <= CompletedFenceValue)
+	{
+		const auto& range = PendingFrees.front().Range;
+		const uint32_t sizeClass = GetSizeClass(std::max(range.Count, 1u));
+		FreeLists[sizeClass].push_back(range.Index);
+		NumAllocated -= 1u << sizeClass;
+		PendingFrees.pop();
+	}
+}
+
+SDescriptorRange ODescriptorAllocator::AllocateTransient(uint32_t Count)
+{
+	if (NumFrames == 0 || TransientOffset + Count > TransientCapacityPerFrame)
+	{
+		return {};
+	}
+
+	const uint32_t index = PersistentCapacity + CurrentFrame * TransientCapacityPerFrame + TransientOffset;
+	TransientOffset += Count;
+	return { index, Count };
+}
+
+void ODescriptorAllocator::BeginFrame(uint32_t FrameIndex)
+{
+	CurrentFrame = NumFrames == 0 ? 0 : FrameIndex % NumFrames;
+	TransientOffset = 0;
+}
+
+uint32_t ODescriptorAllocator::GetCapacity() const
+{
+	return PersistentCapacity + TransientCapacityPerFrame * NumFrames;
+}
+
+uint32_t ODescriptorAllocator::GetPersistentCapacity() const
+{
+	return PersistentCapacity;
+}
+
+uint32_t ODescriptorAllocator::GetNumAllocated() const
+{
+	return NumAllocated;
+}
+
+size_t ODescriptorAllocator::GetNumPendingFrees() const
+{
+	return PendingFrees.size();
+}
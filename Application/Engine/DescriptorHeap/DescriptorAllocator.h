@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+struct SDescriptorRange
+{
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+	uint32_t Index = InvalidIndex;
+	uint32_t Count = 0;
+
+	bool IsValid() const
+	{
+		return Index != InvalidIndex;
+	}
+};
+
+/**
+ * @brief Index allocator of a descriptor heap, free of any graphics API.
+ * The persistent region [0, PersistentCapacity) hands out contiguous blocks rounded up to a power of two size class, freed blocks
+ * return to the free list of their class once the fence of the free completed. Larger free blocks are split when a class runs dry, blocks are never merged.
+ * Behind it every frame in flight owns a linear region for transient descriptors, reset when the frame starts again.
+ */
+class ODescriptorAllocator
+{
+public:
+	ODescriptorAllocator() = default;
+	ODescriptorAllocator(uint32_t PersistentCapacity, uint32_t TransientCapacityPerFrame, uint32_t NumFrames);
+
+	// Returns an invalid range if the persistent region is exhausted
+	SDescriptorRange Allocate(uint32_t Count);
+
+	// The range stays reserved until CompletedFenceValue passed FenceValue
+	void Free(const SDescriptorRange& Range, uint64_t FenceValue);
+	void ReleaseCompleted(uint64_t CompletedFenceValue);
+
+	SDescriptorRange AllocateTransient(uint32_t Count);
+
+	// Only call once the GPU finished the previous use of this frame index
+	void BeginFrame(uint32_t FrameIndex);
+
+	uint32_t GetCapacity() const;
+	uint32_t GetPersistentCapacity() const;
+	uint32_t GetNumAllocated() const;
+	size_t GetNumPendingFrees() const;
+
+	static uint32_t GetSizeClass(uint32_t Count);
+
+private:
+	struct SPendingFree
+	{
+		uint64_t FenceValue = 0;
+		SDescriptorRange Range;
+	};
+
+	uint32_t PersistentCapacity = 0;
+	uint32_t TransientCapacityPerFrame = 0;
+	uint32_t NumFrames = 0;
+
+	// Start indices of free blocks, FreeLists[N] holds blocks of 2^N descriptors
+	std::vector<std::vector<uint32_t>> FreeLists;
+	uint32_t Top = 0;
+	uint32_t NumAllocated = 0;
+	std::queue<SPendingFree> PendingFrees;
+
+	uint32_t CurrentFrame = 0;
+	uint32_t TransientOffset = 0;
+};
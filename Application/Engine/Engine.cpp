@@ -4,11 +4,13 @@
 #include "Application.h"
 #include "Camera/Camera.h"
 #include "DirectX/FrameResource.h"
+#include "DirectX/RenderBackend.h"
 #include "EngineHelper.h"
 #include "Exception.h"
 #include "Filters/BilateralBlur/BilateralBlurFilter.h"
 #include "Logger.h"
 #include "MathUtils.h"
+#include "Stats/Stats.h"
 #include "Test/TextureTest/TextureWaves.h"
 #include "TextureConstants.h"
 #include "UI/Effects/FogWidget.h"
@@ -16,9 +18,11 @@
 #include "Window/Window.h"
 
 #include <DirectXMath.h>
+#include <chrono>
 
 #include <numeric>
 #include <ranges>
+#include <thread>
 
 using namespace Microsoft::WRL;
 using namespace DirectX;
@@ -47,6 +51,7 @@ OEngine::~OEngine()
 
 bool OEngine::Initialize()
 {
+	StartTime = std::chrono::steady_clock::now();
 	UINT createFactoryFlags = 0;
 #if defined(_DEBUG)
 	createFactoryFlags = DXGI_CREATE_FACTORY_DEBUG;
@@ -58,7 +63,7 @@ bool OEngine::Initialize()
 		WIN_LOG(Default, Error, "Failed to verify DirectX Math library support.");
 		return false;
 	}
-	if (const auto adapter = GetAdapter(false))
+	if (const auto adapter = GetAdapter(SRenderBackend::IsHeadless()))
 	{
 		Device = CreateDevice(adapter);
 	}
@@ -95,7 +100,62 @@ void OEngine::InitManagers()
 	TextureManager = make_unique<OTextureManager>(Device.Get(), GetCommandQueue());
 	MaterialManager = make_unique<OMaterialManager>();
 	MaterialManager->LoadMaterialsFromCache();
-	MaterialManager->MaterialsRebuld.AddMember(this, &OEngine::TryRebuildFrameResource);
+	MaterialManager->MaterialsRebuld.Add([this]() { MaterialConstants.clear(); });
+	OStatsRegistry::Get()->SetDumpPath(OApplication::Get()->GetConfigPath("StatsDumpPath"));
+	InitConfigHotReload();
+}
+
+void OEngine::InitConfigHotReload()
+{
+	if (!bConfigHotReload)
+	{
+		return;
+	}
+	const auto directory = std::filesystem::path(OApplication::Get()->GetConfigPath("PSOConfigPath")).parent_path();
+	ConfigWatcher = make_unique<OFileWatcher>(directory, vector<string>{ ".json" });
+	ConfigWatcher->Poll();
+}
+
+void OEngine::UpdateConfigHotReload()
+{
+	if (!ConfigWatcher)
+	{
+		return;
+	}
+
+	constexpr auto pollInterval = std::chrono::milliseconds(500);
+	const auto now = std::chrono::steady_clock::now();
+	if (now - LastConfigPoll >= pollInterval)
+	{
+		LastConfigPoll = now;
+		for (const auto& path : ConfigWatcher->Poll())
+		{
+			for (const string key : { "MaterialsConfigPath", "PSOConfigPath", "RenderGraphConfigPath" })
+			{
+				std::error_code error;
+				if (std::filesystem::equivalent(path, OApplication::Get()->GetConfigPath(key), error))
+				{
+					PendingConfigReloads.insert(key);
+				}
+			}
+		}
+	}
+
+	// Saves of the engine itself show up here as well, they diff as unchanged and cost a parse
+	if (PendingConfigReloads.erase("MaterialsConfigPath"))
+	{
+		MaterialManager->ReloadMaterials();
+	}
+	if (PendingConfigReloads.contains("PSOConfigPath") && PipelineManager->ReloadPSOConfig())
+	{
+		PendingConfigReloads.erase("PSOConfigPath");
+	}
+
+	// Nodes of a changed graph may reference PSOs added in the same edit
+	if (!PendingConfigReloads.contains("PSOConfigPath") && PendingConfigReloads.erase("RenderGraphConfigPath"))
+	{
+		RenderGraph->ReloadConfig(Device.Get());
+	}
 }
 
 void OEngine::PostInitialize()
@@ -117,9 +177,28 @@ TUUID OEngine::AddRenderObject(IRenderObject* RenderObject)
 	const auto uuid = GenerateUUID();
 	RenderObject->SetID(uuid);
 	RenderObjects[uuid] = unique_ptr<IRenderObject>(RenderObject);
+	BuildObjectDescriptors(uuid, RenderObject);
 	return uuid;
 }
 
+void OEngine::BuildObjectDescriptors(const TUUID& UUID, IRenderObject* RenderObject)
+{
+	// Objects added before the heap exists get their descriptors in BuildDescriptorHeap
+	if (SRVDescriptorHeap == nullptr)
+	{
+		return;
+	}
+
+	ObjectDescriptors.BeginOwner(UUID);
+	RenderObject->BuildDescriptors(&ObjectDescriptors);
+	ObjectDescriptors.EndOwner();
+}
+
+SDescriptorPair OEngine::AllocateTransientSRV(uint32_t Count)
+{
+	return ObjectDescriptors.SRVHandle.AllocateTransient(Count);
+}
+
 void OEngine::BuildOffscreenRT()
 {
 	OffscreenRT = BuildRenderObject<OOffscreenTexture>(Device.Get(), GetWindow()->GetWidth(), GetWindow()->GetHeight(), SRenderConstants::BackBufferFormat);
@@ -143,7 +222,7 @@ void OEngine::DrawRenderItems(SPSODescriptionBase* Desc, const string& RenderLay
 	DrawRenderItemsImpl(Desc, renderItems);
 }
 
-void OEngine::UpdateMaterialCB() const
+void OEngine::UpdateMaterialCB()
 {
 	auto copyIndicesTo = [](const vector<uint32_t>& Source, uint32_t* Destination, size_t Size) {
 		if (Source.size() <= Size)
@@ -153,12 +232,15 @@ void OEngine::UpdateMaterialCB() const
 	};
 
 
+	// Constants are cached on the CPU and only rebuilt for dirty materials, the whole table is uploaded every frame
+	const bool bRebuildAll = MaterialConstants.size() != MaterialManager->GetNumMaterials();
+	MaterialConstants.resize(MaterialManager->GetNumMaterials());
 	for (auto& materials = GetMaterials(); const auto& val : materials | std::views::values)
 	{
 
 		if (const auto material = val.get())
 		{
-			if (material->NumFramesDirty > 0)
+			if (bRebuildAll || material->NumFramesDirty > 0)
 			{
 				const auto matTransform = XMLoadFloat4x4(&material->MatTransform);
 
@@ -180,14 +262,13 @@ void OEngine::UpdateMaterialCB() const
 				copyIndicesTo(heightIndices, matConstants.HeightMapIndex, SRenderConstants::MaxHeightMapsPerMaterial);
 
 				Put(matConstants.MatTransform, Transpose(matTransform));
-				for(auto& cb : FrameResources)
-				{
-					cb->MaterialBuffer->CopyData(material->MaterialCBIndex, matConstants);
-					material->NumFramesDirty--;
-				}
+				MaterialConstants[material->MaterialCBIndex] = matConstants;
+				material->NumFramesDirty = 0;
 			}
 		}
 	}
+
+	CurrentFrameResources->MaterialBuffer.CopyRange(0, MaterialConstants);
 }
 
 void OEngine::UpdateLightCB(const UpdateEventArgs& Args) const
@@ -195,37 +276,21 @@ void OEngine::UpdateLightCB(const UpdateEventArgs& Args) const
 	uint32_t dirIndex = 0;
 	uint32_t pointIndex =0;
 	uint32_t spotIndex = 0;
+	// Light buffers live in the upload ring for a single frame, so every light is written each frame
+	const auto frame = CurrentFrameResources;
 	for (const auto component : LightComponents)
 	{
-		if(component->TryUpdate())
+		switch (component->GetLightType()) // todo make it more generic
 		{
-			for (auto& cb : FrameResources)
-			{
-				switch (component->GetLightType())
-				{
-				case ELightType::Directional:
-					cb->DirectionalLightBuffer->CopyData(dirIndex, component->GetDirectionalLight());
-					break;
-				case ELightType::Point:
-					cb->PointLightBuffer->CopyData(pointIndex, component->GetPointLight());
-					break;
-				case ELightType::Spot:
-					cb->SpotLightBuffer->CopyData(spotIndex, component->GetSpotLight());
-					break;
-				}
-			}
-			switch (component->GetLightType()) // todo make it more generic
-			{
-			case ELightType::Directional:
-				dirIndex++;
-				break;
-			case ELightType::Point:
-				pointIndex++;
-				break;
-			case ELightType::Spot:
-				spotIndex++;
-				break;
-			}
+		case ELightType::Directional:
+			frame->DirectionalLightBuffer.CopyData(dirIndex++, component->GetDirectionalLight());
+			break;
+		case ELightType::Point:
+			frame->PointLightBuffer.CopyData(pointIndex++, component->GetPointLight());
+			break;
+		case ELightType::Spot:
+			frame->SpotLightBuffer.CopyData(spotIndex++, component->GetSpotLight());
+			break;
 		}
 	}
 }
@@ -233,6 +298,23 @@ void OEngine::UpdateLightCB(const UpdateEventArgs& Args) const
 void OEngine::DrawRenderItemsImpl(SPSODescriptionBase* Description, const vector<ORenderItem*>& RenderItems)
 {
 	auto cmd = GetCommandQueue()->GetCommandList();
+	const auto instanceBuffer = Engine->CurrentFrameResources->InstanceBuffer.GetGPUAddress();
+
+	// Bindless pipelines read the instance offset from a root constant, the instance table is bound once and nothing is looked up by name per draw
+	static const TShaderSlot instanceDataSlot = SShaderSlots::Intern("gInstanceData");
+	static const TShaderSlot drawConstantsSlot = SShaderSlots::Intern("cbDrawConstants");
+	const int32_t drawConstantsIndex = Description->RootSignature->GetRootIndex(drawConstantsSlot);
+	const bool bBindless = bBindlessDraws && drawConstantsIndex != -1;
+	if (bBindless)
+	{
+		GetCommandQueue()->SetResource(instanceDataSlot, instanceBuffer, Description);
+	}
+	else if (drawConstantsIndex != -1)
+	{
+		// Bindless shader with bindless draws turned off, the instance data bound per draw already starts at the first instance
+		GetCommandQueue()->SetRootConstant(drawConstantsIndex, 0, Description);
+	}
+
 	for (size_t i = 0; i < RenderItems.size(); i++)
 	{
 		const auto renderItem = RenderItems[i];
@@ -243,15 +325,22 @@ void OEngine::DrawRenderItemsImpl(SPSODescriptionBase* Description, const vector
 		if (!renderItem->Instances.empty() && renderItem->Geometry)
 		{
 			renderItem->BindResources(cmd.Get(), Engine->CurrentFrameResources);
-			auto instanceBuffer = Engine->CurrentFrameResources->InstanceBuffer->GetResource();
-			auto location = instanceBuffer->Resource->GetGPUVirtualAddress() + renderItem->StartInstanceLocation * sizeof(SInstanceData);
-			GetCommandQueue()->SetResource("gInstanceData", location,Description);
-			cmd->DrawIndexedInstanced(
+			if (bBindless)
+			{
+				GetCommandQueue()->SetRootConstant(drawConstantsIndex, renderItem->StartInstanceLocation, Description);
+			}
+			else
+			{
+				auto location = instanceBuffer + renderItem->StartInstanceLocation * sizeof(SInstanceData);
+				GetCommandQueue()->SetResource(instanceDataSlot, location, Description);
+			}
+			GetCommandQueue()->DrawIndexedInstanced(
 			    renderItem->ChosenSubmesh->IndexCount,
 			    renderItem->VisibleInstanceCount,
 			    renderItem->ChosenSubmesh->StartIndexLocation,
 			    renderItem->ChosenSubmesh->BaseVertexLocation,
 			    0);
+			STAT_SAMPLE(InstancesPerDraw, renderItem->VisibleInstanceCount);
 		}
 	}
 }
@@ -267,7 +356,7 @@ void OEngine::DrawFullScreenQuad()
 	commandList->IASetVertexBuffers(0, 1, nullptr);
 	commandList->IASetIndexBuffer(nullptr);
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	commandList->DrawInstanced(6, 1, 0, 0);
+	GetCommandQueue()->DrawInstanced(6, 1, 0, 0);
 }
 
 void OEngine::InitUIManager()
@@ -312,6 +401,11 @@ Microsoft::WRL::ComPtr<ID3D12Device2> OEngine::GetDevice() const
 	return Device;
 }
 
+std::chrono::steady_clock::time_point OEngine::GetStartTime() const
+{
+	return StartTime;
+}
+
 void OEngine::FlushGPU() const
 {
 	DirectCommandQueue->Flush();
@@ -338,6 +432,7 @@ void OEngine::PostTestInit()
 	BuildFrameResource(GetPassCountRequired());
 	GetCommandQueue()->TryResetCommandList();
 	BuildDescriptorHeap();
+	RenderGraph->AllocateTransientResources(Device.Get());
 	InitUIManager();
 	GetCommandQueue()->ExecuteCommandListAndWait();
 	HasInitializedTests = true;
@@ -367,37 +462,40 @@ void OEngine::OnEnd(shared_ptr<OTest> Test) const
 	Test->Destroy();
 }
 
-void OEngine::TryRebuildFrameResource()
-{
-	LOG(Engine, Log, "Engine::RebuildFrameResource")
-	if (CurrentNumMaterials != MaterialManager->GetNumMaterials() || CurrentNumInstances != GetTotalNumberOfInstances())
-	{
-		FrameResources.clear();
-		BuildFrameResource(PassCount);
-	}
-}
-
 void OEngine::BuildFrameResource(uint32_t Count)
 {
 	PassCount = Count;
+	if (UploadRing == nullptr)
+	{
+		UploadRing = make_unique<OUploadRingBuffer>(Device.Get(), GetCommandQueue(), SRenderConstants::UploadRingSize, GetWindow());
+	}
 
-	CurrentNumInstances = GetTotalNumberOfInstances();
-	CurrentNumMaterials = MaterialManager->GetNumMaterials();
-
+	CurrentFrameResources = nullptr;
+	FrameResources.clear();
 	for (int i = 0; i < SRenderConstants::NumFrameResources; ++i)
 	{
-		auto frameResource = make_unique<SFrameResource>(Device.Get(), GetWindow());
-		frameResource->SetPass(PassCount);
-		frameResource->SetInstances(CurrentNumInstances);
-		frameResource->SetMaterials(CurrentNumMaterials);
-		frameResource->SetDirectionalLight(GetLightComponentsCount());
-		frameResource->SetPointLight(GetLightComponentsCount());
-		frameResource->SetSpotLight(GetLightComponentsCount());
-		FrameResources.push_back(std::move(frameResource));
+		FrameResources.push_back(make_unique<SFrameResource>(UploadRing.get()));
 	}
 	OnFrameResourceChanged.Broadcast();
 }
 
+void OEngine::AllocateFrameResource()
+{
+	// Sized to the current scene every frame, added objects or instances no longer rebuild anything
+	PassCount = GetPassCountRequired();
+	CurrentFrameResources->SetPass(PassCount);
+	CurrentFrameResources->SetInstances(GetTotalNumberOfInstances());
+	CurrentFrameResources->SetMaterials(MaterialManager->GetNumMaterials());
+	CurrentFrameResources->SetDirectionalLight(GetLightComponentsCount());
+	CurrentFrameResources->SetPointLight(GetLightComponentsCount());
+	CurrentFrameResources->SetSpotLight(GetLightComponentsCount());
+}
+
+OUploadRingBuffer* OEngine::GetUploadRing() const
+{
+	return UploadRing.get();
+}
+
 void OEngine::SetDescriptorHeap()
 {
 	GetCommandQueue()->TryResetCommandList();
@@ -428,11 +526,30 @@ void OEngine::PrepareRenderTarget()
 
 void OEngine::Draw(UpdateEventArgs& Args)
 {
+	const auto cpuFrameStart = std::chrono::high_resolution_clock::now();
+	DrainInputEvents();
 	if (HasInitializedTests)
 	{
+		// Nothing is recorded yet, reloaded PSOs can be swapped in without touching a frame in progress
+		PipelineManager->UpdatePipelineBuilds();
+		PipelineManager->UpdateShaderHotReload();
+		UpdateConfigHotReload();
+		PipelineManager->UpdateShaderPermutations();
+		SyncReplayState(Args.Timer);
 		SetDescriptorHeap();
 		Update(Args);
 		Render(Args);
+
+		const auto cpuFrameTime = std::chrono::high_resolution_clock::now() - cpuFrameStart;
+		STAT_SAMPLE(CPUFrameTimeUs, std::chrono::duration_cast<std::chrono::microseconds>(cpuFrameTime).count());
+		OStatsRegistry::Get()->EndFrame(Args.Timer.GetDeltaTime());
+
+		if (!bFirstFrameRendered)
+		{
+			bFirstFrameRendered = true;
+			const auto sinceStart = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+			LOG(Engine, Log, "Startup: first frame rendered {:.1f} ms after start, {} PSOs still building", sinceStart, PipelineManager->GetNumPendingPSOs());
+		}
 	}
 }
 
@@ -457,6 +574,12 @@ void OEngine::Update(UpdateEventArgs& Args)
 
 void OEngine::UpdateFrameResource()
 {
+	// Everything allocated during the previous frame is in use until its fence passed
+	if (CurrentFrameResources)
+	{
+		UploadRing->FinishFrame(CurrentFrameResources->Fence);
+	}
+
 	CurrentFrameResourceIndex = (CurrentFrameResourceIndex + 1) % SRenderConstants::NumFrameResources;
 	CurrentFrameResources = FrameResources[CurrentFrameResourceIndex].get();
 
@@ -467,12 +590,35 @@ void OEngine::UpdateFrameResource()
 	{
 		GetCommandQueue()->WaitForFenceValue(CurrentFrameResources->Fence);
 	}
+	UploadRing->ReleaseCompletedFrames();
+	AllocateFrameResource();
+
+	ObjectDescriptors.ReleaseCompleted(GetCommandQueue()->GetFence()->GetCompletedValue());
+	ObjectDescriptors.BeginFrame(CurrentFrameResourceIndex);
 }
 
 void OEngine::InitRenderGraph()
 {
 	RenderGraph = make_unique<ORenderGraph>();
 	RenderGraph->Initialize(PipelineManager.get(), GetCommandQueue());
+	RenderGraph->SetNumRecordingThreads(std::max(1u, std::thread::hardware_concurrency()));
+	RenderGraph->BindResource("SceneColor", [this]() { return GetOffscreenRT()->GetResource(); });
+	RenderGraph->BindResource("BackBuffer", [this]() { return GetWindow()->GetResource(); });
+	RenderGraph->BindResource("CubeMap", [this]() { return CubeRenderTarget ? CubeRenderTarget->GetResource() : nullptr; });
+
+	BindTransientResources(GetSobelFilter(), { "SobelOutput" });
+	BindTransientResources(GetBlurFilter(), { "BlurMap0", "BlurMap1" });
+	BindTransientResources(GetBilateralBlurFilter(), { "BilateralInput", "BilateralOutput" });
+}
+
+void OEngine::BindTransientResources(OFilterBase* Filter, const vector<string>& Names) const
+{
+	const auto resources = Filter->GetTransientResources();
+	CHECK_MSG(resources.size() == Names.size(), "Transient resource names don't match the filter!");
+	for (size_t i = 0; i < Names.size(); i++)
+	{
+		RenderGraph->BindTransientResource(Names[i], resources[i], [Filter]() { Filter->RebuildDescriptors(); });
+	}
 }
 
 uint32_t OEngine::GetLightComponentsCount() const
@@ -489,11 +635,14 @@ void OEngine::RemoveRenderObject(TUUID UUID)
 {
 	LOG(Render, Log, "Removing object with UUID: {}", TEXT(UUID));
 	RenderObjects.erase(UUID);
+
+	// The GPU may still reference the descriptors of this frame
+	ObjectDescriptors.FreeOwner(UUID, GetCommandQueue()->Signal());
 }
 
 void OEngine::UpdateObjectCB() const
 {
-	auto res = CurrentFrameResources->PassCB.get();
+	auto res = &CurrentFrameResources->PassCB;
 
 	int32_t idx = 1; // TODO calc frame resource automatically and calc frame resources
 	for (auto& val : RenderObjects | std::views::values)
@@ -650,6 +799,298 @@ void OEngine::OnMouseWheel(MouseWheelEventArgs& Args)
 	}
 }
 
+bool OEngine::PushInputEvent(const SInputEvent& Event)
+{
+	if (FrameReplayer)
+	{
+		// Live input is ignored while the recorded stream drives the engine.
+		return false;
+	}
+
+	if (!InputQueue.Push(Event))
+	{
+		STAT_INC(InputEventsDropped);
+		return false;
+	}
+	return true;
+}
+
+void OEngine::DrainInputEvents()
+{
+	SInputEvent pending;
+	if (!InputQueue.Pop(pending))
+	{
+		return;
+	}
+
+	SInputEvent next;
+	while (InputQueue.Pop(next))
+	{
+		if (pending.CanCoalesce(next))
+		{
+			pending.Coalesce(next);
+			STAT_INC(InputEventsCoalesced);
+			continue;
+		}
+		DispatchInputEvent(pending);
+		pending = next;
+	}
+	DispatchInputEvent(pending);
+}
+
+void OEngine::DispatchInputEvent(const SInputEvent& Event)
+{
+	STAT_INC(InputEventsDispatched);
+	if (FrameRecorder)
+	{
+		FrameRecorder->AddEvent(Event);
+	}
+
+	const auto hwnd = reinterpret_cast<HWND>(Event.Window);
+	const bool left = Event.HasFlag(SInputEvent::LeftButton);
+	const bool middle = Event.HasFlag(SInputEvent::MiddleButton);
+	const bool right = Event.HasFlag(SInputEvent::RightButton);
+	const bool control = Event.HasFlag(SInputEvent::Control);
+	const bool shift = Event.HasFlag(SInputEvent::Shift);
+	const bool alt = Event.HasFlag(SInputEvent::Alt);
+
+	switch (Event.Type)
+	{
+	case EInputEventType::KeyPressed:
+	case EInputEventType::KeyReleased:
+	{
+		const auto state = Event.Type == EInputEventType::KeyPressed ? KeyEventArgs::Pressed : KeyEventArgs::Released;
+		KeyEventArgs args(static_cast<KeyCode::Key>(Event.Key), Event.Char, state, control, shift, alt, hwnd);
+		if (state == KeyEventArgs::Pressed)
+		{
+			OnKeyPressed(args);
+		}
+		else
+		{
+			OnKeyReleased(args);
+		}
+		break;
+	}
+	case EInputEventType::MouseMoved:
+	{
+		MouseMotionEventArgs args(left, middle, right, control, shift, Event.X, Event.Y, hwnd);
+		OnMouseMoved(args);
+		break;
+	}
+	case EInputEventType::MouseButtonPressed:
+	case EInputEventType::MouseButtonReleased:
+	{
+		const auto state = Event.Type == EInputEventType::MouseButtonPressed ? MouseButtonEventArgs::Pressed : MouseButtonEventArgs::Released;
+		MouseButtonEventArgs args(static_cast<MouseButtonEventArgs::EMouseButton>(Event.Button), state, left, middle, right, control, shift, Event.X, Event.Y, hwnd);
+		if (state == MouseButtonEventArgs::Pressed)
+		{
+			OnMouseButtonPressed(args);
+		}
+		else
+		{
+			OnMouseButtonReleased(args);
+		}
+		break;
+	}
+	case EInputEventType::MouseWheel:
+	{
+		MouseWheelEventArgs args(Event.WheelDelta, left, middle, right, control, shift, Event.X, Event.Y, hwnd);
+		OnMouseWheel(args);
+		break;
+	}
+	default:
+		LOG(Input, Warning, "Unknown input event type!");
+		break;
+	}
+}
+
+bool OEngine::StartRecording(const string& Path)
+{
+	StopReplay();
+	FrameRecorder = make_unique<OFrameRecorder>(Path);
+	if (!FrameRecorder->IsOpen())
+	{
+		FrameRecorder.reset();
+		return false;
+	}
+	LOG(Engine, Log, "Recording frames to {}", TEXT(Path));
+	return true;
+}
+
+void OEngine::StopRecording()
+{
+	FrameRecorder.reset();
+}
+
+bool OEngine::StartReplay(const string& Path, float FixedDeltaTime)
+{
+	StopRecording();
+	FrameReplayer = make_unique<OFrameReplayer>(Path, FixedDeltaTime);
+	if (!FrameReplayer->IsOpen())
+	{
+		FrameReplayer.reset();
+		return false;
+	}
+	LOG(Engine, Log, "Replaying frames from {}", TEXT(Path));
+	return true;
+}
+
+void OEngine::StopReplay()
+{
+	if (FrameReplayer)
+	{
+		LOG(Engine, Log, "Replay finished, frames: {}", FrameReplayer->GetNumFramesRead());
+	}
+	FrameReplayer.reset();
+}
+
+void OEngine::SetNumRecordingThreads(uint32_t NumThreads)
+{
+	RenderGraph->SetNumRecordingThreads(NumThreads);
+}
+
+void OEngine::RunRecordingBenchmark(STimer& Timer)
+{
+	if (!SRenderBackend::IsHeadless())
+	{
+		LOG(Render, Warning, "Recording benchmark runs on a GPU device, use -headless to keep submission out of the results");
+	}
+
+	constexpr uint32_t warmupFrames = 16;
+	constexpr uint32_t measuredFrames = 128;
+	const uint32_t previousThreads = RenderGraph->GetNumRecordingThreads();
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	// Both draw paths are measured, zero threads is the single command list path and every further step doubles the recording threads
+	for (const bool bBindless : { true, false })
+	{
+		bBindlessDraws = bBindless;
+		for (uint32_t threads = 0; threads <= maxThreads; threads = threads == 0 ? 1 : threads * 2)
+		{
+			RenderGraph->SetNumRecordingThreads(threads);
+			int64_t totalUs = 0;
+			uint64_t totalDraws = 0;
+			for (uint32_t frame = 0; frame < warmupFrames + measuredFrames; frame++)
+			{
+				Timer.Tick();
+				UpdateEventArgs args(Timer, Window->GetHWND());
+				Draw(args);
+				if (frame >= warmupFrames)
+				{
+					totalUs += RenderGraph->GetLastRecordingTime().count();
+					totalDraws += OStatsRegistry::Get()->GetLastFrame(EStatCounter::DrawCalls);
+				}
+			}
+			LOG(Render, Log, "Recording benchmark: {} draws, {} threads, {} us recording per frame, {} ns per draw",
+			    bBindless ? "bindless" : "bound", threads, totalUs / measuredFrames, totalDraws == 0 ? 0 : totalUs * 1000 / static_cast<int64_t>(totalDraws));
+		}
+	}
+	bBindlessDraws = true;
+	RenderGraph->SetNumRecordingThreads(previousThreads);
+}
+
+void OEngine::RunBindingBenchmark()
+{
+	const auto handle = PipelineManager->FindPSO(SPSOType::Opaque);
+	if (handle.Build.valid())
+	{
+		handle.Build.wait();
+	}
+	const auto pso = handle.Get();
+	if (pso == nullptr)
+	{
+		LOG(Render, Error, "Binding benchmark needs the {} pipeline state", TEXT(SPSOType::Opaque));
+		return;
+	}
+
+	// Alternating between two addresses keeps the redundancy check from skipping any of the binds
+	constexpr uint32_t numBinds = 1000000;
+	const auto address = CurrentFrameResources->PassCB.GetGPUAddress();
+	const auto measure = [&](const string& Path, const auto& Bind) {
+		const auto queue = GetCommandQueue();
+		queue->TryResetCommandList();
+		queue->SetPipelineState(pso);
+		const auto cmdList = queue->GetCommandList();
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t bind = 0; bind < numBinds; bind++)
+		{
+			Bind(cmdList.Get(), address + (bind & 1) * 256);
+		}
+		const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		queue->ExecuteCommandListAndWait();
+		LOG(Render, Log, "Binding benchmark: {}, {:.1f} M binds/s", Path, numBinds / elapsed / 1e6);
+	};
+
+	static const TShaderSlot passSlot = SShaderSlots::Intern("cbPass");
+	measure("name looked up in the root signature", [&](ID3D12GraphicsCommandList* CmdList, D3D12_GPU_VIRTUAL_ADDRESS Address) {
+		pso->RootSignature->SetResource("cbPass", Address, CmdList);
+	});
+	measure("name interned per call", [&](ID3D12GraphicsCommandList*, D3D12_GPU_VIRTUAL_ADDRESS Address) {
+		GetCommandQueue()->SetResource("cbPass", Address, pso);
+	});
+	measure("interned slot", [&](ID3D12GraphicsCommandList*, D3D12_GPU_VIRTUAL_ADDRESS Address) {
+		GetCommandQueue()->SetResource(passSlot, Address, pso);
+	});
+}
+
+void OEngine::RunShaderCompileBenchmark()
+{
+	PipelineManager->RunShaderCompileBenchmark();
+}
+
+void OEngine::RunConfigBenchmark()
+{
+	PipelineManager->RunConfigBenchmark();
+}
+
+bool OEngine::IsReplaying() const
+{
+	return FrameReplayer != nullptr;
+}
+
+bool OEngine::PrepareReplayFrame()
+{
+	if (!FrameReplayer || !FrameReplayer->ReadFrame())
+	{
+		return false;
+	}
+
+	for (const auto& event : FrameReplayer->GetCurrentFrame().Events)
+	{
+		if (!InputQueue.Push(event))
+		{
+			STAT_INC(InputEventsDropped);
+		}
+	}
+	return true;
+}
+
+const STimer& OEngine::GetReplayTimer() const
+{
+	return FrameReplayer->GetTimer();
+}
+
+void OEngine::SyncReplayState(const STimer& Timer)
+{
+	if (FrameRecorder)
+	{
+		FrameRecorder->RecordFrame(Timer, GetCameraState());
+	}
+	else if (FrameReplayer)
+	{
+		// Camera movement polled from the keyboard never goes through the input queue, so the recorded state is authoritative.
+		const auto& camera = FrameReplayer->GetCurrentFrame().Header.Camera;
+		const XMFLOAT3 target = { camera.Position.x + camera.Look.x, camera.Position.y + camera.Look.y, camera.Position.z + camera.Look.z };
+		Window->GetCamera()->LookAt(camera.Position, target, camera.Up);
+	}
+}
+
+SCameraState OEngine::GetCameraState() const
+{
+	const auto camera = Window->GetCamera();
+	return { camera->GetPosition3f(), camera->GetLook3f(), camera->GetUp3f() };
+}
+
 void OEngine::OnResizeRequest(HWND& WindowHandle)
 {
 	LOG(Engine, Log, "Engine::OnResize")
@@ -687,6 +1128,13 @@ void OEngine::OnResizeRequest(HWND& WindowHandle)
 	{
 		bilateralFilter->OnResize(args.Width, args.Height);
 	}
+
+	// The filters recreated their textures as committed resources, move them back into the transient heaps
+	if (RenderGraph && HasInitializedTests)
+	{
+		FlushGPU();
+		RenderGraph->AllocateTransientResources(Device.Get());
+	}
 }
 
 void OEngine::OnUpdateWindowSize(ResizeEventArgs& Args)
@@ -936,19 +1384,20 @@ D3D12_COMPUTE_PIPELINE_STATE_DESC OEngine::GetSobelPSODesc()
 
 void OEngine::BuildDescriptorHeap()
 {
-	SRVDescNum = GetDesiredCountOfSRVs();
+	SRVDescNum = SRenderConstants::MaxSRVDescriptors + SRenderConstants::TransientSRVDescriptorsPerFrame * SRenderConstants::NumFrameResources;
 	SRVDescriptorHeap = CreateDescriptorHeap(SRVDescNum,
 	                                         D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
 	                                         D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE);
 	SetObjectDescriptor();
-	// Textures, SRV offset only
+	// Textures, SRV offset only. Shaders index them from the heap start so they take one contiguous block.
 	uint32_t texturesOffset = 0;
+	const auto texturesBlock = ObjectDescriptors.SRVHandle.Offset(SCast<uint32_t>(TextureManager->GetTextures().size()));
 	auto buildSRV = [&](STexture* Texture){
 		auto resourceSRV = Texture->GetSRVDesc();
-		auto pair = ObjectDescriptors.SRVHandle.Offset();
+		auto pair = ObjectDescriptors.SRVHandle.GetPair(texturesBlock.Index + texturesOffset);
 
 		Device->CreateShaderResourceView(Texture->Resource.Resource.Get(), &resourceSRV, pair.CPUHandle);
-		Texture->HeapIdx = texturesOffset;
+		Texture->HeapIdx = pair.Index;
 		texturesOffset++;
 	};
 
@@ -971,9 +1420,9 @@ void OEngine::BuildDescriptorHeap()
 		buildSRV(texture.get());
 	}
 
-	for (const auto& rObject : RenderObjects | std::views::values)
+	for (const auto& [uuid, rObject] : RenderObjects)
 	{
-		rObject->BuildDescriptors(&ObjectDescriptors);
+		BuildObjectDescriptors(uuid, rObject.get());
 	}
 }
 
@@ -1434,7 +1883,7 @@ void OEngine::PerformFrustrumCulling()
 	auto det = XMMatrixDeterminant(view);
 	const auto invView = XMMatrixInverse(&det, view);
 	const auto camera = Window->GetCamera();
-	auto currentInstanceBuffer = CurrentFrameResources->InstanceBuffer.get();
+	auto currentInstanceBuffer = &CurrentFrameResources->InstanceBuffer;
 	int32_t counter = 0;
 	for (auto& e : AllRenderItems)
 	{
@@ -1463,17 +1912,19 @@ void OEngine::PerformFrustrumCulling()
 
 			if (localSpaceFrustum.Contains(e->Bounds) != DirectX::DISJOINT || !FrustrumCullingEnabled)
 			{
-				SInstanceData data;
+				// Written straight into the upload heap, no staging copy per instance
+				auto& data = currentInstanceBuffer->Emplace(counter++);
 				XMStoreFloat4x4(&data.World, XMMatrixTranspose(world));
 				XMStoreFloat4x4(&data.TexTransform, XMMatrixTranspose(textTransform));
 				data.MaterialIndex = instData[i].MaterialIndex;
 				data.GridSpatialStep = instData[i].GridSpatialStep;
 				data.DisplacementMapTexelSize = instData[i].DisplacementMapTexelSize;
-				currentInstanceBuffer->CopyData(counter++, data);
 				visibleInstanceCount++;
 			}
 		}
 		e->VisibleInstanceCount = visibleInstanceCount;
+		STAT_ADD(InstancesVisible, visibleInstanceCount);
+		STAT_ADD(InstancesCulled, instData.size() - visibleInstanceCount);
 	}
 }
 
@@ -1583,8 +2034,7 @@ void OEngine::UpdateMainPass(const STimer& Timer)
 	MainPassCB.TotalTime = Timer.GetTime();
 	MainPassCB.DeltaTime = Timer.GetDeltaTime();
 	GetNumLights(MainPassCB.NumPointLights, MainPassCB.NumSpotLights, MainPassCB.NumDirLights);
-	const auto currPassCB = CurrentFrameResources->PassCB.get();
-	currPassCB->CopyData(0, MainPassCB);
+	CurrentFrameResources->PassCB.CopyData(0, MainPassCB);
 }
 
 void OEngine::GetNumLights(uint32_t& OutNumPointLights, uint32_t& OutNumSpotLights, uint32_t& OutNumDirLights) const
@@ -1609,28 +2059,6 @@ void OEngine::GetNumLights(uint32_t& OutNumPointLights, uint32_t& OutNumSpotLigh
 	}
 }
 
-uint32_t OEngine::GetDesiredCountOfRTVs() const
-{
-	return std::accumulate(RenderObjects.begin(), RenderObjects.end(), SRenderConstants::RenderBuffersCount, [](int acc, const auto& renderObject) {
-		return acc + renderObject.second->GetNumRTVRequired();
-	});
-}
-
-uint32_t OEngine::GetDesiredCountOfDSVs() const
-{
-	return std::accumulate(RenderObjects.begin(), RenderObjects.end(), 1, [](int acc, const auto& renderObject) {
-		return acc + renderObject.second->GetNumDSVRequired();
-	});
-}
-
-uint32_t OEngine::GetDesiredCountOfSRVs() const
-{
-	const auto roNum = std::accumulate(RenderObjects.begin(), RenderObjects.end(), 1, [](int acc, const auto& renderObject) {
-		return acc + renderObject.second->GetNumSRVRequired();
-	});
-	return roNum + UIManager->GetNumSRVRequired() + GetTextureManager()->GetNumTotalTextures();
-}
-
 std::unordered_map<string, unique_ptr<SMeshGeometry>>& OEngine::GetSceneGeometry()
 {
 	return SceneGeometry;
@@ -1813,6 +2241,11 @@ ComPtr<ID3D12PipelineState> OEngine::GetPSO(const string& PSOName)
 	return PSOs.at(PSOName);
 }
 
+void OEngine::SetShaderFeature(const string& Name, uint32_t ValueIndex) const
+{
+	PipelineManager->SetShaderFeature(Name, ValueIndex);
+}
+
 void OEngine::SetFog(XMFLOAT4 Color, float Start, float Range)
 {
 	MainPassCB.FogColor = Color;
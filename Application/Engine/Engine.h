@@ -3,13 +3,17 @@
 #include "DirectX/RenderItem/RenderItem.h"
 #include "DirectX/ShaderTypes.h"
 #include "ExitHelper.h"
+#include "FileWatcher/FileWatcher.h"
 #include "Filters/BilateralBlur/BilateralBlurFilter.h"
 #include "Filters/Blur/BlurFilter.h"
 #include "Filters/SobelFilter/SobelFilter.h"
 #include "GraphicsPipelineManager/GraphicsPipelineManager.h"
+#include "Input/InputEvent.h"
+#include "Input/SPSCQueue.h"
 #include "MaterialManager/MaterialManager.h"
 #include "MeshGenerator/MeshGenerator.h"
 #include "RenderGraph/Graph/RenderGraph.h"
+#include "Replay/FrameRecorder.h"
 #include "RenderTarget/CubeMap/DynamicCubeMap/DynamicCubeMapTarget.h"
 #include "RenderTarget/RenderTarget.h"
 #include "ShaderCompiler/Compiler.h"
@@ -65,6 +69,15 @@ public:
 	OWindow* GetWindow() const;
 	ComPtr<ID3D12Device2> GetDevice() const;
 
+	// When Initialize started, the origin of the startup trace
+	std::chrono::steady_clock::time_point GetStartTime() const;
+
+	// Edits of the material, PSO and render graph configs are applied while running, off with -noconfigreload
+	inline static bool bConfigHotReload = true;
+
+	// Pipelines declaring cbDrawConstants index the instance table per draw, off binds the instance data per draw for every pipeline
+	inline static bool bBindlessDraws = true;
+
 	void FlushGPU() const;
 
 	int InitTests(shared_ptr<class OTest> Test);
@@ -81,7 +94,6 @@ public:
 
 	void OnEnd(shared_ptr<OTest> Test) const;
 
-	void TryRebuildFrameResource();
 	void OnPreRender();
 	void PrepareRenderTarget(ORenderTargetBase* RenderTarget);
 
@@ -99,6 +111,24 @@ public:
 	void OnMouseButtonPressed(MouseButtonEventArgs& Args);
 	void OnMouseButtonReleased(MouseButtonEventArgs& Args);
 	void OnMouseWheel(MouseWheelEventArgs& Args);
+	bool PushInputEvent(const SInputEvent& Event);
+	void DrainInputEvents();
+
+	bool StartRecording(const string& Path);
+	void StopRecording();
+	bool StartReplay(const string& Path, float FixedDeltaTime);
+	void StopReplay();
+	bool IsReplaying() const;
+	bool PrepareReplayFrame();
+	const STimer& GetReplayTimer() const;
+
+	void SetNumRecordingThreads(uint32_t NumThreads);
+	// Renders frames with an increasing number of recording threads, bindless and bound, and logs the recording time of each step
+	void RunRecordingBenchmark(STimer& Timer);
+	// Binds the pass constants of the opaque PSO by name, by name through the queue and by slot, and logs binds per second of each
+	void RunBindingBenchmark();
+	void RunShaderCompileBenchmark();
+	void RunConfigBenchmark();
 	void OnResizeRequest(HWND& WindowHandle);
 	void OnUpdateWindowSize(ResizeEventArgs& Args);
 	void SetWindowViewport();
@@ -143,9 +173,6 @@ public:
 	UINT DSVDescriptorSize = 0;
 	UINT CBVSRVUAVDescriptorSize = 0;
 
-	uint32_t GetDesiredCountOfRTVs() const;
-	uint32_t GetDesiredCountOfDSVs() const;
-	uint32_t GetDesiredCountOfSRVs() const;
 	std::unordered_map<string, unique_ptr<SMeshGeometry>>& GetSceneGeometry();
 	SMeshGeometry* SetSceneGeometry(unique_ptr<SMeshGeometry> Geometry);
 	ORenderItem* BuildRenderItemFromMesh(const string& Name, string Category, unique_ptr<SMeshGeometry> Mesh, const SRenderItemParams& Params);
@@ -186,6 +213,9 @@ public:
 	void SetPipelineState(SPSODescriptionBase* PSOInfo);
 
 	void SetFog(DirectX::XMFLOAT4 Color, float Start, float Range);
+
+	// Selects the shader permutations used from the next frame on, see OGraphicsPipelineManager::ResolvePermutation
+	void SetShaderFeature(const string& Name, uint32_t ValueIndex) const;
 	SPassConstants& GetMainPassCB();
 	ComPtr<ID3D12DescriptorHeap>& GetSRVHeap();
 
@@ -214,7 +244,13 @@ public:
 	template<typename T>
 	T* GetObjectByUUID(TUUID UUID, bool Checked = false);
 
+	void RemoveRenderObject(TUUID UUID);
+
 	void SetObjectDescriptor();
+	void BuildObjectDescriptors(const TUUID& UUID, IRenderObject* RenderObject);
+
+	// Valid for the current frame only
+	SDescriptorPair AllocateTransientSRV(uint32_t Count = 1);
 	D3D12_GPU_DESCRIPTOR_HANDLE GetSRVDescHandleForTexture(STexture* Texture) const;
 	void SetAmbientLight(const DirectX::XMFLOAT4& Color);
 
@@ -245,6 +281,7 @@ public:
 	}
 
 	OMeshGenerator* GetMeshGenerator() const;
+	OUploadRingBuffer* GetUploadRing() const;
 
 	void Pick(int32_t SX, int32_t SY);
 	ORenderItem* GetPickedItem() const;
@@ -254,7 +291,7 @@ public:
 	ODynamicCubeMapRenderTarget* BuildCubeRenderTarget(DirectX::XMFLOAT3 Center);
 	void DrawRenderItems(SPSODescriptionBase* Desc, const string& RenderLayer);
 
-	void UpdateMaterialCB() const;
+	void UpdateMaterialCB();
 	void UpdateLightCB(const UpdateEventArgs& Args)const;
 	void UpdateObjectCB() const;
 	void SetDescriptorHeap();
@@ -275,16 +312,24 @@ protected:
 	ComPtr<ID3D12Device2> CreateDevice(ComPtr<IDXGIAdapter4> Adapter);
 
 	void UpdateFrameResource();
+	void AllocateFrameResource();
+	void DispatchInputEvent(const SInputEvent& Event);
+	void SyncReplayState(const STimer& Timer);
+	SCameraState GetCameraState() const;
 	void InitRenderGraph();
+	void InitConfigHotReload();
+	void UpdateConfigHotReload();
+	void BindTransientResources(OFilterBase* Filter, const vector<string>& Names) const;
 	uint32_t GetLightComponentsCount() const;
 private:
-	void RemoveRenderObject(TUUID UUID);
 	void BuildFrameResource(uint32_t Count = 1);
 
 	uint32_t PassCount = 1;
 	uint32_t CurrentPass = 0;
-	uint32_t CurrentNumMaterials = 0;
-	uint32_t CurrentNumInstances = 0;
+	unique_ptr<OUploadRingBuffer> UploadRing;
+
+	// CPU copy of the material table, indexed by MaterialCBIndex
+	vector<SMaterialData> MaterialConstants;
 
 	OEngine() = default;
 	void UpdateMainPass(const STimer& Timer);
@@ -332,6 +377,8 @@ private:
 	uint32_t SRVDescNum = 0;
 
 	bool HasInitializedTests = false;
+	std::chrono::steady_clock::time_point StartTime;
+	bool bFirstFrameRendered = false;
 	STimer TickTimer;
 	OOffscreenTexture* OffscreenRT = nullptr;
 	ODynamicCubeMapRenderTarget* CubeRenderTarget = nullptr;
@@ -356,6 +403,14 @@ private:
 	unique_ptr<ORenderGraph> RenderGraph;
 	vector<OLightComponent*> LightComponents;
 
+	// Config path keys whose files changed and weren't applied yet, a reload that can't run now is retried next frame
+	unique_ptr<OFileWatcher> ConfigWatcher;
+	std::chrono::steady_clock::time_point LastConfigPoll;
+	unordered_set<string> PendingConfigReloads;
+
+	TSPSCQueue<SInputEvent, 1024> InputQueue;
+	unique_ptr<OFrameRecorder> FrameRecorder;
+	unique_ptr<OFrameReplayer> FrameReplayer;
 };
 
 template<typename T, typename... Args>
@@ -366,6 +421,7 @@ TUUID OEngine::BuildRenderObjectImpl(Args&&... Params)
 	object->SetID(uuid);
 	object->InitRenderObject();
 	RenderObjects[uuid] = unique_ptr<IRenderObject>(object);
+	BuildObjectDescriptors(uuid, object);
 	return uuid;
 }
 
@@ -2,7 +2,58 @@
 
 void SRenderObjectDescriptor::Init(SDescriptorResourceData SRV, SDescriptorResourceData RTV, SDescriptorResourceData DSV)
 {
-	SRVHandle.Init(SRV);
+	SRVHandle.Init(SRV, SRenderConstants::TransientSRVDescriptorsPerFrame);
 	RTVHandle.Init(RTV);
 	DSVHandle.Init(DSV);
+	OwnedRanges.clear();
+}
+
+void SRenderObjectDescriptor::BeginOwner(const TUUID& Owner)
+{
+	auto& ranges = OwnedRanges[Owner];
+	SRVHandle.Recording = &ranges.SRV;
+	RTVHandle.Recording = &ranges.RTV;
+	DSVHandle.Recording = &ranges.DSV;
+}
+
+void SRenderObjectDescriptor::EndOwner()
+{
+	SRVHandle.Recording = nullptr;
+	RTVHandle.Recording = nullptr;
+	DSVHandle.Recording = nullptr;
+}
+
+void SRenderObjectDescriptor::FreeOwner(const TUUID& Owner, uint64_t FenceValue)
+{
+	const auto it = OwnedRanges.find(Owner);
+	if (it == OwnedRanges.end())
+	{
+		return;
+	}
+
+	for (const auto& range : it->second.SRV)
+	{
+		SRVHandle.Free(range, FenceValue);
+	}
+	for (const auto& range : it->second.RTV)
+	{
+		RTVHandle.Free(range, FenceValue);
+	}
+	for (const auto& range : it->second.DSV)
+	{
+		DSVHandle.Free(range, FenceValue);
+	}
+	OwnedRanges.erase(it);
+}
+
+void SRenderObjectDescriptor::BeginFrame(uint32_t FrameIndex)
+{
+	SRVHandle.Allocator.BeginFrame(FrameIndex);
+}
+
+void SRenderObjectDescriptor::ReleaseCompleted(uint64_t CompletedFenceValue)
+{
+	SRVHandle.Allocator.ReleaseCompleted(CompletedFenceValue);
+	RTVHandle.Allocator.ReleaseCompleted(CompletedFenceValue);
+	DSVHandle.Allocator.ReleaseCompleted(CompletedFenceValue);
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "DirectX/ObjectConstants.h"
+#include "Engine/DescriptorHeap/DescriptorAllocator.h"
 #include "Engine/UploadBuffer/UploadBuffer.h"
+#include "Engine/UploadBuffer/UploadRingBuffer.h"
 #include "Events.h"
 #include "Logger.h"
 #include "Statics.h"
@@ -25,21 +27,18 @@ struct SDescriptorResourceData
 	UINT Count;
 };
 
+/**
+ * @brief Descriptors of one heap. Offset allocates contiguous descriptors from the heap allocator, they can be freed again
+ * so objects may come and go without rebuilding the heap.
+ */
 struct TDescriptorHandle
 {
 	void Offset(CD3DX12_CPU_DESCRIPTOR_HANDLE& OutCPUHandle, CD3DX12_GPU_DESCRIPTOR_HANDLE& OutGPUHandle, uint32_t& OutIndex)
 	{
-		OutCPUHandle = CPUHandle;
-		OutGPUHandle = GPUHandle;
-		OutIndex = CurrentOffset;
-		CurrentOffset++;
-		CPUHandle.Offset(1, DescSize);
-
-		if (GPUHandle.ptr != 0)
-		{
-			GPUHandle.Offset(1, DescSize);
-		}
-		Check();
+		const auto pair = Offset();
+		OutCPUHandle = pair.CPUHandle;
+		OutGPUHandle = pair.GPUHandle;
+		OutIndex = pair.Index;
 	}
 
 	void Offset(SDescriptorPair& OutHandle)
@@ -47,90 +46,131 @@ struct TDescriptorHandle
 		Offset(OutHandle.CPUHandle, OutHandle.GPUHandle, OutHandle.Index);
 	}
 
+	// Descriptors of the vector are contiguous
 	void Offset(vector<SDescriptorPair>& OutHandle, uint32_t NumDesc)
 	{
+		OutHandle.resize(std::max<size_t>(OutHandle.size(), NumDesc));
+		const auto first = Offset(NumDesc);
 		for (uint32_t i = 0; i < NumDesc; i++)
 		{
-			auto pair = Offset();
-			if (i >= OutHandle.size())
-			{
-				OutHandle.push_back(pair);
-			}
-			else
-			{
-				OutHandle[i] = pair;
-			}
+			OutHandle[i] = GetPair(first.Index + i);
 		}
 	}
 
 	void Offset(vector<SDescriptorPair>& OutHandle)
 	{
-		for (auto& handle : OutHandle)
-		{
-			Offset(handle.CPUHandle, handle.GPUHandle, handle.Index);
-		}
+		Offset(OutHandle, SCast<uint32_t>(OutHandle.size()));
 	}
 
 	SDescriptorPair Offset(const uint32_t Value = 1)
 	{
-		const auto oldCPU = CPUHandle;
-		const auto oldGPU = GPUHandle;
-		const auto oldOffset = CurrentOffset;
-		CurrentOffset += Value;
-		CPUHandle.Offset(Value, DescSize);
-		if (GPUHandle.ptr != 0)
+		Check();
+		const auto range = Allocator.Allocate(Value);
+		if (!range.IsValid())
 		{
-			GPUHandle.Offset(Value, DescSize);
+			LOG(Render, Error, "Descriptor heap overflow");
+			return {};
 		}
+
+		if (Recording)
+		{
+			Recording->push_back(range);
+		}
+		return GetPair(range.Index);
+	}
+
+	// Valid until the same frame index starts again
+	SDescriptorPair AllocateTransient(const uint32_t Value = 1)
+	{
 		Check();
-		return { oldCPU, oldGPU, oldOffset };
+		const auto range = Allocator.AllocateTransient(Value);
+		if (!range.IsValid())
+		{
+			LOG(Render, Error, "Transient descriptor region overflow");
+			return {};
+		}
+		return GetPair(range.Index);
 	}
 
-	void Check() const
+	void Free(const SDescriptorRange& Range, uint64_t FenceValue)
 	{
-		if (CurrentOffset > MaxOffset)
+		Allocator.Free(Range, FenceValue);
+	}
+
+	SDescriptorPair GetPair(uint32_t Index) const
+	{
+		SDescriptorPair pair;
+		pair.CPUHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(CPUHandle, SCast<INT>(Index), DescSize);
+		if (GPUHandle.ptr != 0)
 		{
-			LOG(Render, Error, "Descriptor heap overflow");
+			pair.GPUHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(GPUHandle, SCast<INT>(Index), DescSize);
 		}
+		pair.Index = Index;
+		return pair;
+	}
 
+	void Check() const
+	{
 		if (!bIsInitized)
 		{
 			LOG(Render, Error, "Descriptor heap not initized");
 		}
 
-		if (MaxOffset == 0)
+		if (Allocator.GetCapacity() == 0)
 		{
 			LOG(Render, Error, "Descriptor heap max count not initized");
 		}
 	}
 
-	void Init(SDescriptorResourceData Data)
+	void Init(SDescriptorResourceData Data, uint32_t TransientCountPerFrame = 0)
 	{
 		bIsInitized = true;
-		MaxOffset = Data.Count;
 		DescSize = Data.Size;
 		CPUHandle = Data.Heap->GetCPUDescriptorHandleForHeapStart();
 		if (Data.Heap->GetDesc().Flags == D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
 		{
 			GPUHandle = Data.Heap->GetGPUDescriptorHandleForHeapStart();
 		}
+
+		const uint32_t transientCount = TransientCountPerFrame * SRenderConstants::NumFrameResources;
+		CHECK_MSG(Data.Count > transientCount, "Descriptor heap is smaller than its transient region!");
+		Allocator = ODescriptorAllocator(Data.Count - transientCount, TransientCountPerFrame, SRenderConstants::NumFrameResources);
 	}
 
 	bool bIsInitized = false;
 	uint32_t DescSize;
 	CD3DX12_CPU_DESCRIPTOR_HANDLE CPUHandle;
 	CD3DX12_GPU_DESCRIPTOR_HANDLE GPUHandle;
-	uint32_t CurrentOffset = 0;
-	uint32_t MaxOffset = 0;
+	ODescriptorAllocator Allocator;
+
+	// Persistent allocations are appended here while an owner is being built
+	vector<SDescriptorRange>* Recording = nullptr;
 };
 
 struct SRenderObjectDescriptor : IDescriptor
 {
 	void Init(SDescriptorResourceData SRV, SDescriptorResourceData RTV, SDescriptorResourceData DSV);
 
+	// Descriptors allocated in between belong to the owner and are freed together with it
+	void BeginOwner(const TUUID& Owner);
+	void EndOwner();
+	void FreeOwner(const TUUID& Owner, uint64_t FenceValue);
+
+	void BeginFrame(uint32_t FrameIndex);
+	void ReleaseCompleted(uint64_t CompletedFenceValue);
+
 	TDescriptorHandle SRVHandle;
 	TDescriptorHandle RTVHandle;
 	TDescriptorHandle DSVHandle;
+
+private:
+	struct SOwnedRanges
+	{
+		vector<SDescriptorRange> SRV;
+		vector<SDescriptorRange> RTV;
+		vector<SDescriptorRange> DSV;
+	};
+	map<TUUID, SOwnedRanges> OwnedRanges;
 };
 
 template <typename DataType>
@@ -138,7 +178,7 @@ struct TUploadBufferData
 {
 	int32_t StartIndex = -1;
 	int32_t EndIndex = INT32_MAX;
-	OUploadBuffer<DataType>* Buffer = nullptr;
+	TUploadAllocation<DataType>* Buffer = nullptr;
 	void PutData(const DataType& Data)
 	{
 		Buffer->CopyData(StartIndex, Data);
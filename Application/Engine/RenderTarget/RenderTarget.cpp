@@ -75,6 +75,13 @@ void ORenderTargetBase::PrepareRenderTarget(ID3D12GraphicsCommandList* CommandLi
 	CommandList->OMSetRenderTargets(1, &backbufferView, true, &depthStencilView.CPUHandle);
 }
 
+void ORenderTargetBase::BindRenderTarget(ID3D12GraphicsCommandList* CommandList, uint32_t SubtargetIdx) const
+{
+	auto backbufferView = GetRTV(SubtargetIdx).CPUHandle;
+	auto depthStencilView = GetDSV(SubtargetIdx);
+	CommandList->OMSetRenderTargets(1, &backbufferView, true, &depthStencilView.CPUHandle);
+}
+
 void ORenderTargetBase::UnsetRenderTarget(OCommandQueue* CommandQueue)
 {
 	PreparedTaregts.clear();
@@ -46,6 +46,9 @@ public:
 	void SetViewport(ID3D12GraphicsCommandList* List) const;
 	virtual void PrepareRenderTarget(ID3D12GraphicsCommandList* CommandList, uint32_t SubtargetIdx = 0);
 
+	// Sets the views of a target which has been prepared earlier this frame, without clearing it
+	void BindRenderTarget(ID3D12GraphicsCommandList* CommandList, uint32_t SubtargetIdx = 0) const;
+
 	void UnsetRenderTarget(OCommandQueue* CommandQueue);
 	wstring GetName() override
 	{
@@ -4,31 +4,23 @@
 
 #include "Shader.h"
 
+namespace
+{
+constexpr auto ShaderLevels = MakeEnumTable<EShaderLevel>({
+	{ "Vertex", EShaderLevel::VertexShader },
+	{ "Pixel", EShaderLevel::PixelShader },
+	{ "Compute", EShaderLevel::ComputeShader },
+	{ "Geometry", EShaderLevel::GeometryShader },
+	{ "Hull", EShaderLevel::HullShader },
+	{ "Domain", EShaderLevel::DomainShader },
+});
+} // namespace
+
 void SShaderDefinition::TypeFromString(const string& Other)
 {
-	if (Other == "Vertex")
-	{
-		ShaderType = EShaderLevel::VertexShader;
-	}
-	else if (Other == "Pixel")
-	{
-		ShaderType = EShaderLevel::PixelShader;
-	}
-	else if (Other == "Compute")
-	{
-		ShaderType = EShaderLevel::ComputeShader;
-	}
-	else if (Other == "Geometry")
-	{
-		ShaderType = EShaderLevel::GeometryShader;
-	}
-	else if (Other == "Hull")
-	{
-		ShaderType = EShaderLevel::HullShader;
-	}
-	else if (Other == "Domain")
+	if (const auto level = ShaderLevels.FromString(Other))
 	{
-		ShaderType = EShaderLevel::DomainShader;
+		ShaderType = *level;
 	}
 	else
 	{
@@ -36,15 +28,15 @@ void SShaderDefinition::TypeFromString(const string& Other)
 	}
 }
 
-void OShader::Init(const SShaderDefinition& Info, const ComPtr<IDxcBlob>& Blob)
+void OShader::Init(const SShaderDefinition& Info, vector<uint8_t> InByteCode)
 {
-	ShaderBlob = Blob;
+	ByteCode = std::move(InByteCode);
 	ShaderInfo = Info;
 }
 
 D3D12_SHADER_BYTECODE OShader::GetShaderByteCode() const
 {
 	return {
-		reinterpret_cast<BYTE*>(ShaderBlob->GetBufferPointer()), ShaderBlob->GetBufferSize()
+		ByteCode.data(), ByteCode.size()
 	};
 }
\ No newline at end of file
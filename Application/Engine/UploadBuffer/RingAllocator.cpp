@@ -0,0 +1,88 @@
+#include "RingAllocator.h"
+
+ORingAllocator::ORingAllocator(uint64_t Size)
+    : Size(Size)
+{
+}
+
+uint64_t ORingAllocator::Allocate(uint64_t AllocSize, uint64_t Alignment)
+{
+	const uint64_t usedSize = GetUsedSize();
+	if (usedSize == 0)
+	{
+		// Nothing is alive, start over from the beginning to keep the whole ring contiguous
+		Head = 0;
+		Tail = 0;
+	}
+
+	const uint64_t aligned = (Head + Alignment - 1) & ~(Alignment - 1);
+	const bool bWrapped = Head < Tail || (Head == Tail && usedSize > 0);
+	if (bWrapped)
+	{
+		// Live range is [Tail, Size) + [0, Head), free memory lies in between
+		if (aligned + AllocSize > Tail)
+		{
+			return InvalidOffset;
+		}
+		TotalAllocated += aligned + AllocSize - Head;
+		Head = aligned + AllocSize;
+		return aligned;
+	}
+
+	if (aligned + AllocSize <= Size)
+	{
+		TotalAllocated += aligned + AllocSize - Head;
+		Head = aligned + AllocSize;
+		return aligned;
+	}
+
+	// Skip the remainder of the ring, offset zero satisfies any alignment
+	if (AllocSize > Tail)
+	{
+		return InvalidOffset;
+	}
+	TotalAllocated += Size - Head + AllocSize;
+	Head = AllocSize;
+	return 0;
+}
+
+void ORingAllocator::FinishFrame(uint64_t FenceValue)
+{
+	Frames.push({ FenceValue, Head, TotalAllocated });
+}
+
+void ORingAllocator::ReleaseCompletedFrames(uint64_t CompletedFenceValue)
+{
+	while (!Frames.empty() && Frames.front().FenceValue <= CompletedFenceValue)
+	{
+		const auto& frame = Frames.front();
+
+		// Frames without allocations after a restart from zero would move the tail backwards
+		if (frame.TotalAllocated > TotalReleased)
+		{
+			Tail = frame.Head;
+			TotalReleased = frame.TotalAllocated;
+		}
+		Frames.pop();
+	}
+}
+
+bool ORingAllocator::HasPendingFrames() const
+{
+	return !Frames.empty();
+}
+
+uint64_t ORingAllocator::GetOldestPendingFence() const
+{
+	return Frames.empty() ? 0 : Frames.front().FenceValue;
+}
+
+uint64_t ORingAllocator::GetSize() const
+{
+	return Size;
+}
+
+uint64_t ORingAllocator::GetUsedSize() const
+{
+	return TotalAllocated - TotalReleased;
+}
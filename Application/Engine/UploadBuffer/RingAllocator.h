@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <queue>
+
+/**
+ * @brief Offset bookkeeping of a ring over a fixed range. Allocations are linear, the end of every frame is marked with a fence value
+ * and the range allocated up to that mark is reclaimed once the fence completed. Free of any graphics API so it can be exercised on the CPU alone.
+ */
+class ORingAllocator
+{
+public:
+	static constexpr uint64_t InvalidOffset = UINT64_MAX;
+
+	explicit ORingAllocator(uint64_t Size);
+
+	// Returns the aligned offset or InvalidOffset if the ring has no room left until older frames are released
+	uint64_t Allocate(uint64_t Size, uint64_t Alignment);
+
+	void FinishFrame(uint64_t FenceValue);
+	void ReleaseCompletedFrames(uint64_t CompletedFenceValue);
+
+	bool HasPendingFrames() const;
+	uint64_t GetOldestPendingFence() const;
+
+	uint64_t GetSize() const;
+	uint64_t GetUsedSize() const;
+
+private:
+	struct SFrameMarker
+	{
+		uint64_t FenceValue = 0;
+		uint64_t Head = 0;
+		uint64_t TotalAllocated = 0;
+	};
+
+	uint64_t Size = 0;
+	uint64_t Head = 0;
+	uint64_t Tail = 0;
+
+	// Monotonic byte counts including alignment padding and the space skipped on wrap around
+	uint64_t TotalAllocated = 0;
+	uint64_t TotalReleased = 0;
+
+	std::queue<SFrameMarker> Frames;
+};
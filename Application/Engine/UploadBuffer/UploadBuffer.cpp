@@ -1,5 +0,0 @@
-//
-// Created by Cybea on 18/12/2023.
-//
-
-#include "UploadBuffer.h"
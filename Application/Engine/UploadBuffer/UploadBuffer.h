@@ -2,9 +2,11 @@
 
 #include "DirectX/Resource.h"
 #include "DirectXUtils.h"
+#include "Stats/Stats.h"
+#include "UploadWriter.h"
 
 template<typename Type>
-class OUploadBuffer
+class OUploadBuffer : public TUploadWriter<Type>
 {
 public:
 	OUploadBuffer(ID3D12Device* Device, UINT ElementCount, bool IsConstantBuffer, IRenderObject* Owner = nullptr);
@@ -23,7 +25,7 @@ public:
 		{
 			UploadBuffer.Resource->Unmap(0, nullptr);
 		}
-		MappedData = nullptr;
+		this->MappedData = nullptr;
 	}
 
 	SResourceInfo* GetResource()
@@ -31,11 +33,6 @@ public:
 		return &UploadBuffer;
 	}
 
-	void CopyData(int ElementIdx, const Type& Data)
-	{
-		memcpy(&MappedData[ElementIdx * ElementByteSize], &Data, sizeof(Type));
-	}
-
 	uint32_t SetFreeIndex()
 	{
 		auto old = CurrentOffset;
@@ -43,7 +40,7 @@ public:
 		return old;
 	}
 
-	auto GetGPUAddress() const
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const
 	{
 		return UploadBuffer.Resource->GetGPUVirtualAddress();
 	}
@@ -51,18 +48,16 @@ public:
 public:
 	SResourceInfo UploadBuffer;
 	IRenderObject* Owner = nullptr;
-	UINT ElementByteSize = 0;
 	bool bIsConstantBuffer = false;
 	uint32_t CurrentOffset = 0;
 	uint32_t MaxOffset = 0;
-	BYTE* MappedData = nullptr;
 };
 
 template<typename Type>
 OUploadBuffer<Type>::OUploadBuffer(ID3D12Device* Device, UINT ElementCount, bool IsConstantBuffer, IRenderObject* Owner)
     : bIsConstantBuffer(IsConstantBuffer), Owner(Owner) , MaxOffset(ElementCount)
 {
-	ElementByteSize = sizeof(Type);
+	this->ElementByteSize = sizeof(Type);
 
 	// Constant buffer elements need to be multiples of 256 bytes.
 	// This is because the hardware can only view constant data
@@ -74,12 +69,12 @@ OUploadBuffer<Type>::OUploadBuffer(ID3D12Device* Device, UINT ElementCount, bool
 
 	if (IsConstantBuffer)
 	{
-		ElementByteSize = Utils::CalcBufferByteSize(sizeof(Type));
+		this->ElementByteSize = Utils::CalcBufferByteSize(sizeof(Type));
 	}
-	const auto uploadBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(ElementByteSize * ElementCount);
+	const auto uploadBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(this->ElementByteSize * ElementCount);
 
 	UploadBuffer = Utils::CreateResource(Owner, Device, D3D12_HEAP_TYPE_UPLOAD, uploadBufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ);
-	THROW_IF_FAILED(UploadBuffer.Resource->Map(0, nullptr, reinterpret_cast<void**>(&MappedData)));
+	THROW_IF_FAILED(UploadBuffer.Resource->Map(0, nullptr, reinterpret_cast<void**>(&this->MappedData)));
 }
 
 template<typename Type>
@@ -0,0 +1,56 @@
+#include "UploadRingBuffer.h"
+
+#include "CommandQueue/CommandQueue.h"
+#include "Logger.h"
+
+OUploadRingBuffer::OUploadRingBuffer(ID3D12Device* Device, OCommandQueue* Queue, uint64_t Size, IRenderObject* Owner)
+    : Allocator(Size), Queue(Queue)
+{
+	const auto uploadBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(Size);
+	UploadBuffer = Utils::CreateResource(Owner, Device, D3D12_HEAP_TYPE_UPLOAD, uploadBufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ);
+	THROW_IF_FAILED(UploadBuffer.Resource->Map(0, nullptr, reinterpret_cast<void**>(&MappedData)));
+}
+
+OUploadRingBuffer::~OUploadRingBuffer()
+{
+	if (UploadBuffer.Resource != nullptr)
+	{
+		UploadBuffer.Resource->Unmap(0, nullptr);
+	}
+	MappedData = nullptr;
+}
+
+OUploadRingBuffer::SAllocation OUploadRingBuffer::Allocate(uint64_t Size, uint64_t Alignment)
+{
+	uint64_t offset = Allocator.Allocate(Size, Alignment);
+	while (offset == ORingAllocator::InvalidOffset)
+	{
+		CHECK_MSG(Allocator.HasPendingFrames(), "Upload ring is too small for a single frame!");
+
+		LOG(Render, Warning, "Upload ring is full, waiting for the GPU to release a frame");
+		STAT_INC(UploadRingStalls);
+		Queue->WaitForFenceValue(Allocator.GetOldestPendingFence());
+		ReleaseCompletedFrames();
+		offset = Allocator.Allocate(Size, Alignment);
+	}
+
+	SAllocation result;
+	result.MappedData = MappedData + offset;
+	result.GPUAddress = UploadBuffer.Resource->GetGPUVirtualAddress() + offset;
+	return result;
+}
+
+void OUploadRingBuffer::FinishFrame(uint64_t FenceValue)
+{
+	Allocator.FinishFrame(FenceValue);
+}
+
+void OUploadRingBuffer::ReleaseCompletedFrames()
+{
+	Allocator.ReleaseCompletedFrames(Queue->GetFence()->GetCompletedValue());
+}
+
+uint64_t OUploadRingBuffer::GetUsedSize() const
+{
+	return Allocator.GetUsedSize();
+}
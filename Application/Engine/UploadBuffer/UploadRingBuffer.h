@@ -0,0 +1,82 @@
+#pragma once
+
+#include "DirectX/Resource.h"
+#include "DirectXUtils.h"
+#include "RingAllocator.h"
+#include "Stats/Stats.h"
+#include "UploadWriter.h"
+
+class OCommandQueue;
+
+/**
+ * @brief Typed window into the ring, valid for the frame it was allocated in. Mirrors the OUploadBuffer interface.
+ */
+template<typename Type>
+struct TUploadAllocation : TUploadWriter<Type>
+{
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUAddress() const
+	{
+		return GPUAddress;
+	}
+
+	uint32_t GetNumElements() const
+	{
+		return NumElements;
+	}
+
+	D3D12_GPU_VIRTUAL_ADDRESS GPUAddress = 0;
+	uint32_t NumElements = 0;
+};
+
+/**
+ * @brief One persistently mapped upload heap shared by all per frame data. Any system may sub allocate constant or structured data from it,
+ * the memory is reclaimed once the GPU finished the frame it was allocated in.
+ */
+class OUploadRingBuffer
+{
+public:
+	OUploadRingBuffer(ID3D12Device* Device, OCommandQueue* Queue, uint64_t Size, IRenderObject* Owner = nullptr);
+	~OUploadRingBuffer();
+
+	OUploadRingBuffer(const OUploadRingBuffer&) = delete;
+	OUploadRingBuffer& operator=(const OUploadRingBuffer&) = delete;
+
+	struct SAllocation
+	{
+		BYTE* MappedData = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS GPUAddress = 0;
+	};
+
+	// Waits for the oldest frame in flight if the ring is full
+	SAllocation Allocate(uint64_t Size, uint64_t Alignment);
+
+	template<typename Type>
+	TUploadAllocation<Type> Allocate(uint32_t NumElements, bool IsConstantBuffer);
+
+	// Everything allocated so far belongs to the frame completing with this fence value
+	void FinishFrame(uint64_t FenceValue);
+	void ReleaseCompletedFrames();
+
+	uint64_t GetUsedSize() const;
+
+private:
+	ORingAllocator Allocator;
+	OCommandQueue* Queue = nullptr;
+	SResourceInfo UploadBuffer;
+	BYTE* MappedData = nullptr;
+};
+
+template<typename Type>
+TUploadAllocation<Type> OUploadRingBuffer::Allocate(uint32_t NumElements, bool IsConstantBuffer)
+{
+	TUploadAllocation<Type> result;
+	result.ElementByteSize = IsConstantBuffer ? Utils::CalcBufferByteSize(sizeof(Type)) : sizeof(Type);
+	result.NumElements = NumElements;
+
+	// Empty tables still get one element so that the root descriptor points to valid memory
+	const uint64_t alignment = IsConstantBuffer ? D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT : 16;
+	const auto allocation = Allocate(static_cast<uint64_t>(result.ElementByteSize) * std::max(NumElements, 1u), alignment);
+	result.MappedData = allocation.MappedData;
+	result.GPUAddress = allocation.GPUAddress;
+	return result;
+}
@@ -0,0 +1,52 @@
+//
+// Created by Cybea on 18/12/2023.
+//
+
+#include "UploadWriter.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UPLOAD_STREAMING_STORES 1
+#endif
+
+void Utils::StreamCopy(void* Dest, const void* Src, size_t Size)
+{
+#ifdef UPLOAD_STREAMING_STORES
+	auto dest = static_cast<uint8_t*>(Dest);
+	auto src = static_cast<const uint8_t*>(Src);
+
+	// Streaming stores need 16 byte aligned destinations
+	const size_t head = std::min<size_t>((16 - (reinterpret_cast<uintptr_t>(dest) & 15)) & 15, Size);
+	memcpy(dest, src, head);
+	dest += head;
+	src += head;
+	Size -= head;
+
+	for (; Size >= 64; Size -= 64, dest += 64, src += 64)
+	{
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+		_mm_stream_si128(reinterpret_cast<__m128i*>(dest), a);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 16), b);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 32), c);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 48), d);
+	}
+	for (; Size >= 16; Size -= 16, dest += 16, src += 16)
+	{
+		_mm_stream_si128(reinterpret_cast<__m128i*>(dest), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+	}
+	memcpy(dest, src, Size);
+#else
+	memcpy(Dest, Src, Size);
+#endif
+}
+
+void Utils::StreamFence()
+{
+#ifdef UPLOAD_STREAMING_STORES
+	// Makes the streamed data visible before the command list reading it is submitted
+	_mm_sfence();
+#endif
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Stats/Stats.h"
+#include "Types.h"
+
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+
+namespace Utils
+{
+// Copies with non temporal stores which bypass the cache, falls back to memcpy without SSE2.
+// Pays off for large blocks which the CPU never reads back, like uploads into write combined memory.
+void StreamCopy(void* Dest, const void* Src, size_t Size);
+
+// Streaming stores are weakly ordered, fence once after the last StreamCopy instead of after each of them
+void StreamFence();
+} // namespace Utils
+
+/**
+ * @brief Element writers over mapped upload memory, shared by the upload buffer and the per frame ring allocations.
+ * Upload heaps are write combined: write every element once and in order, never read from the mapped memory.
+ */
+template<typename Type>
+struct TUploadWriter
+{
+	void CopyData(int ElementIdx, const Type& Data)
+	{
+		memcpy(&MappedData[ElementIdx * ElementByteSize], &Data, sizeof(Type));
+		STAT_ADD(UploadBytesCopied, sizeof(Type));
+	}
+
+	// Non temporal stores are only used for packed ranges. Padded constant buffer elements end in partly written cache lines,
+	// streaming those is slower than copying through the cache.
+	void CopyRange(int StartIdx, std::span<const Type> Data, bool bNonTemporal = false)
+	{
+		uint8_t* dest = &MappedData[StartIdx * ElementByteSize];
+		if (ElementByteSize == sizeof(Type))
+		{
+			if (bNonTemporal)
+			{
+				Utils::StreamCopy(dest, Data.data(), Data.size_bytes());
+				Utils::StreamFence();
+			}
+			else
+			{
+				memcpy(dest, Data.data(), Data.size_bytes());
+			}
+		}
+		else
+		{
+			// The padding is skipped
+			for (size_t i = 0; i < Data.size(); i++)
+			{
+				memcpy(dest + i * ElementByteSize, &Data[i], sizeof(Type));
+			}
+		}
+		STAT_ADD(UploadBytesCopied, Data.size_bytes());
+	}
+
+	// Constructs the element directly in the mapped memory, the caller fills in the rest without a staging copy.
+	// The returned reference is for writing only.
+	template<typename... Args>
+	Type& Emplace(int ElementIdx, Args&&... Arguments)
+	{
+		static_assert(std::is_trivially_destructible_v<Type>, "Upload memory is never destroyed");
+		STAT_ADD(UploadBytesCopied, sizeof(Type));
+		return *new (&MappedData[ElementIdx * ElementByteSize]) Type(std::forward<Args>(Arguments)...);
+	}
+
+	uint8_t* MappedData = nullptr;
+	uint32_t ElementByteSize = 0;
+};
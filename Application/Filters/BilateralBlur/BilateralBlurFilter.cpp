@@ -3,12 +3,11 @@
 #include "BilateralBlurFilter.h"
 
 #include "DirectX/ShaderTypes.h"
+#include "Engine/Engine.h"
 
 OBilateralBlurFilter::OBilateralBlurFilter(ID3D12Device* Device, OCommandQueue* Other, UINT Width, UINT Height, DXGI_FORMAT Format)
     : OFilterBase(Device, Other, Width, Height, Format)
 {
-	BlurBuffer = OUploadBuffer<SBilateralBlur>::Create(Device, 1, true, this);
-	BufferConstants = OUploadBuffer<SBufferConstants>::Create(Device, 1, true, this);
 	FilterName = L"BilateralBlurFilter";
 }
 
@@ -81,23 +80,24 @@ void OBilateralBlurFilter::Execute(const SPSODescriptionBase* PSO, SResourceInfo
 	using namespace Utils;
 	PSO->RootSignature->ActivateRootSignature(Queue->GetCommandList().Get());
 	auto cmd = Queue->GetCommandList().Get();
-	BlurBuffer->CopyData(0, { SpatialSigma, IntensitySigma, BlurCount });
-	BufferConstants->CopyData(0, { Width, Height });
-	PSO->RootSignature->SetResource("BilateralBlur", BlurBuffer->GetGPUAddress(), cmd);
-	PSO->RootSignature->SetResource("BufferConstants", BufferConstants->GetGPUAddress(), cmd);
 
-	ResourceBarrier(cmd, Input, D3D12_RESOURCE_STATE_COPY_SOURCE);
-	ResourceBarrier(cmd, &InputTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+	// Frames in flight may still read the constants of earlier frames, every frame gets its own copy from the ring
+	auto blurBuffer = OEngine::Get()->GetUploadRing()->Allocate<SBilateralBlur>(1, true);
+	auto bufferConstants = OEngine::Get()->GetUploadRing()->Allocate<SBufferConstants>(1, true);
+	blurBuffer.CopyData(0, { SpatialSigma, IntensitySigma, BlurCount });
+	bufferConstants.CopyData(0, { Width, Height });
+	PSO->RootSignature->SetResource("BilateralBlur", blurBuffer.GetGPUAddress(), cmd);
+	PSO->RootSignature->SetResource("BufferConstants", bufferConstants.GetGPUAddress(), cmd);
+
+	ResourceBarriers(cmd, { { { Input, D3D12_RESOURCE_STATE_COPY_SOURCE }, { &InputTexture, D3D12_RESOURCE_STATE_COPY_DEST } } });
 
 	cmd->CopyResource(InputTexture.Resource.Get(), Input->Resource.Get());
 
-	ResourceBarrier(cmd, &InputTexture, D3D12_RESOURCE_STATE_GENERIC_READ);
-	ResourceBarrier(cmd, &OutputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	ResourceBarriers(cmd, { { { &InputTexture, D3D12_RESOURCE_STATE_GENERIC_READ }, { &OutputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS } } });
 	PSO->RootSignature->SetResource("Input", BlurInputSrvHandle.GPUHandle, cmd);
 	PSO->RootSignature->SetResource("Output", BlurOutputUavHandle.GPUHandle, cmd);
 
 	cmd->Dispatch(Width / 32 + 1, Height / 32 + 1, 1);
 
-	ResourceBarrier(cmd, &OutputTexture, D3D12_RESOURCE_STATE_GENERIC_READ);
-	ResourceBarrier(cmd, &InputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	ResourceBarriers(cmd, { { { &OutputTexture, D3D12_RESOURCE_STATE_GENERIC_READ }, { &InputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS } } });
 }
@@ -33,6 +33,11 @@ public:
 		return 4;
 	}
 
+	vector<SResourceInfo*> GetTransientResources() override
+	{
+		return { &InputTexture, &OutputTexture };
+	}
+
 	void SetSpatialSigma(float Value)
 	{
 		SpatialSigma = Value;
@@ -53,9 +58,6 @@ private:
 	SDescriptorPair BlurInputSrvHandle;
 	SDescriptorPair BlurInputUavHandle;
 
-	TUploadBuffer<SBilateralBlur> BlurBuffer;
-	TUploadBuffer<SBufferConstants> BufferConstants;
-
 	SResourceInfo InputTexture;
 	SResourceInfo OutputTexture;
 	float SpatialSigma;
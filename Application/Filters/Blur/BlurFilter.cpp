@@ -1,12 +1,12 @@
 #include "BlurFilter.h"
 
 #include "DirectX/ShaderTypes.h"
+#include "Engine/Engine.h"
 #include "Logger.h"
 
 OBlurFilter::OBlurFilter(ID3D12Device* Device, OCommandQueue* Other, UINT Width, UINT Height, DXGI_FORMAT Format)
     : OFilterBase(Device, Other, Width, Height, Format)
 {
-	Buffer = make_unique<OUploadBuffer<SConstantBlurSettings>>(Device, 1, true, this);
 	FilterName = L"BlurFilter";
 }
 
@@ -81,31 +81,32 @@ void OBlurFilter::Execute(
 	using namespace Utils;
 	const auto weights = CalcGaussWeights(Sigma);
 	const auto blurRadius = static_cast<int32_t>(weights.size() / 2);
-	Buffer->CopyData(0,
-	                 { blurRadius,
-	                   weights[0],
-	                   weights[1],
-	                   weights[2],
-	                   weights[3],
-	                   weights[4],
-	                   weights[5],
-	                   weights[6],
-	                   weights[7],
-	                   weights[8],
-	                   weights[9],
-	                   weights[10] });
+
+	// Frames in flight may still read the settings of earlier frames, every frame gets its own copy from the ring
+	auto settings = OEngine::Get()->GetUploadRing()->Allocate<SConstantBlurSettings>(1, true);
+	settings.CopyData(0,
+	                  { blurRadius,
+	                    weights[0],
+	                    weights[1],
+	                    weights[2],
+	                    weights[3],
+	                    weights[4],
+	                    weights[5],
+	                    weights[6],
+	                    weights[7],
+	                    weights[8],
+	                    weights[9],
+	                    weights[10] });
 	auto rootSig = VerticalBlurPSO->RootSignature;
 	auto cmdList = Queue->GetCommandList().Get();
 	rootSig->ActivateRootSignature(Queue->GetCommandList().Get());
-	rootSig->SetResource("cbSettings", Buffer->GetResource()->Resource->GetGPUVirtualAddress(), cmdList);
+	rootSig->SetResource("cbSettings", settings.GetGPUAddress(), cmdList);
 
-	ResourceBarrier(cmdList, Input, D3D12_RESOURCE_STATE_COPY_SOURCE);
-	ResourceBarrier(cmdList, &BlurMap0, D3D12_RESOURCE_STATE_COPY_DEST);
+	ResourceBarriers(cmdList, { { { Input, D3D12_RESOURCE_STATE_COPY_SOURCE }, { &BlurMap0, D3D12_RESOURCE_STATE_COPY_DEST } } });
 
 	cmdList->CopyResource(BlurMap0.Resource.Get(), Input->Resource.Get());
 
-	ResourceBarrier(cmdList, &BlurMap0, D3D12_RESOURCE_STATE_GENERIC_READ);
-	ResourceBarrier(cmdList, &BlurMap1, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	ResourceBarriers(cmdList, { { { &BlurMap0, D3D12_RESOURCE_STATE_GENERIC_READ }, { &BlurMap1, D3D12_RESOURCE_STATE_UNORDERED_ACCESS } } });
 
 	for (int i = 0; i < BlurCount; i++)
 	{
@@ -120,8 +121,7 @@ void OBlurFilter::Execute(
 		const UINT numGroupsX = (UINT)ceilf(Width / 256.0f);
 		Queue->GetCommandList().Get()->Dispatch(numGroupsX, Height, 1);
 
-		ResourceBarrier(Queue->GetCommandList().Get(), &BlurMap0, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-		ResourceBarrier(Queue->GetCommandList().Get(), &BlurMap1, D3D12_RESOURCE_STATE_GENERIC_READ);
+		ResourceBarriers(cmdList, { { { &BlurMap0, D3D12_RESOURCE_STATE_UNORDERED_ACCESS }, { &BlurMap1, D3D12_RESOURCE_STATE_GENERIC_READ } } });
 
 		// vertical BLur
 		Queue->GetCommandList().Get()->SetPipelineState(VerticalBlurPSO->PSO.Get());
@@ -134,8 +134,7 @@ void OBlurFilter::Execute(
 		UINT numGroupsY = (UINT)ceilf(Height / 256.0f);
 		cmdList->Dispatch(Width, numGroupsY, 1);
 
-		ResourceBarrier(cmdList, &BlurMap0, D3D12_RESOURCE_STATE_GENERIC_READ);
-		ResourceBarrier(cmdList, &BlurMap1, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		ResourceBarriers(cmdList, { { { &BlurMap0, D3D12_RESOURCE_STATE_GENERIC_READ }, { &BlurMap1, D3D12_RESOURCE_STATE_UNORDERED_ACCESS } } });
 	}
 }
 
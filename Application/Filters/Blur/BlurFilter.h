@@ -41,6 +41,11 @@ public:
 		return 4;
 	}
 
+	vector<SResourceInfo*> GetTransientResources() override
+	{
+		return { &BlurMap0, &BlurMap1 };
+	}
+
 	void SetParameters(float InSigma, uint32_t InBlurCount)
 	{
 		Sigma = InSigma;
@@ -64,7 +69,6 @@ private:
 
 	SResourceInfo BlurMap0;
 	SResourceInfo BlurMap1;
-	unique_ptr<OUploadBuffer<SConstantBlurSettings>> Buffer;
 
 	float Sigma = 2.5;
 	uint32_t BlurCount = 1;
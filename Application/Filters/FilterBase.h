@@ -23,6 +23,19 @@ public:
 	}
 
 	virtual void OnResize(UINT NewWidth, UINT NewHeight);
+
+	// Intermediate textures which are only used while the filter executes, the render graph may alias their memory
+	virtual vector<SResourceInfo*> GetTransientResources()
+	{
+		return {};
+	}
+
+	// Recreates the views once the transient resources were moved to other memory
+	void RebuildDescriptors() const
+	{
+		BuildDescriptors();
+	}
+
 	wstring GetName() override
 	{
 		return FilterName;
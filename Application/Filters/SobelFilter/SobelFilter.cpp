@@ -67,7 +67,9 @@ std::pair<bool, CD3DX12_GPU_DESCRIPTOR_HANDLE> OSobelFilter::Execute(SPSODescrip
 	root->SetResource("Input", Input, cmd);
 	root->SetResource("Output", UAVHandle.GPUHandle, cmd);
 
-	Utils::ResourceBarrier(cmd, &Output, D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	// The render graph usually transitions the output before the node runs
+	const SResourceTransition toUnorderedAccess{ &Output, D3D12_RESOURCE_STATE_UNORDERED_ACCESS };
+	Utils::ResourceBarriers(cmd, { &toUnorderedAccess, 1 });
 
 	UINT numGroupsX = (UINT)ceilf(Width / 16.0f);
 	UINT numGroupsY = (UINT)ceilf(Height / 16.0f);
@@ -14,6 +14,11 @@ public:
 		return 2;
 	}
 
+	vector<SResourceInfo*> GetTransientResources() override
+	{
+		return { &Output };
+	}
+
 	void BuildDescriptors() const override;
 	void BuildResource() override;
 
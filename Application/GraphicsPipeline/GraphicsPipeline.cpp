@@ -1,8 +1,10 @@
 #include "GraphicsPipeline.h"
 
 #include "Engine/Engine.h"
+#include "GraphicsPipelineManager/PipelineLibrary.h"
+#include "PipelineStateHash.h"
 
-void SPSOGraphicsDescription::BuildPipelineState(ID3D12Device* Device)
+void SPSOGraphicsDescription::BuildPipelineState(ID3D12Device* Device, OPipelineLibrary* Library)
 {
 	PSODesc.pRootSignature = RootSignature->RootSignatureParams.RootSignature.Get();
 	PSODesc.InputLayout = {
@@ -11,13 +13,26 @@ void SPSOGraphicsDescription::BuildPipelineState(ID3D12Device* Device)
 	};
 	RootSignature->Type = EPSOType::Graphics;
 
+	Hash = HashPipelineState(PSODesc, RootSignature->RootSignatureParams.RootSignatureHash);
+	if (Library)
+	{
+		PSO = Library->FindOrCreate(PSODesc, Hash);
+		return;
+	}
 	THROW_IF_FAILED(Device->CreateGraphicsPipelineState(&PSODesc, IID_PPV_ARGS(&PSO)));
 }
 
-void SPSOComputeDescription::BuildPipelineState(ID3D12Device* Device)
+void SPSOComputeDescription::BuildPipelineState(ID3D12Device* Device, OPipelineLibrary* Library)
 {
 	PSODesc.pRootSignature = RootSignature->RootSignatureParams.RootSignature.Get();
 	RootSignature->Type = EPSOType::Compute;
+
+	Hash = HashPipelineState(PSODesc, RootSignature->RootSignatureParams.RootSignatureHash);
+	if (Library)
+	{
+		PSO = Library->FindOrCreate(PSODesc, Hash);
+		return;
+	}
 	THROW_IF_FAILED(Device->CreateComputePipelineState(&PSODesc, IID_PPV_ARGS(&PSO)));
 }
 
@@ -43,11 +58,13 @@ vector<D3D12_ROOT_PARAMETER1>& SShaderPipelineDesc::BuildParameterArray()
 {
 	RootSignatureParams.RootParameters.clear();
 	RootSignatureParams.RootParameters.resize(RootSignatureParams.RootParamMap.size());
+	RootSignatureParams.RootParameterTypes.resize(RootSignatureParams.RootParamMap.size());
 
 	for (auto& param : RootSignatureParams.RootParamMap | std::views::values)
 	{
 		auto index = RootSignatureParams.RootParamIndexMap[param.Name];
 		RootSignatureParams.RootParameters[index] = param.RootParameter;
+		RootSignatureParams.RootParameterTypes[index] = param.Type;
 	}
 	return RootSignatureParams.RootParameters;
 }
@@ -94,71 +111,87 @@ ID3D12RootSignature* SShadersPipeline::GetRootSignature() const
 
 void SShaderPipelineDesc::SetResource(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList)
 {
-	switch (Type)
+	const auto idx = GetIndexFromName(Name);
+	if (idx == -1)
 	{
-	case EPSOType::Graphics:
-		SetGraphicsResourceCBView(Name, Handle, CmdList);
-		break;
-	case EPSOType::Compute:
-		SetComputeResourceCBView(Name, Handle, CmdList);
-		break;
+		return;
 	}
+	SetRootDescriptor(idx, Handle, CmdList);
 }
 
-void SShaderPipelineDesc::SetComputeResourceCBView(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList)
+void SShaderPipelineDesc::SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Handle, ID3D12GraphicsCommandList* CmdList)
 {
-	auto idx = GetIndexFromName(Name);
+	const auto idx = GetIndexFromName(Name);
 	if (idx == -1)
 	{
 		return;
 	}
-	auto& param = GetRootParameterFromName(Name);
-	switch (param.Type)
+	SetRootDescriptorTable(idx, Handle, CmdList);
+}
+
+void SShaderPipelineDesc::SetRootDescriptor(uint32_t Index, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList) const
+{
+	const bool bCompute = Type == EPSOType::Compute;
+	switch (RootSignatureParams.RootParameterTypes[Index])
 	{
 	case D3D12_ROOT_PARAMETER_TYPE_SRV:
+		if (bCompute)
+		{
+			CmdList->SetComputeRootShaderResourceView(Index, Handle);
+		}
+		else
+		{
+			CmdList->SetGraphicsRootShaderResourceView(Index, Handle);
+		}
+		break;
 	case D3D12_ROOT_PARAMETER_TYPE_UAV:
-	case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
-		CmdList->SetComputeRootShaderResourceView(idx, Handle);
+		if (bCompute)
+		{
+			CmdList->SetComputeRootUnorderedAccessView(Index, Handle);
+		}
+		else
+		{
+			CmdList->SetGraphicsRootUnorderedAccessView(Index, Handle);
+		}
+		break;
 	case D3D12_ROOT_PARAMETER_TYPE_CBV:
-		CmdList->SetComputeRootConstantBufferView(idx, Handle);
+		if (bCompute)
+		{
+			CmdList->SetComputeRootConstantBufferView(Index, Handle);
+		}
+		else
+		{
+			CmdList->SetGraphicsRootConstantBufferView(Index, Handle);
+		}
+		break;
+	default:
+		LOG(Render, Error, "Root parameter {} is not a root descriptor", Index);
 		break;
 	}
 }
 
-void SShaderPipelineDesc::SetGraphicsResourceCBView(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList)
+void SShaderPipelineDesc::SetRootDescriptorTable(uint32_t Index, D3D12_GPU_DESCRIPTOR_HANDLE Handle, ID3D12GraphicsCommandList* CmdList) const
 {
-	const auto idx = GetIndexFromName(Name);
-	if (idx == -1)
-	{
-		return;
-	}
-	auto& param = GetRootParameterFromName(Name);
-	switch (param.Type)
+	switch (Type)
 	{
-	case D3D12_ROOT_PARAMETER_TYPE_SRV:
-	case D3D12_ROOT_PARAMETER_TYPE_UAV:
-		CmdList->SetGraphicsRootShaderResourceView(idx, Handle);
+	case EPSOType::Graphics:
+		CmdList->SetGraphicsRootDescriptorTable(Index, Handle);
 		break;
-	case D3D12_ROOT_PARAMETER_TYPE_CBV:
-		CmdList->SetGraphicsRootConstantBufferView(idx, Handle);
+	case EPSOType::Compute:
+		CmdList->SetComputeRootDescriptorTable(Index, Handle);
 		break;
 	}
 }
 
-void SShaderPipelineDesc::SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Handle, ID3D12GraphicsCommandList* CmdList)
+void SShaderPipelineDesc::SetRootConstant(uint32_t Index, uint32_t Value, ID3D12GraphicsCommandList* CmdList) const
 {
-	const auto idx = GetIndexFromName(Name);
-	if (idx == -1)
-	{
-		return;
-	}
 	switch (Type)
 	{
 	case EPSOType::Graphics:
-		CmdList->SetGraphicsRootDescriptorTable(idx, Handle);
+		CmdList->SetGraphicsRoot32BitConstant(Index, Value, 0);
 		break;
 	case EPSOType::Compute:
-		CmdList->SetComputeRootDescriptorTable(idx, Handle);
+		CmdList->SetComputeRoot32BitConstant(Index, Value, 0);
 		break;
 	}
 }
@@ -176,6 +209,30 @@ void SShaderPipelineDesc::ActivateRootSignature(ID3D12GraphicsCommandList* CmdLi
 	}
 }
 
+void SShaderPipelineDesc::SetRootParamIndex(const wstring& Name, uint32_t Index)
+{
+	RootSignatureParams.RootParamIndexMap[Name] = Index;
+
+	const TShaderSlot slot = SShaderSlots::Intern(Name);
+	auto& slots = RootSignatureParams.SlotToRootIndex;
+	if (slot >= slots.size())
+	{
+		slots.resize(slot + 1, -1);
+	}
+	slots[slot] = static_cast<int32_t>(Index);
+}
+
+uint32_t SShaderPipelineDesc::GetNumRootParameters() const
+{
+	return static_cast<uint32_t>(RootSignatureParams.RootParameterTypes.size());
+}
+
+int32_t SShaderPipelineDesc::GetRootIndex(TShaderSlot Slot) const
+{
+	const auto& slots = RootSignatureParams.SlotToRootIndex;
+	return Slot < slots.size() ? slots[Slot] : -1;
+}
+
 unordered_map<wstring, uint32_t>& SShaderPipelineDesc::GetRootParamIndexMap()
 {
 	return RootSignatureParams.RootParamIndexMap;
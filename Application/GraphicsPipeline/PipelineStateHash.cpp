@@ -0,0 +1,305 @@
+#include "PipelineStateHash.h"
+
+#include "HashUtils.h"
+
+#include <string_view>
+#include <tuple>
+
+namespace
+{
+// Keeps a compute and a graphics description with the same fields apart
+constexpr uint32_t GraphicsPipelineTag = 0;
+constexpr uint32_t ComputePipelineTag = 1;
+
+// Every hashed or compared field of a struct, pointers are left out and followed by the callers
+auto Fields(const D3D12_DESCRIPTOR_RANGE1& Range)
+{
+	return std::tie(Range.RangeType, Range.NumDescriptors, Range.BaseShaderRegister, Range.RegisterSpace, Range.Flags, Range.OffsetInDescriptorsFromTableStart);
+}
+
+auto Fields(const D3D12_STATIC_SAMPLER_DESC& Sampler)
+{
+	return std::tie(Sampler.Filter,
+	                Sampler.AddressU,
+	                Sampler.AddressV,
+	                Sampler.AddressW,
+	                Sampler.MipLODBias,
+	                Sampler.MaxAnisotropy,
+	                Sampler.ComparisonFunc,
+	                Sampler.BorderColor,
+	                Sampler.MinLOD,
+	                Sampler.MaxLOD,
+	                Sampler.ShaderRegister,
+	                Sampler.RegisterSpace,
+	                Sampler.ShaderVisibility);
+}
+
+// Descriptor table ranges are compared through SRootSignatureLayout::Ranges
+auto Fields(const D3D12_ROOT_PARAMETER1& Parameter)
+{
+	static constexpr D3D12_ROOT_CONSTANTS noConstants{};
+	static constexpr D3D12_ROOT_DESCRIPTOR1 noDescriptor{};
+	const auto& constants = Parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS ? Parameter.Constants : noConstants;
+	const bool bDescriptor = Parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_CBV
+	                         || Parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_SRV
+	                         || Parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_UAV;
+	const auto& descriptor = bDescriptor ? Parameter.Descriptor : noDescriptor;
+	return std::tie(Parameter.ParameterType,
+	                Parameter.ShaderVisibility,
+	                constants.ShaderRegister,
+	                constants.RegisterSpace,
+	                constants.Num32BitValues,
+	                descriptor.ShaderRegister,
+	                descriptor.RegisterSpace,
+	                descriptor.Flags);
+}
+
+auto Fields(const D3D12_RENDER_TARGET_BLEND_DESC& Blend)
+{
+	return std::tie(Blend.BlendEnable,
+	                Blend.LogicOpEnable,
+	                Blend.SrcBlend,
+	                Blend.DestBlend,
+	                Blend.BlendOp,
+	                Blend.SrcBlendAlpha,
+	                Blend.DestBlendAlpha,
+	                Blend.BlendOpAlpha,
+	                Blend.LogicOp,
+	                Blend.RenderTargetWriteMask);
+}
+
+auto Fields(const D3D12_RASTERIZER_DESC& Rasterizer)
+{
+	return std::tie(Rasterizer.FillMode,
+	                Rasterizer.CullMode,
+	                Rasterizer.FrontCounterClockwise,
+	                Rasterizer.DepthBias,
+	                Rasterizer.DepthBiasClamp,
+	                Rasterizer.SlopeScaledDepthBias,
+	                Rasterizer.DepthClipEnable,
+	                Rasterizer.MultisampleEnable,
+	                Rasterizer.AntialiasedLineEnable,
+	                Rasterizer.ForcedSampleCount,
+	                Rasterizer.ConservativeRaster);
+}
+
+auto Fields(const D3D12_DEPTH_STENCILOP_DESC& Op)
+{
+	return std::tie(Op.StencilFailOp, Op.StencilDepthFailOp, Op.StencilPassOp, Op.StencilFunc);
+}
+
+auto Fields(const D3D12_DEPTH_STENCIL_DESC& DepthStencil)
+{
+	return std::tie(DepthStencil.DepthEnable, DepthStencil.DepthWriteMask, DepthStencil.DepthFunc, DepthStencil.StencilEnable, DepthStencil.StencilReadMask, DepthStencil.StencilWriteMask);
+}
+
+auto Fields(const D3D12_INPUT_ELEMENT_DESC& Element)
+{
+	return std::tie(Element.SemanticIndex, Element.Format, Element.InputSlot, Element.AlignedByteOffset, Element.InputSlotClass, Element.InstanceDataStepRate);
+}
+
+auto Fields(const D3D12_SO_DECLARATION_ENTRY& Entry)
+{
+	return std::tie(Entry.Stream, Entry.SemanticIndex, Entry.StartComponent, Entry.ComponentCount, Entry.OutputSlot);
+}
+
+template<typename T>
+bool FieldsEqual(const T& Lhs, const T& Rhs)
+{
+	return Fields(Lhs) == Fields(Rhs);
+}
+
+template<typename T>
+bool FieldsEqual(const vector<T>& Lhs, const vector<T>& Rhs)
+{
+	return std::ranges::equal(Lhs, Rhs, [](const T& A, const T& B) { return FieldsEqual(A, B); });
+}
+
+template<typename T>
+void AddFields(Utils::SHasher& Hasher, const T& Value)
+{
+	std::apply([&Hasher](const auto&... Field) { (Hasher.Add(Field), ...); }, Fields(Value));
+}
+
+void AddString(Utils::SHasher& Hasher, const char* String)
+{
+	Hasher.Add(std::string_view(String ? String : ""));
+}
+
+void AddByteCode(Utils::SHasher& Hasher, const D3D12_SHADER_BYTECODE& ByteCode)
+{
+	const size_t size = ByteCode.pShaderBytecode ? ByteCode.BytecodeLength : 0;
+	Hasher.Add(static_cast<uint64_t>(size));
+	Hasher.AddBytes(ByteCode.pShaderBytecode, size);
+}
+
+D3D12_ROOT_PARAMETER1 ToParameter1(const D3D12_ROOT_PARAMETER& Parameter, vector<D3D12_DESCRIPTOR_RANGE1>& OutRanges)
+{
+	// Version 1.0 semantics expressed in 1.1 flags, the same conversion the runtime applies
+	D3D12_ROOT_PARAMETER1 result{};
+	result.ParameterType = Parameter.ParameterType;
+	result.ShaderVisibility = Parameter.ShaderVisibility;
+	switch (Parameter.ParameterType)
+	{
+	case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+		for (uint32_t i = 0; i < Parameter.DescriptorTable.NumDescriptorRanges; i++)
+		{
+			const auto& range = Parameter.DescriptorTable.pDescriptorRanges[i];
+			const auto flags = range.RangeType == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER
+			                       ? D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE
+			                       : D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE | D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+			OutRanges.push_back({ range.RangeType, range.NumDescriptors, range.BaseShaderRegister, range.RegisterSpace, flags, range.OffsetInDescriptorsFromTableStart });
+		}
+		result.DescriptorTable.NumDescriptorRanges = Parameter.DescriptorTable.NumDescriptorRanges;
+		break;
+	case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+		result.Constants = Parameter.Constants;
+		break;
+	default:
+		result.Descriptor = { Parameter.Descriptor.ShaderRegister, Parameter.Descriptor.RegisterSpace, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE };
+		break;
+	}
+	return result;
+}
+} // namespace
+
+SRootSignatureLayout::SRootSignatureLayout(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc)
+{
+	if (Desc.Version == D3D_ROOT_SIGNATURE_VERSION_1_0)
+	{
+		const auto& desc = Desc.Desc_1_0;
+		for (uint32_t i = 0; i < desc.NumParameters; i++)
+		{
+			auto& ranges = Ranges.emplace_back();
+			Parameters.push_back(ToParameter1(desc.pParameters[i], ranges));
+		}
+		StaticSamplers.assign(desc.pStaticSamplers, desc.pStaticSamplers + desc.NumStaticSamplers);
+		Flags = desc.Flags;
+	}
+	else
+	{
+		const auto& desc = Desc.Desc_1_1;
+		for (uint32_t i = 0; i < desc.NumParameters; i++)
+		{
+			const auto& parameter = Parameters.emplace_back(desc.pParameters[i]);
+			auto& ranges = Ranges.emplace_back();
+			if (parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
+			{
+				const auto& table = parameter.DescriptorTable;
+				ranges.assign(table.pDescriptorRanges, table.pDescriptorRanges + table.NumDescriptorRanges);
+			}
+		}
+		StaticSamplers.assign(desc.pStaticSamplers, desc.pStaticSamplers + desc.NumStaticSamplers);
+		Flags = desc.Flags;
+	}
+
+	// The copies would point into the source description, which the layout must not outlive
+	for (auto& parameter : Parameters)
+	{
+		if (parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
+		{
+			parameter.DescriptorTable.pDescriptorRanges = nullptr;
+		}
+	}
+}
+
+bool SRootSignatureLayout::operator==(const SRootSignatureLayout& Other) const
+{
+	return Flags == Other.Flags
+	       && FieldsEqual(Parameters, Other.Parameters)
+	       && std::ranges::equal(Ranges, Other.Ranges, [](const auto& A, const auto& B) { return FieldsEqual(A, B); })
+	       && FieldsEqual(StaticSamplers, Other.StaticSamplers);
+}
+
+uint64_t HashRootSignature(const SRootSignatureLayout& Layout)
+{
+	Utils::SHasher hasher;
+	hasher.Add(Layout.Flags);
+	hasher.Add(static_cast<uint64_t>(Layout.Parameters.size()));
+	for (size_t i = 0; i < Layout.Parameters.size(); i++)
+	{
+		AddFields(hasher, Layout.Parameters[i]);
+		hasher.Add(static_cast<uint64_t>(Layout.Ranges[i].size()));
+		for (const auto& range : Layout.Ranges[i])
+		{
+			AddFields(hasher, range);
+		}
+	}
+	hasher.Add(static_cast<uint64_t>(Layout.StaticSamplers.size()));
+	for (const auto& sampler : Layout.StaticSamplers)
+	{
+		AddFields(hasher, sampler);
+	}
+	return hasher.Value;
+}
+
+uint64_t HashRootSignature(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc)
+{
+	return HashRootSignature(SRootSignatureLayout(Desc));
+}
+
+uint64_t HashPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64_t RootSignatureHash)
+{
+	Utils::SHasher hasher;
+	hasher.Add(GraphicsPipelineTag);
+	hasher.Add(RootSignatureHash);
+	for (const auto& byteCode : { Desc.VS, Desc.PS, Desc.DS, Desc.HS, Desc.GS })
+	{
+		AddByteCode(hasher, byteCode);
+	}
+
+	const auto& streamOutput = Desc.StreamOutput;
+	hasher.Add(streamOutput.NumEntries);
+	for (uint32_t i = 0; i < streamOutput.NumEntries; i++)
+	{
+		AddString(hasher, streamOutput.pSODeclaration[i].SemanticName);
+		AddFields(hasher, streamOutput.pSODeclaration[i]);
+	}
+	hasher.Add(streamOutput.NumStrides);
+	hasher.AddBytes(streamOutput.pBufferStrides, streamOutput.pBufferStrides ? streamOutput.NumStrides * sizeof(UINT) : 0);
+	hasher.Add(streamOutput.RasterizedStream);
+
+	hasher.Add(Desc.BlendState.AlphaToCoverageEnable);
+	hasher.Add(Desc.BlendState.IndependentBlendEnable);
+	for (const auto& target : Desc.BlendState.RenderTarget)
+	{
+		AddFields(hasher, target);
+	}
+	hasher.Add(Desc.SampleMask);
+	AddFields(hasher, Desc.RasterizerState);
+	AddFields(hasher, Desc.DepthStencilState);
+	AddFields(hasher, Desc.DepthStencilState.FrontFace);
+	AddFields(hasher, Desc.DepthStencilState.BackFace);
+
+	hasher.Add(Desc.InputLayout.NumElements);
+	for (uint32_t i = 0; i < Desc.InputLayout.NumElements; i++)
+	{
+		AddString(hasher, Desc.InputLayout.pInputElementDescs[i].SemanticName);
+		AddFields(hasher, Desc.InputLayout.pInputElementDescs[i]);
+	}
+
+	hasher.Add(Desc.IBStripCutValue);
+	hasher.Add(Desc.PrimitiveTopologyType);
+	hasher.Add(Desc.NumRenderTargets);
+	for (uint32_t i = 0; i < std::min<uint32_t>(Desc.NumRenderTargets, D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT); i++)
+	{
+		hasher.Add(Desc.RTVFormats[i]);
+	}
+	hasher.Add(Desc.DSVFormat);
+	hasher.Add(Desc.SampleDesc.Count);
+	hasher.Add(Desc.SampleDesc.Quality);
+	hasher.Add(Desc.NodeMask);
+	hasher.Add(Desc.Flags);
+	return hasher.Value;
+}
+
+uint64_t HashPipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64_t RootSignatureHash)
+{
+	Utils::SHasher hasher;
+	hasher.Add(ComputePipelineTag);
+	hasher.Add(RootSignatureHash);
+	AddByteCode(hasher, Desc.CS);
+	hasher.Add(Desc.NodeMask);
+	hasher.Add(Desc.Flags);
+	return hasher.Value;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "DirectX/DXHelper.h"
+#include "Types.h"
+
+/**
+ * @brief Owning copy of a root signature description, normalized to version 1.1. The D3D12 description only points at its
+ * parameters, ranges and samplers, the layout keeps them alive so it can be compared and hashed after the source is gone.
+ */
+struct SRootSignatureLayout
+{
+	SRootSignatureLayout() = default;
+	explicit SRootSignatureLayout(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc);
+
+	vector<D3D12_ROOT_PARAMETER1> Parameters;
+
+	// Ranges of the descriptor table parameters, empty for every other parameter
+	vector<vector<D3D12_DESCRIPTOR_RANGE1>> Ranges;
+	vector<D3D12_STATIC_SAMPLER_DESC> StaticSamplers;
+	D3D12_ROOT_SIGNATURE_FLAGS Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+	// Compares every field by value, pointers inside the parameters are followed instead of compared
+	bool operator==(const SRootSignatureLayout& Other) const;
+};
+
+// Structural hashes, stable between runs so they may name entries persisted on disk. Fields are hashed one by one, padding never leaks in.
+uint64_t HashRootSignature(const SRootSignatureLayout& Layout);
+uint64_t HashRootSignature(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc);
+
+// The root signature is referenced by pointer, pass the structural hash of its layout instead. Shader byte code is hashed by content.
+uint64_t HashPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64_t RootSignatureHash);
+uint64_t HashPipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64_t RootSignatureHash);
+
+inline bool operator==(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Lhs, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Rhs)
+{
+	return SRootSignatureLayout(Lhs) == SRootSignatureLayout(Rhs);
+}
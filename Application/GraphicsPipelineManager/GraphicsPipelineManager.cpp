@@ -2,11 +2,64 @@
 #include "GraphicsPipelineManager.h"
 
 #include "Application.h"
+#include "Exception.h"
+#include "Stats/Stats.h"
+#include "Threading/ThreadPool.h"
+
+#include <chrono>
+#include <ranges>
+#include <thread>
+
+bool SPSOHandle::IsReady() const
+{
+	if (Description == nullptr)
+	{
+		return false;
+	}
+	return !Build.valid() || (Build.wait_for(std::chrono::seconds(0)) == std::future_status::ready && Build.get());
+}
+
+bool SPSOHandle::HasFailed() const
+{
+	if (Description == nullptr)
+	{
+		return true;
+	}
+	return Build.valid() && Build.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !Build.get();
+}
+
+SPSODescriptionBase* SPSOHandle::Get() const
+{
+	return IsReady() ? Description : nullptr;
+}
+
+OGraphicsPipelineManager::~OGraphicsPipelineManager()
+{
+	if (PendingPSOBuilds.valid())
+	{
+		PendingPSOBuilds.wait();
+	}
+	if (PendingReload.valid())
+	{
+		PendingReload.wait();
+	}
+
+	// Destroying a pending permutation waits for its job
+	Permutations.clear();
+	if (PipelineLibrary)
+	{
+		PipelineLibrary->Save(true);
+	}
+}
 
 void OGraphicsPipelineManager::LoadPipelines()
 {
+	PipelineLibrary = make_unique<OPipelineLibrary>(OApplication::Get()->GetConfigPath("PipelineLibraryPath"));
+	PipelineLibrary->Load(OEngine::Get()->GetDevice().Get());
+
 	PSOReader = make_unique<OPSOReader>(OApplication::Get()->GetConfigPath("PSOConfigPath"));
 	auto psos = PSOReader->LoadPSOs();
+	vector<pair<SPSODescriptionBase*, std::promise<bool>>> builds;
 	for (auto& pso : psos)
 	{
 		LOG(Render, Log, "Loading PSO: {}", TEXT(pso->Name));
@@ -16,38 +69,80 @@ void OGraphicsPipelineManager::LoadPipelines()
 			continue;
 		}
 
-		if (auto vertex = FindShader(pso->ShaderPipeline.VertexShaderName, EShaderLevel::VertexShader))
-		{
-			pso->SetVertexByteCode(vertex->GetShaderByteCode());
-		}
-		if (auto pixel = FindShader(pso->ShaderPipeline.PixelShaderName, EShaderLevel::PixelShader))
-		{
-			pso->SetPixelByteCode(pixel->GetShaderByteCode());
-		}
-		if (auto geometry = FindShader(pso->ShaderPipeline.GeometryShaderName, EShaderLevel::GeometryShader))
-		{
-			pso->SetGeometryByteCode(geometry->GetShaderByteCode());
-		}
-		if (auto hull = FindShader(pso->ShaderPipeline.HullShaderName, EShaderLevel::HullShader))
-		{
-			pso->SetHullByteCode(hull->GetShaderByteCode());
-		}
-		if (auto domain = FindShader(pso->ShaderPipeline.DomainShaderName, EShaderLevel::DomainShader))
+		SetShaderByteCodes(*pso, [this](const string& PipelineName, EShaderLevel ShaderType) { return FindShader(PipelineName, ShaderType); });
+		pso->RootSignature = FindRootSignatureForPipeline(pso->RootSignatureName);
+		if(pso->RootSignature != nullptr)
 		{
-			pso->SetDomainByteCode(domain->GetShaderByteCode());
+			auto& build = builds.emplace_back(pso.get(), std::promise<bool>());
+			PSOBuilds[pso->Name] = build.second.get_future().share();
+			GlobalPSOMap[pso->Name] = std::move(pso);
 		}
-		if (auto compute = FindShader(pso->ShaderPipeline.ComputeShaderName, EShaderLevel::ComputeShader))
+
+	}
+
+	// The shaders are compiled at this point, only the driver work is left. Render graph nodes skip their passes until their PSOs are ready.
+	NumPendingPSOs = static_cast<uint32_t>(builds.size());
+	PendingPSOBuilds = std::async(std::launch::async, [this, builds = std::move(builds)]() mutable {
+		BuildPipelineStates(std::move(builds));
+	});
+}
+
+void OGraphicsPipelineManager::BuildPipelineStates(vector<pair<SPSODescriptionBase*, std::promise<bool>>> Builds)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto device = OEngine::Get()->GetDevice();
+	OThreadPool pool(GetNumCompileThreads() - 1);
+	pool.ParallelFor(Builds.size(), [&](size_t Index) {
+		auto& [pso, promise] = Builds[Index];
+		bool bBuilt = true;
+		try
 		{
-			pso->SetComputeByteCode(compute->GetShaderByteCode());
+			pso->BuildPipelineState(device.Get(), PipelineLibrary.get());
 		}
-		pso->RootSignature = FindRootSignatureForPipeline(pso->RootSignatureName);
-		if(pso->RootSignature != nullptr)
+		catch (const SDXException& exception)
 		{
-			pso->BuildPipelineState(OEngine::Get()->GetDevice().Get());
-			GlobalPSOMap[pso->Name] = std::move(pso);
+			LOG(Render, Error, "Building PSO {} failed, passes using it stay disabled: {}", TEXT(pso->Name), exception.ToString());
+			bBuilt = false;
 		}
+		promise.set_value(bBuilt);
+		NumPendingPSOs--;
+	});
+	AllPSOsReadyTime = std::chrono::steady_clock::now() - OEngine::Get()->GetStartTime();
+
+	const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	auto& rootSignatures = OEngine::Get()->GetShaderCompiler()->GetRootSignatureCache();
+	LOG(Render, Log, "Built {} PSOs in {:.1f} ms: {} loaded from the pipeline library, {} compiled, {} shared", Builds.size(), elapsed, PipelineLibrary->GetNumLoaded(), PipelineLibrary->GetNumCreated(), PipelineLibrary->GetNumShared());
+	LOG(Render, Log, "{} root signatures, {} pipelines reuse an identical one", rootSignatures.GetNumRootSignatures(), rootSignatures.GetNumShared());
+	PipelineLibrary->Save(false);
+}
+
+void OGraphicsPipelineManager::UpdatePipelineBuilds()
+{
+	if (!PendingPSOBuilds.valid())
+	{
+		return;
+	}
 
+	if (PendingPSOBuilds.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		NumFramesBeforeReady++;
+		return;
 	}
+	PendingPSOBuilds.get();
+	LOG(Render, Log, "Startup: all {} PSOs ready {:.1f} ms after start, {} frames were rendered before",
+	    PSOBuilds.size(),
+	    std::chrono::duration<double, std::milli>(AllPSOsReadyTime).count(),
+	    NumFramesBeforeReady);
+}
+
+uint32_t OGraphicsPipelineManager::GetPSOGeneration() const
+{
+	return PSOGeneration;
+}
+
+uint32_t OGraphicsPipelineManager::GetNumPendingPSOs() const
+{
+	return NumPendingPSOs;
 }
 
 OShader* OGraphicsPipelineManager::FindShader(const string& PipelineName, EShaderLevel ShaderType)
@@ -65,20 +160,56 @@ OShader* OGraphicsPipelineManager::FindShader(const string& PipelineName, EShade
 	return GlobalShaderMap[PipelineName][ShaderType].get();
 }
 
+void OGraphicsPipelineManager::SetShaderByteCodes(SPSODescriptionBase& PSO, const TShaderLookup& FindShader)
+{
+	if (auto vertex = FindShader(PSO.ShaderPipeline.VertexShaderName, EShaderLevel::VertexShader))
+	{
+		PSO.SetVertexByteCode(vertex->GetShaderByteCode());
+	}
+	if (auto pixel = FindShader(PSO.ShaderPipeline.PixelShaderName, EShaderLevel::PixelShader))
+	{
+		PSO.SetPixelByteCode(pixel->GetShaderByteCode());
+	}
+	if (auto geometry = FindShader(PSO.ShaderPipeline.GeometryShaderName, EShaderLevel::GeometryShader))
+	{
+		PSO.SetGeometryByteCode(geometry->GetShaderByteCode());
+	}
+	if (auto hull = FindShader(PSO.ShaderPipeline.HullShaderName, EShaderLevel::HullShader))
+	{
+		PSO.SetHullByteCode(hull->GetShaderByteCode());
+	}
+	if (auto domain = FindShader(PSO.ShaderPipeline.DomainShaderName, EShaderLevel::DomainShader))
+	{
+		PSO.SetDomainByteCode(domain->GetShaderByteCode());
+	}
+	if (auto compute = FindShader(PSO.ShaderPipeline.ComputeShaderName, EShaderLevel::ComputeShader))
+	{
+		PSO.SetComputeByteCode(compute->GetShaderByteCode());
+	}
+}
+
 void OGraphicsPipelineManager::Init()
 {
 	LoadShaders();
 	LoadPipelines();
+
+	if (bShaderHotReload)
+	{
+		ShaderWatcher = make_unique<OFileWatcher>(OApplication::Get()->GetShadersFolder(), vector<string>{ ".hlsl", ".hlsli" });
+		ShaderWatcher->Poll();
+		LOG(Render, Log, "Watching {} shader files for changes", ShaderDependencies.GetNumFiles());
+	}
 }
 
-SPSODescriptionBase* OGraphicsPipelineManager::FindPSO(const string& PipelineName)
+SPSOHandle OGraphicsPipelineManager::FindPSO(const string& PipelineName)
 {
-	if (GlobalPSOMap.contains(PipelineName))
+	if (const auto it = GlobalPSOMap.find(PipelineName); it != GlobalPSOMap.end())
 	{
-		return GlobalPSOMap[PipelineName].get();
+		const auto build = PSOBuilds.find(PipelineName);
+		return { it->second.get(), build != PSOBuilds.end() ? build->second : std::shared_future<bool>() };
 	}
 	LOG(Render, Warning, "Pipeline not found: {}", TEXT(PipelineName));
-	return nullptr;
+	return {};
 }
 
 SShadersPipeline* OGraphicsPipelineManager::FindShadersPipeline(const string& PipelineName)
@@ -91,23 +222,442 @@ SShadersPipeline* OGraphicsPipelineManager::FindShadersPipeline(const string& Pi
 	return nullptr;
 }
 
-void OGraphicsPipelineManager::LoadShaders()
+vector<SShaderPipelineCompilation> OGraphicsPipelineManager::ReadShaderPipelines()
 {
 	ShaderReader = make_unique<OShaderReader>(OApplication::Get()->GetConfigPath("ShadersConfigPath"));
-	auto pipelines = ShaderReader->LoadShaders();
-	for (auto& pipeline : pipelines)
+	vector<SShaderPipelineCompilation> compilations;
+	for (auto& [name, stages] : ShaderReader->LoadShaders())
+	{
+		compilations.push_back({ .Name = name, .Stages = std::move(stages) });
+	}
+
+	// The reader hands out an unordered map, sorting keeps compilation and logs the same between runs
+	std::ranges::sort(compilations, {}, &SShaderPipelineCompilation::Name);
+	return compilations;
+}
+
+uint32_t OGraphicsPipelineManager::GetNumCompileThreads()
+{
+	return OShaderCompiler::NumThreads != 0 ? OShaderCompiler::NumThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void OGraphicsPipelineManager::LoadShaders()
+{
+	auto compilations = ReadShaderPipelines();
+	PermutationSpaces = ShaderReader->LoadPermutations();
+	for (const auto& [name, space] : PermutationSpaces)
+	{
+		LOG(Render, Log, "Shader pipeline {} has {} permutations in a {} bit key", TEXT(name), space.GetNumPermutations(), space.GetNumBits());
+	}
+	const uint32_t threads = GetNumCompileThreads();
+	const auto start = std::chrono::steady_clock::now();
+	OEngine::Get()->GetShaderCompiler()->CompilePipelines(compilations, threads);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	LOG(Render, Log, "Compiled {} shader pipelines on {} threads in {} ms", compilations.size(), threads, elapsed.count());
+
+	for (auto& compilation : compilations)
+	{
+		SShadersPipeline shadersPipeline;
+		shadersPipeline.BuildFromStages(compilation.Stages);
+		shadersPipeline.PipelineInfo = compilation.PipelineInfo;
+
+		GlobalShaderPipelineMap[compilation.Name] = shadersPipeline;
+		RootSignatures[compilation.Name] = compilation.PipelineInfo;
+		PutShaderContainer(compilation.Name, compilation.Shaders);
+		RecordDependencies(compilation);
+		ShaderStages[compilation.Name] = std::move(compilation.Stages);
+	}
+}
+
+void OGraphicsPipelineManager::RecordDependencies(const SShaderPipelineCompilation& Compilation)
+{
+	for (size_t i = 0; i < Compilation.Dependencies.size(); i++)
+	{
+		ShaderDependencies.SetDependencies({ Compilation.Name, static_cast<uint32_t>(i) }, Compilation.Dependencies[i]);
+	}
+}
+
+void OGraphicsPipelineManager::UpdateShaderHotReload()
+{
+	// A reload clones the live PSOs, they have to be built first
+	if (!ShaderWatcher || PendingPSOBuilds.valid())
+	{
+		return;
+	}
+
+	if (PendingReload.valid())
+	{
+		if (PendingReload.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return;
+		}
+		auto reload = PendingReload.get();
+		ApplyShaderReload(reload);
+	}
+
+	// Changes made while a reload was running are picked up by the next poll, the watcher compares against its last snapshot
+	constexpr auto pollInterval = std::chrono::milliseconds(500);
+	const auto now = std::chrono::steady_clock::now();
+	if (now - LastShaderPoll < pollInterval)
+	{
+		return;
+	}
+	LastShaderPoll = now;
+
+	const auto changed = ShaderWatcher->Poll();
+	const auto pipelines = ShaderDependencies.GetAffectedPipelines(changed);
+	if (pipelines.empty())
+	{
+		return;
+	}
+
+	vector<SShaderPipelineCompilation> compilations;
+	for (const auto& name : pipelines)
+	{
+		compilations.push_back({ .Name = name, .Stages = ShaderStages[name] });
+	}
+	LOG(Render, Log, "{} shader files changed, reloading {} pipelines", changed.size(), compilations.size());
+	PendingReload = std::async(std::launch::async, [this, compilations = std::move(compilations)]() mutable {
+		return BuildShaderReload(std::move(compilations));
+	});
+}
+
+bool OGraphicsPipelineManager::ReloadPSOConfig()
+{
+	// Both swap live PSOs, their rebuilt state would be overwritten
+	if (PendingPSOBuilds.valid() || PendingReload.valid())
+	{
+		return false;
+	}
+
+	const auto diff = PSOReader->ReloadList("PipelineStateObjects", "Name");
+	if (!diff || diff->IsEmpty())
+	{
+		return true;
+	}
+
+	unordered_set<string> names(diff->Changed.begin(), diff->Changed.end());
+	names.insert(diff->Added.begin(), diff->Added.end());
+
+	// Built before anything is swapped, a PSO failing to build keeps its previous state
+	const auto device = OEngine::Get()->GetDevice();
+	vector<pair<SPSODescriptionBase*, unique_ptr<SPSODescriptionBase>>> rebuilt;
+	for (auto& pso : PSOReader->LoadPSOs())
+	{
+		if (!names.contains(pso->Name))
+		{
+			continue;
+		}
+
+		const auto live = GlobalPSOMap.find(pso->Name);
+		if (live != GlobalPSOMap.end() && live->second->Type != pso->Type)
+		{
+			LOG(Render, Warning, "PSO {} changed its type, restart to apply it", TEXT(pso->Name));
+			continue;
+		}
+
+		SetShaderByteCodes(*pso, [this](const string& PipelineName, EShaderLevel ShaderType) { return FindShader(PipelineName, ShaderType); });
+		pso->RootSignature = FindRootSignatureForPipeline(pso->RootSignatureName);
+		if (pso->RootSignature == nullptr)
+		{
+			LOG(Render, Error, "Root signature not found for PSO: {}", TEXT(pso->Name));
+			continue;
+		}
+
+		try
+		{
+			pso->BuildPipelineState(device.Get(), PipelineLibrary.get());
+		}
+		catch (const SDXException& exception)
+		{
+			LOG(Render, Error, "Rebuilding PSO {} failed, keeping the previous one: {}", TEXT(pso->Name), exception.ToString());
+			continue;
+		}
+		rebuilt.emplace_back(live != GlobalPSOMap.end() ? live->second.get() : nullptr, std::move(pso));
+	}
+
+	for (const auto& name : diff->Removed)
+	{
+		LOG(Render, Warning, "PSO {} was removed from the config, it stays alive until the next start", TEXT(name));
+	}
+	if (rebuilt.empty())
+	{
+		return true;
+	}
+
+	// Frames in flight may still reference the old pipeline states
+	OEngine::Get()->FlushGPU();
+	for (auto& [live, pso] : rebuilt)
+	{
+		PSOBuilds.erase(pso->Name);
+		if (live == nullptr)
+		{
+			GlobalPSOMap[pso->Name] = std::move(pso);
+			continue;
+		}
+
+		// Permutations were built from the previous description, they compile again on their next use
+		std::erase_if(Permutations, [live](const auto& Entry) { return Entry.first.first == live; });
+		live->CopyFrom(*pso);
+	}
+	PSOGeneration++;
+	LOG(Render, Log, "Reloaded the PSO config: {} PSOs rebuilt or added", rebuilt.size());
+	return true;
+}
+
+OShader* OGraphicsPipelineManager::FindCompiledShader(const vector<SShaderPipelineCompilation>& Pipelines, const string& PipelineName, EShaderLevel ShaderType)
+{
+	for (const auto& pipeline : Pipelines)
+	{
+		if (pipeline.Name != PipelineName)
+		{
+			continue;
+		}
+		for (const auto& shader : pipeline.Shaders)
+		{
+			if (shader->GetShaderType() == ShaderType)
+			{
+				return shader.get();
+			}
+		}
+	}
+	return nullptr;
+}
+
+unique_ptr<SPSODescriptionBase> OGraphicsPipelineManager::RebuildPSO(const SPSODescriptionBase& Source, const vector<SShaderPipelineCompilation>& Pipelines, OPipelineLibrary* Library)
+{
+	auto rebuilt = Source.Clone();
+	SetShaderByteCodes(*rebuilt, [&Pipelines](const string& PipelineName, EShaderLevel ShaderType) {
+		return FindCompiledShader(Pipelines, PipelineName, ShaderType);
+	});
+	for (const auto& pipeline : Pipelines)
+	{
+		if (pipeline.Name == Source.RootSignatureName)
+		{
+			rebuilt->RootSignature = pipeline.PipelineInfo;
+		}
+	}
+
+	try
+	{
+		rebuilt->BuildPipelineState(OEngine::Get()->GetDevice().Get(), Library);
+	}
+	catch (const SDXException& exception)
+	{
+		LOG(Render, Error, "Building PSO {} failed: {}", TEXT(rebuilt->Name), exception.ToString());
+		return nullptr;
+	}
+	return rebuilt;
+}
+
+OGraphicsPipelineManager::SShaderReload OGraphicsPipelineManager::BuildShaderReload(vector<SShaderPipelineCompilation> Pipelines)
+{
+	// Unchanged stages of a pipeline hit the shader cache, only the stages depending on the changed files run through DXC
+	SShaderReload reload;
+	OEngine::Get()->GetShaderCompiler()->CompilePipelines(Pipelines, GetNumCompileThreads());
+	reload.Pipelines = std::move(Pipelines);
+
+	unordered_set<string> reloaded;
+	for (const auto& pipeline : reload.Pipelines)
+	{
+		if (pipeline.Shaders.size() != pipeline.Stages.size())
+		{
+			LOG(Render, Error, "Shader reload of {} failed, keeping the previous shaders", TEXT(pipeline.Name));
+			return reload;
+		}
+		reloaded.insert(pipeline.Name);
+	}
+
+	for (const auto& pso : GlobalPSOMap | std::views::values)
+	{
+		const auto& names = pso->ShaderPipeline;
+		const bool bAffected = std::ranges::any_of(array{ &names.VertexShaderName, &names.PixelShaderName, &names.GeometryShaderName, &names.HullShaderName, &names.DomainShaderName, &names.ComputeShaderName, &pso->RootSignatureName },
+		                                           [&reloaded](const string* Name) { return reloaded.contains(*Name); });
+		if (!bAffected)
+		{
+			continue;
+		}
+
+		auto rebuilt = RebuildPSO(*pso, reload.Pipelines, PipelineLibrary.get());
+		if (!rebuilt)
+		{
+			LOG(Render, Error, "Keeping the previous shaders of {}", TEXT(pso->Name));
+			return reload;
+		}
+		reload.PSOs.emplace_back(pso.get(), std::move(rebuilt));
+	}
+
+	reload.bSucceeded = true;
+	return reload;
+}
+
+void OGraphicsPipelineManager::ApplyShaderReload(SShaderReload& Reload)
+{
+	// A failed compile still reports the files it read, fixing a broken include has to trigger the next reload
+	for (const auto& pipeline : Reload.Pipelines)
+	{
+		RecordDependencies(pipeline);
+	}
+	if (!Reload.bSucceeded)
+	{
+		return;
+	}
+
+	// Frames in flight may still reference the old pipeline states and root signatures
+	OEngine::Get()->FlushGPU();
+
+	for (auto& [live, rebuilt] : Reload.PSOs)
+	{
+		live->PSO = rebuilt->PSO;
+		live->Hash = rebuilt->Hash;
+		live->RootSignature = rebuilt->RootSignature;
+
+		// Built now, also if it failed to build at startup
+		PSOBuilds.erase(live->Name);
+
+		// The rebuilt copy points at the new byte code, the live description has to follow before the old shaders are released
+		SetShaderByteCodes(*live, [&Reload](const string& PipelineName, EShaderLevel ShaderType) {
+			return FindCompiledShader(Reload.Pipelines, PipelineName, ShaderType);
+		});
+
+		// Permutations were built from the old sources, they compile again on their next use. Destroying a pending
+		// entry waits for its job, which may still read the shaders released below.
+		std::erase_if(Permutations, [live](const auto& Entry) { return Entry.first.first == live; });
+	}
+
+	for (auto& pipeline : Reload.Pipelines)
 	{
-		const auto newSignature = make_shared<SShaderPipelineDesc>();
-		auto shaders = OEngine::Get()->GetShaderCompiler()->CompileShaders(pipeline.second, *newSignature);
-		newSignature->PipelineName = pipeline.first;
 		SShadersPipeline shadersPipeline;
-		shadersPipeline.BuildFromStages(pipeline.second);
-		shadersPipeline.PipelineInfo = newSignature;
+		shadersPipeline.BuildFromStages(pipeline.Stages);
+		shadersPipeline.PipelineInfo = pipeline.PipelineInfo;
 
-		GlobalShaderPipelineMap[pipeline.first] = shadersPipeline;
-		RootSignatures[pipeline.first] = newSignature;
-		PutShaderContainer(pipeline.first, shaders);
+		GlobalShaderPipelineMap[pipeline.Name] = shadersPipeline;
+		RootSignatures[pipeline.Name] = pipeline.PipelineInfo;
+		GlobalShaderMap[pipeline.Name].clear();
+		PutShaderContainer(pipeline.Name, pipeline.Shaders);
+		ShaderStages[pipeline.Name] = std::move(pipeline.Stages);
+	}
+	PSOGeneration++;
+	LOG(Render, Log, "Reloaded {} shader pipelines and {} PSOs", Reload.Pipelines.size(), Reload.PSOs.size());
+}
+
+void OGraphicsPipelineManager::SetShaderFeature(const string& Name, uint32_t ValueIndex)
+{
+	ShaderFeatures[Name] = ValueIndex;
+}
+
+SPSODescriptionBase* OGraphicsPipelineManager::ResolvePermutation(SPSODescriptionBase* PSO)
+{
+	if (PSO == nullptr)
+	{
+		return PSO;
+	}
+
+	const auto space = PermutationSpaces.find(PSO->RootSignatureName);
+	if (space == PermutationSpaces.end())
+	{
+		return PSO;
+	}
+
+	const auto key = space->second.MakeKey(ShaderFeatures);
+	if (key == 0)
+	{
+		return PSO;
+	}
+
+	auto& entry = Permutations[{ PSO, key }];
+	if (entry.Permutation)
+	{
+		return entry.Permutation->PSO.get();
+	}
+
+	if (!entry.bFailed && !entry.Pending.valid())
+	{
+		SShaderPipelineCompilation compilation{ .Name = PSO->RootSignatureName, .Stages = ShaderStages[PSO->RootSignatureName] };
+		for (auto& stage : compilation.Stages)
+		{
+			stage.Defines = space->second.GetDefines(key, std::move(stage.Defines));
+		}
+
+		// The job works on its own copy, hot reload may change the live PSO meanwhile
+		auto source = PSO->Clone();
+		source->Name += " [" + space->second.ToString(key) + "]";
+		LOG(Render, Log, "Compiling permutation {}", TEXT(source->Name));
+		entry.Pending = std::async(std::launch::async, [compilation = std::move(compilation), source = std::move(source), library = PipelineLibrary.get()]() mutable {
+			return BuildPermutation(std::move(compilation), std::move(source), library);
+		});
+	}
+	STAT_INC(ShaderPermutationFallbacks);
+	return PSO;
+}
+
+unique_ptr<OGraphicsPipelineManager::SShaderPermutation> OGraphicsPipelineManager::BuildPermutation(SShaderPipelineCompilation Pipeline, unique_ptr<SPSODescriptionBase> Source, OPipelineLibrary* Library)
+{
+	// One thread per permutation, several of them are usually requested in the same frame
+	vector<SShaderPipelineCompilation> pipelines;
+	pipelines.push_back(std::move(Pipeline));
+	OEngine::Get()->GetShaderCompiler()->CompilePipelines(pipelines, 1);
+	if (pipelines[0].Shaders.size() != pipelines[0].Stages.size())
+	{
+		LOG(Render, Error, "Permutation {} failed to compile, the default variant stays in use", TEXT(Source->Name));
+		return nullptr;
+	}
+
+	auto permutation = make_unique<SShaderPermutation>();
+	permutation->PSO = RebuildPSO(*Source, pipelines, Library);
+	if (!permutation->PSO)
+	{
+		return nullptr;
+	}
+	permutation->Pipeline = std::move(pipelines[0]);
+	LOG(Render, Log, "Permutation {} is ready", TEXT(permutation->PSO->Name));
+	return permutation;
+}
+
+void OGraphicsPipelineManager::UpdateShaderPermutations()
+{
+	uint32_t numLive = 0;
+	uint32_t numPending = 0;
+	for (auto& entry : Permutations | std::views::values)
+	{
+		if (entry.Pending.valid() && entry.Pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			entry.Permutation = entry.Pending.get();
+			entry.bFailed = entry.Permutation == nullptr;
+		}
+		numLive += entry.Permutation != nullptr;
+		numPending += entry.Pending.valid();
+	}
+	STAT_ADD(ShaderPermutationsLive, numLive);
+	STAT_ADD(ShaderPermutationsPending, numPending);
+}
+
+void OGraphicsPipelineManager::RunShaderCompileBenchmark()
+{
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		// The cache is bypassed, otherwise every step after the first only measures disk reads
+		auto compilations = ReadShaderPipelines();
+		const auto start = std::chrono::steady_clock::now();
+		OEngine::Get()->GetShaderCompiler()->CompilePipelines(compilations, threads, false);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+		LOG(Render, Log, "Shader compile benchmark: {} threads, {} ms for {} pipelines", threads, elapsed.count(), compilations.size());
+	}
+	LOG(Render, Log, "Shader compile benchmark: {} DXC instances created", OEngine::Get()->GetShaderCompiler()->GetNumContexts());
+}
+
+void OGraphicsPipelineManager::RunConfigBenchmark() const
+{
+	constexpr uint32_t numIterations = 1000;
+	size_t numPSOs = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t iteration = 0; iteration < numIterations; iteration++)
+	{
+		numPSOs += PSOReader->LoadPSOs().size();
 	}
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	LOG(Render, Log, "Config benchmark: {} us to decode {} pipeline states", elapsed.count() / numIterations, numPSOs / numIterations);
 }
 
 void OGraphicsPipelineManager::PutShaderContainer(const string& PipelineName, vector<unique_ptr<OShader>>& Shaders)
@@ -1,9 +1,18 @@
 #pragma once
+#include "FileWatcher/FileWatcher.h"
 #include "GraphicsPipeline/GraphicsPipeline.h"
+#include "GraphicsPipeline/PipelineStateHash.h"
 #include "PSOReader/PsoReader.h"
+#include "PipelineLibrary.h"
+#include "ShaderCompiler/Compiler.h"
+#include "ShaderCompiler/ShaderDependencyGraph.h"
+#include "ShaderCompiler/ShaderPermutation.h"
 #include "ShaderReader/ShaderReader.h"
 #include "Types.h"
 
+#include <atomic>
+#include <future>
+
 struct SRootSignature
 {
 	string Name;
@@ -11,6 +20,26 @@ struct SRootSignature
 	D3D12_VERSIONED_ROOT_SIGNATURE_DESC RootSignatureDesc;
 };
 
+/**
+ * @brief PSO whose pipeline state may still be building on a worker thread. Recording with it is only valid once IsReady returned true.
+ */
+struct SPSOHandle
+{
+	SPSODescriptionBase* Description = nullptr;
+
+	// Empty for PSOs that were built synchronously, e.g. rebuilt by hot reload
+	std::shared_future<bool> Build;
+
+	// Never blocks, false while the pipeline state is building and if building it failed
+	bool IsReady() const;
+
+	// Never blocks, true if the PSO doesn't exist or building its pipeline state failed. Only a reload can bring it back.
+	bool HasFailed() const;
+
+	// Null unless ready
+	SPSODescriptionBase* Get() const;
+};
+
 class OGraphicsPipelineManager
 {
 	using SGlobalShaderPipelineMap = unordered_map<string, SShadersPipeline>;
@@ -18,14 +47,98 @@ class OGraphicsPipelineManager
 	using SGlobalPSOMap = unordered_map<string, unique_ptr<SPSODescriptionBase>>;
 
 public:
+	// Waits for background compilation and saves the pipeline library
+	~OGraphicsPipelineManager();
+
+	// Pipeline states are built on worker threads after Init returns, see SPSOHandle
 	void Init();
-	SPSODescriptionBase* FindPSO(const string& PipelineName);
+	SPSOHandle FindPSO(const string& PipelineName);
 	SShadersPipeline* FindShadersPipeline(const string& PipelineName);
 	OShader* FindShader(const string& PipelineName, EShaderLevel ShaderType);
 
+	// Compiles the full shader config from source with 1, 2, 4... threads and logs the wall time of each step
+	void RunShaderCompileBenchmark();
+	// Decodes the loaded PSO config into pipeline descriptions repeatedly and logs the average time, parsing is measured by RendererBench
+	void RunConfigBenchmark() const;
+	static uint32_t GetNumCompileThreads();
+
+	// Starts recompiling shaders changed on disk in the background and swaps in the rebuilt PSOs once done, call between frames
+	void UpdateShaderHotReload();
+
+	// Rebuilds the PSOs whose entries changed in the PSO config, the live descriptions keep their addresses. False while
+	// pipeline states are still building or shaders reloading, try again later. Call between frames.
+	bool ReloadPSOConfig();
+
+	// Changes whenever a reload swaps live PSOs, PSOs that failed to build may be ready afterwards
+	uint32_t GetPSOGeneration() const;
+
+	// Cleared by -noshaderreload, read once on Init
+	inline static bool bShaderHotReload = true;
+
+	// Global feature values permutations are selected by, e.g. FOG = 1. Axes nobody set keep their first value.
+	void SetShaderFeature(const string& Name, uint32_t ValueIndex);
+
+	// Variant of PSO matching the current features, PSO has to be ready. Only call between frames. A permutation is compiled on a background thread
+	// the first time it is asked for, PSO itself serves as the fallback until it is ready.
+	SPSODescriptionBase* ResolvePermutation(SPSODescriptionBase* PSO);
+
+	// Collects finished permutations and reports how many are live, call between frames
+	void UpdateShaderPermutations();
+
+	// Logs the startup trace once every pipeline state is built, call between frames
+	void UpdatePipelineBuilds();
+	uint32_t GetNumPendingPSOs() const;
+
 protected:
+	struct SShaderReload
+	{
+		vector<SShaderPipelineCompilation> Pipelines;
+
+		// Live PSO and the copy rebuilt from the recompiled pipelines
+		vector<pair<SPSODescriptionBase*, unique_ptr<SPSODescriptionBase>>> PSOs;
+		bool bSucceeded = false;
+	};
+
+	struct SShaderPermutation
+	{
+		// Owns the shaders and the root signature the PSO was built from
+		SShaderPipelineCompilation Pipeline;
+		unique_ptr<SPSODescriptionBase> PSO;
+	};
+
+	struct SPermutationEntry
+	{
+		std::future<unique_ptr<SShaderPermutation>> Pending;
+
+		// Empty while pending and if the permutation failed to build
+		unique_ptr<SShaderPermutation> Permutation;
+		bool bFailed = false;
+	};
+
+	using TShaderLookup = std::function<OShader*(const string& PipelineName, EShaderLevel ShaderType)>;
+
 	void LoadShaders();
+	vector<SShaderPipelineCompilation> ReadShaderPipelines();
+
+	// Stages FindShader returns nothing for keep their current byte code
+	static void SetShaderByteCodes(SPSODescriptionBase& PSO, const TShaderLookup& FindShader);
+
+	static OShader* FindCompiledShader(const vector<SShaderPipelineCompilation>& Pipelines, const string& PipelineName, EShaderLevel ShaderType);
+
+	// Copy of Source using the shaders and root signatures of Pipelines where it references them, empty if the pipeline state failed to build
+	static unique_ptr<SPSODescriptionBase> RebuildPSO(const SPSODescriptionBase& Source, const vector<SShaderPipelineCompilation>& Pipelines, OPipelineLibrary* Library);
+
+	// Runs on a worker thread, Source is a copy owned by the job
+	static unique_ptr<SShaderPermutation> BuildPermutation(SShaderPipelineCompilation Pipeline, unique_ptr<SPSODescriptionBase> Source, OPipelineLibrary* Library);
+
+	// Runs on a worker thread, only reads the live PSOs
+	SShaderReload BuildShaderReload(vector<SShaderPipelineCompilation> Pipelines);
+	void ApplyShaderReload(SShaderReload& Reload);
+	void RecordDependencies(const SShaderPipelineCompilation& Compilation);
 	void LoadPipelines();
+
+	// Runs on a worker thread, every PSO is built by the pool and its promise fulfilled as soon as it is done
+	void BuildPipelineStates(vector<pair<SPSODescriptionBase*, std::promise<bool>>> Builds);
 	void LoadRenderNodes();
 	void PutShaderContainer(const string& PipelineName, vector<unique_ptr<OShader>>& Shaders);
 	SShadersPipeline MakePipelineInfoForPSO(const shared_ptr<SPSODescriptionBase>& PSO);
@@ -36,13 +149,22 @@ protected:
 	SGlobalShaderMap GlobalShaderMap;
 	SGlobalPSOMap GlobalPSOMap;
 	unordered_map<string, shared_ptr<SShaderPipelineDesc>> RootSignatures;
-};
+	unique_ptr<OPipelineLibrary> PipelineLibrary;
 
-inline bool operator==(const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Lhs, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Rhs)
-{
-	return Lhs.Desc_1_1.Flags == Rhs.Desc_1_1.Flags
-	       && Lhs.Desc_1_1.NumParameters == Rhs.Desc_1_1.NumParameters
-	       && Lhs.Desc_1_1.NumStaticSamplers == Rhs.Desc_1_1.NumStaticSamplers
-	       && Lhs.Desc_1_1.pParameters == Rhs.Desc_1_1.pParameters
-	       && Lhs.Version == Rhs.Version;
-}
\ No newline at end of file
+	unordered_map<string, std::shared_future<bool>> PSOBuilds;
+	std::future<void> PendingPSOBuilds;
+	std::atomic<uint32_t> NumPendingPSOs = 0;
+	std::chrono::steady_clock::duration AllPSOsReadyTime{};
+	uint32_t NumFramesBeforeReady = 0;
+
+	unique_ptr<OFileWatcher> ShaderWatcher;
+	OShaderDependencyGraph ShaderDependencies;
+	unordered_map<string, vector<SPipelineStage>> ShaderStages;
+	std::future<SShaderReload> PendingReload;
+	std::chrono::steady_clock::time_point LastShaderPoll;
+	uint32_t PSOGeneration = 0;
+
+	unordered_map<string, OShaderPermutationSpace> PermutationSpaces;
+	map<string, uint32_t> ShaderFeatures;
+	map<pair<const SPSODescriptionBase*, TShaderPermutationKey>, SPermutationEntry> Permutations;
+};
@@ -0,0 +1,274 @@
+#include "PipelineLibrary.h"
+
+#include "Logger.h"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+
+namespace
+{
+// Magic, version, number of pipelines, their hashes, then the size and bytes of the serialized library
+struct SPipelineLibraryHeader
+{
+	uint32_t Magic = 0;
+	uint32_t Version = 0;
+	uint64_t NumPipelines = 0;
+};
+
+std::optional<vector<uint8_t>> ReadFile(const std::filesystem::path& Path)
+{
+	std::ifstream file(Path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return std::nullopt;
+	}
+	return vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool ReadBytes(const vector<uint8_t>& Data, size_t& Offset, void* OutValue, size_t Size)
+{
+	if (Size > Data.size() - Offset)
+	{
+		return false;
+	}
+	std::memcpy(OutValue, Data.data() + Offset, Size);
+	Offset += Size;
+	return true;
+}
+} // namespace
+
+OPipelineLibrary::OPipelineLibrary(std::filesystem::path Path)
+    : Path(std::move(Path))
+{
+}
+
+void OPipelineLibrary::Load(ID3D12Device* InDevice)
+{
+	SLockGuard lock(Mutex);
+	THROW_IF_FAILED(InDevice->QueryInterface(IID_PPV_ARGS(&Device)));
+
+	if (const auto data = ReadFile(Path))
+	{
+		size_t offset = 0;
+		SPipelineLibraryHeader header;
+		bool bValid = ReadBytes(*data, offset, &header, sizeof(header)) && header.Magic == Magic && header.Version == Version;
+		for (uint64_t i = 0; bValid && i < header.NumPipelines; i++)
+		{
+			uint64_t hash = 0;
+			bValid = ReadBytes(*data, offset, &hash, sizeof(hash));
+			StoredHashes.insert(hash);
+		}
+
+		uint64_t blobSize = 0;
+		bValid = bValid && ReadBytes(*data, offset, &blobSize, sizeof(blobSize)) && blobSize == data->size() - offset;
+		if (bValid)
+		{
+			Blob.assign(data->begin() + offset, data->end());
+			const HRESULT result = Device->CreatePipelineLibrary(Blob.data(), Blob.size(), IID_PPV_ARGS(&Library));
+			if (FAILED(result))
+			{
+				// D3D12_ERROR_DRIVER_VERSION_MISMATCH and D3D12_ERROR_ADAPTER_NOT_FOUND are expected after a driver update
+				LOG(Render, Warning, "Pipeline library {} can't be used with this device ({:#x}), starting empty", Path.wstring(), static_cast<uint32_t>(result));
+				Library.Reset();
+			}
+		}
+		else
+		{
+			LOG(Render, Warning, "Pipeline library {} is corrupt, starting empty", Path.wstring());
+		}
+	}
+
+	if (!Library)
+	{
+		Blob.clear();
+		StoredHashes.clear();
+		if (FAILED(Device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&Library))))
+		{
+			LOG(Render, Warning, "Pipeline libraries are not supported, pipeline states are compiled on every run");
+			Library.Reset();
+		}
+	}
+	LOG(Render, Log, "Pipeline library holds {} pipeline states", StoredHashes.size());
+}
+
+ComPtr<ID3D12PipelineState> OPipelineLibrary::FindOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64_t Hash)
+{
+	return FindOrCreate(
+	    Desc,
+	    Hash,
+	    [this](const wstring& Name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& PSODesc, ComPtr<ID3D12PipelineState>& OutPSO) {
+		    return Library->LoadGraphicsPipeline(Name.c_str(), &PSODesc, IID_PPV_ARGS(&OutPSO));
+	    },
+	    [this](const D3D12_GRAPHICS_PIPELINE_STATE_DESC& PSODesc, ComPtr<ID3D12PipelineState>& OutPSO) {
+		    return Device->CreateGraphicsPipelineState(&PSODesc, IID_PPV_ARGS(&OutPSO));
+	    });
+}
+
+ComPtr<ID3D12PipelineState> OPipelineLibrary::FindOrCreate(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64_t Hash)
+{
+	return FindOrCreate(
+	    Desc,
+	    Hash,
+	    [this](const wstring& Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& PSODesc, ComPtr<ID3D12PipelineState>& OutPSO) {
+		    return Library->LoadComputePipeline(Name.c_str(), &PSODesc, IID_PPV_ARGS(&OutPSO));
+	    },
+	    [this](const D3D12_COMPUTE_PIPELINE_STATE_DESC& PSODesc, ComPtr<ID3D12PipelineState>& OutPSO) {
+		    return Device->CreateComputePipelineState(&PSODesc, IID_PPV_ARGS(&OutPSO));
+	    });
+}
+
+template<typename TDesc, typename TLoad, typename TCreate>
+ComPtr<ID3D12PipelineState> OPipelineLibrary::FindOrCreate(const TDesc& Desc, uint64_t Hash, TLoad&& LoadPipeline, TCreate&& CreatePipeline)
+{
+	const auto name = MakeName(Hash);
+	ComPtr<ID3D12PipelineState> pso;
+	{
+		SLockGuard lock(Mutex);
+		if (const auto it = Pipelines.find(Hash); it != Pipelines.end())
+		{
+			NumShared++;
+			return it->second;
+		}
+
+		// Fails if the description differs from the stored one, the hash names the pipeline so that only happens on a collision
+		if (Library && StoredHashes.contains(Hash) && SUCCEEDED(LoadPipeline(name, Desc, pso)))
+		{
+			NumLoaded++;
+			Pipelines[Hash] = pso;
+			return pso;
+		}
+	}
+
+	// Compiled outside the lock, pipeline states of different descriptions are created concurrently
+	THROW_IF_FAILED(CreatePipeline(Desc, pso));
+
+	SLockGuard lock(Mutex);
+	const auto [it, bInserted] = Pipelines.try_emplace(Hash, pso);
+	if (!bInserted)
+	{
+		// Another thread created the same description meanwhile
+		NumShared++;
+		return it->second;
+	}
+
+	NumCreated++;
+	if (Library && !StoredHashes.contains(Hash))
+	{
+		if (SUCCEEDED(Library->StorePipeline(name.c_str(), pso.Get())))
+		{
+			StoredHashes.insert(Hash);
+			bDirty = true;
+		}
+		else
+		{
+			LOG(Render, Warning, "Pipeline state {} couldn't be stored in the pipeline library", name);
+		}
+	}
+	return pso;
+}
+
+bool OPipelineLibrary::Save(bool bDropUnused)
+{
+	SLockGuard lock(Mutex);
+	if (!Library)
+	{
+		return false;
+	}
+
+	const bool bHasUnused = std::ranges::any_of(StoredHashes, [this](uint64_t Hash) { return !Pipelines.contains(Hash); });
+	if (!bDropUnused || !bHasUnused)
+	{
+		bDirty = bDirty && !Write(Library.Get(), StoredHashes);
+		return !bDirty;
+	}
+
+	// A fresh library holding only the pipeline states used by this run, the live library keeps serving until it is destroyed
+	ComPtr<ID3D12PipelineLibrary> compacted;
+	if (FAILED(Device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&compacted))))
+	{
+		return false;
+	}
+
+	std::set<uint64_t> hashes;
+	for (const auto& [hash, pso] : Pipelines)
+	{
+		if (SUCCEEDED(compacted->StorePipeline(MakeName(hash).c_str(), pso.Get())))
+		{
+			hashes.insert(hash);
+		}
+	}
+	LOG(Render, Log, "Compacting the pipeline library from {} to {} pipeline states", StoredHashes.size(), hashes.size());
+	return Write(compacted.Get(), hashes);
+}
+
+bool OPipelineLibrary::Write(ID3D12PipelineLibrary* Source, const std::set<uint64_t>& Hashes) const
+{
+	vector<uint8_t> blob(Source->GetSerializedSize());
+	if (FAILED(Source->Serialize(blob.data(), blob.size())))
+	{
+		LOG(Render, Error, "Serializing the pipeline library failed");
+		return false;
+	}
+
+	const SPipelineLibraryHeader header{ .Magic = Magic, .Version = Version, .NumPipelines = Hashes.size() };
+	const uint64_t blobSize = blob.size();
+
+	std::error_code error;
+	std::filesystem::create_directories(Path.parent_path(), error);
+
+	// Written next to the destination and renamed, an interrupted write leaves the previous library intact
+	auto tempPath = Path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			LOG(Render, Error, "Can't write the pipeline library to {}", tempPath.wstring());
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const uint64_t hash : Hashes)
+		{
+			file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+		}
+		file.write(reinterpret_cast<const char*>(&blobSize), sizeof(blobSize));
+		file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, Path, error);
+	if (error)
+	{
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	LOG(Render, Log, "Saved {} pipeline states to {}", Hashes.size(), Path.wstring());
+	return true;
+}
+
+wstring OPipelineLibrary::MakeName(uint64_t Hash)
+{
+	return std::format(L"{:016x}", Hash);
+}
+
+uint32_t OPipelineLibrary::GetNumLoaded() const
+{
+	SLockGuard lock(Mutex);
+	return NumLoaded;
+}
+
+uint32_t OPipelineLibrary::GetNumCreated() const
+{
+	SLockGuard lock(Mutex);
+	return NumCreated;
+}
+
+uint32_t OPipelineLibrary::GetNumShared() const
+{
+	SLockGuard lock(Mutex);
+	return NumShared;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Async.h"
+#include "DirectX/DXHelper.h"
+#include "Types.h"
+
+#include <filesystem>
+#include <set>
+
+/**
+ * @brief Pipeline states persisted between runs in a D3D12 pipeline library, named by the structural hash of their description.
+ * A description seen in a previous run is loaded from the driver blob instead of compiled again, identical descriptions of one run
+ * share a single pipeline state. Thread safe, pipeline states are also built on worker threads.
+ */
+class OPipelineLibrary
+{
+public:
+	static constexpr uint32_t Magic = 0x4C4F5350; // "PSOL"
+	static constexpr uint32_t Version = 1;
+
+	explicit OPipelineLibrary(std::filesystem::path Path);
+
+	// Starts empty if the file is missing, truncated or was written by another driver or adapter
+	void Load(ID3D12Device* Device);
+
+	ComPtr<ID3D12PipelineState> FindOrCreate(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64_t Hash);
+	ComPtr<ID3D12PipelineState> FindOrCreate(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64_t Hash);
+
+	// Writes the file if pipelines were added since it was loaded. Pipelines are never removed from a library, with bDropUnused
+	// the file is rewritten from the pipelines of this run only, so that stale shader versions don't pile up.
+	bool Save(bool bDropUnused);
+
+	uint32_t GetNumLoaded() const;
+	uint32_t GetNumCreated() const;
+	uint32_t GetNumShared() const;
+
+private:
+	template<typename TDesc, typename TLoad, typename TCreate>
+	ComPtr<ID3D12PipelineState> FindOrCreate(const TDesc& Desc, uint64_t Hash, TLoad&& LoadPipeline, TCreate&& CreatePipeline);
+
+	static wstring MakeName(uint64_t Hash);
+	bool Write(ID3D12PipelineLibrary* Source, const std::set<uint64_t>& Hashes) const;
+
+	std::filesystem::path Path;
+	ComPtr<ID3D12Device1> Device;
+
+	// Empty if the device doesn't support pipeline libraries, pipeline states are then created directly
+	ComPtr<ID3D12PipelineLibrary> Library;
+
+	// The library reads from the blob it was created from for as long as it lives
+	vector<uint8_t> Blob;
+
+	// Names stored in Library, a library can't be queried for them
+	std::set<uint64_t> StoredHashes;
+	unordered_map<uint64_t, ComPtr<ID3D12PipelineState>> Pipelines;
+	bool bDirty = false;
+
+	mutable SMutex Mutex;
+	uint32_t NumLoaded = 0;
+	uint32_t NumCreated = 0;
+	uint32_t NumShared = 0;
+};
@@ -0,0 +1,196 @@
+#include "FrameLoop.h"
+
+#include "Logger.h"
+#include "Stats/Stats.h"
+
+#include <algorithm>
+#include <cstring>
+
+OFrameLoop::OFrameLoop(IRenderDevice* Device, const SFrameLoopDesc& Desc)
+    : Device(Device), Desc(Desc), UploadRing(Desc.UploadRingSize)
+{
+}
+
+bool OFrameLoop::Initialize(const vector<SNodeInfo>& Nodes)
+{
+	CompiledGraph = ORenderGraphCompiler::Compile(Nodes);
+	if (!CompiledGraph.bIsValid)
+	{
+		LOG(Render, Error, "Render graph is invalid, the frame loop can't run it");
+		return false;
+	}
+
+	// The output node closes and presents the frame, it has to be the last node of the order
+	if (std::ranges::count(Nodes, true, &SNodeInfo::bIsOutput) != 1)
+	{
+		LOG(Render, Error, "The frame loop needs exactly one output node");
+		return false;
+	}
+
+	BarrierPlan = OBarrierPlanner::Plan(Nodes, CompiledGraph);
+	SwapChain = Device->CreateSwapChain(Desc.NumBackBuffers, Desc.Width, Desc.Height);
+	Recorder = Device->CreateCommandRecorder();
+	UploadBuffer = Device->CreateUploadBuffer(Desc.UploadRingSize);
+	BackBufferFences.assign(Desc.NumBackBuffers, 0);
+	if (!SwapChain)
+	{
+		return false;
+	}
+
+	// Ordered so the handles don't depend on hashing
+	const map<string, uint32_t> initialStates(BarrierPlan.InitialStates.begin(), BarrierPlan.InitialStates.end());
+	for (const auto& [name, state] : initialStates)
+	{
+		if (name != "BackBuffer")
+		{
+			Resources[name] = Device->CreateResource(name, state);
+		}
+	}
+
+	Passes.assign(Desc.NumBackBuffers, {});
+	for (uint32_t backBuffer = 0; backBuffer < Desc.NumBackBuffers; backBuffer++)
+	{
+		for (size_t position = 0; position < CompiledGraph.Order.size(); position++)
+		{
+			const auto& node = Nodes[CompiledGraph.Order[position]];
+			auto& pass = Passes[backBuffer].emplace_back();
+			for (const auto& barrier : BarrierPlan.Batches[position])
+			{
+				pass.Barriers.push_back({ .Resource = ResolveResource(barrier.Resource, backBuffer), .Before = barrier.Before, .After = barrier.After, .Split = barrier.Split });
+			}
+
+			pass.bIsOutput = node.bIsOutput;
+			if (pass.bIsOutput)
+			{
+				continue;
+			}
+
+			auto& pso = PipelineStates[node.PSOType];
+			if (pso == InvalidRenderHandle)
+			{
+				pso = Device->CreatePipelineState(node.PSOType);
+			}
+			pass.PSO = pso;
+
+			for (const auto& resource : node.Writes)
+			{
+				const uint32_t access = OBarrierPlanner::GetAccess(node, resource, true);
+				if (pass.RenderTarget == InvalidRenderHandle && (access == SResourceAccess::RenderTarget || access == SResourceAccess::DepthWrite))
+				{
+					pass.RenderTarget = ResolveResource(resource, backBuffer);
+				}
+				pass.bIsCompute |= access == SResourceAccess::UnorderedAccess;
+			}
+			pass.bIsCompute &= pass.RenderTarget == InvalidRenderHandle;
+		}
+	}
+	return true;
+}
+
+void OFrameLoop::DrawFrame()
+{
+	const uint32_t backBuffer = SwapChain->GetCurrentBackBufferIndex();
+
+	// Frames in flight are bounded by the number of back buffers
+	Device->WaitForFenceValue(BackBufferFences[backBuffer]);
+	UploadRing.ReleaseCompletedFrames(Device->GetCompletedFenceValue());
+
+	Recorder->Begin();
+	const auto& passes = Passes[backBuffer];
+	for (size_t position = 0; position < passes.size(); position++)
+	{
+		RecordPass(passes[position], static_cast<uint32_t>(position), backBuffer);
+	}
+
+	const uint64_t fence = Device->Signal();
+	UploadRing.FinishFrame(fence);
+	BackBufferFences[backBuffer] = fence;
+	NumFrames++;
+}
+
+void OFrameLoop::RecordPass(const SPass& Pass, uint32_t Position, uint32_t BackBufferIndex)
+{
+	Recorder->ResourceBarriers(Pass.Barriers);
+	if (Pass.bIsOutput)
+	{
+		Recorder->End();
+		Device->Submit(Recorder.get());
+		SwapChain->Present();
+		return;
+	}
+
+	const uint64_t constantsAddress = AllocateConstants();
+	if (constantsAddress != 0)
+	{
+		const SPassConstants constants = { .FrameIndex = NumFrames, .Position = Position, .BackBufferIndex = BackBufferIndex };
+		memcpy(UploadBuffer.MappedData + (constantsAddress - UploadBuffer.GPUAddress), &constants, sizeof(constants));
+		STAT_ADD(UploadBytesCopied, sizeof(constants));
+	}
+
+	Recorder->SetPipelineState(Pass.PSO);
+	Recorder->SetResource(0, constantsAddress);
+	if (Pass.RenderTarget != InvalidRenderHandle)
+	{
+		Recorder->SetRenderTarget(Pass.RenderTarget);
+		for (uint32_t draw = 0; draw < Desc.NumDrawsPerNode; draw++)
+		{
+			Recorder->DrawIndexedInstanced(36, 1);
+		}
+	}
+	else if (Pass.bIsCompute)
+	{
+		Recorder->Dispatch((Desc.Width + 15) / 16, (Desc.Height + 15) / 16, 1);
+	}
+}
+
+uint64_t OFrameLoop::AllocateConstants()
+{
+	uint64_t offset = UploadRing.Allocate(sizeof(SPassConstants), ConstantBufferAlignment);
+	while (offset == ORingAllocator::InvalidOffset && UploadRing.HasPendingFrames())
+	{
+		LOG(Render, Warning, "Upload ring is full, waiting for the GPU to release a frame");
+		STAT_INC(UploadRingStalls);
+		Device->WaitForFenceValue(UploadRing.GetOldestPendingFence());
+		UploadRing.ReleaseCompletedFrames(Device->GetCompletedFenceValue());
+		offset = UploadRing.Allocate(sizeof(SPassConstants), ConstantBufferAlignment);
+	}
+
+	if (offset == ORingAllocator::InvalidOffset)
+	{
+		// Binding a null address is reported by the recorder
+		LOG(Render, Error, "Upload ring is too small for a single frame!");
+		return 0;
+	}
+	return UploadBuffer.GPUAddress + offset;
+}
+
+TRenderHandle OFrameLoop::ResolveResource(const string& Name, uint32_t BackBufferIndex) const
+{
+	if (Name == "BackBuffer")
+	{
+		return SwapChain->GetBackBuffer(BackBufferIndex);
+	}
+
+	const auto resource = Resources.find(Name);
+	return resource != Resources.end() ? resource->second : InvalidRenderHandle;
+}
+
+const SCompiledRenderGraph& OFrameLoop::GetCompiledGraph() const
+{
+	return CompiledGraph;
+}
+
+const SBarrierPlan& OFrameLoop::GetBarrierPlan() const
+{
+	return BarrierPlan;
+}
+
+ISwapChain* OFrameLoop::GetSwapChain() const
+{
+	return SwapChain.get();
+}
+
+uint64_t OFrameLoop::GetNumFrames() const
+{
+	return NumFrames;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Engine/UploadBuffer/RingAllocator.h"
+#include "RenderDevice.h"
+#include "RenderGraph/Graph/BarrierPlanner.h"
+#include "RenderGraph/Graph/RenderGraphCompiler.h"
+#include "Types.h"
+
+struct SFrameLoopDesc
+{
+	uint32_t NumBackBuffers = 3;
+	uint32_t Width = 1920;
+	uint32_t Height = 1080;
+
+	// Draws recorded by every node which writes a render target
+	uint32_t NumDrawsPerNode = 1;
+	uint64_t UploadRingSize = 1 << 20;
+};
+
+/**
+ * @brief The frame of OEngine::Draw over IRenderDevice: waits for the back buffer's previous frame, uploads pass constants into
+ * the ring, issues the barrier batches of the plan and one pass per node in the compiled order, and presents once the output
+ * node is reached. Barriers and passes are resolved to device handles once per back buffer, a frame does no lookups by name.
+ */
+class OFrameLoop
+{
+public:
+	OFrameLoop(IRenderDevice* Device, const SFrameLoopDesc& Desc);
+
+	// Compiles the graph, plans its barriers and creates every resource in the state the frame starts from. False for invalid graphs.
+	bool Initialize(const vector<SNodeInfo>& Nodes);
+	void DrawFrame();
+
+	const SCompiledRenderGraph& GetCompiledGraph() const;
+	const SBarrierPlan& GetBarrierPlan() const;
+	ISwapChain* GetSwapChain() const;
+	uint64_t GetNumFrames() const;
+
+	// Alignment of constant buffers in the upload ring
+	static constexpr uint64_t ConstantBufferAlignment = 256;
+
+	struct SPassConstants
+	{
+		uint64_t FrameIndex = 0;
+		uint32_t Position = 0;
+		uint32_t BackBufferIndex = 0;
+	};
+
+private:
+	struct SPass
+	{
+		vector<SResourceBarrierDesc> Barriers;
+		TRenderHandle PSO = InvalidRenderHandle;
+
+		// Draws go to the render target, passes without one dispatch if they write unordered access resources
+		TRenderHandle RenderTarget = InvalidRenderHandle;
+		bool bIsCompute = false;
+		bool bIsOutput = false;
+	};
+
+	TRenderHandle ResolveResource(const string& Name, uint32_t BackBufferIndex) const;
+	uint64_t AllocateConstants();
+	void RecordPass(const SPass& Pass, uint32_t Position, uint32_t BackBufferIndex);
+
+	IRenderDevice* Device = nullptr;
+	SFrameLoopDesc Desc;
+	unique_ptr<ISwapChain> SwapChain;
+	unique_ptr<ICommandRecorder> Recorder;
+
+	SUploadBufferDesc UploadBuffer;
+	ORingAllocator UploadRing;
+
+	SCompiledRenderGraph CompiledGraph;
+	SBarrierPlan BarrierPlan;
+	unordered_map<string, TRenderHandle> Resources;
+	unordered_map<string, TRenderHandle> PipelineStates;
+
+	// Per back buffer, the passes in compiled order
+	vector<vector<SPass>> Passes;
+
+	// Fence of the last frame which rendered into each back buffer
+	vector<uint64_t> BackBufferFences;
+	uint64_t NumFrames = 0;
+};
@@ -0,0 +1,302 @@
+#include "NullRenderDevice.h"
+
+#include "Logger.h"
+#include "Stats/Stats.h"
+
+ONullCommandRecorder::ONullCommandRecorder(ONullRenderDevice* Device)
+    : Device(Device)
+{
+}
+
+void ONullCommandRecorder::Begin()
+{
+	Device->Validate(!bIsOpen, "Begin on an open command recorder");
+	bIsOpen = true;
+	CurrentPSO = InvalidRenderHandle;
+	CurrentRenderTarget = InvalidRenderHandle;
+}
+
+void ONullCommandRecorder::End()
+{
+	Device->Validate(bIsOpen, "End on a closed command recorder");
+	bIsOpen = false;
+}
+
+void ONullCommandRecorder::SetPipelineState(TRenderHandle PSO)
+{
+	if (CurrentPSO == PSO)
+	{
+		return;
+	}
+
+	STAT_INC(PSOSwitches);
+	Device->CommandLog.Record(ECommandType::SetPipelineState);
+	Device->Validate(bIsOpen, "SetPipelineState on a closed command recorder");
+	Device->Validate(Device->IsValid(PSO, ENullObjectType::PipelineState), "SetPipelineState with an unknown pipeline state");
+	CurrentPSO = PSO;
+}
+
+void ONullCommandRecorder::SetResource(uint32_t RootIndex, uint64_t GPUAddress)
+{
+	Device->CommandLog.Record(ECommandType::SetResource);
+	Device->Validate(bIsOpen, "SetResource on a closed command recorder");
+	Device->Validate(CurrentPSO != InvalidRenderHandle, "SetResource without a pipeline state");
+	if (GPUAddress == 0)
+	{
+		Device->CommandLog.Validate(false, "Null resource bound to root index " + std::to_string(RootIndex));
+	}
+}
+
+void ONullCommandRecorder::ResourceBarriers(std::span<const SResourceBarrierDesc> Barriers)
+{
+	if (Barriers.empty())
+	{
+		return;
+	}
+
+	Device->CommandLog.Record(ECommandType::ResourceBarrier);
+	Device->Validate(bIsOpen, "ResourceBarrier on a closed command recorder");
+	for (const auto& barrier : Barriers)
+	{
+		Device->ResourceBarrier(barrier);
+	}
+}
+
+void ONullCommandRecorder::CopyResource(TRenderHandle Dest, TRenderHandle Src)
+{
+	Device->CommandLog.Record(ECommandType::CopyResource);
+	Device->Validate(bIsOpen, "CopyResource on a closed command recorder");
+	Device->Validate(Dest != Src, "CopyResource with the same source and destination");
+	Device->Validate(Device->GetResourceState(Dest) == SResourceAccess::CopyDest, "CopyResource destination is not in the CopyDest state");
+	Device->Validate((Device->GetResourceState(Src) & SResourceAccess::CopySource) != 0, "CopyResource source is not in the CopySource state");
+}
+
+void ONullCommandRecorder::SetRenderTarget(TRenderHandle RenderTarget)
+{
+	Device->CommandLog.Record(ECommandType::SetRenderTarget);
+	Device->Validate(bIsOpen, "SetRenderTarget on a closed command recorder");
+
+	const uint32_t state = Device->GetResourceState(RenderTarget);
+	Device->Validate(state == SResourceAccess::RenderTarget || state == SResourceAccess::DepthWrite, "Render target is not in a writable state");
+	CurrentRenderTarget = RenderTarget;
+}
+
+void ONullCommandRecorder::DrawIndexedInstanced(uint32_t IndexCount, uint32_t InstanceCount)
+{
+	Device->CommandLog.Record(ECommandType::Draw);
+	Device->Validate(bIsOpen, "Draw on a closed command recorder");
+	Device->Validate(CurrentPSO != InvalidRenderHandle, "Draw without a pipeline state");
+	Device->Validate(CurrentRenderTarget != InvalidRenderHandle, "Draw without a render target");
+	Device->Validate(IndexCount > 0 && InstanceCount > 0, "Empty draw");
+	STAT_INC(DrawCalls);
+}
+
+void ONullCommandRecorder::Dispatch(uint32_t GroupsX, uint32_t GroupsY, uint32_t GroupsZ)
+{
+	Device->CommandLog.Record(ECommandType::Dispatch);
+	Device->Validate(bIsOpen, "Dispatch on a closed command recorder");
+	Device->Validate(CurrentPSO != InvalidRenderHandle, "Dispatch without a pipeline state");
+	Device->Validate(GroupsX > 0 && GroupsY > 0 && GroupsZ > 0, "Empty dispatch");
+}
+
+bool ONullCommandRecorder::IsOpen() const
+{
+	return bIsOpen;
+}
+
+ONullSwapChain::ONullSwapChain(ONullRenderDevice* Device, uint32_t NumBackBuffers, uint32_t Width, uint32_t Height)
+    : Device(Device), Width(Width), Height(Height)
+{
+	for (uint32_t i = 0; i < NumBackBuffers; i++)
+	{
+		BackBuffers.push_back(Device->CreateResource("BackBuffer" + std::to_string(i), SResourceAccess::Present));
+	}
+}
+
+uint32_t ONullSwapChain::GetNumBackBuffers() const
+{
+	return static_cast<uint32_t>(BackBuffers.size());
+}
+
+uint32_t ONullSwapChain::GetCurrentBackBufferIndex() const
+{
+	return CurrentBackBuffer;
+}
+
+TRenderHandle ONullSwapChain::GetBackBuffer(uint32_t Index) const
+{
+	return Index < BackBuffers.size() ? BackBuffers[Index] : InvalidRenderHandle;
+}
+
+void ONullSwapChain::Present()
+{
+	Device->CommandLog.Record(ECommandType::Present);
+	Device->Validate(Device->GetResourceState(BackBuffers[CurrentBackBuffer]) == SResourceAccess::Present, "Back buffer is not in the Present state");
+	CurrentBackBuffer = (CurrentBackBuffer + 1) % GetNumBackBuffers();
+}
+
+void ONullSwapChain::Resize(uint32_t NewWidth, uint32_t NewHeight)
+{
+	// Back buffers are recreated in the Present state, which all of them have to be in already
+	for (const auto backBuffer : BackBuffers)
+	{
+		Device->Validate(Device->GetResourceState(backBuffer) == SResourceAccess::Present, "Back buffer in use while resizing");
+	}
+	Width = NewWidth;
+	Height = NewHeight;
+	CurrentBackBuffer = 0;
+}
+
+uint32_t ONullSwapChain::GetWidth() const
+{
+	return Width;
+}
+
+uint32_t ONullSwapChain::GetHeight() const
+{
+	return Height;
+}
+
+SUploadBufferDesc ONullRenderDevice::CreateUploadBuffer(uint64_t Size)
+{
+	const auto handle = CreateObject("UploadBuffer", ENullObjectType::UploadBuffer);
+	auto& memory = Objects.back().Memory;
+	memory.resize(Size);
+
+	// Distinct non zero addresses, one 4GB range per buffer
+	SUploadBufferDesc result;
+	result.Handle = handle;
+	result.MappedData = memory.data();
+	result.GPUAddress = handle << 32;
+	result.Size = Size;
+	return result;
+}
+
+TRenderHandle ONullRenderDevice::CreateResource(const string& Name, uint32_t InitialState)
+{
+	const auto handle = CreateObject(Name, ENullObjectType::Resource);
+	Objects.back().State = InitialState;
+	return handle;
+}
+
+TRenderHandle ONullRenderDevice::CreatePipelineState(const string& Name)
+{
+	return CreateObject(Name, ENullObjectType::PipelineState);
+}
+
+unique_ptr<ICommandRecorder> ONullRenderDevice::CreateCommandRecorder()
+{
+	return make_unique<ONullCommandRecorder>(this);
+}
+
+unique_ptr<ISwapChain> ONullRenderDevice::CreateSwapChain(uint32_t NumBackBuffers, uint32_t Width, uint32_t Height)
+{
+	if (NumBackBuffers == 0)
+	{
+		LOG(Engine, Error, "Swap chain needs at least one back buffer");
+		return nullptr;
+	}
+	return make_unique<ONullSwapChain>(this, NumBackBuffers, Width, Height);
+}
+
+void ONullRenderDevice::Submit(ICommandRecorder* Recorder)
+{
+	CommandLog.Record(ECommandType::ExecuteCommandList);
+	Validate(!static_cast<ONullCommandRecorder*>(Recorder)->IsOpen(), "Submitted an open command recorder");
+}
+
+uint64_t ONullRenderDevice::Signal()
+{
+	CommandLog.Record(ECommandType::Signal);
+	return ++FenceValue;
+}
+
+uint64_t ONullRenderDevice::GetCompletedFenceValue() const
+{
+	return FenceValue;
+}
+
+void ONullRenderDevice::WaitForFenceValue(uint64_t Value)
+{
+	Validate(Value <= FenceValue, "Waiting for a fence value which has never been signaled");
+}
+
+uint32_t ONullRenderDevice::GetResourceState(TRenderHandle Resource) const
+{
+	return IsValid(Resource, ENullObjectType::Resource) ? Objects[Resource - 1].State : SResourceAccess::Common;
+}
+
+const string& ONullRenderDevice::GetName(TRenderHandle Handle) const
+{
+	static const string unknown = "Unknown";
+	return Handle != InvalidRenderHandle && Handle <= Objects.size() ? Objects[Handle - 1].Name : unknown;
+}
+
+bool ONullRenderDevice::IsValid(TRenderHandle Handle, ENullObjectType Type) const
+{
+	return Handle != InvalidRenderHandle && Handle <= Objects.size() && Objects[Handle - 1].Type == Type;
+}
+
+const SCommandLog& ONullRenderDevice::GetCommandLog() const
+{
+	return CommandLog;
+}
+
+void ONullRenderDevice::ResetCommandLog()
+{
+	CommandLog.Reset();
+}
+
+TRenderHandle ONullRenderDevice::CreateObject(const string& Name, ENullObjectType Type)
+{
+	auto& object = Objects.emplace_back();
+	object.Name = Name;
+	object.Type = Type;
+	return Objects.size();
+}
+
+ONullRenderDevice::SObject* ONullRenderDevice::Find(TRenderHandle Handle, ENullObjectType Type)
+{
+	return IsValid(Handle, Type) ? &Objects[Handle - 1] : nullptr;
+}
+
+bool ONullRenderDevice::Validate(bool bCondition, const char* Message)
+{
+	// The message is only built into a string once a check failed, the calls are on the hot path of the frame loop
+	return bCondition || CommandLog.Validate(false, Message);
+}
+
+void ONullRenderDevice::ResourceBarrier(const SResourceBarrierDesc& Barrier)
+{
+	auto* resource = Find(Barrier.Resource, ENullObjectType::Resource);
+	if (!Validate(resource != nullptr, "Barrier on an unknown resource"))
+	{
+		return;
+	}
+
+	const string& name = resource->Name;
+	if (Barrier.Before == Barrier.After)
+	{
+		CommandLog.Validate(false, "Barrier of " + name + " doesn't change its state");
+	}
+	if (resource->State != Barrier.Before)
+	{
+		CommandLog.Validate(false, "Barrier of " + name + " starts from " + std::to_string(Barrier.Before) + " but it is in " + std::to_string(resource->State));
+	}
+	switch (Barrier.Split)
+	{
+	case EBarrierSplit::Begin:
+		Validate(!resource->bIsSplitPending, "Split barrier begun twice");
+		resource->bIsSplitPending = true;
+		break;
+	case EBarrierSplit::End:
+		Validate(resource->bIsSplitPending, "Split barrier ended without a begin");
+		resource->bIsSplitPending = false;
+		resource->State = Barrier.After;
+		break;
+	default:
+		Validate(!resource->bIsSplitPending, "Barrier while a split barrier is pending");
+		resource->State = Barrier.After;
+		break;
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "CommandQueue/CommandLog.h"
+#include "RenderDevice.h"
+#include "Types.h"
+
+ENUM(ENullObjectType, UploadBuffer, Resource, PipelineState)
+
+class ONullRenderDevice;
+
+/**
+ * @brief Records nothing but the command counts, and validates every call against the state the device tracks: the recorder
+ * has to be open, draws need a pipeline state and a render target, barriers have to start from the current state of the resource.
+ */
+class ONullCommandRecorder : public ICommandRecorder
+{
+public:
+	explicit ONullCommandRecorder(ONullRenderDevice* Device);
+
+	void Begin() override;
+	void End() override;
+
+	void SetPipelineState(TRenderHandle PSO) override;
+	void SetResource(uint32_t RootIndex, uint64_t GPUAddress) override;
+	void ResourceBarriers(std::span<const SResourceBarrierDesc> Barriers) override;
+	void CopyResource(TRenderHandle Dest, TRenderHandle Src) override;
+	void SetRenderTarget(TRenderHandle RenderTarget) override;
+
+	void DrawIndexedInstanced(uint32_t IndexCount, uint32_t InstanceCount) override;
+	void Dispatch(uint32_t GroupsX, uint32_t GroupsY, uint32_t GroupsZ) override;
+
+	bool IsOpen() const;
+
+private:
+	ONullRenderDevice* Device = nullptr;
+	bool bIsOpen = false;
+	TRenderHandle CurrentPSO = InvalidRenderHandle;
+	TRenderHandle CurrentRenderTarget = InvalidRenderHandle;
+};
+
+/**
+ * @brief Stub presentation, rotates through back buffers that only exist as handles of the device.
+ */
+class ONullSwapChain : public ISwapChain
+{
+public:
+	ONullSwapChain(ONullRenderDevice* Device, uint32_t NumBackBuffers, uint32_t Width, uint32_t Height);
+
+	uint32_t GetNumBackBuffers() const override;
+	uint32_t GetCurrentBackBufferIndex() const override;
+	TRenderHandle GetBackBuffer(uint32_t Index) const override;
+
+	void Present() override;
+	void Resize(uint32_t Width, uint32_t Height) override;
+
+	uint32_t GetWidth() const;
+	uint32_t GetHeight() const;
+
+private:
+	ONullRenderDevice* Device = nullptr;
+	vector<TRenderHandle> BackBuffers;
+	uint32_t CurrentBackBuffer = 0;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+};
+
+/**
+ * @brief Render device without a graphics API. Upload buffers live in plain CPU memory, command recorders count and validate
+ * into one SCommandLog and the fence completes as soon as it is signaled. Built on every platform, RendererTests and RendererBench
+ * drive OFrameLoop through it. Objects are created and recorded from one thread.
+ */
+class ONullRenderDevice : public IRenderDevice
+{
+public:
+	SUploadBufferDesc CreateUploadBuffer(uint64_t Size) override;
+	TRenderHandle CreateResource(const string& Name, uint32_t InitialState) override;
+	TRenderHandle CreatePipelineState(const string& Name) override;
+
+	unique_ptr<ICommandRecorder> CreateCommandRecorder() override;
+	unique_ptr<ISwapChain> CreateSwapChain(uint32_t NumBackBuffers, uint32_t Width, uint32_t Height) override;
+
+	void Submit(ICommandRecorder* Recorder) override;
+	uint64_t Signal() override;
+	uint64_t GetCompletedFenceValue() const override;
+	void WaitForFenceValue(uint64_t FenceValue) override;
+
+	// Common for handles which aren't resources
+	uint32_t GetResourceState(TRenderHandle Resource) const;
+	const string& GetName(TRenderHandle Handle) const;
+	bool IsValid(TRenderHandle Handle, ENullObjectType Type) const;
+
+	const SCommandLog& GetCommandLog() const;
+	void ResetCommandLog();
+
+private:
+	friend ONullCommandRecorder;
+	friend ONullSwapChain;
+
+	struct SObject
+	{
+		string Name;
+		ENullObjectType Type = ENullObjectType::Resource;
+		uint32_t State = SResourceAccess::Common;
+
+		// A begin only barrier left the resource between Before and After
+		bool bIsSplitPending = false;
+		vector<uint8_t> Memory;
+	};
+
+	TRenderHandle CreateObject(const string& Name, ENullObjectType Type);
+	SObject* Find(TRenderHandle Handle, ENullObjectType Type);
+	bool Validate(bool bCondition, const char* Message);
+	void ResourceBarrier(const SResourceBarrierDesc& Barrier);
+
+	// Indexed by handle - 1
+	vector<SObject> Objects;
+	SCommandLog CommandLog;
+	uint64_t FenceValue = 0;
+};
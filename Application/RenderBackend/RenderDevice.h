@@ -0,0 +1,95 @@
+#pragma once
+#include "RenderGraph/Graph/BarrierPlanner.h"
+#include "Types.h"
+
+#include <span>
+
+// Opaque id of an object created by a render device, 0 is never handed out
+using TRenderHandle = uint64_t;
+
+inline constexpr TRenderHandle InvalidRenderHandle = 0;
+
+/**
+ * @brief Persistently mapped upload memory. Write every byte once and in order, on a GPU heap the memory is write combined.
+ */
+struct SUploadBufferDesc
+{
+	TRenderHandle Handle = InvalidRenderHandle;
+	uint8_t* MappedData = nullptr;
+	uint64_t GPUAddress = 0;
+	uint64_t Size = 0;
+};
+
+/**
+ * @brief Transition in the API independent states of SResourceAccess. Begin only barriers are finished by an End barrier
+ * with the same states later in the frame.
+ */
+struct SResourceBarrierDesc
+{
+	TRenderHandle Resource = InvalidRenderHandle;
+	uint32_t Before = SResourceAccess::Common;
+	uint32_t After = SResourceAccess::Common;
+	EBarrierSplit Split = EBarrierSplit::Full;
+};
+
+/**
+ * @brief Command list of a render device. A recorder is used by one thread at a time, between Begin and End.
+ */
+class ICommandRecorder
+{
+public:
+	virtual ~ICommandRecorder() = default;
+
+	virtual void Begin() = 0;
+	virtual void End() = 0;
+
+	virtual void SetPipelineState(TRenderHandle PSO) = 0;
+	virtual void SetResource(uint32_t RootIndex, uint64_t GPUAddress) = 0;
+
+	// One call per batch, see SBarrierPlan
+	virtual void ResourceBarriers(std::span<const SResourceBarrierDesc> Barriers) = 0;
+	virtual void CopyResource(TRenderHandle Dest, TRenderHandle Src) = 0;
+	virtual void SetRenderTarget(TRenderHandle RenderTarget) = 0;
+
+	virtual void DrawIndexedInstanced(uint32_t IndexCount, uint32_t InstanceCount) = 0;
+	virtual void Dispatch(uint32_t GroupsX, uint32_t GroupsY, uint32_t GroupsZ) = 0;
+};
+
+class ISwapChain
+{
+public:
+	virtual ~ISwapChain() = default;
+
+	virtual uint32_t GetNumBackBuffers() const = 0;
+	virtual uint32_t GetCurrentBackBufferIndex() const = 0;
+	virtual TRenderHandle GetBackBuffer(uint32_t Index) const = 0;
+
+	// The current back buffer has to be in the Present state, the next one becomes current
+	virtual void Present() = 0;
+	virtual void Resize(uint32_t Width, uint32_t Height) = 0;
+};
+
+/**
+ * @brief Thin interface over the graphics API, which is all the frame loop of OFrameLoop needs. The null device in
+ * NullRenderDevice.h implements it on the CPU alone so the loop runs and can be profiled on machines without a GPU.
+ */
+class IRenderDevice
+{
+public:
+	virtual ~IRenderDevice() = default;
+
+	virtual SUploadBufferDesc CreateUploadBuffer(uint64_t Size) = 0;
+
+	// Textures and render targets, created in the given state
+	virtual TRenderHandle CreateResource(const string& Name, uint32_t InitialState) = 0;
+	virtual TRenderHandle CreatePipelineState(const string& Name) = 0;
+
+	virtual unique_ptr<ICommandRecorder> CreateCommandRecorder() = 0;
+	virtual unique_ptr<ISwapChain> CreateSwapChain(uint32_t NumBackBuffers, uint32_t Width, uint32_t Height) = 0;
+
+	// Recorders are executed in submission order, Signal returns the fence value completed once all of them finished
+	virtual void Submit(ICommandRecorder* Recorder) = 0;
+	virtual uint64_t Signal() = 0;
+	virtual uint64_t GetCompletedFenceValue() const = 0;
+	virtual void WaitForFenceValue(uint64_t FenceValue) = 0;
+};
@@ -0,0 +1,173 @@
+#include "BarrierPlanner.h"
+
+#include "Logger.h"
+
+#include <bit>
+
+namespace
+{
+constexpr auto Accesses = MakeEnumTable<uint32_t>({
+	{ "Common", SResourceAccess::Common },
+	{ "RenderTarget", SResourceAccess::RenderTarget },
+	{ "DepthWrite", SResourceAccess::DepthWrite },
+	{ "DepthRead", SResourceAccess::DepthRead },
+	{ "ShaderResource", SResourceAccess::ShaderResource },
+	{ "UnorderedAccess", SResourceAccess::UnorderedAccess },
+	{ "CopySource", SResourceAccess::CopySource },
+	{ "CopyDest", SResourceAccess::CopyDest },
+	{ "Present", SResourceAccess::Present },
+});
+} // namespace
+
+uint32_t SResourceAccess::FromString(const string& Name)
+{
+	uint32_t result = Common;
+	for (const auto part : std::views::split(std::string_view(Name), '|'))
+	{
+		const std::string_view state(part.begin(), part.end());
+		if (const auto access = Accesses.FromString(state))
+		{
+			result |= *access;
+		}
+		else
+		{
+			LOG(Render, Warning, "Unknown resource state: {}", TEXT(string(state)));
+			return Common;
+		}
+	}
+
+	if (result != Common && !IsReadOnly(result) && !std::has_single_bit(result))
+	{
+		LOG(Render, Warning, "Only read only states can be combined: {}", TEXT(Name));
+		return Common;
+	}
+	return result;
+}
+
+uint32_t OBarrierPlanner::GetAccess(const SNodeInfo& Node, const string& Resource, bool bIsWrite)
+{
+	if (const auto state = Node.States.find(Resource); state != Node.States.end())
+	{
+		return SResourceAccess::FromString(state->second);
+	}
+	return bIsWrite ? SResourceAccess::RenderTarget : SResourceAccess::ShaderResource;
+}
+
+SBarrierPlan OBarrierPlanner::Plan(const vector<SNodeInfo>& Nodes, const SCompiledRenderGraph& Graph)
+{
+	struct SUse
+	{
+		size_t Position;
+		uint32_t Access;
+	};
+
+	struct SGroup
+	{
+		size_t First;
+		size_t Last;
+		uint32_t Access;
+	};
+
+	SBarrierPlan plan;
+	plan.Batches.resize(Graph.Order.size());
+
+	// Collect the accesses per resource in execution order. A node that reads and writes a resource uses the write state.
+	vector<string> resources;
+	unordered_map<string, vector<SUse>> uses;
+	for (size_t position = 0; position < Graph.Order.size(); position++)
+	{
+		const auto& node = Nodes[Graph.Order[position]];
+		auto addUse = [&](const string& Resource, bool bIsWrite) {
+			auto& resourceUses = uses[Resource];
+			if (resourceUses.empty())
+			{
+				resources.push_back(Resource);
+			}
+			const uint32_t access = GetAccess(node, Resource, bIsWrite);
+			if (!resourceUses.empty() && resourceUses.back().Position == position)
+			{
+				resourceUses.back().Access = bIsWrite ? access : resourceUses.back().Access;
+				return;
+			}
+			resourceUses.push_back({ position, access });
+		};
+
+		for (const auto& resource : node.Reads)
+		{
+			addUse(resource, false);
+		}
+		for (const auto& resource : node.Writes)
+		{
+			addUse(resource, true);
+		}
+	}
+
+	for (const auto& resource : resources)
+	{
+		const auto& resourceUses = uses[resource];
+
+		// Merge runs of read only accesses into one combined state
+		vector<SGroup> groups;
+		for (const auto& use : resourceUses)
+		{
+			const bool bCanMerge = !groups.empty() && SResourceAccess::IsReadOnly(groups.back().Access) && SResourceAccess::IsReadOnly(use.Access);
+			if (bCanMerge || (!groups.empty() && groups.back().Access == use.Access))
+			{
+				groups.back().Last = use.Position;
+				groups.back().Access |= use.Access;
+			}
+			else
+			{
+				groups.push_back({ use.Position, use.Position, use.Access });
+			}
+		}
+
+		// The frame starts in the state the previous one ended with
+		uint32_t state = groups.back().Access;
+		plan.InitialStates[resource] = state;
+
+		uint32_t naiveState = state;
+		for (const auto& use : resourceUses)
+		{
+			if (use.Access != naiveState)
+			{
+				plan.NumNaiveBarriers++;
+				naiveState = use.Access;
+			}
+		}
+		if (naiveState != state)
+		{
+			// Without planning the resource also has to be brought back for the next frame
+			plan.NumNaiveBarriers++;
+		}
+
+		for (size_t i = 0; i < groups.size(); i++)
+		{
+			const auto& group = groups[i];
+			if (group.Access == state)
+			{
+				continue;
+			}
+
+			plan.NumBarriers++;
+			const bool bHasGap = i > 0 && group.First > groups[i - 1].Last + 1;
+			if (bHasGap)
+			{
+				plan.Batches[groups[i - 1].Last + 1].push_back({ resource, state, group.Access, EBarrierSplit::Begin });
+				plan.Batches[group.First].push_back({ resource, state, group.Access, EBarrierSplit::End });
+				plan.NumSplitBarriers++;
+			}
+			else
+			{
+				plan.Batches[group.First].push_back({ resource, state, group.Access, EBarrierSplit::Full });
+			}
+			state = group.Access;
+		}
+	}
+
+	for (const auto& batch : plan.Batches)
+	{
+		plan.NumBatches += !batch.empty();
+	}
+	return plan;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "RenderGraphCompiler.h"
+#include "RenderNodeInfo.h"
+#include "Types.h"
+
+/**
+ * @brief API independent resource access states. Read only states may be combined into one mask.
+ */
+struct SResourceAccess
+{
+	static constexpr uint32_t Common = 0;
+	static constexpr uint32_t RenderTarget = 1 << 0;
+	static constexpr uint32_t DepthWrite = 1 << 1;
+	static constexpr uint32_t DepthRead = 1 << 2;
+	static constexpr uint32_t ShaderResource = 1 << 3;
+	static constexpr uint32_t UnorderedAccess = 1 << 4;
+	static constexpr uint32_t CopySource = 1 << 5;
+	static constexpr uint32_t CopyDest = 1 << 6;
+	static constexpr uint32_t Present = 1 << 7;
+
+	static constexpr uint32_t ReadOnly = DepthRead | ShaderResource | CopySource;
+
+	static bool IsReadOnly(uint32_t Access)
+	{
+		return Access != Common && (Access & ~ReadOnly) == 0;
+	}
+
+	// Read only states may be combined with '|', e.g. "CopySource|ShaderResource"
+	static uint32_t FromString(const string& Name);
+};
+
+ENUM(EBarrierSplit, Full, Begin, End)
+
+struct SPlannedBarrier
+{
+	string Resource;
+	uint32_t Before = SResourceAccess::Common;
+	uint32_t After = SResourceAccess::Common;
+	EBarrierSplit Split = EBarrierSplit::Full;
+};
+
+struct SBarrierPlan
+{
+	// Barriers issued right before the node at the same position of the compiled order, one ResourceBarrier call per non empty batch
+	vector<vector<SPlannedBarrier>> Batches;
+
+	// State every resource is expected in at the beginning of a frame, which is also the state the frame leaves it in
+	unordered_map<string, uint32_t> InitialStates;
+
+	// One barrier and one call per state change of every node access, as issued without planning
+	uint32_t NumNaiveBarriers = 0;
+	uint32_t NumBarriers = 0;
+	uint32_t NumSplitBarriers = 0;
+	uint32_t NumBatches = 0;
+};
+
+/**
+ * @brief Derives the minimal set of transitions from the resource accesses the nodes declare.
+ * Consecutive read only accesses are merged into one combined state, transitions before the same node are batched together
+ * and transitions separated from the previous access by unrelated nodes are split into begin/end pairs.
+ */
+class OBarrierPlanner
+{
+public:
+	static SBarrierPlan Plan(const vector<SNodeInfo>& Nodes, const SCompiledRenderGraph& Graph);
+	static uint32_t GetAccess(const SNodeInfo& Node, const string& Resource, bool bIsWrite);
+};
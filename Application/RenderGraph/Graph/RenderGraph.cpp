@@ -1,7 +1,11 @@
-
 #include "RenderGraph.h"
 
 #include "Application.h"
+#include "CommandQueue/CommandQueue.h"
+#include "Exception.h"
+#include "Stats/Stats.h"
+#include "RenderGraph/Nodes/BilateralBlurNode/BilateralBlurNode.h"
+#include "RenderGraph/Nodes/BlurNode/BlurNode.h"
 #include "RenderGraph/Nodes/DefaultNode/DefaultRenderNode.h"
 #include "RenderGraph/Nodes/PostProcessNode/PostProcessNode.h"
 #include "RenderGraph/Nodes/PresentNode/PresentNode.h"
@@ -18,18 +22,60 @@ void ORenderGraph::Initialize(OGraphicsPipelineManager* PipelineManager, OComman
 	this->PipelineManager = PipelineManager;
 	CommandQueue = OtherCommandQueue;
 
-	auto graph = Reader->LoadRenderGraph();
-	for (auto& node : graph)
+	const auto graph = Reader->LoadRenderGraph();
+	Build(graph, ORenderGraphCompiler::Compile(graph));
+}
+
+bool ORenderGraph::ReloadConfig(ID3D12Device* Device)
+{
+	const auto diff = Reader->ReloadList("RenderGraph", "Name");
+	if (!diff || diff->IsEmpty())
 	{
+		return false;
+	}
+
+	const auto graph = Reader->LoadRenderGraph();
+	auto compiled = ORenderGraphCompiler::Compile(graph);
+	if (!compiled.bIsValid)
+	{
+		LOG(Render, Warning, "The changed render graph doesn't compile, keeping the current one");
+		return false;
+	}
+
+	LOG(Render, Log, "Render graph config changed: {} nodes added, {} removed, {} changed. Recompiling", diff->Added.size(), diff->Removed.size(), diff->Changed.size());
+
+	// Frames in flight still use the previous nodes and transient heaps
+	OEngine::Get()->FlushGPU();
+	Build(graph, std::move(compiled));
+	AllocateTransientResources(Device);
+	return true;
+}
+
+void ORenderGraph::Build(const vector<SNodeInfo>& Graph, SCompiledRenderGraph Compiled)
+{
+	CompiledGraph = std::move(Compiled);
+	BarrierPlan = OBarrierPlanner::Plan(Graph, CompiledGraph);
+	ResourceLifetimes = OTransientAllocator::ComputeLifetimes(Graph, CompiledGraph);
+	AliasingBarriers.assign(CompiledGraph.Order.size(), {});
+
+	// Begin barriers of the previous graph are never ended, its positions don't match the new plan
+	PendingSplitBarriers.clear();
+	PlannedResources.clear();
+	StateMismatches.clear();
+	Nodes.clear();
+	Nodes.resize(Graph.size());
+	NodesReady.assign(Graph.size(), false);
+	NodesFailed.assign(Graph.size(), false);
+	bAllNodesSettled = false;
+	for (const auto index : CompiledGraph.Order)
+	{
+		const auto& node = Graph[index];
 		auto newNode = ResolveNodeType(node.Name);
-		if (Head == nullptr)
-		{
-			Head = newNode.get();
-		}
-		newNode->Initialize(node, OtherCommandQueue, this, PipelineManager->FindPSO(node.PSOType));
-		Graph[node.Name] = newNode.get();
-		Nodes.push_back(move(newNode));
+		newNode->Initialize(node, CommandQueue, this, PipelineManager->FindPSO(node.PSOType).Description);
+		Nodes[index] = move(newNode);
 	}
+	BuildRecordingGroups();
+	LogSchedule(Graph);
 }
 
 void ORenderGraph::Execute()
@@ -37,60 +83,476 @@ void ORenderGraph::Execute()
 	auto engine = OEngine::Get();
 	if (engine->GetSRVHeap())
 	{
-		auto currentNode = Head;
+		using TClock = std::chrono::high_resolution_clock;
+		LastRecordingTime = {};
 		engine->GetWindow()->SetViewport(CommandQueue->GetCommandList().Get());
 		ORenderTargetBase* texture = OEngine::Get()->GetOffscreenRT();
 		CommandQueue->SetRenderTarget(texture);
-		while (currentNode != nullptr)
+
+		// Readiness and permutations are picked once per frame on this thread, recording threads only read the result
+		UpdateNodesReady();
+		for (const auto index : CompiledGraph.Order)
 		{
-			LOG(Render, Log, "Executing node: {}", TEXT(currentNode->GetNodeInfo().Name));
-			currentNode->SetupCommonResources();
-			texture = currentNode->Execute(texture);
-			currentNode = Graph[currentNode->GetNextNode()];
+			if (NodesReady[index])
+			{
+				Nodes[index]->SetActivePSO(PipelineManager->ResolvePermutation(Nodes[index]->GetBasePSO()));
+			}
 		}
+		const auto elapsedSince = [](TClock::time_point Start) {
+			return std::chrono::duration_cast<std::chrono::microseconds>(TClock::now() - Start);
+		};
+
+		for (const auto& group : RecordingGroups)
+		{
+			if (group.bParallel)
+			{
+				const auto start = TClock::now();
+				texture = RecordParallel(group, texture);
+				LastRecordingTime += elapsedSince(start);
+				continue;
+			}
+
+			for (size_t position = group.Begin; position < group.End; position++)
+			{
+				// The output node submits the frame and waits for the GPU, that is not recording
+				const bool bIsRecording = !Nodes[CompiledGraph.Order[position]]->GetNodeInfo().bIsOutput;
+				const auto start = TClock::now();
+				texture = RecordNode(position, texture);
+				LastRecordingTime += bIsRecording ? elapsedSince(start) : std::chrono::microseconds{ 0 };
+			}
+		}
+		STAT_SAMPLE(RecordingTimeUs, LastRecordingTime.count());
 	}
 	else
 	{
 		LOG(Render, Error, "SRVHeap is not initialized!");
 	}
 }
+
+void ORenderGraph::UpdateNodesReady()
+{
+	if (bAllNodesSettled && SettledPSOGeneration == PipelineManager->GetPSOGeneration())
+	{
+		return;
+	}
+
+	bAllNodesSettled = true;
+	SettledPSOGeneration = PipelineManager->GetPSOGeneration();
+	for (const auto index : CompiledGraph.Order)
+	{
+		const auto& node = Nodes[index];
+		bool bReady = true;
+		bool bFailed = false;
+		const auto check = [&](const SPSOHandle& Handle) {
+			bReady = bReady && Handle.IsReady();
+			bFailed = bFailed || Handle.HasFailed();
+		};
+		if (node->GetBasePSO() != nullptr)
+		{
+			check(PipelineManager->FindPSO(node->GetNodeInfo().PSOType));
+		}
+		for (const auto& name : node->GetRequiredPSOs())
+		{
+			check(PipelineManager->FindPSO(name));
+		}
+
+		if (bReady && !NodesReady[index])
+		{
+			LOG(Render, Log, "Node {} is ready", TEXT(node->GetNodeInfo().Name));
+		}
+		if (bFailed && !NodesFailed[index])
+		{
+			LOG(Render, Warning, "Node {} is skipped, a PSO it uses failed to build", TEXT(node->GetNodeInfo().Name));
+		}
+		NodesReady[index] = bReady;
+		NodesFailed[index] = bFailed;
+		bAllNodesSettled = bAllNodesSettled && (bReady || bFailed);
+	}
+}
+
+ORenderTargetBase* ORenderGraph::RecordNode(size_t Position, ORenderTargetBase* RenderTarget)
+{
+	const auto& node = Nodes[CompiledGraph.Order[Position]];
+	IssueBarriers(Position);
+
+	// Barriers still go out, the state tracking of the following nodes relies on them
+	if (!NodesReady[CompiledGraph.Order[Position]])
+	{
+		STAT_INC(RenderNodesSkipped);
+		return RenderTarget;
+	}
+	LOG(Render, Log, "Executing node: {}", TEXT(node->GetNodeInfo().Name));
+	node->SetupCommonResources();
+	return node->Execute(RenderTarget);
+}
+
+ORenderTargetBase* ORenderGraph::RecordParallel(const SRecordingGroup& Group, ORenderTargetBase* RenderTarget)
+{
+	// Only the first node of a group may have barriers, they go to the list recorded before the group
+	IssueBarriers(Group.Begin);
+
+	vector<SCommandContext*> contexts(Group.End - Group.Begin);
+	for (auto& context : contexts)
+	{
+		context = CommandQueue->AcquireContext();
+	}
+
+	RecordingThreads->ParallelFor(contexts.size(), [&](size_t Index) {
+		const auto nodeIndex = CompiledGraph.Order[Group.Begin + Index];
+		if (!NodesReady[nodeIndex])
+		{
+			// The context is submitted empty
+			STAT_INC(RenderNodesSkipped);
+			return;
+		}
+		const auto& node = Nodes[nodeIndex];
+		LOG(Render, Log, "Recording node: {}", TEXT(node->GetNodeInfo().Name));
+		CommandQueue->BindThreadContext(contexts[Index]);
+		PrepareContext(RenderTarget);
+		node->SetupCommonResources();
+		node->Execute(RenderTarget);
+		CommandQueue->BindThreadContext(nullptr);
+	});
+
+	CommandQueue->EnqueueContexts(contexts);
+	PrepareContext(RenderTarget);
+	return RenderTarget;
+}
+
+void ORenderGraph::PrepareContext(ORenderTargetBase* RenderTarget) const
+{
+	const auto engine = OEngine::Get();
+	const auto commandList = CommandQueue->GetCommandList();
+	ID3D12DescriptorHeap* heaps[] = { engine->GetSRVHeap().Get() };
+	commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+	engine->GetWindow()->SetViewport(commandList.Get());
+	CommandQueue->BindRenderTarget(RenderTarget);
+}
+
+void ORenderGraph::BuildRecordingGroups()
+{
+	RecordingGroups.clear();
+	for (size_t position = 0; position < CompiledGraph.Order.size(); position++)
+	{
+		const bool bParallel = NumRecordingThreads > 0 && Nodes[CompiledGraph.Order[position]]->CanRecordInParallel();
+
+		// Barriers have to be recorded in order, a node with barriers starts a new group
+		const bool bHasBarriers = !BarrierPlan.Batches[position].empty() || !AliasingBarriers[position].empty();
+		if (!RecordingGroups.empty())
+		{
+			auto& group = RecordingGroups.back();
+			if (group.bParallel == bParallel && (!bParallel || !bHasBarriers))
+			{
+				group.End++;
+				continue;
+			}
+		}
+		RecordingGroups.push_back({ position, position + 1, bParallel });
+	}
+
+	// A single node gains nothing from a list of its own
+	for (auto& group : RecordingGroups)
+	{
+		group.bParallel = group.bParallel && group.End - group.Begin > 1;
+	}
+}
+
+void ORenderGraph::SetNumRecordingThreads(uint32_t NumThreads)
+{
+	NumRecordingThreads = NumThreads;
+	RecordingThreads = NumThreads > 0 ? make_unique<OThreadPool>(NumThreads - 1) : nullptr;
+	BuildRecordingGroups();
+
+	for (const auto& group : RecordingGroups)
+	{
+		if (group.bParallel)
+		{
+			LOG(Render, Log, "Recording {} nodes from position {} in parallel on {} threads", group.End - group.Begin, group.Begin, NumThreads);
+		}
+	}
+}
+
+uint32_t ORenderGraph::GetNumRecordingThreads() const
+{
+	return NumRecordingThreads;
+}
+
+std::chrono::microseconds ORenderGraph::GetLastRecordingTime() const
+{
+	return LastRecordingTime;
+}
 void ORenderGraph::SetPSO(const string& Type) const
 {
-	CommandQueue->SetPipelineState(PipelineManager->FindPSO(Type));
+	CommandQueue->SetPipelineState(PipelineManager->FindPSO(Type).Get());
 }
 
 SPSODescriptionBase* ORenderGraph::FindPSOInfo(const string& Name) const
 {
-	return PipelineManager->FindPSO(Name);
+	return PipelineManager->FindPSO(Name).Get();
 }
 
-// TODO Resolve automatically the type of the node
-unique_ptr<ORenderNode> ORenderGraph::ResolveNodeType(const string& Type)
+const SCompiledRenderGraph& ORenderGraph::GetCompiledGraph() const
+{
+	return CompiledGraph;
+}
+
+const SBarrierPlan& ORenderGraph::GetBarrierPlan() const
 {
+	return BarrierPlan;
+}
 
-	if (Type == "OpaqueDynamicReflections")
+void ORenderGraph::BindResource(const string& Name, TResourceResolver Resolver)
+{
+	ResourceResolvers[Name] = move(Resolver);
+}
+
+void ORenderGraph::BindTransientResource(const string& Name, SResourceInfo* Resource, std::function<void()> OnPlaced)
+{
+	BindResource(Name, [Resource]() { return Resource; });
+	TransientResources[Name] = { Resource, move(OnPlaced) };
+}
+
+void ORenderGraph::AllocateTransientResources(ID3D12Device* Device)
+{
+	struct SHeapCategory
+	{
+		D3D12_HEAP_FLAGS Flags;
+		vector<STransientResourceDesc> Descs;
+		vector<pair<STransientBinding*, D3D12_RESOURCE_DESC>> Bindings;
+	};
+
+	// Resource heap tier 1 only allows one category of resources per heap
+	SHeapCategory categories[] = {
+		{ D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS },
+		{ D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES },
+		{ D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES }
+	};
+
+	for (auto& [name, binding] : TransientResources)
 	{
-		return make_unique<OReflectionNode>();
+		const auto lifetime = ResourceLifetimes.find(name);
+		if (lifetime == ResourceLifetimes.end() || binding.Resource == nullptr || binding.Resource->Resource == nullptr)
+		{
+			LOG(Render, Warning, "Transient resource {} is not used by the render graph, keeping it committed", TEXT(name));
+			continue;
+		}
+
+		const auto desc = binding.Resource->Resource->GetDesc();
+		const auto info = Device->GetResourceAllocationInfo(0, 1, &desc);
+		auto& category = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER                                                ? categories[0]
+		                 : desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) ? categories[2]
+		                                                                                                                    : categories[1];
+		category.Descs.push_back({ name, info.SizeInBytes, info.Alignment, lifetime->second });
+		category.Bindings.emplace_back(&binding, desc);
 	}
-	if (Type == "Opaque")
+
+	// The previous heaps are released only after their resources were replaced
+	vector<ComPtr<ID3D12Heap>> heaps;
+	AliasingBarriers.assign(CompiledGraph.Order.size(), {});
+	TransientMemorySaved = 0;
+	uint64_t heapSize = 0;
+	for (auto& category : categories)
 	{
-		return make_unique<ODefaultRenderNode>();
+		if (category.Descs.empty())
+		{
+			continue;
+		}
+
+		const auto layout = OTransientAllocator::Allocate(category.Descs);
+		ComPtr<ID3D12Heap> heap;
+		const CD3DX12_HEAP_DESC heapDesc(layout.HeapSize, D3D12_HEAP_TYPE_DEFAULT, layout.HeapAlignment, category.Flags);
+		THROW_IF_FAILED(Device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)));
+		heap->SetName(L"RenderGraphTransientHeap");
+
+		unordered_map<uint32_t, uint32_t> slotUsers;
+		for (const auto& placement : layout.Placements)
+		{
+			slotUsers[placement.Slot]++;
+		}
+
+		for (size_t i = 0; i < category.Descs.size(); i++)
+		{
+			auto& [binding, desc] = category.Bindings[i];
+			const auto& placement = layout.Placements[i];
+			ComPtr<ID3D12Resource> resource;
+			THROW_IF_FAILED(Device->CreatePlacedResource(heap.Get(), placement.Offset, &desc, binding->Resource->CurrentState, nullptr, IID_PPV_ARGS(&resource)));
+			resource->SetName(UTF8ToWString(category.Descs[i].Name).c_str());
+			binding->Resource->Resource = resource;
+
+			if (slotUsers[placement.Slot] > 1)
+			{
+				AliasingBarriers[category.Descs[i].Lifetime.FirstUse].push_back(binding->Resource);
+			}
+			binding->OnPlaced();
+		}
+
+		heaps.push_back(heap);
+		TransientMemorySaved += layout.GetSavedBytes();
+		heapSize += layout.HeapSize;
 	}
-	else if (Type == "Transparent")
+
+	TransientHeaps = move(heaps);
+	BuildRecordingGroups();
+	LOG(Render, Log, "Render graph transient memory: {} bytes in {} heaps, {} bytes saved by aliasing", heapSize, TransientHeaps.size(), TransientMemorySaved);
+}
+
+uint64_t ORenderGraph::GetTransientMemorySaved() const
+{
+	return TransientMemorySaved;
+}
+
+namespace
+{
+D3D12_RESOURCE_STATES ToResourceState(uint32_t Access)
+{
+	if (Access & SResourceAccess::Present)
 	{
-		return make_unique<ODefaultRenderNode>();
+		return D3D12_RESOURCE_STATE_PRESENT;
 	}
-	else if (Type == "PostProcess")
+
+	D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::RenderTarget ? D3D12_RESOURCE_STATE_RENDER_TARGET : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::DepthWrite ? D3D12_RESOURCE_STATE_DEPTH_WRITE : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::DepthRead ? D3D12_RESOURCE_STATE_DEPTH_READ : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::ShaderResource ? D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::UnorderedAccess ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::CopySource ? D3D12_RESOURCE_STATE_COPY_SOURCE : D3D12_RESOURCE_STATE_COMMON;
+	state |= Access & SResourceAccess::CopyDest ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_COMMON;
+	return state;
+}
+} // namespace
+
+void ORenderGraph::IssueBarriers(size_t Position)
+{
+	const auto& batch = BarrierPlan.Batches[Position];
+	const auto& aliased = AliasingBarriers[Position];
+	if (batch.empty() && aliased.empty())
+	{
+		return;
+	}
+
+	vector<ID3D12Resource*> aliasedResources;
+	aliasedResources.reserve(aliased.size());
+	for (const auto resource : aliased)
+	{
+		aliasedResources.push_back(resource->Resource.Get());
+	}
+
+	// Transitions start from the planned state. The tracked state only differs if a node leaves a resource in another state than
+	// it declares, or on the first transition after the resource was created. The barrier then starts from the tracked state.
+	vector<SResourceTransition> transitions;
+	transitions.reserve(batch.size());
+	for (const auto& barrier : batch)
+	{
+		const auto resolver = ResourceResolvers.find(barrier.Resource);
+		SResourceInfo* resource = resolver != ResourceResolvers.end() ? resolver->second() : nullptr;
+		if (resource == nullptr)
+		{
+			continue;
+		}
+
+		const auto before = ToResourceState(barrier.Before);
+		const bool bIsPlannedState = resource->CurrentState == before;
+		if (!bIsPlannedState && PlannedResources.contains(barrier.Resource))
+		{
+			STAT_INC(BarrierStateMismatches);
+			if (StateMismatches.insert(barrier.Resource).second)
+			{
+				LOG(Render, Warning, "{} is not in the planned state before node {}, a node leaves it in another state than it declares", TEXT(barrier.Resource), TEXT(Nodes[CompiledGraph.Order[Position]]->GetNodeInfo().Name));
+			}
+		}
+
+		// Once a transition of the plan completed, the resource has to follow it
+		if (barrier.Split != EBarrierSplit::Begin)
+		{
+			PlannedResources.insert(barrier.Resource);
+		}
+
+		SResourceTransition transition{ resource, ToResourceState(barrier.After) };
+		if (bIsPlannedState)
+		{
+			transition.Before = before;
+		}
+
+		switch (barrier.Split)
+		{
+		case EBarrierSplit::Begin:
+			if (!bIsPlannedState)
+			{
+				// Let the end barrier do the full transition
+				continue;
+			}
+			transition.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+			PendingSplitBarriers[barrier.Resource] = before;
+			break;
+		case EBarrierSplit::End:
+			// The end has to repeat the begin, unless the resource was touched in between
+			if (const auto pending = PendingSplitBarriers.find(barrier.Resource); pending != PendingSplitBarriers.end())
+			{
+				if (pending->second == resource->CurrentState)
+				{
+					transition.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+					transition.Before = pending->second;
+				}
+				PendingSplitBarriers.erase(pending);
+			}
+			break;
+		default:
+			break;
+		}
+		transitions.push_back(transition);
+	}
+	CommandQueue->ResourceBarriers(transitions, aliasedResources);
+}
+
+void ORenderGraph::LogSchedule(const vector<SNodeInfo>& NodeInfos) const
+{
+	LOG(Render, Log, "Render graph barriers: {} planned ({} split) in {} batches, {} without planning", BarrierPlan.NumBarriers, BarrierPlan.NumSplitBarriers, BarrierPlan.NumBatches, BarrierPlan.NumNaiveBarriers);
+
+	for (const auto index : CompiledGraph.Culled)
 	{
-		return make_unique<OPostProcessNode>();
+		LOG(Render, Log, "Node {} is culled, no output depends on it", TEXT(NodeInfos[index].Name));
 	}
-	else if (Type == "UI")
+
+	for (size_t level = 0; level < CompiledGraph.Levels.size(); level++)
 	{
-		return make_unique<OUIRenderNode>();
+		string names;
+		for (const auto index : CompiledGraph.Levels[level])
+		{
+			const uint32_t passes = Nodes[index]->GetNumIndependentPasses();
+			names += names.empty() ? "" : ", ";
+			names += NodeInfos[index].Name + (passes > 1 ? " (" + std::to_string(passes) + " independent passes)" : "");
+		}
+		LOG(Render, Log, "Render graph level {}: {}", level, TEXT(names));
 	}
-	else if (Type == "Present")
+}
+
+namespace
+{
+template<typename TNode>
+unique_ptr<ORenderNode> MakeNode()
+{
+	return make_unique<TNode>();
+}
+
+using TNodeFactory = unique_ptr<ORenderNode> (*)();
+constexpr auto NodeFactories = MakeEnumTable<TNodeFactory>({
+	{ "OpaqueDynamicReflections", &MakeNode<OReflectionNode> },
+	{ "Opaque", &MakeNode<ODefaultRenderNode> },
+	{ "Transparent", &MakeNode<ODefaultRenderNode> },
+	{ "PostProcess", &MakeNode<OPostProcessNode> },
+	{ "Blur", &MakeNode<OBlurNode> },
+	{ "BilateralBlur", &MakeNode<OBilateralBlurNode> },
+	{ "UI", &MakeNode<OUIRenderNode> },
+	{ "Present", &MakeNode<OPresentNode> },
+});
+} // namespace
+
+unique_ptr<ORenderNode> ORenderGraph::ResolveNodeType(const string& Type)
+{
+	if (const auto factory = NodeFactories.FromString(Type))
 	{
-		return make_unique<OPresentNode>();
+		return (*factory)();
 	}
 	LOG(Render, Warning, "Node type not found: {}", TEXT(Type));
 	return make_unique<ODefaultRenderNode>();
@@ -1,26 +1,120 @@
 #pragma once
+#include "RenderGraph/Graph/BarrierPlanner.h"
+#include "RenderGraph/Graph/RenderGraphCompiler.h"
+#include "RenderGraph/Graph/TransientAllocator.h"
 #include "RenderGraph/Nodes/RenderNode.h"
 #include "RenderGraphReader/RenderGraphReader.h"
+#include "Threading/ThreadPool.h"
 #include "Types.h"
 
+#include <chrono>
+
 struct SPSODescriptionBase;
+struct SResourceInfo;
 class OGraphicsPipelineManager;
 class ORenderGraph
 {
 public:
 	ORenderGraph();
-	using ODependencyInfo = unordered_map<string, ORenderNode*>;
 	void Initialize(OGraphicsPipelineManager* PipelineManager, OCommandQueue* OtherCommandQueue);
+
+	// Recompiles the graph if its config changed on disk and places the transient resources again. A graph that doesn't
+	// compile is rejected and the current one keeps running. Call between frames.
+	bool ReloadConfig(ID3D12Device* Device);
 	void Execute();
 	void SetPSO(const string& Type) const;
+
+	// Null while the PSO is still building
 	SPSODescriptionBase* FindPSOInfo(const string& Name) const;
 	static unique_ptr<ORenderNode> ResolveNodeType(const string& Type);
+	const SCompiledRenderGraph& GetCompiledGraph() const;
+	const SBarrierPlan& GetBarrierPlan() const;
+
+	using TResourceResolver = std::function<SResourceInfo*()>;
+
+	// Maps a graph resource name onto the engine resource, resolved every frame since e.g. the back buffer changes
+	void BindResource(const string& Name, TResourceResolver Resolver);
+
+	// Transient resources only live between their first and last use in the compiled order, so their memory may be shared.
+	// OnPlaced runs once the resource was recreated in the transient heap, owners rebuild their views there.
+	void BindTransientResource(const string& Name, SResourceInfo* Resource, std::function<void()> OnPlaced);
+
+	// Moves all bound transient resources into placed heaps, has to run again whenever the owners recreate them
+	void AllocateTransientResources(ID3D12Device* Device);
+	uint64_t GetTransientMemorySaved() const;
+
+	// 0 records every node into the queue's command list on the calling thread,
+	// otherwise runs of parallel capable nodes get own command lists recorded by this many threads
+	void SetNumRecordingThreads(uint32_t NumThreads);
+	uint32_t GetNumRecordingThreads() const;
+
+	// CPU time of the last Execute spent recording, without the output node which submits the frame
+	std::chrono::microseconds GetLastRecordingTime() const;
 
 private:
+	struct SRecordingGroup
+	{
+		// Range of positions in the compiled order
+		size_t Begin = 0;
+		size_t End = 0;
+		bool bParallel = false;
+	};
+
+	struct STransientBinding
+	{
+		SResourceInfo* Resource = nullptr;
+		std::function<void()> OnPlaced;
+	};
+
+	// Replaces the nodes and everything derived from the schedule
+	void Build(const vector<SNodeInfo>& Graph, SCompiledRenderGraph Compiled);
+	void LogSchedule(const vector<SNodeInfo>& NodeInfos) const;
+
+	// A node records nothing until every PSO it uses is built, only its barriers are issued. Nodes using a PSO that failed
+	// to build are skipped until a reload swaps PSOs.
+	void UpdateNodesReady();
+	void IssueBarriers(size_t Position);
+	void BuildRecordingGroups();
+	ORenderTargetBase* RecordNode(size_t Position, ORenderTargetBase* RenderTarget);
+	ORenderTargetBase* RecordParallel(const SRecordingGroup& Group, ORenderTargetBase* RenderTarget);
+
+	// Fresh command lists start without any state, sets what the nodes expect to be inherited
+	void PrepareContext(ORenderTargetBase* RenderTarget) const;
+
 	unique_ptr<ORenderGraphReader> Reader;
+
+	// Indexed by declaration order, culled nodes stay null
 	vector<unique_ptr<ORenderNode>> Nodes;
-	ODependencyInfo Graph;
-	ORenderNode* Head = nullptr;
+	vector<bool> NodesReady;
+	vector<bool> NodesFailed;
+
+	// Every node is either ready or failed, nothing changes until the PSO generation does
+	bool bAllNodesSettled = false;
+	uint32_t SettledPSOGeneration = 0;
+	SCompiledRenderGraph CompiledGraph;
+	SBarrierPlan BarrierPlan;
+	unordered_map<string, TResourceResolver> ResourceResolvers;
+
+	// Ordered so the heap layout doesn't depend on hashing
+	map<string, STransientBinding> TransientResources;
+	unordered_map<string, SResourceLifetime> ResourceLifetimes;
+	vector<ComPtr<ID3D12Heap>> TransientHeaps;
+
+	// Per order position, transient resources taking over memory another transient used before
+	vector<vector<SResourceInfo*>> AliasingBarriers;
+	uint64_t TransientMemorySaved = 0;
+
+	vector<SRecordingGroup> RecordingGroups;
+	unique_ptr<OThreadPool> RecordingThreads;
+	uint32_t NumRecordingThreads = 0;
+	std::chrono::microseconds LastRecordingTime{ 0 };
+
+	// Resources with a begin only barrier in flight, by the state the barrier started from
+	unordered_map<string, D3D12_RESOURCE_STATES> PendingSplitBarriers;
+
+	// Resources transitioned by the plan since the graph was built, and those of them found in another state than planned
+	unordered_set<string> PlannedResources;
+	unordered_set<string> StateMismatches;
 	OCommandQueue* CommandQueue;
 	OGraphicsPipelineManager* PipelineManager;
 };
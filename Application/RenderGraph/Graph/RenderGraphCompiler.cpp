@@ -0,0 +1,182 @@
+#include "RenderGraphCompiler.h"
+
+#include "Logger.h"
+
+#include <queue>
+
+namespace
+{
+void AddEdge(vector<vector<size_t>>& Edges, size_t From, size_t To)
+{
+	if (From != To && std::ranges::find(Edges[To], From) == Edges[To].end())
+	{
+		Edges[To].push_back(From);
+	}
+}
+} // namespace
+
+SCompiledRenderGraph ORenderGraphCompiler::Compile(const vector<SNodeInfo>& Nodes)
+{
+	SCompiledRenderGraph result;
+	const size_t numNodes = Nodes.size();
+	result.Dependencies.resize(numNodes);
+
+	// Producers only (read after write, write after write), used for culling.
+	// Write after read edges order the passes but don't keep the reader alive.
+	vector<vector<size_t>> producers(numNodes);
+
+	// Every write creates a new version of the resource, versions are numbered by the declaration order of their writers
+	unordered_map<string, vector<size_t>> writers;
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		for (const auto& resource : Nodes[i].Writes)
+		{
+			auto& resourceWriters = writers[resource];
+			if (resourceWriters.empty() || resourceWriters.back() != i)
+			{
+				resourceWriters.push_back(i);
+			}
+		}
+	}
+
+	for (const auto& resourceWriters : writers | std::views::values)
+	{
+		for (size_t version = 1; version < resourceWriters.size(); version++)
+		{
+			AddEdge(result.Dependencies, resourceWriters[version - 1], resourceWriters[version]);
+			AddEdge(producers, resourceWriters[version - 1], resourceWriters[version]);
+		}
+	}
+
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		for (const auto& resource : Nodes[i].Reads)
+		{
+			const auto resourceWriters = writers.find(resource);
+			if (resourceWriters == writers.end())
+			{
+				LOG(Render, Error, "Node {} reads {} which no node writes!", TEXT(Nodes[i].Name), TEXT(resource));
+				result.bIsValid = false;
+				continue;
+			}
+
+			// A read consumes the version written last before the reader. Readers declared ahead of every writer consume the
+			// first version, so the graph doesn't depend on the order the nodes are declared in.
+			const auto& versions = resourceWriters->second;
+			const auto next = std::ranges::lower_bound(versions, i);
+			const size_t version = next == versions.begin() ? 0 : next - versions.begin() - 1;
+			const size_t producer = versions[version];
+			if (producer == i)
+			{
+				LOG(Render, Error, "Node {} reads {} before anything writes it!", TEXT(Nodes[i].Name), TEXT(resource));
+				result.bIsValid = false;
+				continue;
+			}
+
+			AddEdge(result.Dependencies, producer, i);
+			AddEdge(producers, producer, i);
+
+			// The next version may only be written once the reader is done with this one
+			if (version + 1 < versions.size())
+			{
+				AddEdge(result.Dependencies, i, versions[version + 1]);
+			}
+		}
+	}
+
+	// Walk back from the outputs, everything not reached is culled
+	vector<bool> alive(numNodes, false);
+	vector<size_t> stack;
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		if (Nodes[i].bIsOutput)
+		{
+			alive[i] = true;
+			stack.push_back(i);
+		}
+	}
+	if (stack.empty() && numNodes > 0)
+	{
+		LOG(Render, Warning, "Render graph has no output nodes, all nodes are culled");
+	}
+
+	while (!stack.empty())
+	{
+		const size_t node = stack.back();
+		stack.pop_back();
+		for (const auto producer : producers[node])
+		{
+			if (!alive[producer])
+			{
+				alive[producer] = true;
+				stack.push_back(producer);
+			}
+		}
+	}
+
+	// Kahn's algorithm over the surviving nodes, ties are resolved by declaration order to keep the schedule stable
+	vector<vector<size_t>> successors(numNodes);
+	vector<uint32_t> numPending(numNodes, 0);
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		if (!alive[i])
+		{
+			result.Culled.push_back(i);
+			continue;
+		}
+		for (const auto dependency : result.Dependencies[i])
+		{
+			if (alive[dependency])
+			{
+				successors[dependency].push_back(i);
+				numPending[i]++;
+			}
+		}
+	}
+
+	vector<uint32_t> level(numNodes, 0);
+	std::priority_queue<size_t, vector<size_t>, std::greater<>> ready;
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		if (alive[i] && numPending[i] == 0)
+		{
+			ready.push(i);
+		}
+	}
+
+	while (!ready.empty())
+	{
+		const size_t node = ready.top();
+		ready.pop();
+		result.Order.push_back(node);
+
+		if (result.Levels.size() <= level[node])
+		{
+			result.Levels.resize(level[node] + 1);
+		}
+		result.Levels[level[node]].push_back(node);
+
+		for (const auto successor : successors[node])
+		{
+			level[successor] = std::max(level[successor], level[node] + 1);
+			if (--numPending[successor] == 0)
+			{
+				ready.push(successor);
+			}
+		}
+	}
+
+	if (result.Order.size() + result.Culled.size() != numNodes)
+	{
+		for (size_t i = 0; i < numNodes; i++)
+		{
+			if (alive[i] && numPending[i] > 0)
+			{
+				LOG(Render, Warning, "Node {} is part of or depends on a cycle", TEXT(Nodes[i].Name));
+			}
+		}
+		LOG(Render, Error, "Render graph contains a cycle!");
+		result.bIsValid = false;
+	}
+	return result;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "RenderNodeInfo.h"
+#include "Types.h"
+
+/**
+ * @brief Schedule produced from the node declarations of a render graph. All indices refer to the declaration order.
+ */
+struct SCompiledRenderGraph
+{
+	// Topological execution order of the nodes which survived culling
+	vector<size_t> Order;
+
+	// Nodes no output depends on
+	vector<size_t> Culled;
+
+	// Order split into dependency levels, nodes within one level are independent and may be recorded in parallel
+	vector<vector<size_t>> Levels;
+
+	// Direct predecessors of every node
+	vector<vector<size_t>> Dependencies;
+
+	bool bIsValid = true;
+};
+
+/**
+ * @brief Builds the dependency DAG from the resources nodes read and write. Every writer creates a new version of the resource,
+ * versions follow the declaration order of the writers. A read depends on the version written last before the reader, or on the
+ * first one for readers declared ahead of every writer. A write depends on the previous writer and on every reader of the previous
+ * version. Reads nothing produces and cycles make the graph invalid.
+ */
+class ORenderGraphCompiler
+{
+public:
+	static SCompiledRenderGraph Compile(const vector<SNodeInfo>& Nodes);
+};
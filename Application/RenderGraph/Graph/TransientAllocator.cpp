@@ -0,0 +1,113 @@
+#include "TransientAllocator.h"
+
+#include <numeric>
+
+namespace
+{
+uint64_t AlignUp(uint64_t Value, uint64_t Alignment)
+{
+	return Alignment <= 1 ? Value : (Value + Alignment - 1) / Alignment * Alignment;
+}
+} // namespace
+
+STransientHeapLayout OTransientAllocator::Allocate(const vector<STransientResourceDesc>& Resources)
+{
+	struct SSlot
+	{
+		uint64_t Size = 0;
+		uint64_t Alignment = 1;
+		size_t LastUse = 0;
+	};
+
+	STransientHeapLayout layout;
+	layout.Placements.resize(Resources.size());
+
+	vector<size_t> order(Resources.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::sort(order, [&](size_t A, size_t B) {
+		const auto& a = Resources[A];
+		const auto& b = Resources[B];
+		return a.Lifetime.FirstUse != b.Lifetime.FirstUse ? a.Lifetime.FirstUse < b.Lifetime.FirstUse : a.Size > b.Size;
+	});
+
+	vector<SSlot> slots;
+	for (const auto index : order)
+	{
+		const auto& resource = Resources[index];
+		layout.UnaliasedSize += AlignUp(resource.Size, resource.Alignment);
+
+		// Prefer the smallest free slot that already fits, otherwise grow the largest free one as little as possible
+		std::optional<size_t> best;
+		for (size_t i = 0; i < slots.size(); i++)
+		{
+			if (slots[i].LastUse >= resource.Lifetime.FirstUse)
+			{
+				continue;
+			}
+
+			if (!best)
+			{
+				best = i;
+				continue;
+			}
+
+			const bool bFits = slots[i].Size >= resource.Size;
+			const bool bBestFits = slots[*best].Size >= resource.Size;
+			if (bFits != bBestFits ? bFits : (bFits ? slots[i].Size < slots[*best].Size : slots[i].Size > slots[*best].Size))
+			{
+				best = i;
+			}
+		}
+
+		if (!best)
+		{
+			best = slots.size();
+			slots.emplace_back();
+		}
+
+		auto& slot = slots[*best];
+		slot.Size = std::max(slot.Size, resource.Size);
+		slot.Alignment = std::max(slot.Alignment, resource.Alignment);
+		slot.LastUse = resource.Lifetime.LastUse;
+		layout.Placements[index].Slot = static_cast<uint32_t>(*best);
+	}
+
+	vector<uint64_t> slotOffsets(slots.size());
+	for (size_t i = 0; i < slots.size(); i++)
+	{
+		layout.HeapSize = AlignUp(layout.HeapSize, slots[i].Alignment);
+		slotOffsets[i] = layout.HeapSize;
+		layout.HeapSize += slots[i].Size;
+		layout.HeapAlignment = std::max(layout.HeapAlignment, slots[i].Alignment);
+	}
+
+	for (auto& placement : layout.Placements)
+	{
+		placement.Offset = slotOffsets[placement.Slot];
+	}
+	return layout;
+}
+
+unordered_map<string, SResourceLifetime> OTransientAllocator::ComputeLifetimes(const vector<SNodeInfo>& Nodes, const SCompiledRenderGraph& Graph)
+{
+	unordered_map<string, SResourceLifetime> lifetimes;
+	for (size_t position = 0; position < Graph.Order.size(); position++)
+	{
+		const auto& node = Nodes[Graph.Order[position]];
+		for (const auto* resources : { &node.Reads, &node.Writes })
+		{
+			for (const auto& resource : *resources)
+			{
+				if (const auto lifetime = lifetimes.find(resource); lifetime != lifetimes.end())
+				{
+					lifetime->second.LastUse = position;
+				}
+				else
+				{
+					lifetimes[resource] = { position, position };
+				}
+			}
+		}
+	}
+	return lifetimes;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "RenderGraphCompiler.h"
+#include "RenderNodeInfo.h"
+#include "Types.h"
+
+struct SResourceLifetime
+{
+	size_t FirstUse = 0;
+	size_t LastUse = 0;
+
+	bool Overlaps(const SResourceLifetime& Other) const
+	{
+		return FirstUse <= Other.LastUse && Other.FirstUse <= LastUse;
+	}
+};
+
+struct STransientResourceDesc
+{
+	string Name;
+	uint64_t Size = 0;
+	uint64_t Alignment = 1;
+	SResourceLifetime Lifetime;
+};
+
+struct STransientPlacement
+{
+	uint64_t Offset = 0;
+
+	// Resources sharing a slot share memory, their lifetimes never overlap
+	uint32_t Slot = 0;
+};
+
+struct STransientHeapLayout
+{
+	// Same order as the descriptions passed to the allocator
+	vector<STransientPlacement> Placements;
+
+	uint64_t HeapSize = 0;
+	uint64_t HeapAlignment = 1;
+
+	// Memory the resources would take as separate allocations
+	uint64_t UnaliasedSize = 0;
+
+	uint64_t GetSavedBytes() const
+	{
+		return UnaliasedSize > HeapSize ? UnaliasedSize - HeapSize : 0;
+	}
+};
+
+/**
+ * @brief Packs transient resources into one heap. Lifetimes form an interval graph which is coloured greedily by first use,
+ * every colour becomes a slot of the heap sized for its largest member. A resource picks the free slot closest to its own size.
+ */
+class OTransientAllocator
+{
+public:
+	static STransientHeapLayout Allocate(const vector<STransientResourceDesc>& Resources);
+
+	// First and last position in the compiled order at which a node reads or writes the resource
+	static unordered_map<string, SResourceLifetime> ComputeLifetimes(const vector<SNodeInfo>& Nodes, const SCompiledRenderGraph& Graph);
+};
@@ -0,0 +1,17 @@
+#include "BilateralBlurNode.h"
+
+#include "Engine/Engine.h"
+
+ORenderTargetBase* OBilateralBlurNode::Execute(ORenderTargetBase* RenderTarget)
+{
+	const auto filter = OEngine::Get()->GetBilateralBlurFilter();
+	SetPSO(SPSOType::BilateralBlur);
+	filter->Execute(FindPSOInfo(SPSOType::BilateralBlur), RenderTarget->GetResource());
+	filter->OutputTo(RenderTarget->GetResource());
+	return RenderTarget;
+}
+
+vector<string> OBilateralBlurNode::GetRequiredPSOs() const
+{
+	return { SPSOType::BilateralBlur };
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include "RenderGraph/Nodes/RenderNode.h"
+
+class OBilateralBlurNode : public ORenderNode
+{
+public:
+	ORenderTargetBase* Execute(ORenderTargetBase* RenderTarget) override;
+	vector<string> GetRequiredPSOs() const override;
+};
@@ -0,0 +1,19 @@
+#include "BlurNode.h"
+
+#include "Engine/Engine.h"
+
+ORenderTargetBase* OBlurNode::Execute(ORenderTargetBase* RenderTarget)
+{
+	const auto filter = OEngine::Get()->GetBlurFilter();
+	filter->Execute(
+	    FindPSOInfo(SPSOType::HorizontalBlur),
+	    FindPSOInfo(SPSOType::VerticalBlur),
+	    RenderTarget->GetResource());
+	filter->OutputTo(RenderTarget->GetResource());
+	return RenderTarget;
+}
+
+vector<string> OBlurNode::GetRequiredPSOs() const
+{
+	return { SPSOType::HorizontalBlur, SPSOType::VerticalBlur };
+}
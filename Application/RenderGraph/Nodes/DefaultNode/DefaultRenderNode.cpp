@@ -6,22 +6,32 @@
 
 void ODefaultRenderNode::SetupCommonResources()
 {
+	static const TShaderSlot passSlot = SShaderSlots::Intern("cbPass");
+	static const TShaderSlot materialDataSlot = SShaderSlots::Intern("gMaterialData");
+	static const TShaderSlot textureMapsSlot = SShaderSlots::Intern("gTextureMaps");
+	static const TShaderSlot cubeMapSlot = SShaderSlots::Intern("gCubeMap");
+	static const TShaderSlot directionalLightsSlot = SShaderSlots::Intern("gDirectionalLights");
+	static const TShaderSlot pointLightsSlot = SShaderSlots::Intern("gPointLights");
+	static const TShaderSlot spotLightsSlot = SShaderSlots::Intern("gSpotLights");
 	auto resource = OEngine::Get()->CurrentFrameResources;
 
 	CommandQueue->SetPipelineState(PSO);
-	CommandQueue->SetResource("cbPass", resource->PassCB->GetGPUAddress(), PSO);
-	CommandQueue->SetResource("gMaterialData", resource->MaterialBuffer->GetGPUAddress(), PSO);
-	CommandQueue->SetResource("gTextureMaps", OEngine::Get()->GetSRVHeap()->GetGPUDescriptorHandleForHeapStart(), PSO);
-	CommandQueue->SetResource("gCubeMap", GetSkyTextureSRV(), PSO);
-	CommandQueue->SetResource("gDirectionalLights", resource->DirectionalLightBuffer->GetGPUAddress(), PSO);
-	CommandQueue->SetResource("gPointLights", resource->PointLightBuffer->GetGPUAddress(), PSO);
-	CommandQueue->SetResource("gSpotLights", resource->SpotLightBuffer->GetGPUAddress(), PSO);
+	CommandQueue->SetResource(passSlot, resource->PassCB.GetGPUAddress(), PSO);
+	CommandQueue->SetResource(materialDataSlot, resource->MaterialBuffer.GetGPUAddress(), PSO);
+	CommandQueue->SetResource(textureMapsSlot, OEngine::Get()->GetSRVHeap()->GetGPUDescriptorHandleForHeapStart(), PSO);
+	CommandQueue->SetResource(cubeMapSlot, GetSkyTextureSRV(), PSO);
+	CommandQueue->SetResource(directionalLightsSlot, resource->DirectionalLightBuffer.GetGPUAddress(), PSO);
+	CommandQueue->SetResource(pointLightsSlot, resource->PointLightBuffer.GetGPUAddress(), PSO);
+	CommandQueue->SetResource(spotLightsSlot, resource->SpotLightBuffer.GetGPUAddress(), PSO);
 }
 
 void ODefaultRenderNode::Initialize(const SNodeInfo& OtherNodeInfo, OCommandQueue* OtherCommandQueue,
                                     ORenderGraph* OtherParentGraph, SPSODescriptionBase* OtherPSO)
 {
 	ORenderNode::Initialize(OtherNodeInfo, OtherCommandQueue, OtherParentGraph, OtherPSO);
+
+	// Creates the layer up front, recording on worker threads must not insert into the layer map
+	OEngine::Get()->GetRenderItems(OtherNodeInfo.RenderLayer);
 }
 
 ORenderTargetBase* ODefaultRenderNode::Execute(ORenderTargetBase* RenderTarget)
@@ -8,4 +8,5 @@ public:
 	void SetupCommonResources() override;
 	void Initialize(const SNodeInfo& OtherNodeInfo, OCommandQueue* OtherCommandQueue, ORenderGraph* OtherParentGraph, SPSODescriptionBase* OtherPSO) override;
 	ORenderTargetBase* Execute(ORenderTargetBase* RenderTarget) override;
+	bool CanRecordInParallel() const override { return true; }
 };
@@ -9,8 +9,6 @@ ORenderTargetBase* OPostProcessNode::Execute(ORenderTargetBase* RenderTarget)
 	CommandQueue->SetRenderTarget(Window);
 	CommandQueue->CopyResourceTo(Window, RenderTarget);
 	DrawSobel(RenderTarget);
-	DrawBlurFilter(Window);
-	CommandQueue->ResourceBarrier(Window, D3D12_RESOURCE_STATE_RENDER_TARGET);
 	return Window;
 }
 void OPostProcessNode::SetupCommonResources()
@@ -21,10 +19,13 @@ void OPostProcessNode::SetupCommonResources()
 void OPostProcessNode::DrawSobel(ORenderTargetBase* RenderTarget)
 {
 	auto engine = OEngine::Get();
-	if (engine->GetSobelFilter()->GetIsEnabled())
+
+	// Until both PSOs are built the frame goes out without the edge overlay
+	const auto sobelPSO = FindPSOInfo(SPSOType::SobelFilter);
+	if (engine->GetSobelFilter()->GetIsEnabled() && sobelPSO && FindPSOInfo(SPSOType::Composite))
 	{
-		CommandQueue->ResourceBarrier(RenderTarget, D3D12_RESOURCE_STATE_GENERIC_READ);
-		auto [executed, result] = engine->GetSobelFilter()->Execute(FindPSOInfo(SPSOType::SobelFilter),RenderTarget->GetSRV().GPUHandle);
+		// The render graph transitions the scene color into copy source and shader resource before the node
+		auto [executed, result] = engine->GetSobelFilter()->Execute(sobelPSO,RenderTarget->GetSRV().GPUHandle);
 		if (executed)
 		{
 			DrawComposite(RenderTarget->GetSRV().GPUHandle, result);
@@ -32,26 +33,14 @@ void OPostProcessNode::DrawSobel(ORenderTargetBase* RenderTarget)
 	}
 }
 
-void OPostProcessNode::DrawBlurFilter(ORenderTargetBase* RenderTarget)
-{
-	auto engine = OEngine::Get();
-	engine->GetBlurFilter()->Execute(
-	    FindPSOInfo(SPSOType::HorizontalBlur),
-	    FindPSOInfo(SPSOType::VerticalBlur),
-	    RenderTarget->GetResource());
-	engine->GetBlurFilter()->OutputTo(RenderTarget->GetResource());
-
-	SetPSO(SPSOType::BilateralBlur);
-	engine->GetBilateralBlurFilter()->Execute(FindPSOInfo(SPSOType::BilateralBlur), RenderTarget->GetResource());
-	engine->GetBilateralBlurFilter()->OutputTo(RenderTarget->GetResource());
-}
-
 void OPostProcessNode::DrawComposite(D3D12_GPU_DESCRIPTOR_HANDLE Input, D3D12_GPU_DESCRIPTOR_HANDLE Input2)
 {
+	static const TShaderSlot baseMapSlot = SShaderSlots::Intern("gBaseMap");
+	static const TShaderSlot edgeMapSlot = SShaderSlots::Intern("gEdgeMap");
 	const auto commandList = CommandQueue->GetCommandList();
 	auto pso = FindPSOInfo(SPSOType::Composite);
 	SetPSO(SPSOType::Composite);
-	CommandQueue->SetResource("gBaseMap", Input, pso);
-	CommandQueue->SetResource("gEdgeMap", Input2, pso);
+	CommandQueue->SetResource(baseMapSlot, Input, pso);
+	CommandQueue->SetResource(edgeMapSlot, Input2, pso);
 	OEngine::Get()->DrawFullScreenQuad();
 }
\ No newline at end of file
@@ -11,7 +11,6 @@ public:
 
 private:
 	void DrawSobel(ORenderTargetBase* RenderTarget);
-	void DrawBlurFilter(ORenderTargetBase* RenderTarget);
 	void DrawComposite(D3D12_GPU_DESCRIPTOR_HANDLE Input, D3D12_GPU_DESCRIPTOR_HANDLE Input2);
 	OWindow* Window = nullptr;
 };
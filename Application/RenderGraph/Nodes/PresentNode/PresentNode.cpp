@@ -8,11 +8,10 @@
 ORenderTargetBase* OPresentNode::Execute(ORenderTargetBase* RenderTarget)
 {
 	auto window = OEngine::Get()->GetWindow();
-	CommandQueue->ResourceBarrier(window, D3D12_RESOURCE_STATE_PRESENT);
 	CommandQueue->ExecuteCommandList();
-	THROW_IF_FAILED(window->GetSwapChain()->Present(0, 0));
-	window->MoveToNextFrame();
+	CommandQueue->Present(window);
+
+	// No flush, the next use of this frame resource waits for the fence so several frames stay in flight
 	OEngine::Get()->CurrentFrameResources->Fence = CommandQueue->Signal();
-	OEngine::Get()->FlushGPU();
 	return RenderTarget;
 }
\ No newline at end of file
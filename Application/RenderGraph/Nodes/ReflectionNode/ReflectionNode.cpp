@@ -6,16 +6,18 @@
 #include "Window/Window.h"
 ORenderTargetBase* OReflectionNode::Execute(ORenderTargetBase* RenderTarget)
 {
+	static const TShaderSlot cubeMapSlot = SShaderSlots::Intern("gCubeMap");
+	static const TShaderSlot passSlot = SShaderSlots::Intern("cbPass");
 	auto cube = OEngine::Get()->GetCubeRenderTarget();
 	auto cmdList = CommandQueue->GetCommandList();
-	CommandQueue->SetResource("gCubeMap", GetSkyTextureSRV(),PSO);
+	CommandQueue->SetResource(cubeMapSlot, GetSkyTextureSRV(),PSO);
 
 	cube->SetViewport(CommandQueue->GetCommandList().Get());
 	for (size_t i = 0; i < cube->GetNumRTVRequired(); i++)
 	{
 		CommandQueue->SetPipelineState(PSO);
 		CommandQueue->SetRenderTarget(cube, i);
-	  	CommandQueue->SetResource("cbPass", cube->GetPassConstantAddresss(i), PSO);
+	  	CommandQueue->SetResource(passSlot, cube->GetPassConstantAddresss(i), PSO);
 		OEngine::Get()->DrawRenderItems(PSO, SRenderLayer::Opaque);
 	   	OEngine::Get()->DrawRenderItems(PSO, SRenderLayer::Sky);
 	}
@@ -23,12 +25,12 @@ ORenderTargetBase* OReflectionNode::Execute(ORenderTargetBase* RenderTarget)
 
 	OEngine::Get()->SetWindowViewport(); //TODO remove this to other place
 
-	CommandQueue->SetResource("cbPass", OEngine::Get()->CurrentFrameResources->PassCB->GetGPUAddress(), PSO);
-	CommandQueue->SetResource("gCubeMap", cube->GetSRVHandle().GPUHandle, PSO);
+	CommandQueue->SetResource(passSlot, OEngine::Get()->CurrentFrameResources->PassCB.GetGPUAddress(), PSO);
+	CommandQueue->SetResource(cubeMapSlot, cube->GetSRVHandle().GPUHandle, PSO);
 
 	CommandQueue->SetRenderTarget(RenderTarget);
 
 	OEngine::Get()->DrawRenderItems(PSO, GetNodeInfo().RenderLayer);
-	CommandQueue->SetResource("gCubeMap", GetSkyTextureSRV(),PSO);
+	CommandQueue->SetResource(cubeMapSlot, GetSkyTextureSRV(),PSO);
 	return RenderTarget;
 }
\ No newline at end of file
@@ -6,4 +6,7 @@ class OReflectionNode : public ODefaultRenderNode
 {
 public:
 	ORenderTargetBase* Execute(ORenderTargetBase* RenderTarget) override;
+
+	// Every cube face is rendered with its own pass constants and render target
+	uint32_t GetNumIndependentPasses() const override { return 6; }
 };
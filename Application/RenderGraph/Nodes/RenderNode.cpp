@@ -27,5 +27,6 @@ void ORenderNode::Initialize(const SNodeInfo& OtherNodeInfo, OCommandQueue* Othe
 	NodeInfo = OtherNodeInfo;
 	CommandQueue = OtherCommandQueue;
 	PSO = OtherPSO;
+	BasePSO = OtherPSO;
 	ParentGraph = OtherParentGraph;
 }
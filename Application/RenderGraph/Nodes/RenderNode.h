@@ -20,13 +20,29 @@ public:
 	virtual ORenderTargetBase* Execute(ORenderTargetBase* RenderTarget);
 	virtual void SetupCommonResources();
 	const SNodeInfo& GetNodeInfo() const { return NodeInfo; }
-	auto GetNextNode() const { return NodeInfo.NextNode; }
+
+	// Number of passes inside the node which don't depend on each other and could be recorded in parallel
+	virtual uint32_t GetNumIndependentPasses() const { return 1; }
+
+	// The node only records draws: no barriers, no render target changes and it returns the target it was given.
+	// Such nodes may be recorded on a worker thread into their own command list.
+	virtual bool CanRecordInParallel() const { return false; }
 	void SetPSO(const string& PSOType) const;
+
+	// Null while the PSO is still building
 	SPSODescriptionBase* FindPSOInfo(string Name) const;
 
+	// PSOs looked up by name while executing, besides the one named in the graph config. The node is skipped until all of them are ready.
+	virtual vector<string> GetRequiredPSOs() const { return {}; }
+
+	// PSO named in the graph config and the permutation of it chosen for the current frame
+	SPSODescriptionBase* GetBasePSO() const { return BasePSO; }
+	void SetActivePSO(SPSODescriptionBase* ActivePSO) { PSO = ActivePSO; }
+
 protected:
 	OCommandQueue* CommandQueue = nullptr;
 	SPSODescriptionBase* PSO = nullptr;
+	SPSODescriptionBase* BasePSO = nullptr;
 private:
 	SNodeInfo NodeInfo;
 	ORenderGraph* ParentGraph;
@@ -0,0 +1,161 @@
+#include "FrameRecorder.h"
+
+#include "Logger.h"
+
+#include <filesystem>
+
+OFrameRecorder::OFrameRecorder(const string& Path)
+{
+	const auto directory = std::filesystem::path(Path).parent_path();
+	if (!directory.empty())
+	{
+		std::filesystem::create_directories(directory);
+	}
+
+	Stream.open(Path, std::ios::binary | std::ios::trunc);
+	if (!Stream.is_open())
+	{
+		LOG(Engine, Warning, "Failed to open replay file {} for writing", TEXT(Path));
+		return;
+	}
+
+	const SReplayFileHeader header;
+	Stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	PendingEvents.reserve(256);
+}
+
+OFrameRecorder::~OFrameRecorder()
+{
+	if (Stream.is_open())
+	{
+		Stream.flush();
+		LOG(Engine, Log, "Replay recorded, frames: {}", FrameIndex);
+	}
+}
+
+bool OFrameRecorder::IsOpen() const
+{
+	return Stream.is_open();
+}
+
+void OFrameRecorder::AddEvent(const SInputEvent& Event)
+{
+	PendingEvents.push_back(Event);
+}
+
+void OFrameRecorder::RecordFrame(const STimer& Timer, const SCameraState& Camera)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	SReplayFrameHeader header;
+	header.FrameIndex = FrameIndex++;
+	header.Time = Timer.GetTime();
+	header.DeltaTime = Timer.GetDeltaTime();
+	header.Camera = Camera;
+	header.NumEvents = static_cast<uint32_t>(PendingEvents.size());
+
+	Stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!PendingEvents.empty())
+	{
+		Stream.write(reinterpret_cast<const char*>(PendingEvents.data()), PendingEvents.size() * sizeof(SInputEvent));
+	}
+	PendingEvents.clear();
+}
+
+uint64_t OFrameRecorder::GetNumFrames() const
+{
+	return FrameIndex;
+}
+
+OFrameReplayer::OFrameReplayer(const string& Path, float FixedDeltaTime)
+    : FixedDeltaTime(FixedDeltaTime)
+{
+	Stream.open(Path, std::ios::binary);
+	if (!Stream.is_open())
+	{
+		LOG(Engine, Warning, "Failed to open replay file {}", TEXT(Path));
+		return;
+	}
+
+	std::error_code error;
+	FileSize = std::filesystem::file_size(Path, error);
+
+	SReplayFileHeader header;
+	Stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	const SReplayFileHeader expected;
+	bIsValid = Stream.good()
+	           && header.Magic == expected.Magic
+	           && header.Version == expected.Version
+	           && header.InputEventSize == expected.InputEventSize
+	           && header.CameraStateSize == expected.CameraStateSize;
+
+	if (!bIsValid)
+	{
+		LOG(Engine, Warning, "Replay file {} is invalid or was recorded by an incompatible build", TEXT(Path));
+	}
+	Timer.SetFixedTime(0.0, 0.0);
+}
+
+bool OFrameReplayer::IsOpen() const
+{
+	return Stream.is_open() && bIsValid;
+}
+
+bool OFrameReplayer::ReadFrame()
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	auto& header = CurrentFrame.Header;
+	if (!Stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	{
+		return false;
+	}
+
+	// A corrupt count must not turn into a huge allocation, the events have to fit into the rest of the file
+	const uint64_t remaining = FileSize - std::min<uint64_t>(FileSize, static_cast<uint64_t>(Stream.tellg()));
+	if (header.NumEvents > remaining / sizeof(SInputEvent))
+	{
+		LOG(Engine, Warning, "Replay file is truncated or corrupt at frame {}, {} events don't fit into the file", header.FrameIndex, header.NumEvents);
+		return false;
+	}
+	CurrentFrame.Events.resize(header.NumEvents);
+	if (header.NumEvents > 0 && !Stream.read(reinterpret_cast<char*>(CurrentFrame.Events.data()), header.NumEvents * sizeof(SInputEvent)))
+	{
+		LOG(Engine, Warning, "Replay file is truncated at frame {}", header.FrameIndex);
+		return false;
+	}
+
+	if (FixedDeltaTime > 0.0f)
+	{
+		Timer.SetFixedTime(static_cast<double>(NumFramesRead + 1) * FixedDeltaTime, FixedDeltaTime);
+	}
+	else
+	{
+		Timer.SetFixedTime(header.Time, header.DeltaTime);
+	}
+
+	NumFramesRead++;
+	return true;
+}
+
+const SReplayFrame& OFrameReplayer::GetCurrentFrame() const
+{
+	return CurrentFrame;
+}
+
+const STimer& OFrameReplayer::GetTimer() const
+{
+	return Timer;
+}
+
+uint64_t OFrameReplayer::GetNumFramesRead() const
+{
+	return NumFramesRead;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Input/InputEvent.h"
+#include "Timer/Timer.h"
+#include "Types.h"
+
+#include <DirectXMath.h>
+
+#include <fstream>
+
+struct SCameraState
+{
+	DirectX::XMFLOAT3 Position = { 0.0f, 0.0f, 0.0f };
+	DirectX::XMFLOAT3 Look = { 0.0f, 0.0f, 1.0f };
+	DirectX::XMFLOAT3 Up = { 0.0f, 1.0f, 0.0f };
+};
+
+struct SReplayFileHeader
+{
+	static constexpr uint32_t DefaultMagic = 0x50525844; // "DXRP"
+	static constexpr uint32_t CurrentVersion = 1;
+
+	uint32_t Magic = DefaultMagic;
+	uint32_t Version = CurrentVersion;
+	uint32_t InputEventSize = sizeof(SInputEvent);
+	uint32_t CameraStateSize = sizeof(SCameraState);
+};
+
+/**
+ * @brief Fixed size part of a recorded frame, followed in the file by NumEvents SInputEvent records.
+ */
+struct SReplayFrameHeader
+{
+	uint64_t FrameIndex = 0;
+	float Time = 0.0f;
+	float DeltaTime = 0.0f;
+	SCameraState Camera;
+	uint32_t NumEvents = 0;
+};
+
+// Headers are written as they are in memory, any padding would put undefined bytes into the file
+static_assert(sizeof(SCameraState) == 9 * sizeof(float));
+static_assert(sizeof(SReplayFileHeader) == 4 * sizeof(uint32_t));
+static_assert(sizeof(SReplayFrameHeader) == sizeof(uint64_t) + 2 * sizeof(float) + sizeof(SCameraState) + sizeof(uint32_t));
+
+struct SReplayFrame
+{
+	SReplayFrameHeader Header;
+	vector<SInputEvent> Events;
+};
+
+/**
+ * @brief Writes timer values, camera state and the input events drained in each frame into a compact binary file.
+ */
+class OFrameRecorder
+{
+public:
+	explicit OFrameRecorder(const string& Path);
+	~OFrameRecorder();
+
+	bool IsOpen() const;
+	void AddEvent(const SInputEvent& Event);
+	void RecordFrame(const STimer& Timer, const SCameraState& Camera);
+	uint64_t GetNumFrames() const;
+
+private:
+	std::ofstream Stream;
+	vector<SInputEvent> PendingEvents;
+	uint64_t FrameIndex = 0;
+};
+
+/**
+ * @brief Reads a file written by OFrameRecorder frame by frame.
+ * With a positive FixedDeltaTime the timer advances by exactly that step, otherwise the recorded values are used.
+ */
+class OFrameReplayer
+{
+public:
+	OFrameReplayer(const string& Path, float FixedDeltaTime);
+
+	bool IsOpen() const;
+	bool ReadFrame();
+
+	const SReplayFrame& GetCurrentFrame() const;
+	const STimer& GetTimer() const;
+	uint64_t GetNumFramesRead() const;
+
+private:
+	std::ifstream Stream;
+	uint64_t FileSize = 0;
+	SReplayFrame CurrentFrame;
+	STimer Timer;
+	float FixedDeltaTime = 0.0f;
+	uint64_t NumFramesRead = 0;
+	bool bIsValid = false;
+};
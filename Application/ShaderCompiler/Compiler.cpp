@@ -5,122 +5,290 @@
 #include "Engine/Engine.h"
 #include "Engine/Shader/Shader.h"
 #include "Logger.h"
+#include "Threading/ThreadPool.h"
 
+#include <format>
 #include <ranges>
 
+OShaderIncludeHandler::OShaderIncludeHandler(ComPtr<IDxcIncludeHandler> Inner)
+    : Inner(std::move(Inner))
+{
+}
+
+HRESULT OShaderIncludeHandler::LoadSource(LPCWSTR Filename, IDxcBlob** OutSource)
+{
+	// DXC probes every include directory, only the candidate that actually opened is a dependency
+	const HRESULT hr = Inner->LoadSource(Filename, OutSource);
+	if (SUCCEEDED(hr))
+	{
+		std::error_code error;
+		IncludedFiles.push_back(std::filesystem::absolute(Filename, error));
+	}
+	return hr;
+}
+
+HRESULT OShaderIncludeHandler::QueryInterface(REFIID Riid, void** OutObject)
+{
+	if (OutObject == nullptr)
+	{
+		return E_POINTER;
+	}
+	if (Riid == __uuidof(IDxcIncludeHandler) || Riid == __uuidof(IUnknown))
+	{
+		*OutObject = static_cast<IDxcIncludeHandler*>(this);
+		AddRef();
+		return S_OK;
+	}
+	*OutObject = nullptr;
+	return E_NOINTERFACE;
+}
+
+ULONG OShaderIncludeHandler::AddRef()
+{
+	return ++RefCount;
+}
+
+ULONG OShaderIncludeHandler::Release()
+{
+	const ULONG count = --RefCount;
+	if (count == 0)
+	{
+		delete this;
+	}
+	return count;
+}
+
+vector<std::filesystem::path> OShaderIncludeHandler::TakeIncludedFiles()
+{
+	return std::exchange(IncludedFiles, {});
+}
+
 void OShaderCompiler::Init()
 {
-	THROW_IF_FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&Compiler)));
-	THROW_IF_FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&Utils)));
-	THROW_IF_FAILED(Utils->CreateDefaultIncludeHandler(&IncludeHandler));
+	auto context = AcquireContext();
+	ComPtr<IDxcVersionInfo> versionInfo;
+	if (SUCCEEDED(context->Compiler.As(&versionInfo)))
+	{
+		uint32_t major = 0;
+		uint32_t minor = 0;
+		versionInfo->GetVersion(&major, &minor);
+		CompilerVersion = std::format("{}.{}", major, minor);
+	}
+
+	ComPtr<IDxcVersionInfo2> versionInfo2;
+	if (SUCCEEDED(context->Compiler.As(&versionInfo2)))
+	{
+		// Builds of the same version may still differ, the commit pins the exact compiler
+		uint32_t commitCount = 0;
+		char* commitHash = nullptr;
+		if (SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash)) && commitHash)
+		{
+			CompilerVersion += std::format("+{}.{}", commitCount, commitHash);
+			CoTaskMemFree(commitHash);
+		}
+	}
+	ReleaseContext(std::move(context));
+
+	ShadersFolder = OApplication::Get()->GetShadersFolder();
+	Cache = make_unique<OShaderCache>(OApplication::Get()->GetConfigPath("ShaderCachePath"));
 }
 
-vector<unique_ptr<OShader>> OShaderCompiler::CompileShaders(vector<SPipelineStage>& OutPipelines, SShaderPipelineDesc& OutShadersPipeline)
+unique_ptr<OShaderCompiler::SDxcContext> OShaderCompiler::AcquireContext()
 {
-	vector<unique_ptr<OShader>> shaders;
-	for (auto& shader : OutPipelines)
 	{
-		LOG(Engine, Log, "Compiling shader: {}", shader.ShaderPath);
-		auto temp = CompileShader(shader.ShaderDefinition, shader.ShaderPath, OutShadersPipeline);
-		shader.Shader = temp.get();
-		shaders.push_back(std::move(temp));
+		SLockGuard lock(ContextMutex);
+		if (!FreeContexts.empty())
+		{
+			auto context = std::move(FreeContexts.back());
+			FreeContexts.pop_back();
+			return context;
+		}
 	}
-	OutShadersPipeline.RootSignatureParams.RootSignature = BuildRootSignature(OutShadersPipeline.BuildParameterArray(), Utils::GetStaticSamplers(), OutShadersPipeline.RootSignatureParams.RootSignatureDesc);
-	return shaders;
+
+	auto context = make_unique<SDxcContext>();
+	THROW_IF_FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&context->Compiler)));
+	THROW_IF_FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&context->Utils)));
+
+	ComPtr<IDxcIncludeHandler> defaultHandler;
+	THROW_IF_FAILED(context->Utils->CreateDefaultIncludeHandler(&defaultHandler));
+	context->IncludeHandler.Attach(new OShaderIncludeHandler(std::move(defaultHandler)));
+	return context;
+}
+
+void OShaderCompiler::ReleaseContext(unique_ptr<SDxcContext> Context)
+{
+	SLockGuard lock(ContextMutex);
+	FreeContexts.push_back(std::move(Context));
+}
+
+uint32_t OShaderCompiler::GetNumContexts()
+{
+	SLockGuard lock(ContextMutex);
+	return static_cast<uint32_t>(FreeContexts.size());
+}
+
+ORootSignatureCache& OShaderCompiler::GetRootSignatureCache()
+{
+	return RootSignatureCache;
 }
 
-void OShaderCompiler::SetCompilationArgs(const SShaderDefinition& Definition)
+void OShaderCompiler::CompilePipelines(vector<SShaderPipelineCompilation>& Pipelines, uint32_t Threads, bool bUseCache)
 {
-	Entry = Definition.ShaderEntry;
-	TargetProfile = Definition.TargetProfile;
-	CompilationArgs = {
+	struct SStageJob
+	{
+		SShaderPipelineCompilation* Pipeline = nullptr;
+		SPipelineStage* Stage = nullptr;
+		size_t StageIndex = 0;
+		std::optional<SShaderCacheEntry> Result;
+		vector<std::filesystem::path> Dependencies;
+	};
+
+	vector<SStageJob> jobs;
+	for (auto& pipeline : Pipelines)
+	{
+		pipeline.PipelineInfo = make_shared<SShaderPipelineDesc>();
+		pipeline.PipelineInfo->PipelineName = pipeline.Name;
+		pipeline.Dependencies.assign(pipeline.Stages.size(), {});
+		for (size_t i = 0; i < pipeline.Stages.size(); i++)
+		{
+			jobs.push_back({ .Pipeline = &pipeline, .Stage = &pipeline.Stages[i], .StageIndex = i });
+		}
+	}
+
+	// Stages only share the cache directory and the context pool, every job writes its own result slot
+	OThreadPool pool(std::max(Threads, 1u) - 1);
+	pool.ParallelFor(jobs.size(), [&](size_t Index) {
+		auto& job = jobs[Index];
+		LOG(Engine, Log, "Compiling shader: {}", job.Stage->ShaderPath);
+		job.Result = CompileStage(job.Stage->ShaderDefinition, job.Stage->ShaderPath, job.Stage->Defines, bUseCache, job.Dependencies);
+	});
+
+	// Root parameter indices follow the order resources are resolved in, merging on one thread in pipeline and stage order
+	// keeps the root signatures identical no matter which thread finished first
+	for (auto& job : jobs)
+	{
+		auto& pipeline = *job.Pipeline;
+		pipeline.Dependencies[job.StageIndex] = std::move(job.Dependencies);
+		if (!job.Result)
+		{
+			continue;
+		}
+		auto shader = MergeStage(job.Stage->ShaderDefinition, std::move(*job.Result), *pipeline.PipelineInfo);
+		job.Stage->Shader = shader.get();
+		pipeline.Shaders.push_back(std::move(shader));
+	}
+
+	for (auto& pipeline : Pipelines)
+	{
+		BuildRootSignature(*pipeline.PipelineInfo);
+	}
+}
+
+vector<wstring> OShaderCompiler::BuildCompilationArgs(const SShaderDefinition& Definition, const vector<pair<string, string>>& Defines) const
+{
+	vector<wstring> args = {
 		L"-E",
-		Entry.c_str(),
+		Definition.ShaderEntry,
 		L"-T",
-		TargetProfile.c_str(),
+		Definition.TargetProfile,
 		DXC_ARG_WARNINGS_ARE_ERRORS,
 		DXC_ARG_ALL_RESOURCES_BOUND,
 		L"-I",
-		OApplication::Get()->GetShadersFolder().c_str(),
+		ShadersFolder,
 	};
 
 	if constexpr (false)
 	{
-		CompilationArgs.push_back(DXC_ARG_DEBUG);
-		CompilationArgs.push_back(DXC_ARG_SKIP_OPTIMIZATIONS);
+		args.push_back(DXC_ARG_DEBUG);
+		args.push_back(DXC_ARG_SKIP_OPTIMIZATIONS);
 	}
 	else
 	{
-		CompilationArgs.push_back(DXC_ARG_OPTIMIZATION_LEVEL3);
+		args.push_back(DXC_ARG_OPTIMIZATION_LEVEL3);
 	}
+
+	for (const auto& [name, value] : Defines)
+	{
+		args.push_back(L"-D");
+		args.push_back(UTF8ToWString(name + "=" + value));
+	}
+	return args;
 }
 
-void OShaderCompiler::ResolveBoundResources(const ComPtr<ID3D12ShaderReflection>& Reflection, const D3D12_SHADER_DESC& ShaderDescription, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
+void OShaderCompiler::ResolveBoundResources(const SShaderReflectionSummary& Reflection, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
 {
 	OutPipelineInfo.RootSignatureParams.DescriptorRanges.reserve(50); // TODO infer from shader
 	uint32_t counter = OutPipelineInfo.GetRootParamIndexMap().size();
-	for (const uint32_t i : std::views::iota(0u, ShaderDescription.BoundResources))
+	for (const auto& resource : Reflection.BoundResources)
 	{
-		D3D12_SHADER_INPUT_BIND_DESC bindDesc{};
-		Reflection->GetResourceBindingDesc(i, &bindDesc);
-
-		if (bindDesc.Type == D3D_SIT_SAMPLER)
+		const auto type = static_cast<D3D_SHADER_INPUT_TYPE>(resource.Type);
+		if (type == D3D_SIT_SAMPLER)
 		{
 			continue;
 		}
 
-		if (!OutPipelineInfo.TryAddRootParameterName(UTF8ToWString(bindDesc.Name)))
+		if (!OutPipelineInfo.TryAddRootParameterName(UTF8ToWString(resource.Name)))
 		{
 			continue;
 		}
 
-		OutPipelineInfo.GetRootParamIndexMap()[UTF8ToWString(bindDesc.Name)] = counter;
+		OutPipelineInfo.SetRootParamIndex(UTF8ToWString(resource.Name), counter);
 		counter += 1;
-		switch (bindDesc.Type)
+		switch (type)
 		{
 		case D3D_SIT_CBUFFER:
-			ResolveConstantBuffers(i, Reflection, bindDesc, OutPipelineInfo);
+			ResolveConstantBuffers(resource, OutPipelineInfo);
 			break;
 		case D3D_SIT_UAV_RWTYPED:
 		case D3D_SIT_TEXTURE:
-			ResolveTextures(bindDesc, OutPipelineInfo, ShaderType);
+			ResolveTextures(resource, OutPipelineInfo, ShaderType);
 			break;
 		case D3D_SIT_STRUCTURED:
-			ResolveStructuredBuffer(bindDesc, OutPipelineInfo, ShaderType);
+			ResolveStructuredBuffer(resource, OutPipelineInfo, ShaderType);
 			break;
 			// Handle other types as needed, for example, samplers
 		}
 	}
 }
 
-void OShaderCompiler::ResolveConstantBuffers(const int32_t ResourceIdx, const ComPtr<ID3D12ShaderReflection>& Reflection, const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo)
+void OShaderCompiler::ResolveConstantBuffers(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo)
 {
-	auto name = UTF8ToWString(BindDesc.Name);
-	ID3D12ShaderReflectionConstantBuffer* shaderReflectionConstantBuffer = Reflection->GetConstantBufferByIndex(ResourceIdx);
-	D3D12_SHADER_BUFFER_DESC constantBufferDesc{};
-	shaderReflectionConstantBuffer->GetDesc(&constantBufferDesc);
+	auto name = UTF8ToWString(Resource.Name);
+	if (Resource.Space == SRenderConstants::RootConstantsSpace)
+	{
+		const D3D12_ROOT_PARAMETER1 rootParameter{
+			.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS,
+			.Constants = {
+			    .ShaderRegister = Resource.BindPoint,
+			    .RegisterSpace = Resource.Space,
+			    .Num32BitValues = (Resource.ByteSize + 3) / 4,
+			}
+		};
+		OutPipelineInfo.AddRootParameter(rootParameter, name);
+		return;
+	}
 
 	const D3D12_ROOT_PARAMETER1 rootParameter{
 		.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV,
 		.Descriptor = {
-		    .ShaderRegister = BindDesc.BindPoint,
-		    .RegisterSpace = BindDesc.Space,
+		    .ShaderRegister = Resource.BindPoint,
+		    .RegisterSpace = Resource.Space,
 		    .Flags = D3D12_ROOT_DESCRIPTOR_FLAG_NONE,
 		}
 	};
 	OutPipelineInfo.AddRootParameter(rootParameter, name);
 }
 
-void OShaderCompiler::ResolveStructuredBuffer(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
+void OShaderCompiler::ResolveStructuredBuffer(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
 {
-	auto name = UTF8ToWString(BindDesc.Name);
-	CHECK(BindDesc.BindCount > 0);
+	auto name = UTF8ToWString(Resource.Name);
+	CHECK(Resource.BindCount > 0);
 
 	D3D12_ROOT_PARAMETER1 rootParameter = {
 		.ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV,
 		.Descriptor = {
-		    .ShaderRegister = BindDesc.BindPoint,
-		    .RegisterSpace = BindDesc.Space,
+		    .ShaderRegister = Resource.BindPoint,
+		    .RegisterSpace = Resource.Space,
 		    .Flags = D3D12_ROOT_DESCRIPTOR_FLAG_NONE,
 		},
 		.ShaderVisibility = ShaderTypeToVisibility(ShaderType),
@@ -129,15 +297,19 @@ void OShaderCompiler::ResolveStructuredBuffer(const D3D12_SHADER_INPUT_BIND_DESC
 	OutPipelineInfo.AddRootParameter(rootParameter, name);
 }
 
-void OShaderCompiler::ResolveTextures(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
+void OShaderCompiler::ResolveTextures(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType)
 {
-	auto name = UTF8ToWString(BindDesc.Name);
-	CHECK(BindDesc.BindCount > 0);
+	auto name = UTF8ToWString(Resource.Name);
+
+	// Unbounded arrays (Texture2D gTextureMaps[]) span the whole heap and are indexed by the shader. Descriptors behind them
+	// are allocated and freed while the table stays bound, so they can't be declared static.
+	const bool bUnbounded = Resource.BindCount == 0 || Resource.BindCount == UINT_MAX;
 	D3D12_DESCRIPTOR_RANGE1 descriptorRange = {
-		.RangeType = GetRangeType(BindDesc),
-		.NumDescriptors = BindDesc.BindCount, // Special handling for structured buffers in space1
-		.BaseShaderRegister = BindDesc.BindPoint,
-		.RegisterSpace = BindDesc.Space,
+		.RangeType = GetRangeType(static_cast<D3D_SHADER_INPUT_TYPE>(Resource.Type)),
+		.NumDescriptors = bUnbounded ? UINT_MAX : Resource.BindCount,
+		.BaseShaderRegister = Resource.BindPoint,
+		.RegisterSpace = Resource.Space,
+		.Flags = bUnbounded ? D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE : D3D12_DESCRIPTOR_RANGE_FLAG_NONE,
 		.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND,
 	};
 
@@ -153,9 +325,9 @@ void OShaderCompiler::ResolveTextures(const D3D12_SHADER_INPUT_BIND_DESC& BindDe
 
 	OutPipelineInfo.AddRootParameter(rootParameter, name);
 }
-D3D12_DESCRIPTOR_RANGE_TYPE OShaderCompiler::GetRangeType(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc)
+D3D12_DESCRIPTOR_RANGE_TYPE OShaderCompiler::GetRangeType(D3D_SHADER_INPUT_TYPE Type)
 {
-	switch (BindDesc.Type)
+	switch (Type)
 	{
 	case D3D_SIT_CBUFFER:
 		return D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
@@ -183,25 +355,43 @@ D3D12_DESCRIPTOR_RANGE_TYPE OShaderCompiler::GetRangeType(const D3D12_SHADER_INP
 	return D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 }
 
-std::tuple<DxcBuffer, ComPtr<IDxcResult>> OShaderCompiler::CreateDxcBuffer(const wstring& ShaderPath)
+std::optional<SShaderCacheEntry> OShaderCompiler::CompileToCacheEntry(SDxcContext& Context, const wstring& ShaderPath, const vector<wstring>& Args, vector<std::filesystem::path>& OutDependencies)
 {
+	OutDependencies = { std::filesystem::path(ShaderPath) };
 	ComPtr<IDxcBlobEncoding> sourceBlob;
-	THROW_IF_FAILED(Utils->LoadFile(ShaderPath.c_str(), nullptr, &sourceBlob));
+	if (FAILED(Context.Utils->LoadFile(ShaderPath.c_str(), nullptr, &sourceBlob)))
+	{
+		// Editors may replace the file while saving, a reload will pick it up on the next change
+		WIN_LOG(Engine, Error, "Failed to read shader: {}", ShaderPath);
+		return std::nullopt;
+	}
 	DxcBuffer sourceBuffer{
 		.Ptr = sourceBlob->GetBufferPointer(),
 		.Size = sourceBlob->GetBufferSize(),
 		.Encoding = 0
 	};
+
+	vector<LPCWSTR> arguments;
+	arguments.reserve(Args.size());
+	for (const auto& arg : Args)
+	{
+		arguments.push_back(arg.c_str());
+	}
+
+	// Dependencies are recorded even if compilation fails, fixing the broken include has to trigger a reload as well
+	Context.IncludeHandler->TakeIncludedFiles();
 	ComPtr<IDxcResult> compiledShaderBuffer{};
-	const HRESULT hr = Compiler->Compile(&sourceBuffer,
-	                                     CompilationArgs.data(),
-	                                     static_cast<uint32_t>(CompilationArgs.size()),
-	                                     IncludeHandler.Get(),
-	                                     IID_PPV_ARGS(&compiledShaderBuffer));
+	const HRESULT hr = Context.Compiler->Compile(&sourceBuffer,
+	                                             arguments.data(),
+	                                             static_cast<uint32_t>(arguments.size()),
+	                                             Context.IncludeHandler.Get(),
+	                                             IID_PPV_ARGS(&compiledShaderBuffer));
+	std::ranges::move(Context.IncludeHandler->TakeIncludedFiles(), std::back_inserter(OutDependencies));
 
 	if (FAILED(hr))
 	{
 		WIN_LOG(Engine, Error, "Failed to compile shader: {}", ShaderPath);
+		return std::nullopt;
 	}
 
 	ComPtr<IDxcBlobUtf8> errors{};
@@ -209,37 +399,37 @@ std::tuple<DxcBuffer, ComPtr<IDxcResult>> OShaderCompiler::CreateDxcBuffer(const
 	if (errors && errors->GetStringLength() > 0)
 	{
 		WIN_LOG(Engine, Error, "Shader compilation error: {}", TEXT(errors->GetStringPointer()));
-		return {};
+		return std::nullopt;
 	}
 
-	ComPtr<IDxcBlob> reflectionBlob{};
-	THROW_IF_FAILED(compiledShaderBuffer->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&reflectionBlob), nullptr));
+	ComPtr<IDxcBlob> compiledShaderBlob{};
+	THROW_IF_FAILED(compiledShaderBuffer->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&compiledShaderBlob), nullptr));
 
 	const DxcBuffer reflectionBuffer{
-		.Ptr = reflectionBlob->GetBufferPointer(),
-		.Size = reflectionBlob->GetBufferSize(),
+		.Ptr = compiledShaderBlob->GetBufferPointer(),
+		.Size = compiledShaderBlob->GetBufferSize(),
 		.Encoding = 0
 	};
-	return { reflectionBuffer, compiledShaderBuffer };
+
+	SShaderCacheEntry entry;
+	const auto byteCode = static_cast<const uint8_t*>(compiledShaderBlob->GetBufferPointer());
+	entry.ByteCode.assign(byteCode, byteCode + compiledShaderBlob->GetBufferSize());
+	entry.Reflection = BuildReflection(Context.Utils.Get(), reflectionBuffer);
+	return entry;
 }
 
-void OShaderCompiler::GetInputLayoutDesc(const ComPtr<ID3D12ShaderReflection>& Reflection, SShaderPipelineDesc& OutPipelineInfo)
+void OShaderCompiler::GetInputLayoutDesc(const SShaderReflectionSummary& Reflection, SShaderPipelineDesc& OutPipelineInfo)
 {
-	D3D12_SHADER_DESC shaderDesc{};
-	Reflection->GetDesc(&shaderDesc);
-	OutPipelineInfo.InputElementSemanticNames.reserve(shaderDesc.InputParameters);
-	OutPipelineInfo.InputElementDescs.reserve(shaderDesc.InputParameters);
+	OutPipelineInfo.InputElementSemanticNames.reserve(Reflection.InputParameters.size());
+	OutPipelineInfo.InputElementDescs.reserve(Reflection.InputParameters.size());
 
-	for (const uint32_t parameterIndex : std::views::iota(0u, shaderDesc.InputParameters))
+	for (const auto& parameter : Reflection.InputParameters)
 	{
-		D3D12_SIGNATURE_PARAMETER_DESC parameterDesc{};
-		Reflection->GetInputParameterDesc(parameterIndex, &parameterDesc);
-
-		OutPipelineInfo.InputElementSemanticNames.emplace_back(parameterDesc.SemanticName);
+		OutPipelineInfo.InputElementSemanticNames.emplace_back(parameter.SemanticName);
 		OutPipelineInfo.InputElementDescs.push_back(D3D12_INPUT_ELEMENT_DESC{
 		    .SemanticName = OutPipelineInfo.InputElementSemanticNames.back().c_str(),
-		    .SemanticIndex = parameterDesc.SemanticIndex,
-		    .Format = Utils::MaskToFormat(parameterDesc.Mask),
+		    .SemanticIndex = parameter.SemanticIndex,
+		    .Format = Utils::MaskToFormat(parameter.Mask),
 		    .InputSlot = 0u,
 		    .AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT,
 		    .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
@@ -249,51 +439,139 @@ void OShaderCompiler::GetInputLayoutDesc(const ComPtr<ID3D12ShaderReflection>& R
 	}
 }
 
-D3D12_SHADER_DESC OShaderCompiler::BuildReflection(DxcBuffer Buffer, ComPtr<ID3D12ShaderReflection>& OutReflection)
+SShaderReflectionSummary OShaderCompiler::BuildReflection(IDxcUtils* DxcUtils, DxcBuffer Buffer)
 {
+	ComPtr<ID3D12ShaderReflection> reflection;
 	D3D12_SHADER_DESC shaderDesc{};
-	Utils->CreateReflection(&Buffer, IID_PPV_ARGS(&OutReflection));
-	OutReflection->GetDesc(&shaderDesc);
-	return shaderDesc;
+	THROW_IF_FAILED(DxcUtils->CreateReflection(&Buffer, IID_PPV_ARGS(&reflection)));
+	reflection->GetDesc(&shaderDesc);
+
+	SShaderReflectionSummary summary;
+	for (const uint32_t i : std::views::iota(0u, shaderDesc.BoundResources))
+	{
+		D3D12_SHADER_INPUT_BIND_DESC bindDesc{};
+		reflection->GetResourceBindingDesc(i, &bindDesc);
+
+		SShaderBoundResource resource{
+			.Name = bindDesc.Name,
+			.Type = static_cast<uint32_t>(bindDesc.Type),
+			.BindPoint = bindDesc.BindPoint,
+			.BindCount = bindDesc.BindCount,
+			.Space = bindDesc.Space,
+		};
+
+		if (bindDesc.Type == D3D_SIT_CBUFFER)
+		{
+			// The reflected size is padded to 16 bytes, root constants only take the used part
+			ID3D12ShaderReflectionConstantBuffer* constantBuffer = reflection->GetConstantBufferByName(bindDesc.Name);
+			D3D12_SHADER_BUFFER_DESC constantBufferDesc{};
+			constantBuffer->GetDesc(&constantBufferDesc);
+			for (const uint32_t variable : std::views::iota(0u, constantBufferDesc.Variables))
+			{
+				D3D12_SHADER_VARIABLE_DESC variableDesc{};
+				constantBuffer->GetVariableByIndex(variable)->GetDesc(&variableDesc);
+				resource.ByteSize = std::max(resource.ByteSize, variableDesc.StartOffset + variableDesc.Size);
+			}
+		}
+		summary.BoundResources.push_back(std::move(resource));
+	}
+
+	for (const uint32_t i : std::views::iota(0u, shaderDesc.InputParameters))
+	{
+		D3D12_SIGNATURE_PARAMETER_DESC parameterDesc{};
+		reflection->GetInputParameterDesc(i, &parameterDesc);
+		summary.InputParameters.push_back({ parameterDesc.SemanticName, parameterDesc.SemanticIndex, parameterDesc.Mask });
+	}
+	return summary;
 }
 
-unique_ptr<OShader> OShaderCompiler::CompileShader(const SShaderDefinition& Definition, const wstring& ShaderPath, SShaderPipelineDesc& OutPipelineInfo)
+SShaderCacheKeyDesc OShaderCompiler::MakeCacheKeyDesc(const SShaderDefinition& Definition, const wstring& ShaderPath, const vector<pair<string, string>>& Defines, const vector<wstring>& Args) const
 {
-	SetCompilationArgs(Definition);
-	auto [buffer, compiledShaderBuffer] = CreateDxcBuffer(ShaderPath);
+	SShaderCacheKeyDesc desc;
+	desc.SourcePath = ShaderPath;
+	desc.IncludeDirs = { ShadersFolder };
+	desc.EntryPoint = WStringToUTF8(Definition.ShaderEntry);
+	desc.TargetProfile = WStringToUTF8(Definition.TargetProfile);
+	desc.CompilerVersion = CompilerVersion;
+	desc.Defines = Defines;
+
+	vector<string> commandLine;
+	std::ranges::transform(Args, std::back_inserter(commandLine), WStringToUTF8);
+	desc.SetArguments(commandLine);
+	return desc;
+}
 
-	ComPtr<ID3D12ShaderReflection> shaderReflection{};
-	const D3D12_SHADER_DESC shaderDesc = BuildReflection(buffer, shaderReflection);
+std::optional<SShaderCacheEntry> OShaderCompiler::CompileStage(const SShaderDefinition& Definition, const wstring& ShaderPath, const vector<pair<string, string>>& Defines, bool bUseCache, vector<std::filesystem::path>& OutDependencies)
+{
+	const auto args = BuildCompilationArgs(Definition, Defines);
+	const auto key = bUseCache && Cache ? OShaderCache::ComputeKey(MakeCacheKeyDesc(Definition, ShaderPath, Defines, args)) : std::nullopt;
+	if (key)
+	{
+		if (auto entry = Cache->Load(*key))
+		{
+			LOG(Engine, Log, "Shader loaded from cache: {}", ShaderPath);
+
+			// Same includes the key was hashed from, DXC never ran to report them
+			OutDependencies = OShaderCache::CollectIncludes(ShaderPath, { ShadersFolder });
+			OutDependencies.insert(OutDependencies.begin(), std::filesystem::path(ShaderPath));
+			return entry;
+		}
+	}
 
-	ResolveBoundResources(shaderReflection, shaderDesc, OutPipelineInfo, Definition.ShaderType);
+	auto context = AcquireContext();
+	auto entry = CompileToCacheEntry(*context, ShaderPath, args, OutDependencies);
+	ReleaseContext(std::move(context));
+
+	if (entry && key && !Cache->Store(*key, *entry))
+	{
+		LOG(Engine, Warning, "Failed to write shader cache entry: {}", TEXT(Cache->GetEntryPath(*key).string()));
+	}
+	return entry;
+}
+
+unique_ptr<OShader> OShaderCompiler::MergeStage(const SShaderDefinition& Definition, SShaderCacheEntry&& Entry, SShaderPipelineDesc& OutPipelineInfo)
+{
+	ResolveBoundResources(Entry.Reflection, OutPipelineInfo, Definition.ShaderType);
 	if (Definition.ShaderType == EShaderLevel::VertexShader)
 	{
-		GetInputLayoutDesc(shaderReflection, OutPipelineInfo);
+		GetInputLayoutDesc(Entry.Reflection, OutPipelineInfo);
 	}
-	ComPtr<IDxcBlob> compiledShaderBlob;
-	THROW_IF_FAILED(compiledShaderBuffer->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&compiledShaderBlob), nullptr));
 
 	auto shader = make_unique<OShader>();
-	shader->Init(Definition, compiledShaderBlob);
-	return std::move(shader);
+	shader->Init(Definition, std::move(Entry.ByteCode));
+	return shader;
 }
 
-ComPtr<ID3D12RootSignature> OShaderCompiler::BuildRootSignature(vector<D3D12_ROOT_PARAMETER1>& RootParameter, const vector<CD3DX12_STATIC_SAMPLER_DESC>& StaticSamplers, D3D12_VERSIONED_ROOT_SIGNATURE_DESC& OutDescription)
+unique_ptr<OShader> OShaderCompiler::CompileShader(const SShaderDefinition& Definition, const wstring& ShaderPath, SShaderPipelineDesc& OutPipelineInfo)
 {
-	ComPtr<ID3D12RootSignature> rootSignature;
-	const auto numSamples = static_cast<uint32_t>(StaticSamplers.size());
+	vector<std::filesystem::path> dependencies;
+	auto entry = CompileStage(Definition, ShaderPath, {}, true, dependencies);
+	if (!entry)
+	{
+		return nullptr;
+	}
+	return MergeStage(Definition, std::move(*entry), OutPipelineInfo);
+}
 
-	const D3D12_VERSIONED_ROOT_SIGNATURE_DESC desc = {
+void OShaderCompiler::BuildRootSignature(SShaderPipelineDesc& OutPipelineInfo)
+{
+	auto& params = OutPipelineInfo.RootSignatureParams;
+	const auto& rootParameters = OutPipelineInfo.BuildParameterArray();
+
+	// The description points into the params, which keep the samplers alive as long as the description may be read
+	params.StaticSamplers = Utils::GetStaticSamplers();
+	params.RootSignatureDesc = {
 		.Version = D3D_ROOT_SIGNATURE_VERSION_1_1,
 		.Desc_1_1 = {
-		    .NumParameters = static_cast<uint32_t>(RootParameter.size()),
-		    .pParameters = RootParameter.data(),
-		    .NumStaticSamplers = numSamples,
-		    .pStaticSamplers = StaticSamplers.data(),
+		    .NumParameters = static_cast<uint32_t>(rootParameters.size()),
+		    .pParameters = rootParameters.data(),
+		    .NumStaticSamplers = static_cast<uint32_t>(params.StaticSamplers.size()),
+		    .pStaticSamplers = params.StaticSamplers.data(),
 		    .Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT,
 		},
 	};
-	OutDescription = desc;
-	Utils::BuildRootSignature(OEngine::Get()->GetDevice().Get(), rootSignature, OutDescription);
-	return rootSignature;
+
+	const auto rootSignature = RootSignatureCache.FindOrBuild(OEngine::Get()->GetDevice().Get(), params.RootSignatureDesc);
+	params.RootSignature = rootSignature.RootSignature;
+	params.RootSignatureHash = rootSignature.Hash;
 }
@@ -1,34 +1,111 @@
 #pragma once
 #include "Engine/Shader/Shader.h"
+#include "RootSignatureCache.h"
+#include "ShaderCache.h"
+#include "Async.h"
 #include "Types.h"
 
+#include <atomic>
 #include <d3d12shader.h> // Contains functions and structures useful in accessing shader information.
 #include <dxcapi.h>
+#include <filesystem>
 
 struct SShaderPipelineDesc;
+
+/**
+ * @brief Stages of one pipeline and everything compiled from them, PipelineInfo is created by the compiler.
+ */
+struct SShaderPipelineCompilation
+{
+	string Name;
+	vector<SPipelineStage> Stages;
+	shared_ptr<SShaderPipelineDesc> PipelineInfo;
+	vector<unique_ptr<OShader>> Shaders;
+
+	// Per stage, the source itself and every file it included
+	vector<vector<std::filesystem::path>> Dependencies;
+};
+
+/**
+ * @brief Forwards to the default DXC include handler and records every file it opened, the include dependencies of a compilation.
+ */
+class OShaderIncludeHandler : public IDxcIncludeHandler
+{
+public:
+	explicit OShaderIncludeHandler(ComPtr<IDxcIncludeHandler> Inner);
+
+	HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR Filename, IDxcBlob** OutSource) override;
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID Riid, void** OutObject) override;
+	ULONG STDMETHODCALLTYPE AddRef() override;
+	ULONG STDMETHODCALLTYPE Release() override;
+
+	// Returns the files opened since the previous call
+	vector<std::filesystem::path> TakeIncludedFiles();
+
+private:
+	ComPtr<IDxcIncludeHandler> Inner;
+	std::atomic<ULONG> RefCount = 1;
+	vector<std::filesystem::path> IncludedFiles;
+};
+
+/**
+ * @brief Compilation only reads from the definition and the arguments built from it, every worker borrows its own DXC instance,
+ * so stages of different pipelines may be compiled concurrently. Resolving reflection into pipeline descs stays on the calling thread.
+ */
 class OShaderCompiler
 {
 public:
+	// Worker threads used by CompilePipelines, 0 uses every hardware thread
+	inline static uint32_t NumThreads = 0;
+
 	unique_ptr<OShader> CompileShader(const SShaderDefinition& Definition, const wstring& ShaderPath, SShaderPipelineDesc& OutPipelineInfo);
-	vector<unique_ptr<OShader>> CompileShaders(vector<SPipelineStage>& OutPipelines, SShaderPipelineDesc& OutShadersPipeline);
+
+	// Compiles every stage on Threads threads, then merges reflection and builds root signatures in the order of Pipelines
+	void CompilePipelines(vector<SShaderPipelineCompilation>& Pipelines, uint32_t Threads, bool bUseCache = true);
 	void Init();
 
+	uint32_t GetNumContexts();
+	ORootSignatureCache& GetRootSignatureCache();
+
 private:
-	ComPtr<ID3D12RootSignature> BuildRootSignature(vector<D3D12_ROOT_PARAMETER1>& RootParameter, const vector<CD3DX12_STATIC_SAMPLER_DESC>& StaticSamplers, D3D12_VERSIONED_ROOT_SIGNATURE_DESC& OutDescription);
-	D3D12_SHADER_DESC BuildReflection(DxcBuffer Buffer, ComPtr<ID3D12ShaderReflection>& OutReflection);
-	void GetInputLayoutDesc(const ComPtr<ID3D12ShaderReflection>& Reflection, SShaderPipelineDesc& OutPipelineInfo);
-	void SetCompilationArgs(const SShaderDefinition& Definition);
-	void ResolveBoundResources(const ComPtr<ID3D12ShaderReflection>& Reflection, const D3D12_SHADER_DESC& ShaderDescription, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
-	void ResolveConstantBuffers(int32_t ResourceIdx, const ComPtr<ID3D12ShaderReflection>& Reflection, const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo);
-	void ResolveTextures(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
-	void ResolveStructuredBuffer(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
-
-	D3D12_DESCRIPTOR_RANGE_TYPE GetRangeType(const D3D12_SHADER_INPUT_BIND_DESC& BindDesc);
-	std::tuple<DxcBuffer, ComPtr<IDxcResult>> CreateDxcBuffer(const wstring& ShaderPath);
-	ComPtr<IDxcCompiler3> Compiler;
-	ComPtr<IDxcUtils> Utils;
-	ComPtr<IDxcIncludeHandler> IncludeHandler;
-	vector<LPCWSTR> CompilationArgs;
-	wstring Entry;
-	wstring TargetProfile;
+	struct SDxcContext
+	{
+		ComPtr<IDxcCompiler3> Compiler;
+		ComPtr<IDxcUtils> Utils;
+		ComPtr<OShaderIncludeHandler> IncludeHandler;
+	};
+
+	// DXC objects are not thread safe, the pool grows up to the number of threads compiling at the same time
+	unique_ptr<SDxcContext> AcquireContext();
+	void ReleaseContext(unique_ptr<SDxcContext> Context);
+
+	// Pipelines with identical root parameters share one root signature object
+	void BuildRootSignature(SShaderPipelineDesc& OutPipelineInfo);
+	SShaderReflectionSummary BuildReflection(IDxcUtils* DxcUtils, DxcBuffer Buffer);
+	void GetInputLayoutDesc(const SShaderReflectionSummary& Reflection, SShaderPipelineDesc& OutPipelineInfo);
+	vector<wstring> BuildCompilationArgs(const SShaderDefinition& Definition, const vector<pair<string, string>>& Defines) const;
+	void ResolveBoundResources(const SShaderReflectionSummary& Reflection, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
+	void ResolveConstantBuffers(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo);
+	void ResolveTextures(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
+	void ResolveStructuredBuffer(const SShaderBoundResource& Resource, SShaderPipelineDesc& OutPipelineInfo, EShaderLevel ShaderType);
+
+	D3D12_DESCRIPTOR_RANGE_TYPE GetRangeType(D3D_SHADER_INPUT_TYPE Type);
+
+	// Runs DXC and reflects the result, empty on compilation errors
+	std::optional<SShaderCacheEntry> CompileToCacheEntry(SDxcContext& Context, const wstring& ShaderPath, const vector<wstring>& Args, vector<std::filesystem::path>& OutDependencies);
+	SShaderCacheKeyDesc MakeCacheKeyDesc(const SShaderDefinition& Definition, const wstring& ShaderPath, const vector<pair<string, string>>& Defines, const vector<wstring>& Args) const;
+
+	// Thread safe, loads from the cache or compiles
+	std::optional<SShaderCacheEntry> CompileStage(const SShaderDefinition& Definition, const wstring& ShaderPath, const vector<pair<string, string>>& Defines, bool bUseCache, vector<std::filesystem::path>& OutDependencies);
+
+	// Not thread safe, resolves the reflection into the pipeline desc
+	unique_ptr<OShader> MergeStage(const SShaderDefinition& Definition, SShaderCacheEntry&& Entry, SShaderPipelineDesc& OutPipelineInfo);
+
+	SMutex ContextMutex;
+	vector<unique_ptr<SDxcContext>> FreeContexts;
+
+	wstring ShadersFolder;
+	string CompilerVersion;
+	unique_ptr<OShaderCache> Cache;
+	ORootSignatureCache RootSignatureCache;
 };
@@ -0,0 +1,38 @@
+#include "RootSignatureCache.h"
+
+#include "DirectXUtils.h"
+
+ORootSignatureCache::SRootSignature ORootSignatureCache::FindOrBuild(ID3D12Device* Device, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc)
+{
+	SRootSignatureLayout layout(Desc);
+	const uint64_t hash = HashRootSignature(layout);
+
+	SLockGuard lock(Mutex);
+	auto& entries = Entries[hash];
+	for (const auto& entry : entries)
+	{
+		if (entry.Layout == layout)
+		{
+			NumShared++;
+			return { entry.RootSignature, hash };
+		}
+	}
+
+	ComPtr<ID3D12RootSignature> rootSignature;
+	Utils::BuildRootSignature(Device, rootSignature, Desc);
+	entries.push_back({ std::move(layout), rootSignature });
+	NumRootSignatures++;
+	return { rootSignature, hash };
+}
+
+uint32_t ORootSignatureCache::GetNumRootSignatures()
+{
+	SLockGuard lock(Mutex);
+	return NumRootSignatures;
+}
+
+uint32_t ORootSignatureCache::GetNumShared()
+{
+	SLockGuard lock(Mutex);
+	return NumShared;
+}
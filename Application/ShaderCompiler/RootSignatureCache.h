@@ -0,0 +1,40 @@
+#pragma once
+#include "Async.h"
+#include "DirectX/DXHelper.h"
+#include "GraphicsPipeline/PipelineStateHash.h"
+#include "Types.h"
+
+/**
+ * @brief Hands out one root signature object per distinct layout. Pipelines whose shaders bind the same resources share it,
+ * which saves the serialization and creation on the device and lets the command list skip redundant root signature switches.
+ * Thread safe, pipelines are compiled on worker threads during hot reload and for permutations.
+ */
+class ORootSignatureCache
+{
+public:
+	struct SRootSignature
+	{
+		ComPtr<ID3D12RootSignature> RootSignature;
+		uint64_t Hash = 0;
+	};
+
+	// Returns the root signature built for an identical layout earlier or builds it now
+	SRootSignature FindOrBuild(ID3D12Device* Device, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc);
+
+	uint32_t GetNumRootSignatures();
+	uint32_t GetNumShared();
+
+private:
+	struct SEntry
+	{
+		SRootSignatureLayout Layout;
+		ComPtr<ID3D12RootSignature> RootSignature;
+	};
+
+	SMutex Mutex;
+
+	// Entries of a hash are compared in full, a collision builds a second root signature instead of sharing the wrong one
+	unordered_map<uint64_t, vector<SEntry>> Entries;
+	uint32_t NumRootSignatures = 0;
+	uint32_t NumShared = 0;
+};
@@ -0,0 +1,370 @@
+#include "ShaderCache.h"
+
+#include "HashUtils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <thread>
+
+namespace
+{
+std::optional<string> ReadFile(const std::filesystem::path& Path)
+{
+	std::ifstream file(Path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return std::nullopt;
+	}
+	return string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Names of all #include directives, conditional compilation is ignored so the result may contain more files than the compiler opens
+vector<string> ParseIncludes(const string& Source)
+{
+	vector<string> result;
+	size_t lineStart = 0;
+	while (lineStart < Source.size())
+	{
+		size_t lineEnd = Source.find('\n', lineStart);
+		if (lineEnd == string::npos)
+		{
+			lineEnd = Source.size();
+		}
+
+		std::string_view line(Source.data() + lineStart, lineEnd - lineStart);
+		const auto skipSpaces = [&line]() {
+			while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+			{
+				line.remove_prefix(1);
+			}
+		};
+
+		skipSpaces();
+		if (line.starts_with('#'))
+		{
+			line.remove_prefix(1);
+			skipSpaces();
+			if (line.starts_with("include"))
+			{
+				line.remove_prefix(7);
+				skipSpaces();
+				if (!line.empty() && (line.front() == '"' || line.front() == '<'))
+				{
+					const char closing = line.front() == '"' ? '"' : '>';
+					line.remove_prefix(1);
+					if (const size_t end = line.find(closing); end != std::string_view::npos)
+					{
+						result.emplace_back(line.substr(0, end));
+					}
+				}
+			}
+		}
+		lineStart = lineEnd + 1;
+	}
+	return result;
+}
+
+std::optional<std::filesystem::path> ResolveInclude(const string& Name, const std::filesystem::path& IncludingDir, const vector<std::filesystem::path>& IncludeDirs)
+{
+	std::error_code error;
+	if (auto candidate = IncludingDir / Name; std::filesystem::is_regular_file(candidate, error))
+	{
+		return std::filesystem::weakly_canonical(candidate, error);
+	}
+	for (const auto& dir : IncludeDirs)
+	{
+		if (auto candidate = dir / Name; std::filesystem::is_regular_file(candidate, error))
+		{
+			return std::filesystem::weakly_canonical(candidate, error);
+		}
+	}
+	return std::nullopt;
+}
+
+struct SBinaryWriter
+{
+	vector<uint8_t> Data;
+
+	template<typename T>
+	void Write(const T& Value)
+	{
+		const auto bytes = reinterpret_cast<const uint8_t*>(&Value);
+		Data.insert(Data.end(), bytes, bytes + sizeof(T));
+	}
+
+	void Write(const string& Value)
+	{
+		Write(static_cast<uint32_t>(Value.size()));
+		Data.insert(Data.end(), Value.begin(), Value.end());
+	}
+
+	void Write(const vector<uint8_t>& Value)
+	{
+		Write(static_cast<uint64_t>(Value.size()));
+		Data.insert(Data.end(), Value.begin(), Value.end());
+	}
+};
+
+// Every read checks the remaining size, a truncated or foreign file turns the reader invalid instead of reading past the end
+struct SBinaryReader
+{
+	std::span<const uint8_t> Data;
+	size_t Offset = 0;
+	bool bValid = true;
+
+	bool CanRead(uint64_t Size)
+	{
+		bValid = bValid && Size <= Data.size() - Offset;
+		return bValid;
+	}
+
+	template<typename T>
+	T Read()
+	{
+		T value{};
+		if (CanRead(sizeof(T)))
+		{
+			std::memcpy(&value, Data.data() + Offset, sizeof(T));
+			Offset += sizeof(T);
+		}
+		return value;
+	}
+
+	string ReadString()
+	{
+		const auto size = Read<uint32_t>();
+		if (!CanRead(size))
+		{
+			return {};
+		}
+		string value(reinterpret_cast<const char*>(Data.data() + Offset), size);
+		Offset += size;
+		return value;
+	}
+
+	vector<uint8_t> ReadBytes()
+	{
+		const auto size = Read<uint64_t>();
+		if (!CanRead(size))
+		{
+			return {};
+		}
+		vector<uint8_t> value(Data.begin() + Offset, Data.begin() + Offset + size);
+		Offset += size;
+		return value;
+	}
+};
+} // namespace
+
+void SShaderCacheKeyDesc::SetArguments(const vector<string>& CommandLine)
+{
+	Arguments.clear();
+	for (size_t i = 0; i < CommandLine.size(); i++)
+	{
+		// Include directories are absolute and would tie the key to the checkout, defines are already in Defines
+		if (CommandLine[i] == "-I" || CommandLine[i] == "-D")
+		{
+			i++;
+			continue;
+		}
+		Arguments.push_back(CommandLine[i]);
+	}
+}
+
+OShaderCache::OShaderCache(std::filesystem::path Directory)
+    : Directory(std::move(Directory))
+{
+	std::error_code error;
+	std::filesystem::create_directories(this->Directory, error);
+}
+
+vector<std::filesystem::path> OShaderCache::CollectIncludes(const std::filesystem::path& SourcePath, const vector<std::filesystem::path>& IncludeDirs)
+{
+	std::set<std::filesystem::path> visited;
+	vector<std::filesystem::path> pending = { SourcePath };
+	while (!pending.empty())
+	{
+		const auto current = pending.back();
+		pending.pop_back();
+
+		const auto source = ReadFile(current);
+		if (!source)
+		{
+			continue;
+		}
+
+		for (const auto& name : ParseIncludes(*source))
+		{
+			const auto resolved = ResolveInclude(name, current.parent_path(), IncludeDirs);
+			if (resolved && visited.insert(*resolved).second)
+			{
+				pending.push_back(*resolved);
+			}
+		}
+	}
+
+	// std::set keeps them sorted, the key doesn't depend on the order files were discovered in
+	return { visited.begin(), visited.end() };
+}
+
+std::optional<uint64_t> OShaderCache::ComputeKey(const SShaderCacheKeyDesc& Desc)
+{
+	Utils::SHasher hasher;
+	hasher.Add(Version);
+
+	const auto source = ReadFile(Desc.SourcePath);
+	if (!source)
+	{
+		return std::nullopt;
+	}
+	hasher.Add(*source);
+
+	// Only contents are hashed, moving the project to another directory keeps the cache valid
+	for (const auto& include : CollectIncludes(Desc.SourcePath, Desc.IncludeDirs))
+	{
+		const auto content = ReadFile(include);
+		if (!content)
+		{
+			return std::nullopt;
+		}
+		hasher.Add(include.filename().string());
+		hasher.Add(*content);
+	}
+
+	hasher.Add(static_cast<uint64_t>(Desc.Defines.size()));
+	for (const auto& [name, value] : Desc.Defines)
+	{
+		hasher.Add(name);
+		hasher.Add(value);
+	}
+	hasher.Add(Desc.EntryPoint);
+	hasher.Add(Desc.TargetProfile);
+	hasher.Add(Desc.CompilerVersion);
+	hasher.Add(static_cast<uint64_t>(Desc.Arguments.size()));
+	for (const auto& argument : Desc.Arguments)
+	{
+		hasher.Add(argument);
+	}
+	return hasher.Value;
+}
+
+std::filesystem::path OShaderCache::GetEntryPath(uint64_t Key) const
+{
+	// No std::format here, the cache is built with older standard libraries as well
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.shader", static_cast<unsigned long long>(Key));
+	return Directory / name;
+}
+
+std::optional<SShaderCacheEntry> OShaderCache::Load(uint64_t Key) const
+{
+	const auto data = ReadFile(GetEntryPath(Key));
+	if (!data)
+	{
+		return std::nullopt;
+	}
+	return Deserialize(Key, { reinterpret_cast<const uint8_t*>(data->data()), data->size() });
+}
+
+bool OShaderCache::Store(uint64_t Key, const SShaderCacheEntry& Entry) const
+{
+	const auto path = GetEntryPath(Key);
+	// Identical stages of different pipelines may be stored from several threads at once, each writes its own temporary file
+	auto tempPath = path;
+	tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+	const auto data = Serialize(Key, Entry);
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error)
+	{
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+vector<uint8_t> OShaderCache::Serialize(uint64_t Key, const SShaderCacheEntry& Entry)
+{
+	SBinaryWriter writer;
+	writer.Write(Magic);
+	writer.Write(Version);
+	writer.Write(Key);
+	writer.Write(Entry.ByteCode);
+
+	writer.Write(static_cast<uint32_t>(Entry.Reflection.BoundResources.size()));
+	for (const auto& resource : Entry.Reflection.BoundResources)
+	{
+		writer.Write(resource.Name);
+		writer.Write(resource.Type);
+		writer.Write(resource.BindPoint);
+		writer.Write(resource.BindCount);
+		writer.Write(resource.Space);
+		writer.Write(resource.ByteSize);
+	}
+
+	writer.Write(static_cast<uint32_t>(Entry.Reflection.InputParameters.size()));
+	for (const auto& parameter : Entry.Reflection.InputParameters)
+	{
+		writer.Write(parameter.SemanticName);
+		writer.Write(parameter.SemanticIndex);
+		writer.Write(parameter.Mask);
+	}
+	return std::move(writer.Data);
+}
+
+std::optional<SShaderCacheEntry> OShaderCache::Deserialize(uint64_t Key, std::span<const uint8_t> Data)
+{
+	SBinaryReader reader{ .Data = Data };
+	if (reader.Read<uint32_t>() != Magic || reader.Read<uint32_t>() != Version || reader.Read<uint64_t>() != Key)
+	{
+		return std::nullopt;
+	}
+
+	SShaderCacheEntry entry;
+	entry.ByteCode = reader.ReadBytes();
+
+	const auto numResources = reader.Read<uint32_t>();
+	for (uint32_t i = 0; i < numResources && reader.bValid; i++)
+	{
+		SShaderBoundResource resource;
+		resource.Name = reader.ReadString();
+		resource.Type = reader.Read<uint32_t>();
+		resource.BindPoint = reader.Read<uint32_t>();
+		resource.BindCount = reader.Read<uint32_t>();
+		resource.Space = reader.Read<uint32_t>();
+		resource.ByteSize = reader.Read<uint32_t>();
+		entry.Reflection.BoundResources.push_back(std::move(resource));
+	}
+
+	const auto numParameters = reader.Read<uint32_t>();
+	for (uint32_t i = 0; i < numParameters && reader.bValid; i++)
+	{
+		SShaderInputParameter parameter;
+		parameter.SemanticName = reader.ReadString();
+		parameter.SemanticIndex = reader.Read<uint32_t>();
+		parameter.Mask = reader.Read<uint32_t>();
+		entry.Reflection.InputParameters.push_back(std::move(parameter));
+	}
+
+	if (!reader.bValid || reader.Offset != Data.size() || entry.ByteCode.empty())
+	{
+		return std::nullopt;
+	}
+	return entry;
+}
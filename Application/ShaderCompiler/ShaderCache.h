@@ -0,0 +1,88 @@
+#pragma once
+#include "Types.h"
+
+#include <filesystem>
+#include <span>
+
+/**
+ * @brief Everything the root signature and input layout are built from, so that a cached shader needs no reflection.
+ * Types are the raw D3D_SHADER_INPUT_TYPE values, the cache itself doesn't depend on any graphics API.
+ */
+struct SShaderBoundResource
+{
+	string Name;
+	uint32_t Type = 0;
+	uint32_t BindPoint = 0;
+	uint32_t BindCount = 0;
+	uint32_t Space = 0;
+
+	// Bytes up to the end of the last variable, constant buffers only
+	uint32_t ByteSize = 0;
+};
+
+struct SShaderInputParameter
+{
+	string SemanticName;
+	uint32_t SemanticIndex = 0;
+	uint32_t Mask = 0;
+};
+
+struct SShaderReflectionSummary
+{
+	vector<SShaderBoundResource> BoundResources;
+	vector<SShaderInputParameter> InputParameters;
+};
+
+struct SShaderCacheEntry
+{
+	vector<uint8_t> ByteCode;
+	SShaderReflectionSummary Reflection;
+};
+
+/**
+ * @brief Inputs of a single compilation. Anything that changes the produced bytecode has to be part of it.
+ */
+struct SShaderCacheKeyDesc
+{
+	std::filesystem::path SourcePath;
+	vector<std::filesystem::path> IncludeDirs;
+	vector<pair<string, string>> Defines;
+	string EntryPoint;
+	string TargetProfile;
+	string CompilerVersion;
+	vector<string> Arguments;
+
+	// Takes the command line of the compilation. Include directories and defines are skipped, included files are hashed by
+	// content and Defines are part of the key on their own.
+	void SetArguments(const vector<string>& CommandLine);
+};
+
+/**
+ * @brief Content addressed store of compiled shaders. The key hashes the source, every file it includes transitively and the compilation settings,
+ * so stale entries are simply never looked up again. Entries are written to a temporary file first and renamed, a crash never leaves a torn entry behind.
+ */
+class OShaderCache
+{
+public:
+	static constexpr uint32_t Magic = 0x43444853; // "SHDC"
+	static constexpr uint32_t Version = 1;
+
+	explicit OShaderCache(std::filesystem::path Directory);
+
+	// Empty if the source or one of its includes can't be read
+	static std::optional<uint64_t> ComputeKey(const SShaderCacheKeyDesc& Desc);
+
+	// Quoted and angled includes resolved relative to the including file first, then to IncludeDirs. Unresolved includes are skipped.
+	static vector<std::filesystem::path> CollectIncludes(const std::filesystem::path& SourcePath, const vector<std::filesystem::path>& IncludeDirs);
+
+	std::optional<SShaderCacheEntry> Load(uint64_t Key) const;
+	bool Store(uint64_t Key, const SShaderCacheEntry& Entry) const;
+
+	static vector<uint8_t> Serialize(uint64_t Key, const SShaderCacheEntry& Entry);
+	static std::optional<SShaderCacheEntry> Deserialize(uint64_t Key, std::span<const uint8_t> Data);
+
+	std::filesystem::path GetEntryPath(uint64_t Key) const;
+
+private:
+	std::filesystem::path Directory;
+};
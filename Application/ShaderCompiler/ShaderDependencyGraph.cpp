@@ -0,0 +1,92 @@
+#include "ShaderDependencyGraph.h"
+
+#include <algorithm>
+#include <cctype>
+
+string OShaderDependencyGraph::NormalizePath(const std::filesystem::path& Path)
+{
+	std::error_code error;
+	auto absolute = std::filesystem::weakly_canonical(std::filesystem::absolute(Path, error), error);
+	if (error)
+	{
+		absolute = std::filesystem::absolute(Path, error);
+	}
+
+	auto result = absolute.lexically_normal().generic_string();
+#ifdef _WIN32
+	std::ranges::transform(result, result.begin(), [](unsigned char Char) { return static_cast<char>(std::tolower(Char)); });
+#endif
+	return result;
+}
+
+void OShaderDependencyGraph::SetDependencies(const SShaderStageId& Stage, const vector<std::filesystem::path>& Files)
+{
+	RemoveStage(Stage);
+
+	std::set<string> unique;
+	for (const auto& file : Files)
+	{
+		unique.insert(NormalizePath(file));
+	}
+
+	auto& dependencies = Dependencies[Stage];
+	for (const auto& file : unique)
+	{
+		Dependents[file].insert(Stage);
+		dependencies.push_back(file);
+	}
+}
+
+void OShaderDependencyGraph::RemoveStage(const SShaderStageId& Stage)
+{
+	const auto it = Dependencies.find(Stage);
+	if (it == Dependencies.end())
+	{
+		return;
+	}
+
+	for (const auto& file : it->second)
+	{
+		auto dependents = Dependents.find(file);
+		dependents->second.erase(Stage);
+		if (dependents->second.empty())
+		{
+			Dependents.erase(dependents);
+		}
+	}
+	Dependencies.erase(it);
+}
+
+vector<SShaderStageId> OShaderDependencyGraph::GetAffectedStages(const vector<std::filesystem::path>& ChangedFiles) const
+{
+	std::set<SShaderStageId> affected;
+	for (const auto& file : ChangedFiles)
+	{
+		if (const auto it = Dependents.find(NormalizePath(file)); it != Dependents.end())
+		{
+			affected.insert(it->second.begin(), it->second.end());
+		}
+	}
+	return { affected.begin(), affected.end() };
+}
+
+vector<string> OShaderDependencyGraph::GetAffectedPipelines(const vector<std::filesystem::path>& ChangedFiles) const
+{
+	std::set<string> pipelines;
+	for (const auto& stage : GetAffectedStages(ChangedFiles))
+	{
+		pipelines.insert(stage.Pipeline);
+	}
+	return { pipelines.begin(), pipelines.end() };
+}
+
+vector<string> OShaderDependencyGraph::GetDependencies(const SShaderStageId& Stage) const
+{
+	const auto it = Dependencies.find(Stage);
+	return it != Dependencies.end() ? it->second : vector<string>{};
+}
+
+size_t OShaderDependencyGraph::GetNumFiles() const
+{
+	return Dependents.size();
+}
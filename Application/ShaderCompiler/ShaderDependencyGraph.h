@@ -0,0 +1,43 @@
+#pragma once
+#include "Types.h"
+
+#include <filesystem>
+#include <map>
+#include <set>
+
+/**
+ * @brief One stage of a shader pipeline, StageIndex is the position in the pipeline config.
+ */
+struct SShaderStageId
+{
+	string Pipeline;
+	uint32_t StageIndex = 0;
+
+	auto operator<=>(const SShaderStageId&) const = default;
+};
+
+/**
+ * @brief Maps every file a stage was compiled from back to the stage. Files are recorded transitively, so a change
+ * to an include nested a few levels deep still reaches every stage that ends up reading it. Free of any graphics API.
+ */
+class OShaderDependencyGraph
+{
+public:
+	// Replaces everything recorded for the stage, Files holds the source itself and all of its includes
+	void SetDependencies(const SShaderStageId& Stage, const vector<std::filesystem::path>& Files);
+	void RemoveStage(const SShaderStageId& Stage);
+
+	// Sorted and unique, a stage depending on several of the changed files is listed once
+	vector<SShaderStageId> GetAffectedStages(const vector<std::filesystem::path>& ChangedFiles) const;
+	vector<string> GetAffectedPipelines(const vector<std::filesystem::path>& ChangedFiles) const;
+
+	vector<string> GetDependencies(const SShaderStageId& Stage) const;
+	size_t GetNumFiles() const;
+
+	// Absolute, lexically normal and with forward slashes. Windows paths are lower case, the file system there ignores case.
+	static string NormalizePath(const std::filesystem::path& Path);
+
+private:
+	std::map<SShaderStageId, vector<string>> Dependencies;
+	std::map<string, std::set<SShaderStageId>> Dependents;
+};
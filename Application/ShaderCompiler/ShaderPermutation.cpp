@@ -0,0 +1,162 @@
+#include "ShaderPermutation.h"
+
+#include <bit>
+
+uint32_t SShaderPermutationAxis::GetNumValues() const
+{
+	return Values.empty() ? 2 : static_cast<uint32_t>(Values.size());
+}
+
+uint32_t SShaderPermutationAxis::GetNumBits() const
+{
+	return std::bit_width(GetNumValues() - 1);
+}
+
+bool OShaderPermutationSpace::AddAxis(SShaderPermutationAxis Axis)
+{
+	if (FindAxis(Axis.Name) || NumBits + Axis.GetNumBits() > 64)
+	{
+		return false;
+	}
+
+	BitOffsets.push_back(NumBits);
+	NumBits += Axis.GetNumBits();
+	Axes.push_back(std::move(Axis));
+	return true;
+}
+
+TShaderPermutationKey OShaderPermutationSpace::SetValue(TShaderPermutationKey Key, size_t AxisIndex, uint32_t ValueIndex) const
+{
+	const uint32_t numBits = Axes[AxisIndex].GetNumBits();
+	if (numBits == 0)
+	{
+		return Key;
+	}
+
+	const TShaderPermutationKey mask = (numBits == 64 ? ~0ull : (1ull << numBits) - 1) << BitOffsets[AxisIndex];
+	const uint32_t value = std::min(ValueIndex, Axes[AxisIndex].GetNumValues() - 1);
+	return (Key & ~mask) | (static_cast<TShaderPermutationKey>(value) << BitOffsets[AxisIndex]);
+}
+
+uint32_t OShaderPermutationSpace::GetValue(TShaderPermutationKey Key, size_t AxisIndex) const
+{
+	const uint32_t numBits = Axes[AxisIndex].GetNumBits();
+	if (numBits == 0)
+	{
+		return 0;
+	}
+	const TShaderPermutationKey mask = numBits == 64 ? ~0ull : (1ull << numBits) - 1;
+	return static_cast<uint32_t>((Key >> BitOffsets[AxisIndex]) & mask);
+}
+
+TShaderPermutationKey OShaderPermutationSpace::MakeKey(const map<string, uint32_t>& Features) const
+{
+	TShaderPermutationKey key = 0;
+	for (size_t i = 0; i < Axes.size(); i++)
+	{
+		if (const auto it = Features.find(Axes[i].Name); it != Features.end())
+		{
+			key = SetValue(key, i, it->second);
+		}
+	}
+	return key;
+}
+
+bool OShaderPermutationSpace::IsValid(TShaderPermutationKey Key) const
+{
+	if (NumBits < 64 && (Key >> NumBits) != 0)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < Axes.size(); i++)
+	{
+		if (GetValue(Key, i) >= Axes[i].GetNumValues())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+vector<pair<string, string>> OShaderPermutationSpace::GetDefines(TShaderPermutationKey Key) const
+{
+	vector<pair<string, string>> defines;
+	for (size_t i = 0; i < Axes.size(); i++)
+	{
+		const auto& axis = Axes[i];
+		const uint32_t value = GetValue(Key, i);
+		if (!axis.Values.empty())
+		{
+			defines.emplace_back(axis.Name, axis.Values[value]);
+		}
+		else if (value != 0)
+		{
+			defines.emplace_back(axis.Name, "1");
+		}
+	}
+	return defines;
+}
+
+vector<pair<string, string>> OShaderPermutationSpace::GetDefines(TShaderPermutationKey Key, vector<pair<string, string>> StageDefines) const
+{
+	for (auto& define : GetDefines(Key))
+	{
+		const auto it = std::ranges::find(StageDefines, define.first, &pair<string, string>::first);
+		if (it != StageDefines.end())
+		{
+			it->second = std::move(define.second);
+		}
+		else
+		{
+			StageDefines.push_back(std::move(define));
+		}
+	}
+	return StageDefines;
+}
+
+string OShaderPermutationSpace::ToString(TShaderPermutationKey Key) const
+{
+	string result;
+	for (const auto& [name, value] : GetDefines(Key))
+	{
+		result += (result.empty() ? "" : " ") + name + "=" + value;
+	}
+	return result.empty() ? "default" : result;
+}
+
+std::optional<size_t> OShaderPermutationSpace::FindAxis(const string& Name) const
+{
+	for (size_t i = 0; i < Axes.size(); i++)
+	{
+		if (Axes[i].Name == Name)
+		{
+			return i;
+		}
+	}
+	return std::nullopt;
+}
+
+const vector<SShaderPermutationAxis>& OShaderPermutationSpace::GetAxes() const
+{
+	return Axes;
+}
+
+uint64_t OShaderPermutationSpace::GetNumPermutations() const
+{
+	uint64_t count = 1;
+	for (const auto& axis : Axes)
+	{
+		count *= axis.GetNumValues();
+	}
+	return count;
+}
+
+uint32_t OShaderPermutationSpace::GetNumBits() const
+{
+	return NumBits;
+}
+
+bool OShaderPermutationSpace::IsEmpty() const
+{
+	return Axes.empty();
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Types.h"
+
+using TShaderPermutationKey = uint64_t;
+
+/**
+ * @brief One feature a shader can be compiled with. A switch without values is either left undefined or defined as 1,
+ * otherwise the macro is defined to the selected value.
+ */
+struct SShaderPermutationAxis
+{
+	string Name;
+	vector<string> Values;
+
+	uint32_t GetNumValues() const;
+	uint32_t GetNumBits() const;
+};
+
+/**
+ * @brief Feature axes of a pipeline packed into a bitmask, the value index of every axis occupies just enough bits to hold it.
+ * Key 0 selects the first value of every axis, which is the variant compiled at startup. Free of any graphics API.
+ */
+class OShaderPermutationSpace
+{
+public:
+	// False if the axis is declared twice or the key would exceed 64 bits
+	bool AddAxis(SShaderPermutationAxis Axis);
+
+	TShaderPermutationKey SetValue(TShaderPermutationKey Key, size_t AxisIndex, uint32_t ValueIndex) const;
+	uint32_t GetValue(TShaderPermutationKey Key, size_t AxisIndex) const;
+
+	// Axes missing from Features keep their first value, indices past the last value are clamped
+	TShaderPermutationKey MakeKey(const map<string, uint32_t>& Features) const;
+	bool IsValid(TShaderPermutationKey Key) const;
+
+	// Defines of every axis not left undefined, in declaration order
+	vector<pair<string, string>> GetDefines(TShaderPermutationKey Key) const;
+
+	// Defines of a stage with the permutation applied, an axis named like one of the stage defines replaces its value
+	vector<pair<string, string>> GetDefines(TShaderPermutationKey Key, vector<pair<string, string>> StageDefines) const;
+	string ToString(TShaderPermutationKey Key) const;
+
+	std::optional<size_t> FindAxis(const string& Name) const;
+	const vector<SShaderPermutationAxis>& GetAxes() const;
+	uint64_t GetNumPermutations() const;
+	uint32_t GetNumBits() const;
+	bool IsEmpty() const;
+
+private:
+	vector<SShaderPermutationAxis> Axes;
+	vector<uint32_t> BitOffsets;
+	uint32_t NumBits = 0;
+};
@@ -15,6 +15,8 @@ void OFogWidget::Draw()
 
 void OFogWidget::Update()
 {
+	// Without fog the FOG permutation compiles the fog math out of the lit shaders
+	Engine->SetShaderFeature("FOG", bEnabled);
 	if (bEnabled)
 	{
 		if (Engine == nullptr)
@@ -8,7 +8,7 @@ void OLightComponentWidget::Draw()
 	ImGui::SeparatorText("Light SelectedComponent");
 	if (LightComponent)
 	{
-		ImGui::Text("Light Type: %s", ToString(LightComponent->GetLightType()).c_str());
+		ImGui::Text("Light Type: %s", ToString(LightComponent->GetLightType()));
 		bool dirty = false;
 		switch (LightComponent->GetLightType())
 		{
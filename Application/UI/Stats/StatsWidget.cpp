@@ -0,0 +1,72 @@
+#include "StatsWidget.h"
+
+#include "Stats/Stats.h"
+
+void OStatsWidget::Draw()
+{
+	if (ImGui::CollapsingHeader("Stats"))
+	{
+		ImGui::Text("Frame: %llu", Registry->GetFrameIndex());
+		if (ImGui::BeginTable("Counters", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Counter");
+			ImGui::TableSetupColumn("Last Frame");
+			ImGui::TableSetupColumn("Average");
+			ImGui::TableHeadersRow();
+			for (size_t i = 0; i < NumStatCounters; i++)
+			{
+				const auto counter = static_cast<EStatCounter>(i);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(ToString(counter));
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", Registry->GetLastFrame(counter));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", Registry->GetAverage(counter));
+			}
+			ImGui::EndTable();
+		}
+
+		for (size_t i = 0; i < NumStatHistograms; i++)
+		{
+			const auto histogram = static_cast<EStatHistogram>(i);
+			const auto& data = Registry->GetHistogram(histogram);
+			if (ImGui::TreeNode(ToString(histogram)))
+			{
+				float buckets[SStatHistogram::NumBuckets];
+				for (size_t j = 0; j < SStatHistogram::NumBuckets; j++)
+				{
+					buckets[j] = static_cast<float>(data.Buckets[j].load(std::memory_order_relaxed));
+				}
+				const uint64_t count = data.Count.load(std::memory_order_relaxed);
+				ImGui::Text("Samples: %llu Avg: %llu Max: %llu",
+				            count,
+				            count == 0 ? 0 : data.Sum.load(std::memory_order_relaxed) / count,
+				            data.Max.load(std::memory_order_relaxed));
+				ImGui::PlotHistogram("Log2 Buckets", buckets, SStatHistogram::NumBuckets, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+				ImGui::TreePop();
+			}
+		}
+
+		bSettingsChanged |= ImGui::Checkbox("Dump To Disk", &bDumpEnabled);
+		bSettingsChanged |= ImGui::SliderInt("Dump Every N Frames", &DumpFrequency, 1, 10000);
+		if (ImGui::Button("Dump Now"))
+		{
+			Registry->Dump();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Reset Histograms"))
+		{
+			Registry->ResetHistograms();
+		}
+	}
+}
+
+void OStatsWidget::Update()
+{
+	if (bSettingsChanged)
+	{
+		Registry->SetDumpFrequency(bDumpEnabled ? DumpFrequency : 0);
+		bSettingsChanged = false;
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "UI/Widget.h"
+
+class OStatsRegistry;
+class OStatsWidget : public IWidget
+{
+public:
+	OStatsWidget(OStatsRegistry* Other)
+	    : Registry(Other){};
+
+	void Draw() override;
+	void Update() override;
+
+private:
+	OStatsRegistry* Registry = nullptr;
+	bool bDumpEnabled = false;
+	bool bSettingsChanged = false;
+	int32_t DumpFrequency = 600;
+};
@@ -1,6 +1,7 @@
 #include "UiManager.h"
 
 #include "Engine/Engine.h"
+#include "Stats/Stats.h"
 #include "UI/Effects/FogWidget.h"
 #include "UI/Effects/Light/LightWidget.h"
 #include "UI/Engine/Camera.h"
@@ -8,6 +9,7 @@
 #include "UI/Geometry/GeometryManager.h"
 #include "UI/Material/MaterialManager/MaterialManager.h"
 #include "UI/Material/TextureManager/TextureManager.h"
+#include "UI/Stats/StatsWidget.h"
 #include "Window/Window.h"
 #include "backends/imgui_impl_dx12.h"
 #include "backends/imgui_impl_win32.h"
@@ -75,6 +77,7 @@ void OUIManager::InitWidgets(OEngine* Engine)
 	MakeWidget<OGeometryManagerWidget>(Engine, &Engine->GetRenderLayers());
 	MakeWidget<OMaterialManagerWidget>(Engine->GetMaterialManager());
 	MakeWidget<OTextureManagerWidget>(Engine->GetTextureManager());
+	MakeWidget<OStatsWidget>(OStatsRegistry::Get());
 }
 
 void OUIManager::OnMouseButtonPressed(MouseButtonEventArgs& Args)
@@ -3,6 +3,7 @@
 
 #include "Application.h"
 #include "Camera/Camera.h"
+#include "DirectX/RenderBackend.h"
 #include "Exception.h"
 #include "Logger.h"
 
@@ -26,9 +27,12 @@ void OWindow::BuildResource()
 {
 	const auto engine = OEngine::Get();
 	auto device = engine->GetDevice();
-	SwapChain = CreateSwapChain();
-	TotalRTVDescNum = OEngine::Get()->GetDesiredCountOfRTVs();
-	TotalDSVDescNum = OEngine::Get()->GetDesiredCountOfDSVs();
+	if (!SRenderBackend::IsHeadless())
+	{
+		SwapChain = CreateSwapChain();
+	}
+	TotalRTVDescNum = SRenderConstants::MaxRTVDescriptors;
+	TotalDSVDescNum = SRenderConstants::MaxDSVDescriptors;
 
 	RTVDescriptorSize = engine->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
@@ -75,8 +79,11 @@ UINT OWindow::GetCurrentBackBufferIndex() const
 
 UINT OWindow::Present()
 {
-	THROW_IF_FAILED(SwapChain->Present(0, 0));
-	CurrentBackBufferIndex = SwapChain->GetCurrentBackBufferIndex();
+	if (SwapChain)
+	{
+		THROW_IF_FAILED(SwapChain->Present(0, 0));
+	}
+	MoveToNextFrame();
 	return CurrentBackBufferIndex;
 }
 
@@ -190,7 +197,10 @@ void OWindow::Hide()
 
 void OWindow::RegsterWindow()
 {
-	Show();
+	if (!SRenderBackend::IsHeadless())
+	{
+		Show();
+	}
 	UpdateWindow(Hwnd);
 }
 
@@ -351,7 +361,7 @@ void OWindow::OnResize(ResizeEventArgs& Event)
 
 void OWindow::ResetBuffers()
 {
-	if (SwapChain)
+	if (SwapChain || SRenderBackend::IsHeadless())
 	{
 		OEngine::Get()->GetCommandQueue()->TryResetCommandList();
 		for (int i = 0; i < SRenderConstants::RenderBuffersCount; ++i)
@@ -360,7 +370,10 @@ void OWindow::ResetBuffers()
 			BackBuffers[i].Resource.Reset();
 		}
 
-		THROW_IF_FAILED(SwapChain->ResizeBuffers(SRenderConstants::RenderBuffersCount, WindowInfo.ClientWidth, WindowInfo.ClientHeight, SRenderConstants::BackBufferFormat, DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH));
+		if (SwapChain)
+		{
+			THROW_IF_FAILED(SwapChain->ResizeBuffers(SRenderConstants::RenderBuffersCount, WindowInfo.ClientWidth, WindowInfo.ClientHeight, SRenderConstants::BackBufferFormat, DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH));
+		}
 		CurrentBackBufferIndex = 0;
 
 		UpdateRenderTargetViews();
@@ -478,6 +491,22 @@ ComPtr<IDXGISwapChain4> OWindow::CreateSwapChain()
 	return swapChain4;
 }
 
+SResourceInfo OWindow::CreateHeadlessBackBuffer()
+{
+	const auto engine = OEngine::Get();
+	UINT msaaQuality;
+	const bool msaaState = engine->GetMSAAState(msaaQuality);
+	const auto desc = CD3DX12_RESOURCE_DESC::Tex2D(SRenderConstants::BackBufferFormat,
+	                                               WindowInfo.ClientWidth,
+	                                               WindowInfo.ClientHeight,
+	                                               1,
+	                                               1,
+	                                               msaaState ? 4 : 1,
+	                                               msaaState ? msaaQuality - 1 : 0,
+	                                               D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+	return Utils::CreateResource(this, engine->GetDevice().Get(), D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_PRESENT);
+}
+
 void OWindow::UpdateRenderTargetViews()
 {
 	const auto device = OEngine::Get()->GetDevice();
@@ -485,7 +514,15 @@ void OWindow::UpdateRenderTargetViews()
 
 	for (int i = 0; i < SRenderConstants::RenderBuffersCount; i++)
 	{
-		THROW_IF_FAILED(SwapChain->GetBuffer(i, IID_PPV_ARGS(&BackBuffers[i].Resource)));
+		if (SwapChain)
+		{
+			THROW_IF_FAILED(SwapChain->GetBuffer(i, IID_PPV_ARGS(&BackBuffers[i].Resource)));
+		}
+		else
+		{
+			// Headless backend has no swap chain, back buffers are plain render targets which are never presented.
+			BackBuffers[i] = CreateHeadlessBackBuffer();
+		}
 		device->CreateRenderTargetView(BackBuffers[i].Resource.Get(), nullptr, rtvHandle);
 		BackBuffers[i].CurrentState = D3D12_RESOURCE_STATE_PRESENT;
 		BackBuffers[i].Context = this;
@@ -148,6 +148,7 @@ protected:
 
 	// Create the swapchian.
 	ComPtr<IDXGISwapChain4> CreateSwapChain();
+	SResourceInfo CreateHeadlessBackBuffer();
 
 	void UpdateRenderTargetViews();
 	void ResizeDepthBuffer();
@@ -0,0 +1,28 @@
+#include "Benchmark.h"
+
+// RendererBench [name...], without names every benchmark runs
+int main(int Argc, char** Argv)
+{
+	int numRun = 0;
+	for (const auto& [name, function] : SBenchmark::GetAll())
+	{
+		const bool bSelected = Argc == 1 || std::any_of(Argv + 1, Argv + Argc, [&name](const char* Arg) { return name == Arg; });
+		if (bSelected)
+		{
+			std::printf("%s\n", name.c_str());
+			function();
+			numRun++;
+		}
+	}
+
+	if (numRun == 0)
+	{
+		std::printf("No benchmark matches, available:\n");
+		for (const auto& name : SBenchmark::GetAll() | std::views::keys)
+		{
+			std::printf("  %s\n", name.c_str());
+		}
+		return 1;
+	}
+	return 0;
+}
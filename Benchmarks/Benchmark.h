@@ -0,0 +1,62 @@
+#pragma once
+#include "Types.h"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+/**
+ * @brief Benchmarks register themselves by name through BENCHMARK, RendererBench runs the ones named on the command line or
+ * all of them. Numbers are only meaningful against another run on the same machine, compare them before and after a change.
+ */
+struct SBenchmark
+{
+	using TFunction = void (*)();
+
+	SBenchmark(const char* Name, TFunction Function)
+	{
+		GetAll().emplace_back(Name, Function);
+	}
+
+	static vector<pair<string, TFunction>>& GetAll()
+	{
+		static vector<pair<string, TFunction>> benchmarks;
+		return benchmarks;
+	}
+};
+
+#define BENCHMARK(Name)                                   \
+	static void Name();                                   \
+	static const SBenchmark Name##Registration(#Name, &Name); \
+	static void Name()
+
+namespace Bench
+{
+// Results are added here so the measured work can't be optimized away
+inline volatile uint64_t Sink = 0;
+
+// Nanoseconds per iteration of the fastest of a few runs, the other runs are disturbed by the rest of the system
+template<typename TFunction>
+double Measure(uint64_t NumIterations, TFunction&& Function, uint32_t NumRuns = 5)
+{
+	double best = std::numeric_limits<double>::max();
+	for (uint32_t run = 0; run < NumRuns; run++)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		Function(NumIterations);
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count() / static_cast<double>(NumIterations));
+	}
+	return best;
+}
+
+inline void Report(const string& Name, double NsPerIteration)
+{
+	std::printf("  %-48s %12.2f ns\n", Name.c_str(), NsPerIteration);
+}
+
+inline void Report(const string& Name, double Value, const char* Unit)
+{
+	std::printf("  %-48s %12.2f %s\n", Name.c_str(), Value, Unit);
+}
+} // namespace Bench
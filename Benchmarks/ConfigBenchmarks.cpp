@@ -0,0 +1,155 @@
+#include "Benchmark.h"
+#include "ConfigReader.h"
+#include "Json/JsonDocument.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+const std::filesystem::path ConfigDirectory = RENDERER_SOURCE_DIR "/Resources/Config";
+
+string ReadFile(const std::filesystem::path& Path)
+{
+	std::ifstream file(Path, std::ios::binary);
+	return string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Enough iterations for a few milliseconds per run on the largest config
+uint64_t GetNumIterations(const string& Text)
+{
+	return std::max<uint64_t>(20, 2'000'000 / std::max<size_t>(Text.size(), 1));
+}
+} // namespace
+
+BENCHMARK(ConfigParsing)
+{
+	vector<std::filesystem::path> files;
+	for (const auto& entry : std::filesystem::directory_iterator(ConfigDirectory))
+	{
+		if (entry.path().extension() == ".json")
+		{
+			files.push_back(entry.path());
+		}
+	}
+	std::ranges::sort(files);
+
+	const auto snapshotDirectory = std::filesystem::temp_directory_path() / "RendererBench";
+	std::filesystem::create_directories(snapshotDirectory);
+	for (const auto& path : files)
+	{
+		const string text = ReadFile(path);
+		const string name = path.filename().string() + " (" + std::to_string(text.size() / 1024) + " KB)";
+		const uint64_t numIterations = GetNumIterations(text);
+
+		// The readers used to go through read_json, the text is already in memory for both parsers
+		const double ptree = Bench::Measure(numIterations, [&](uint64_t Count) {
+			for (uint64_t i = 0; i < Count; i++)
+			{
+				std::istringstream stream(text);
+				boost::property_tree::ptree tree;
+				boost::property_tree::read_json(stream, tree);
+				Bench::Sink = Bench::Sink + tree.size();
+			}
+		});
+
+		// Parse takes over its buffer, the copy is part of what a reader pays
+		const double document = Bench::Measure(numIterations, [&](uint64_t Count) {
+			for (uint64_t i = 0; i < Count; i++)
+			{
+				OJsonDocument json;
+				json.Parse(text);
+				Bench::Sink = Bench::Sink + json.GetNumNodes();
+			}
+		});
+
+		// A warm start hashes the text it read and loads the snapshot instead of parsing
+		const auto snapshotPath = snapshotDirectory / (path.filename() += ".bin");
+		OJsonDocument parsed;
+		parsed.Parse(text);
+		parsed.SaveSnapshot(snapshotPath, OJsonDocument::HashSource(text));
+		const double snapshot = Bench::Measure(numIterations, [&](uint64_t Count) {
+			for (uint64_t i = 0; i < Count; i++)
+			{
+				OJsonDocument json;
+				json.LoadSnapshot(snapshotPath, OJsonDocument::HashSource(text));
+				Bench::Sink = Bench::Sink + json.GetNumNodes();
+			}
+		});
+
+		const double hash = Bench::Measure(numIterations, [&](uint64_t Count) {
+			for (uint64_t i = 0; i < Count; i++)
+			{
+				Bench::Sink = Bench::Sink + OJsonDocument::HashSource(text);
+			}
+		});
+
+		std::printf("  %s\n", name.c_str());
+		Bench::Report("  property_tree read_json", ptree / 1000.0, "us");
+		Bench::Report("  OJsonDocument::Parse", document / 1000.0, "us");
+		Bench::Report("  OJsonDocument::LoadSnapshot", snapshot / 1000.0, "us");
+		Bench::Report("    of which HashSource", hash / 1000.0, "us");
+	}
+	std::filesystem::remove_all(snapshotDirectory);
+}
+
+namespace
+{
+// Adds entries the way OTexturesParser does, through the writable tree of the reader
+class OBenchConfig : public OConfigReader
+{
+public:
+	using OConfigReader::OConfigReader;
+
+	void AddEntry(const string& Name)
+	{
+		boost::property_tree::ptree entry;
+		entry.put("Name", Name);
+		entry.put("Path", "Resources/Textures/" + Name + ".dds");
+		entry.put("ViewDimensions", "Texture2D");
+		entry.put("Type", "Diffuse");
+		GetWritableTree().get_child("Textures").push_back({ "", entry });
+		MarkDirty();
+	}
+};
+
+constexpr uint32_t NumSavedEntries = 1000;
+
+double MeasureSave(const std::filesystem::path& Path, bool bBatched)
+{
+	// One iteration saves all entries into a fresh file, a few runs keep the disk cache warm
+	return Bench::Measure(1, [&](uint64_t) {
+		std::ofstream(Path) << R"({ "Textures": [] })";
+		OBenchConfig config(Path.string());
+		if (bBatched)
+		{
+			config.BeginWriteBatch();
+		}
+		for (uint32_t i = 0; i < NumSavedEntries; i++)
+		{
+			config.AddEntry("Texture" + std::to_string(i));
+		}
+		if (bBatched)
+		{
+			config.EndWriteBatch();
+		}
+	}, 3);
+}
+} // namespace
+
+BENCHMARK(ConfigSaving)
+{
+	const auto directory = std::filesystem::temp_directory_path() / "RendererBench";
+	std::filesystem::create_directories(directory);
+	STestLog::bIsQuiet = true;
+
+	// Without a batch every entry rewrites the whole file, as saving the textures one by one used to
+	Bench::Report("1000 entries, saved one by one", MeasureSave(directory / "Textures.json", false) / 1e6, "ms");
+	Bench::Report("1000 entries, saved in one batch", MeasureSave(directory / "Textures.json", true) / 1e6, "ms");
+
+	STestLog::bIsQuiet = false;
+	std::filesystem::remove_all(directory);
+}
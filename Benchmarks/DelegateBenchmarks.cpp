@@ -0,0 +1,77 @@
+#include "Benchmark.h"
+#include "Delegate.h"
+
+#include <boost/signals2.hpp>
+
+namespace
+{
+constexpr uint64_t NumBroadcasts = 1'000'000;
+constexpr uint64_t NumBindings = 200'000;
+constexpr int NumListeners = 4;
+
+// Captures as much as a member binding does, small enough for the inline storage
+struct SListener
+{
+	void OnChanged(int Value)
+	{
+		Total += Value;
+	}
+
+	uint64_t Total = 0;
+};
+} // namespace
+
+BENCHMARK(Delegates)
+{
+	SListener listeners[NumListeners];
+
+	SDelegate<void, int> delegate;
+	boost::signals2::signal<void(int)> signal;
+	for (auto& listener : listeners)
+	{
+		delegate.AddMember(&listener, &SListener::OnChanged);
+		signal.connect([&listener](int Value) { listener.OnChanged(Value); });
+	}
+
+	Bench::Report("SDelegate broadcast to 4", Bench::Measure(NumBroadcasts, [&](uint64_t Count) {
+		              for (uint64_t i = 0; i < Count; i++)
+		              {
+			              delegate.Broadcast(static_cast<int>(i));
+		              }
+	              }));
+	Bench::Report("signals2 broadcast to 4", Bench::Measure(NumBroadcasts, [&](uint64_t Count) {
+		              for (uint64_t i = 0; i < Count; i++)
+		              {
+			              signal(static_cast<int>(i));
+		              }
+	              }));
+
+	// Bind and unbind one more listener next to the existing ones, as UI widgets do when they are opened and closed
+	SListener extra;
+	Bench::Report("SDelegate add and remove", Bench::Measure(NumBindings, [&](uint64_t Count) {
+		              for (uint64_t i = 0; i < Count; i++)
+		              {
+			              delegate.Remove(delegate.AddMember(&extra, &SListener::OnChanged));
+		              }
+	              }));
+	Bench::Report("signals2 connect and disconnect", Bench::Measure(NumBindings, [&](uint64_t Count) {
+		              for (uint64_t i = 0; i < Count; i++)
+		              {
+			              signal.connect([&extra](int Value) { extra.OnChanged(Value); }).disconnect();
+		              }
+	              }));
+
+	SSingleDelegate<void, int> single;
+	single.BindMember(&listeners[0], &SListener::OnChanged);
+	Bench::Report("SSingleDelegate execute", Bench::Measure(NumBroadcasts, [&](uint64_t Count) {
+		              for (uint64_t i = 0; i < Count; i++)
+		              {
+			              single.Execute(static_cast<int>(i));
+		              }
+	              }));
+
+	for (const auto& listener : listeners)
+	{
+		Bench::Sink = Bench::Sink + listener.Total;
+	}
+}
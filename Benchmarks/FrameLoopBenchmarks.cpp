@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+#include "RenderBackend/FrameLoop.h"
+#include "RenderBackend/NullRenderDevice.h"
+#include "RenderGraphReader/RenderGraphReader.h"
+
+namespace
+{
+constexpr uint64_t NumFrames = 100'000;
+} // namespace
+
+// CPU cost of a frame of the shipped render graph on the null device: barriers, pass constants, recording and presentation.
+// Scales with the draws per node, the fixed part is what the graph and the backend add on top of the scene.
+BENCHMARK(FrameLoop)
+{
+	STestLog::bIsQuiet = true;
+	ORenderGraphReader reader(RENDERER_SOURCE_DIR "/Resources/Config/RenderGraphConfig.json");
+	const auto nodes = reader.LoadRenderGraph();
+	STestLog::bIsQuiet = false;
+
+	for (const uint32_t numDraws : { 1u, 100u })
+	{
+		ONullRenderDevice device;
+		SFrameLoopDesc desc;
+		desc.NumDrawsPerNode = numDraws;
+		OFrameLoop loop(&device, desc);
+		if (!loop.Initialize(nodes))
+		{
+			std::printf("  Shipped render graph is invalid\n");
+			return;
+		}
+
+		const uint64_t numFrames = NumFrames / numDraws;
+		Bench::Report("Frame with " + std::to_string(numDraws) + " draws per node", Bench::Measure(numFrames, [&](uint64_t Count) {
+			              for (uint64_t frame = 0; frame < Count; frame++)
+			              {
+				              loop.DrawFrame();
+			              }
+		              }));
+
+		const auto& log = device.GetCommandLog();
+		Bench::Report("Commands per frame", static_cast<double>(log.GetTotal()) / static_cast<double>(loop.GetNumFrames()), "cmds");
+		Bench::Sink = Bench::Sink + log.GetValidationErrors();
+	}
+}
@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+#include "Engine/UploadBuffer/UploadWriter.h"
+
+namespace
+{
+constexpr uint32_t NumInstances = 100'000;
+constexpr uint32_t NumFrames = 20;
+
+// Same layout and size as SInstanceData, which needs DirectXMath
+struct SInstance
+{
+	float World[16];
+	float TexTransform[16];
+	uint32_t MaterialIndex;
+	float DisplacementMapTexelSize[2];
+	float GridSpatialStep;
+};
+
+// Plain memory stands in for the mapped upload heap, it isn't write combined so the gap to streaming stores is smaller than on a GPU heap
+struct SUploadMemory
+{
+	SUploadMemory(uint32_t ElementByteSize)
+	    : Memory(static_cast<size_t>(NumInstances) * ElementByteSize + 64)
+	{
+		Writer.MappedData = Memory.data() + (64 - reinterpret_cast<uintptr_t>(Memory.data()) % 64) % 64;
+		Writer.ElementByteSize = ElementByteSize;
+	}
+
+	vector<uint8_t> Memory;
+	TUploadWriter<SInstance> Writer;
+};
+
+void ReportBandwidth(const string& Name, uint32_t ElementByteSize, double NsPerFrame)
+{
+	Bench::Report(Name, static_cast<double>(NumInstances) * ElementByteSize / NsPerFrame, "GB/s");
+}
+
+void RunWriters(uint32_t ElementByteSize, const string& Suffix)
+{
+	SUploadMemory upload(ElementByteSize);
+	vector<SInstance> instances(NumInstances);
+	for (uint32_t i = 0; i < NumInstances; i++)
+	{
+		instances[i].MaterialIndex = i;
+	}
+
+	ReportBandwidth("CopyData per element" + Suffix, ElementByteSize, Bench::Measure(NumFrames, [&](uint64_t Count) {
+		                for (uint64_t frame = 0; frame < Count; frame++)
+		                {
+			                for (uint32_t i = 0; i < NumInstances; i++)
+			                {
+				                upload.Writer.CopyData(i, instances[i]);
+			                }
+		                }
+	                }));
+	ReportBandwidth("CopyRange" + Suffix, ElementByteSize, Bench::Measure(NumFrames, [&](uint64_t Count) {
+		                for (uint64_t frame = 0; frame < Count; frame++)
+		                {
+			                upload.Writer.CopyRange(0, instances);
+		                }
+	                }));
+	ReportBandwidth("CopyRange non temporal" + Suffix, ElementByteSize, Bench::Measure(NumFrames, [&](uint64_t Count) {
+		                for (uint64_t frame = 0; frame < Count; frame++)
+		                {
+			                upload.Writer.CopyRange(0, instances, true);
+		                }
+	                }));
+
+	// Culling builds the visible instances in place, no staging array is written and read back
+	ReportBandwidth("Emplace per element" + Suffix, ElementByteSize, Bench::Measure(NumFrames, [&](uint64_t Count) {
+		                for (uint64_t frame = 0; frame < Count; frame++)
+		                {
+			                for (uint32_t i = 0; i < NumInstances; i++)
+			                {
+				                auto& instance = upload.Writer.Emplace(i);
+				                std::copy_n(instances[i].World, 16, instance.World);
+				                std::copy_n(instances[i].TexTransform, 16, instance.TexTransform);
+				                instance.MaterialIndex = i;
+				                instance.DisplacementMapTexelSize[0] = instance.DisplacementMapTexelSize[1] = 1.0f;
+				                instance.GridSpatialStep = 1.0f;
+			                }
+		                }
+	                }));
+	Bench::Sink = Bench::Sink + upload.Memory[upload.Memory.size() / 2];
+}
+} // namespace
+
+BENCHMARK(UploadWriters)
+{
+	// Structured buffers are packed, constant buffer elements are padded to 256 bytes
+	RunWriters(sizeof(SInstance), "");
+	RunWriters(256, ", 256 byte stride");
+}
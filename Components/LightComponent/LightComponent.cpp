@@ -51,13 +51,13 @@ void OLightComponent::UpdateFrameResource(const SFrameResource* FrameResource)
 	switch (LightType)
 	{
 	case ELightType::Directional:
-		FrameResource->DirectionalLightBuffer->CopyData(DirLightBufferInfo.StartIndex, DirectionalLight);
+		FrameResource->DirectionalLightBuffer.CopyData(DirLightBufferInfo.StartIndex, DirectionalLight);
 		break;
 	case ELightType::Point:
-		FrameResource->PointLightBuffer->CopyData(PointLightBufferInfo.StartIndex, PointLight);
+		FrameResource->PointLightBuffer.CopyData(PointLightBufferInfo.StartIndex, PointLight);
 		break;
 	case ELightType::Spot:
-		FrameResource->SpotLightBuffer->CopyData(SpotLightBufferInfo.StartIndex, SpotLight);
+		FrameResource->SpotLightBuffer.CopyData(SpotLightBufferInfo.StartIndex, SpotLight);
 		break;
 	}
 }
@@ -69,13 +69,6 @@ void OLightComponent::InitFrameResource(const TUploadBufferData<SDirectionalLigh
 	SpotLightBufferInfo = Spot;
 }
 
-bool OLightComponent::TryUpdate()
-{
-	bool res = NumFramesDirty > 0;
-	NumFramesDirty=0;
-	return res;
-}
-
 ELightType OLightComponent::GetLightType() const
 {
 	return LightType;
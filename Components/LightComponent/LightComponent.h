@@ -10,23 +10,6 @@ ENUM(ELightType,
      Point,
      Spot)
 
-inline string ToString(const ELightType& Type)
-{
-	switch (Type)
-	{
-	case ELightType::Directional:
-		return "Directional";
-		break;
-	case ELightType::Point:
-		return "Point";
-		break;
-	case ELightType::Spot:
-		return "Spot";
-		break;
-	}
-	return "Unknown";
-}
-
 class OLightComponent : public OSceneComponent
 {
 public:
@@ -44,7 +27,6 @@ public:
 	                       const TUploadBufferData<SSpotLight>& Spot);
 
 	int NumFramesDirty = SRenderConstants::NumFrameResources;
-	bool TryUpdate() ;
 	ELightType GetLightType() const;
 	int32_t GetLightIndex() const;
 	SDirectionalLight& GetDirectionalLight() ;
@@ -0,0 +1,112 @@
+#include "ConfigDiff.h"
+
+namespace
+{
+// Last element per key, in the order the keys first appear
+vector<pair<std::string_view, SJsonValue>> IndexEntries(const SJsonValue& List, std::string_view KeyMember)
+{
+	vector<pair<std::string_view, SJsonValue>> entries;
+	unordered_map<std::string_view, size_t> positions;
+	for (const auto entry : List)
+	{
+		const auto key = entry.Find(KeyMember);
+		if (!key || key.GetType() == EJsonType::Array || key.GetType() == EJsonType::Object)
+		{
+			continue;
+		}
+
+		const auto [it, bInserted] = positions.try_emplace(key.GetText(), entries.size());
+		if (bInserted)
+		{
+			entries.emplace_back(key.GetText(), entry);
+		}
+		else
+		{
+			entries[it->second].second = entry;
+		}
+	}
+	return entries;
+}
+} // namespace
+
+bool SConfigDiff::IsEmpty() const
+{
+	return Added.empty() && Removed.empty() && Changed.empty();
+}
+
+size_t SConfigDiff::GetNumEntries() const
+{
+	return Added.size() + Removed.size() + Changed.size();
+}
+
+bool OConfigDiff::Equals(const SJsonValue& Lhs, const SJsonValue& Rhs)
+{
+	if (Lhs.IsValid() != Rhs.IsValid() || Lhs.GetType() != Rhs.GetType() || Lhs.GetNumChildren() != Rhs.GetNumChildren())
+	{
+		return false;
+	}
+
+	switch (Lhs.GetType())
+	{
+	case EJsonType::Array:
+	{
+		auto rhs = Rhs.begin();
+		for (const auto lhs : Lhs)
+		{
+			if (!Equals(lhs, *rhs))
+			{
+				return false;
+			}
+			++rhs;
+		}
+		return true;
+	}
+	case EJsonType::Object:
+		// Config objects are small, looking every member up is cheaper than sorting both
+		for (const auto lhs : Lhs)
+		{
+			if (!Equals(lhs, Rhs.Find(lhs.GetName())))
+			{
+				return false;
+			}
+		}
+		return true;
+	default:
+		return Lhs.GetText() == Rhs.GetText();
+	}
+}
+
+SConfigDiff OConfigDiff::Diff(const SJsonValue& Old, const SJsonValue& New, std::string_view KeyMember)
+{
+	SConfigDiff diff;
+	const auto oldEntries = IndexEntries(Old, KeyMember);
+	const auto newEntries = IndexEntries(New, KeyMember);
+
+	unordered_map<std::string_view, SJsonValue> oldByKey(oldEntries.begin(), oldEntries.end());
+	for (const auto& [key, entry] : newEntries)
+	{
+		const auto old = oldByKey.find(key);
+		if (old == oldByKey.end())
+		{
+			diff.Added.emplace_back(key);
+		}
+		else if (!Equals(old->second, entry))
+		{
+			diff.Changed.emplace_back(key);
+		}
+	}
+
+	unordered_set<std::string_view> newKeys;
+	for (const auto& key : newEntries | std::views::keys)
+	{
+		newKeys.insert(key);
+	}
+	for (const auto& key : oldEntries | std::views::keys)
+	{
+		if (!newKeys.contains(key))
+		{
+			diff.Removed.emplace_back(key);
+		}
+	}
+	return diff;
+}
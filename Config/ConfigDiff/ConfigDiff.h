@@ -0,0 +1,31 @@
+#pragma once
+#include "Json/JsonDocument.h"
+#include "Types.h"
+
+/**
+ * @brief Entries of a config list that differ between two versions of the file, identified by their key member.
+ * Added and changed entries are listed in the order of the new version, removed ones in the order of the old one.
+ */
+struct SConfigDiff
+{
+	vector<string> Added;
+	vector<string> Removed;
+	vector<string> Changed;
+
+	bool IsEmpty() const;
+	size_t GetNumEntries() const;
+};
+
+/**
+ * @brief Structural comparison of parsed configs, free of the objects built from them so it runs anywhere.
+ */
+class OConfigDiff
+{
+public:
+	// Members of an object compare regardless of their order, array elements in order. Scalars compare by type and source text.
+	static bool Equals(const SJsonValue& Lhs, const SJsonValue& Rhs);
+
+	// Old and New are arrays of objects named by their KeyMember, a missing array counts as empty. Elements without the key are
+	// ignored, of duplicated keys the last element counts, as that is the one the readers keep.
+	static SConfigDiff Diff(const SJsonValue& Old, const SJsonValue& New, std::string_view KeyMember);
+};
@@ -3,3 +3,150 @@
 //
 
 #include "ConfigReader.h"
+
+#include <chrono>
+#include <sstream>
+
+void OConfigReader::LoadConfig(const string& FileName)
+{
+	if (bIsLoaded)
+	{
+		return;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	std::ifstream file(FileName, std::ios::binary);
+	CWIN_LOG(!file.is_open(), Default, Error, "Can't open config file {}", TEXT(FileName));
+	string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	// The hash covers the whole text, any edit of the file invalidates its snapshot
+	const uint64_t hash = OJsonDocument::HashSource(text);
+	const auto snapshotPath = SnapshotDirectory.empty() ? std::filesystem::path() : SnapshotDirectory / (std::filesystem::path(FileName).filename() += ".bin");
+	const bool bFromSnapshot = !snapshotPath.empty() && Document.LoadSnapshot(snapshotPath, hash);
+	if (!bFromSnapshot)
+	{
+		if (!Document.Parse(std::move(text)))
+		{
+			LOG(Config, Error, "Can't parse {}: {}", TEXT(FileName), TEXT(Document.GetError()));
+		}
+		else if (!snapshotPath.empty() && !Document.SaveSnapshot(snapshotPath, hash))
+		{
+			LOG(Config, Warning, "Can't write the config snapshot {}", snapshotPath.wstring());
+		}
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	LOG(Config, Log, "Loaded {} from {} in {} us, {} nodes", TEXT(FileName), bFromSnapshot ? L"snapshot" : L"JSON", elapsed.count(), Document.GetNumNodes());
+	CWIN_LOG(Document.IsEmpty(), Default, Error, "Config file is empty!")
+	bIsLoaded = true;
+}
+
+bool OConfigReader::Reload(OJsonDocument& OutPrevious)
+{
+	if (WriteBatchDepth > 0 || NumPendingEdits > 0)
+	{
+		LOG(Config, Warning, "{} has unsaved edits, not reloading it", TEXT(FileName));
+		return false;
+	}
+
+	std::ifstream file(FileName, std::ios::binary);
+	OJsonDocument document;
+	if (!file.is_open() || !document.Parse(string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>())))
+	{
+		// Editors save in several steps, the next change of the file is picked up again
+		LOG(Config, Warning, "Can't reload {}, keeping the previous version: {}", TEXT(FileName), TEXT(document.GetError()));
+		return false;
+	}
+
+	OutPrevious = std::move(Document);
+	Document = std::move(document);
+
+	// Writers pick up the new file as well
+	PTree.clear();
+	bIsTreeLoaded = false;
+	return true;
+}
+
+std::optional<SConfigDiff> OConfigReader::ReloadList(const string& ListKey, std::string_view KeyMember)
+{
+	OJsonDocument previous;
+	if (!Reload(previous))
+	{
+		return std::nullopt;
+	}
+	return OConfigDiff::Diff(previous.GetRoot().Find(ListKey), Document.GetRoot().Find(ListKey), KeyMember);
+}
+
+void OConfigReader::SetSnapshotDirectory(const std::filesystem::path& Directory)
+{
+	SnapshotDirectory = Directory;
+}
+
+boost::property_tree::ptree& OConfigReader::GetWritableTree()
+{
+	if (!bIsTreeLoaded)
+	{
+		read_json(FileName, PTree);
+		bIsTreeLoaded = true;
+	}
+	return PTree;
+}
+
+void OConfigReader::BeginWriteBatch()
+{
+	WriteBatchDepth++;
+}
+
+bool OConfigReader::EndWriteBatch()
+{
+	if (WriteBatchDepth == 0)
+	{
+		LOG(Config, Error, "Write batch of {} ended without being started", TEXT(FileName));
+		return false;
+	}
+	return --WriteBatchDepth > 0 || Flush();
+}
+
+bool OConfigReader::MarkDirty()
+{
+	NumPendingEdits++;
+	return WriteBatchDepth > 0 || Flush();
+}
+
+bool OConfigReader::Flush()
+{
+	if (NumPendingEdits == 0)
+	{
+		return true;
+	}
+
+	std::ostringstream stream;
+	write_json(stream, GetWritableTree());
+	string text = stream.str();
+
+	const auto tempPath = FileName + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write(text.data(), static_cast<std::streamsize>(text.size()));
+		if (!file.good())
+		{
+			LOG(Config, Error, "Can't write {}", TEXT(tempPath));
+			return false;
+		}
+	}
+
+	// An interrupted save leaves either the old or the new file, never a truncated one
+	std::error_code error;
+	std::filesystem::rename(tempPath, FileName, error);
+	if (error)
+	{
+		LOG(Config, Error, "Can't replace {}: {}", TEXT(FileName), TEXT(error.message()));
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+
+	LOG(Config, Log, "Saved {} edits to {}", NumPendingEdits, TEXT(FileName));
+	NumPendingEdits = 0;
+	Document.Parse(std::move(text));
+	return true;
+}
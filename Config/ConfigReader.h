@@ -1,4 +1,6 @@
 #pragma once
+#include "ConfigDiff/ConfigDiff.h"
+#include "Json/JsonDocument.h"
 #include "Logger.h"
 #include "boost/property_tree/json_parser.hpp"
 #include "boost/property_tree/ptree.hpp"
@@ -12,90 +14,78 @@ public:
 		LoadConfig(FileName);
 	}
 
-	void LoadConfig(const string& FileName)
-	{
-		if (!bIsLoaded)
-		{
-			read_json(FileName, PTree);
-			CWIN_LOG(PTree.size() == 0, Default, Error, "Config file is empty!")
-			bIsLoaded = true;
-		}
-	}
+	// Reads the snapshot of the file if it was taken from the same text, otherwise parses the file and refreshes the snapshot
+	void LoadConfig(const string& FileName);
+
+	// Parses the file again after it changed on disk and hands out the previous document to diff against. The current document
+	// stays if the file doesn't parse or edits are waiting to be written.
+	bool Reload(OJsonDocument& OutPrevious);
+
+	// Reloads the file and diffs the entries of the root list ListKey by their KeyMember, nothing if the reload failed
+	std::optional<SConfigDiff> ReloadList(const string& ListKey, std::string_view KeyMember);
+
+	// Snapshots of the parsed configs are kept here, none are used while it is empty
+	static void SetSnapshotDirectory(const std::filesystem::path& Directory);
 
-	static auto GetAttribute(const boost::property_tree::ptree& Tree, const string& Value)
+	static auto GetAttribute(const SJsonValue& Tree, const string& Value)
 	{
-		return Tree.get<string>(Value);
+		return Tree.Get<string>(Value);
 	}
 
 	template<typename T>
 	T GetRoot(const std::string& Key) const
 	{
 		CWIN_LOG(!bIsLoaded, Default, Error, "Config file not loaded!");
-		if (PTree.get_child_optional(Key) == boost::none)
-		{
-			LOG(Debug, Error, "Key not found: {}", TEXT(Key));
-		}
-		return PTree.get<T>(Key);
+		return Document.GetRoot().Get<T>(Key);
 	}
 
-	auto GetRootChild(const std::string& Key) const
+	SJsonValue GetRootChild(const std::string& Key) const
 	{
 		CWIN_LOG(!bIsLoaded, Default, Error, "Config file not loaded!");
-		if (PTree.get_child_optional(Key) == boost::none)
-		{
-			LOG(Debug, Error, "Key not found: {}", TEXT(Key));
-		}
-
-		return PTree.get_child(Key);
+		return Document.GetRoot().GetChild(Key);
 	}
 
-	auto GetChild(const std::string& Key, const boost::property_tree::ptree& Tree) const
+	SJsonValue GetChild(const std::string& Key, const SJsonValue& Tree) const
 	{
 		CWIN_LOG(!bIsLoaded, Default, Error, "Config file not loaded!");
-		if (Tree.get_child_optional(Key) == boost::none)
-		{
-			LOG(Debug, Error, "Key not found: {}", TEXT(Key));
-		}
-
-		return Tree.get_child(Key);
-	}
-
-	template<typename T>
-	static T GetOptionalOr(const boost::property_tree::ptree& Tree, const std::string& Key, const T& Default)
-	{
-		if (auto Optional = Tree.get_optional<T>(Key))
-		{
-			return Optional.get();
-		}
-		return Default;
+		return Tree.GetChild(Key);
 	}
 
+	// A missing tree reads as the default as well
 	template<typename T>
-	static T GetOptionalOr(const boost::optional<const boost::property_tree::ptree&>& Tree, const std::string& Key, const T& Default)
+	static T GetOptionalOr(const SJsonValue& Tree, const std::string& Key, const T& Default)
 	{
-		if (Tree)
-		{
-			return GetOptionalOr<T>(Tree.get(), Key, Default);
-		}
-		return Default;
+		return Tree.GetOr<T>(Key, Default);
 	}
 
-	static string GetOptionalOr(const boost::property_tree::ptree& Tree, const std::string& Key, const char* Default)
+	static string GetOptionalOr(const SJsonValue& Tree, const std::string& Key, const char* Default)
 	{
-		return GetOptionalOr<string>(Tree, Key, Default);
+		return Tree.GetOr(Key, Default);
 	}
 
-	static string GetOptionalOr(const boost::optional<const boost::property_tree::ptree&>& Tree, const std::string& Key, const char* Default)
-	{
-		if (Tree)
-		{
-			return GetOptionalOr<string>(Tree.get(), Key, Default);
-		}
-		return Default;
-	}
+	// Edits made until the outermost batch ends stay in memory and are saved with a single write
+	void BeginWriteBatch();
+	bool EndWriteBatch();
 
 protected:
+	// Tree edited by the writers, parsed from the file on first use. Reading goes through the document.
+	boost::property_tree::ptree& GetWritableTree();
+
+	// Call after editing the writable tree, saves right away unless a batch is open
+	bool MarkDirty();
+
+	// Replaces the file atomically through a temporary next to it, the document is refreshed so that reads see the edits
+	bool Flush();
+
 	string FileName;
-	boost::property_tree::ptree PTree;
+	OJsonDocument Document;
 	bool bIsLoaded = false;
+
+private:
+	boost::property_tree::ptree PTree;
+	bool bIsTreeLoaded = false;
+	uint32_t WriteBatchDepth = 0;
+	uint32_t NumPendingEdits = 0;
+
+	static inline std::filesystem::path SnapshotDirectory;
 };
@@ -0,0 +1,671 @@
+#include "JsonDocument.h"
+
+#include "HashUtils.h"
+#include "Logger.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+constexpr uint32_t SnapshotMagic = 0x504E534A; // "JSNP"
+// Version 2 hashes the source text by words
+constexpr uint32_t SnapshotVersion = 2;
+
+// Nesting deeper than this is rejected instead of overflowing the stack
+constexpr uint32_t MaxDepth = 256;
+
+struct SJsonSnapshotHeader
+{
+	uint32_t Magic = 0;
+	uint32_t Version = 0;
+	uint64_t SourceHash = 0;
+	uint64_t BufferSize = 0;
+	uint64_t NumNodes = 0;
+};
+
+/**
+ * @brief Recursive descent over the mutable text. String contents are unescaped towards the front of their own span, an escape
+ * sequence never produces more bytes than it occupies, so the write position can't overtake the read position.
+ */
+class OJsonParser
+{
+public:
+	OJsonParser(string& Text, vector<SJsonNode>& Nodes)
+	    : Text(Text), Nodes(Nodes) {}
+
+	bool Parse()
+	{
+		SkipWhitespace();
+		if (!ParseValue(0, 0, 0))
+		{
+			return false;
+		}
+		SkipWhitespace();
+		return Position == Text.size() || Fail("unexpected characters after the root value");
+	}
+
+	string GetError() const
+	{
+		uint32_t line = 1;
+		size_t lineStart = 0;
+		for (size_t i = 0; i < std::min(ErrorPosition, Text.size()); i++)
+		{
+			if (Text[i] == '\n')
+			{
+				line++;
+				lineStart = i + 1;
+			}
+		}
+		return "line " + std::to_string(line) + ", column " + std::to_string(ErrorPosition - lineStart + 1) + ": " + ErrorMessage;
+	}
+
+private:
+	bool Fail(const char* Message)
+	{
+		ErrorMessage = Message;
+		ErrorPosition = Position;
+		return false;
+	}
+
+	void SkipWhitespace()
+	{
+		while (Position < Text.size() && (Text[Position] == ' ' || Text[Position] == '\t' || Text[Position] == '\n' || Text[Position] == '\r'))
+		{
+			Position++;
+		}
+	}
+
+	bool Consume(char Character)
+	{
+		SkipWhitespace();
+		if (Position < Text.size() && Text[Position] == Character)
+		{
+			Position++;
+			return true;
+		}
+		return false;
+	}
+
+	bool ParseValue(uint32_t NameOffset, uint32_t NameLength, uint32_t Depth)
+	{
+		if (Depth > MaxDepth)
+		{
+			return Fail("nesting is too deep");
+		}
+		if (Position >= Text.size())
+		{
+			return Fail("unexpected end of input");
+		}
+
+		const auto index = static_cast<uint32_t>(Nodes.size());
+		Nodes.push_back({ .NameOffset = NameOffset, .NameLength = NameLength });
+
+		bool bResult = false;
+		switch (Text[Position])
+		{
+		case '{':
+			Nodes[index].Type = EJsonType::Object;
+			bResult = ParseObject(index, Depth);
+			break;
+		case '[':
+			Nodes[index].Type = EJsonType::Array;
+			bResult = ParseArray(index, Depth);
+			break;
+		case '"':
+		{
+			Nodes[index].Type = EJsonType::String;
+			uint32_t offset = 0, length = 0;
+			bResult = ParseString(offset, length);
+			Nodes[index].TextOffset = offset;
+			Nodes[index].TextLength = length;
+			break;
+		}
+		case 't':
+			bResult = ParseLiteral(index, "true", EJsonType::Bool);
+			break;
+		case 'f':
+			bResult = ParseLiteral(index, "false", EJsonType::Bool);
+			break;
+		case 'n':
+			bResult = ParseLiteral(index, "null", EJsonType::Null);
+			break;
+		default:
+			bResult = ParseNumber(index);
+			break;
+		}
+		Nodes[index].End = static_cast<uint32_t>(Nodes.size());
+		return bResult;
+	}
+
+	bool ParseObject(uint32_t Index, uint32_t Depth)
+	{
+		Position++;
+		if (Consume('}'))
+		{
+			return true;
+		}
+
+		do
+		{
+			SkipWhitespace();
+			if (Position >= Text.size() || Text[Position] != '"')
+			{
+				return Fail("expected a member name");
+			}
+
+			uint32_t nameOffset = 0, nameLength = 0;
+			if (!ParseString(nameOffset, nameLength))
+			{
+				return false;
+			}
+			if (!Consume(':'))
+			{
+				return Fail("expected ':' after the member name");
+			}
+			SkipWhitespace();
+			if (!ParseValue(nameOffset, nameLength, Depth + 1))
+			{
+				return false;
+			}
+			Nodes[Index].NumChildren++;
+		}
+		while (Consume(','));
+
+		return Consume('}') || Fail("expected ',' or '}'");
+	}
+
+	bool ParseArray(uint32_t Index, uint32_t Depth)
+	{
+		Position++;
+		if (Consume(']'))
+		{
+			return true;
+		}
+
+		do
+		{
+			SkipWhitespace();
+			if (!ParseValue(0, 0, Depth + 1))
+			{
+				return false;
+			}
+			Nodes[Index].NumChildren++;
+		}
+		while (Consume(','));
+
+		return Consume(']') || Fail("expected ',' or ']'");
+	}
+
+	bool ParseLiteral(uint32_t Index, std::string_view Literal, EJsonType Type)
+	{
+		if (Text.compare(Position, Literal.size(), Literal) != 0)
+		{
+			return Fail("invalid literal");
+		}
+		Nodes[Index].Type = Type;
+		Nodes[Index].TextOffset = static_cast<uint32_t>(Position);
+		Nodes[Index].TextLength = static_cast<uint32_t>(Literal.size());
+		Position += Literal.size();
+		return true;
+	}
+
+	bool ParseNumber(uint32_t Index)
+	{
+		const auto isDigit = [this]() { return Position < Text.size() && Text[Position] >= '0' && Text[Position] <= '9'; };
+		const auto skipDigits = [&]() {
+			const size_t start = Position;
+			while (isDigit())
+			{
+				Position++;
+			}
+			return Position > start;
+		};
+
+		const size_t start = Position;
+		if (Text[Position] == '-')
+		{
+			Position++;
+		}
+		if (!skipDigits())
+		{
+			return Fail("unexpected character");
+		}
+		if (Position < Text.size() && Text[Position] == '.')
+		{
+			Position++;
+			if (!skipDigits())
+			{
+				return Fail("expected digits after the decimal point");
+			}
+		}
+		if (Position < Text.size() && (Text[Position] == 'e' || Text[Position] == 'E'))
+		{
+			Position++;
+			if (Position < Text.size() && (Text[Position] == '+' || Text[Position] == '-'))
+			{
+				Position++;
+			}
+			if (!skipDigits())
+			{
+				return Fail("expected digits in the exponent");
+			}
+		}
+
+		Nodes[Index].Type = EJsonType::Number;
+		Nodes[Index].TextOffset = static_cast<uint32_t>(start);
+		Nodes[Index].TextLength = static_cast<uint32_t>(Position - start);
+		return true;
+	}
+
+	bool ParseHex(uint32_t& OutValue)
+	{
+		if (Text.size() - Position < 4)
+		{
+			return Fail("truncated unicode escape");
+		}
+		const auto [ptr, error] = std::from_chars(Text.data() + Position, Text.data() + Position + 4, OutValue, 16);
+		if (error != std::errc() || ptr != Text.data() + Position + 4)
+		{
+			return Fail("invalid unicode escape");
+		}
+		Position += 4;
+		return true;
+	}
+
+	void WriteUTF8(size_t& Write, uint32_t CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Text[Write++] = static_cast<char>(CodePoint);
+		}
+		else if (CodePoint < 0x800)
+		{
+			Text[Write++] = static_cast<char>(0xC0 | (CodePoint >> 6));
+			Text[Write++] = static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Text[Write++] = static_cast<char>(0xE0 | (CodePoint >> 12));
+			Text[Write++] = static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Text[Write++] = static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+		else
+		{
+			Text[Write++] = static_cast<char>(0xF0 | (CodePoint >> 18));
+			Text[Write++] = static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F));
+			Text[Write++] = static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Text[Write++] = static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+	}
+
+	bool ParseString(uint32_t& OutOffset, uint32_t& OutLength)
+	{
+		Position++;
+		const size_t start = Position;
+		size_t write = Position;
+		while (true)
+		{
+			if (Position >= Text.size())
+			{
+				return Fail("unterminated string");
+			}
+
+			const char character = Text[Position];
+			if (character == '"')
+			{
+				Position++;
+				break;
+			}
+			if (static_cast<unsigned char>(character) < 0x20)
+			{
+				return Fail("control character in string");
+			}
+			if (character != '\\')
+			{
+				Text[write++] = character;
+				Position++;
+				continue;
+			}
+
+			Position++;
+			if (Position >= Text.size())
+			{
+				return Fail("unterminated string");
+			}
+			switch (Text[Position++])
+			{
+			case '"':
+				Text[write++] = '"';
+				break;
+			case '\\':
+				Text[write++] = '\\';
+				break;
+			case '/':
+				Text[write++] = '/';
+				break;
+			case 'b':
+				Text[write++] = '\b';
+				break;
+			case 'f':
+				Text[write++] = '\f';
+				break;
+			case 'n':
+				Text[write++] = '\n';
+				break;
+			case 'r':
+				Text[write++] = '\r';
+				break;
+			case 't':
+				Text[write++] = '\t';
+				break;
+			case 'u':
+			{
+				uint32_t codePoint = 0;
+				if (!ParseHex(codePoint))
+				{
+					return false;
+				}
+				if (codePoint >= 0xD800 && codePoint < 0xDC00)
+				{
+					uint32_t low = 0;
+					if (Text.compare(Position, 2, "\\u") != 0)
+					{
+						return Fail("unpaired surrogate");
+					}
+					Position += 2;
+					if (!ParseHex(low))
+					{
+						return false;
+					}
+					if (low < 0xDC00 || low >= 0xE000)
+					{
+						return Fail("unpaired surrogate");
+					}
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+				}
+				else if (codePoint >= 0xDC00 && codePoint < 0xE000)
+				{
+					return Fail("unpaired surrogate");
+				}
+				WriteUTF8(write, codePoint);
+				break;
+			}
+			default:
+				Position--;
+				return Fail("invalid escape sequence");
+			}
+		}
+
+		OutOffset = static_cast<uint32_t>(start);
+		OutLength = static_cast<uint32_t>(write - start);
+		return true;
+	}
+
+	string& Text;
+	vector<SJsonNode>& Nodes;
+	size_t Position = 0;
+	size_t ErrorPosition = 0;
+	string ErrorMessage;
+};
+} // namespace
+
+SJsonValue::SIterator& SJsonValue::SIterator::operator++()
+{
+	Index = Document->GetNode(Index).End;
+	return *this;
+}
+
+const SJsonNode& SJsonValue::GetNode() const
+{
+	return Document->GetNode(Index);
+}
+
+EJsonType SJsonValue::GetType() const
+{
+	return IsValid() ? GetNode().Type : EJsonType::Null;
+}
+
+std::string_view SJsonValue::GetName() const
+{
+	return IsValid() ? Document->GetString(GetNode().NameOffset, GetNode().NameLength) : std::string_view();
+}
+
+std::string_view SJsonValue::GetText() const
+{
+	return IsValid() ? Document->GetString(GetNode().TextOffset, GetNode().TextLength) : std::string_view();
+}
+
+uint32_t SJsonValue::GetNumChildren() const
+{
+	return IsValid() ? GetNode().NumChildren : 0;
+}
+
+SJsonValue SJsonValue::Find(std::string_view Key) const
+{
+	if (GetType() != EJsonType::Object)
+	{
+		return {};
+	}
+
+	// Config objects hold a handful of members, a linear scan beats building an index
+	for (const auto member : *this)
+	{
+		if (member.GetName() == Key)
+		{
+			return member;
+		}
+	}
+	return {};
+}
+
+SJsonValue SJsonValue::GetChild(std::string_view Key) const
+{
+	const auto result = Find(Key);
+	if (!result)
+	{
+		LOG(Config, Error, "Key not found: {}", TEXT(string(Key)));
+	}
+	return result;
+}
+
+SJsonValue::SIterator SJsonValue::begin() const
+{
+	const auto type = GetType();
+	if (type != EJsonType::Array && type != EJsonType::Object)
+	{
+		return end();
+	}
+	return { Document, Index + 1 };
+}
+
+SJsonValue::SIterator SJsonValue::end() const
+{
+	return { Document, IsValid() ? GetNode().End : 0 };
+}
+
+void SJsonValue::ReportInvalid(std::string_view Key) const
+{
+	if (Find(Key))
+	{
+		LOG(Config, Error, "Value of {} has an unexpected type: {}", TEXT(string(Key)), TEXT(string(Find(Key).GetText())));
+	}
+}
+
+bool OJsonDocument::Parse(string Text)
+{
+	Buffer = std::move(Text);
+	Nodes.clear();
+	Error.clear();
+
+	// Config files average around one node every dozen bytes
+	Nodes.reserve(Buffer.size() / 12 + 1);
+	OJsonParser parser(Buffer, Nodes);
+	if (!parser.Parse())
+	{
+		Error = parser.GetError();
+		Buffer.clear();
+		Nodes.clear();
+		return false;
+	}
+	Nodes.shrink_to_fit();
+	return true;
+}
+
+bool OJsonDocument::SaveSnapshot(const std::filesystem::path& Path, uint64_t SourceHash) const
+{
+	std::error_code error;
+	std::filesystem::create_directories(Path.parent_path(), error);
+
+	// Written next to the destination and renamed, an interrupted write leaves the previous snapshot intact
+	auto tempPath = Path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		const SJsonSnapshotHeader header{
+			.Magic = SnapshotMagic,
+			.Version = SnapshotVersion,
+			.SourceHash = SourceHash,
+			.BufferSize = Buffer.size(),
+			.NumNodes = Nodes.size()
+		};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(Nodes.data()), static_cast<std::streamsize>(Nodes.size() * sizeof(SJsonNode)));
+		file.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, Path, error);
+	if (error)
+	{
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+bool OJsonDocument::LoadSnapshot(const std::filesystem::path& Path, uint64_t SourceHash)
+{
+	std::ifstream file(Path, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	const auto fileSize = static_cast<uint64_t>(file.tellg());
+	file.seekg(0);
+	SJsonSnapshotHeader header;
+	if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	{
+		return false;
+	}
+	if (header.Magic != SnapshotMagic || header.Version != SnapshotVersion || header.SourceHash != SourceHash || header.NumNodes == 0
+	    || header.NumNodes > UINT32_MAX || header.BufferSize > UINT32_MAX
+	    || fileSize - sizeof(header) != header.NumNodes * sizeof(SJsonNode) + header.BufferSize)
+	{
+		return false;
+	}
+
+	vector<SJsonNode> nodes(header.NumNodes);
+	string buffer(header.BufferSize, '\0');
+	file.read(reinterpret_cast<char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(SJsonNode)));
+	file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	if (!file)
+	{
+		return false;
+	}
+
+	// A damaged snapshot must not hand out spans past the buffer or let iteration run past the parent
+	if (nodes[0].End != nodes.size())
+	{
+		return false;
+	}
+	for (uint32_t i = 0; i < nodes.size(); i++)
+	{
+		const auto& node = nodes[i];
+		if (node.End <= i || node.End > nodes.size() || node.Type > EJsonType::Object
+		    || uint64_t(node.NameOffset) + node.NameLength > buffer.size() || uint64_t(node.TextOffset) + node.TextLength > buffer.size())
+		{
+			return false;
+		}
+
+		const bool bContainer = node.Type == EJsonType::Array || node.Type == EJsonType::Object;
+		uint32_t child = i + 1;
+		uint32_t numChildren = 0;
+		while (bContainer && child < node.End)
+		{
+			if (nodes[child].End <= child || nodes[child].End > node.End)
+			{
+				return false;
+			}
+			child = nodes[child].End;
+			numChildren++;
+		}
+		if (numChildren != node.NumChildren || (!bContainer && node.End != i + 1))
+		{
+			return false;
+		}
+	}
+
+	Buffer = std::move(buffer);
+	Nodes = std::move(nodes);
+	Error.clear();
+	return true;
+}
+
+uint64_t OJsonDocument::HashSource(std::string_view Text)
+{
+	// FNV-1a over 8 byte words, a byte at a time the hash took longer than loading the snapshot. Each step is a bijection of the
+	// previous value, so an edit of any single word always changes the result.
+	uint64_t hash = Utils::SHasher::OffsetBasis ^ Text.size();
+	size_t offset = 0;
+	for (; offset + sizeof(uint64_t) <= Text.size(); offset += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, Text.data() + offset, sizeof(word));
+		hash = (hash ^ word) * Utils::SHasher::Prime;
+	}
+	for (; offset < Text.size(); offset++)
+	{
+		hash = (hash ^ static_cast<uint8_t>(Text[offset])) * Utils::SHasher::Prime;
+	}
+	return hash;
+}
+
+SJsonValue OJsonDocument::GetRoot() const
+{
+	return Nodes.empty() ? SJsonValue() : SJsonValue{ this, 0 };
+}
+
+const string& OJsonDocument::GetError() const
+{
+	return Error;
+}
+
+bool OJsonDocument::IsEmpty() const
+{
+	return Nodes.empty() || Nodes[0].NumChildren == 0;
+}
+
+const SJsonNode& OJsonDocument::GetNode(uint32_t Index) const
+{
+	return Nodes[Index];
+}
+
+std::string_view OJsonDocument::GetString(uint32_t Offset, uint32_t Length) const
+{
+	return std::string_view(Buffer).substr(Offset, Length);
+}
+
+uint32_t OJsonDocument::GetNumNodes() const
+{
+	return static_cast<uint32_t>(Nodes.size());
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include "Types.h"
+
+#include <charconv>
+#include <filesystem>
+#include <string_view>
+
+enum class EJsonType : uint8_t
+{
+	Null,
+	Bool,
+	Number,
+	String,
+	Array,
+	Object
+};
+
+/**
+ * @brief One value of a parsed document. Nodes are stored in document order, the children of a node directly follow it and End is
+ * the index past its last descendant, so the next sibling of a node is found without walking its subtree. Names and scalar texts are
+ * offsets into the text buffer of the document, which keeps the node trivially copyable and the snapshot relocatable.
+ */
+struct SJsonNode
+{
+	EJsonType Type = EJsonType::Null;
+
+	// Member name inside an object, empty for array elements and the root
+	uint32_t NameOffset = 0;
+	uint32_t NameLength = 0;
+
+	// Unescaped string, number literal or true/false, empty for arrays and objects
+	uint32_t TextOffset = 0;
+	uint32_t TextLength = 0;
+	uint32_t NumChildren = 0;
+	uint32_t End = 0;
+};
+
+class OJsonDocument;
+
+/**
+ * @brief Non-owning handle to a node, valid while its document is alive. Lookups of missing members return an invalid value
+ * instead of failing, so they can be chained and tested once. Scalars convert the way the property tree did: every scalar keeps its
+ * source text and is parsed into the requested type on access, a quoted "1" reads as a number and 0 reads as a string.
+ */
+struct SJsonValue
+{
+	struct SIterator
+	{
+		const OJsonDocument* Document = nullptr;
+		uint32_t Index = 0;
+
+		SJsonValue operator*() const { return { Document, Index }; }
+		SIterator& operator++();
+		bool operator==(const SIterator& Other) const { return Index == Other.Index; }
+	};
+
+	const OJsonDocument* Document = nullptr;
+	uint32_t Index = 0;
+
+	bool IsValid() const { return Document != nullptr; }
+	explicit operator bool() const { return IsValid(); }
+
+	EJsonType GetType() const;
+	std::string_view GetName() const;
+	std::string_view GetText() const;
+	uint32_t GetNumChildren() const;
+
+	// Direct member of an object, dots in the key are not treated as a path
+	SJsonValue Find(std::string_view Key) const;
+
+	// Same as Find, but a missing member is reported
+	SJsonValue GetChild(std::string_view Key) const;
+
+	// Members of an object or elements of an array, nothing for scalars and invalid values
+	SIterator begin() const;
+	SIterator end() const;
+
+	template<typename T>
+	std::optional<T> TryAs() const;
+
+	template<typename T>
+	T As() const
+	{
+		return TryAs<T>().value_or(T{});
+	}
+
+	template<typename T>
+	std::optional<T> GetOptional(std::string_view Key) const
+	{
+		return Find(Key).TryAs<T>();
+	}
+
+	template<typename T>
+	T GetOr(std::string_view Key, const T& Default) const
+	{
+		return GetOptional<T>(Key).value_or(Default);
+	}
+
+	string GetOr(std::string_view Key, const char* Default) const
+	{
+		return GetOr<string>(Key, Default);
+	}
+
+	// Reports missing or unconvertible members and returns a value initialized T for them
+	template<typename T>
+	T Get(std::string_view Key) const
+	{
+		if (auto result = GetChild(Key).TryAs<T>())
+		{
+			return std::move(*result);
+		}
+		ReportInvalid(Key);
+		return T{};
+	}
+
+private:
+	const SJsonNode& GetNode() const;
+	void ReportInvalid(std::string_view Key) const;
+};
+
+/**
+ * @brief JSON parsed in situ: the source text is kept as the buffer of the document and strings are unescaped in place, so the
+ * parser allocates nothing besides the flat node array. The parsed state can be written out as a snapshot and read back with two
+ * copies, validated by the hash of the source text.
+ */
+class OJsonDocument
+{
+public:
+	// False on a syntax error, the document is left empty and GetError describes the problem
+	bool Parse(string Text);
+
+	bool SaveSnapshot(const std::filesystem::path& Path, uint64_t SourceHash) const;
+
+	// False if the snapshot is missing, corrupt or was taken from a different source text
+	bool LoadSnapshot(const std::filesystem::path& Path, uint64_t SourceHash);
+
+	static uint64_t HashSource(std::string_view Text);
+
+	SJsonValue GetRoot() const;
+	const string& GetError() const;
+	bool IsEmpty() const;
+	const SJsonNode& GetNode(uint32_t Index) const;
+	std::string_view GetString(uint32_t Offset, uint32_t Length) const;
+	uint32_t GetNumNodes() const;
+
+private:
+	string Buffer;
+	vector<SJsonNode> Nodes;
+	string Error;
+};
+
+namespace JsonDetail
+{
+template<typename T>
+std::optional<T> ParseNumber(std::string_view Text)
+{
+	T value{};
+	const auto begin = Text.data() + (!Text.empty() && Text.front() == '+' ? 1 : 0);
+	const auto [ptr, error] = std::from_chars(begin, Text.data() + Text.size(), value);
+	if (error != std::errc() || ptr != Text.data() + Text.size())
+	{
+		return std::nullopt;
+	}
+	return value;
+}
+} // namespace JsonDetail
+
+template<typename T>
+std::optional<T> SJsonValue::TryAs() const
+{
+	if (!IsValid())
+	{
+		return std::nullopt;
+	}
+
+	const auto type = GetType();
+	if (type == EJsonType::Array || type == EJsonType::Object)
+	{
+		return std::nullopt;
+	}
+
+	const auto text = GetText();
+	if constexpr (std::is_same_v<T, string>)
+	{
+		return string(text);
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		if (text == "true" || text == "1")
+		{
+			return true;
+		}
+		if (text == "false" || text == "0")
+		{
+			return false;
+		}
+		return std::nullopt;
+	}
+	else
+	{
+		static_assert(std::is_arithmetic_v<T>, "Only strings, bools and numbers can be read from a JSON scalar");
+		return JsonDetail::ParseNumber<T>(text);
+	}
+}
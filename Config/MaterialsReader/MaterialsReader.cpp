@@ -1,12 +1,12 @@
 #include "MaterialsReader.h"
 
-vector<STexturePath> OMaterialsConfigParser::GetTexturePaths(const boost::property_tree::ptree& Node, const string& Key)
+vector<STexturePath> OMaterialsConfigParser::GetTexturePaths(const SJsonValue& Node, const string& Key)
 {
 	vector<STexturePath> paths;
-	for (const auto& val : Node.get_child(Key) | std::views::values)
+	for (const auto val : Node.GetChild(Key))
 	{
 		STexturePath path;
-		path.Path = UTF8ToWString(val.data());
+		path.Path = UTF8ToWString(val.As<string>());
 		paths.push_back(path);
 	}
 	return paths;
@@ -16,28 +16,28 @@ std::unordered_map<string, unique_ptr<SMaterial>> OMaterialsConfigParser::LoadMa
 {
 	std::unordered_map<string, unique_ptr<SMaterial>> Materials;
 	LoadConfig(FileName);
-	for (const auto& val : PTree.get_child("Materials") | std::views::values)
+	for (const auto val : GetRootChild("Materials"))
 	{
 		auto material = make_unique<SMaterial>();
-		material->Name = val.get<string>("Name");
-		auto& data = val.get_child("Data");
+		material->Name = val.Get<string>("Name");
+		const auto data = val.GetChild("Data");
 
 		material->DiffuseMaps = GetTexturePaths(data, "DiffuseMapPaths");
 		material->NormalMaps = GetTexturePaths(data, "NormalMapPaths");
 		material->HeightMaps = GetTexturePaths(data, "HeightMapPaths");
 
-		auto& diffChild = data.get_child("Diffuse");
-		material->MaterialSurface.DiffuseAlbedo.x = diffChild.get<float>("x");
-		material->MaterialSurface.DiffuseAlbedo.y = diffChild.get<float>("y");
-		material->MaterialSurface.DiffuseAlbedo.z = diffChild.get<float>("z");
-		material->MaterialSurface.DiffuseAlbedo.w = diffChild.get<float>("w");
+		const auto diffChild = data.GetChild("Diffuse");
+		material->MaterialSurface.DiffuseAlbedo.x = diffChild.Get<float>("x");
+		material->MaterialSurface.DiffuseAlbedo.y = diffChild.Get<float>("y");
+		material->MaterialSurface.DiffuseAlbedo.z = diffChild.Get<float>("z");
+		material->MaterialSurface.DiffuseAlbedo.w = diffChild.Get<float>("w");
 
-		auto& fresnelChild = data.get_child("Fresnel");
-		material->MaterialSurface.FresnelR0.x = fresnelChild.get<float>("x");
-		material->MaterialSurface.FresnelR0.y = fresnelChild.get<float>("y");
-		material->MaterialSurface.FresnelR0.z = fresnelChild.get<float>("z");
+		const auto fresnelChild = data.GetChild("Fresnel");
+		material->MaterialSurface.FresnelR0.x = fresnelChild.Get<float>("x");
+		material->MaterialSurface.FresnelR0.y = fresnelChild.Get<float>("y");
+		material->MaterialSurface.FresnelR0.z = fresnelChild.Get<float>("z");
 
-		material->MaterialSurface.Roughness = data.get<float>("Roughness");
+		material->MaterialSurface.Roughness = data.Get<float>("Roughness");
 		Materials[material->Name] = std::move(material);
 	}
 	return std::move(Materials);
@@ -57,42 +57,35 @@ void OMaterialsConfigParser::AddDataToNode(const SMaterial* Mat, boost::property
 }
 
 void OMaterialsConfigParser::AddMaterial(const SMaterial* Material)
+{
+	AddMaterials({ { Material->Name, Material } });
+}
+
+void OMaterialsConfigParser::AddMaterials(const std::unordered_map<string, const SMaterial*>& Materials)
 {
 	using namespace boost::property_tree;
 	LoadConfig(FileName);
-	auto name = Material->Name;
-
-	bool foundMat = false;
-	auto& items = PTree.get_child("Materials");
-	for (auto& item : items)
-	{
-		if (item.second.get<string>("Name") == name)
-		{
-			auto& matNode = item.second;
-			auto& data = matNode.get_child("Data");
-			matNode.put("Name", Material->Name);
-			AddDataToNode(Material, data);
-			foundMat = true;
-			break;
-		}
-	}
+	auto& items = GetWritableTree().get_child("Materials");
 
-	if (!foundMat)
+	// Indexed once per batch instead of scanning the whole list for every material
+	unordered_map<string, ptree*> nodes;
+	for (auto& item : items | std::views::values)
 	{
-		ptree matNode;
-		matNode.put("Name", Material->Name);
-		ptree data;
-		AddDataToNode(Material, data);
-		matNode.add_child("Data", data);
-		items.push_back(std::make_pair("", matNode));
+		nodes.try_emplace(item.get<string>("Name"), &item);
 	}
-	write_json(FileName, PTree);
-}
 
-void OMaterialsConfigParser::AddMaterials(const std::unordered_map<string, SMaterial*>& Materials)
-{
-	for (const auto& value : Materials | std::views::values)
+	BeginWriteBatch();
+	for (const auto material : Materials | std::views::values)
 	{
-		AddMaterial(value);
+		auto& matNode = nodes[material->Name];
+		if (!matNode)
+		{
+			matNode = &items.push_back(std::make_pair("", ptree()))->second;
+			matNode->put("Name", material->Name);
+			matNode->add_child("Data", ptree());
+		}
+		AddDataToNode(material, matNode->get_child("Data"));
+		MarkDirty();
 	}
+	EndWriteBatch();
 }
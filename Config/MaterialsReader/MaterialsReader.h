@@ -15,6 +15,8 @@ public:
 	void AddDataToNode(const SMaterial* Mat, boost::property_tree::ptree& OutNode);
 	/*Adds or modifies the material in the tree*/
 	void AddMaterial(const SMaterial* Material);
-	void AddMaterials(const std::unordered_map<string, SMaterial*>& Materials);
-	static vector<STexturePath> GetTexturePaths(const boost::property_tree::ptree& Node, const string& Key);
+
+	// Adds or modifies every material and saves the file once
+	void AddMaterials(const std::unordered_map<string, const SMaterial*>& Materials);
+	static vector<STexturePath> GetTexturePaths(const SJsonValue& Node, const string& Key);
 };
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#include "DirectX/DXHelper.h"
+#include "Logger.h"
+#include "Types.h"
+
+// Names used by the PSO config, decoded through compile time tables. Free of the config reader so the tables can be checked on their own.
+namespace PSOTables
+{
+inline constexpr auto LogicOps = MakeEnumTable<D3D12_LOGIC_OP>({
+	{ "Clear", D3D12_LOGIC_OP_CLEAR },
+	{ "Set", D3D12_LOGIC_OP_SET },
+	{ "Copy", D3D12_LOGIC_OP_COPY },
+	{ "CopyInverted", D3D12_LOGIC_OP_COPY_INVERTED },
+	{ "NoOp", D3D12_LOGIC_OP_NOOP },
+	{ "Invert", D3D12_LOGIC_OP_INVERT },
+	{ "And", D3D12_LOGIC_OP_AND },
+	{ "Nand", D3D12_LOGIC_OP_NAND },
+	{ "Or", D3D12_LOGIC_OP_OR },
+});
+
+inline constexpr auto BlendOps = MakeEnumTable<D3D12_BLEND_OP>({
+	{ "Add", D3D12_BLEND_OP_ADD },
+	{ "Subtract", D3D12_BLEND_OP_SUBTRACT },
+	{ "RevSubtract", D3D12_BLEND_OP_REV_SUBTRACT },
+	{ "Min", D3D12_BLEND_OP_MIN },
+	{ "Max", D3D12_BLEND_OP_MAX },
+});
+
+inline constexpr auto Blends = MakeEnumTable<D3D12_BLEND>({
+	{ "Zero", D3D12_BLEND_ZERO },
+	{ "One", D3D12_BLEND_ONE },
+	{ "SrcColor", D3D12_BLEND_SRC_COLOR },
+	{ "InvSrcColor", D3D12_BLEND_INV_SRC_COLOR },
+	{ "SrcAlpha", D3D12_BLEND_SRC_ALPHA },
+	{ "InvSrcAlpha", D3D12_BLEND_INV_SRC_ALPHA },
+	{ "DestAlpha", D3D12_BLEND_DEST_ALPHA },
+	{ "InvDestAlpha", D3D12_BLEND_INV_DEST_ALPHA },
+	{ "DestColor", D3D12_BLEND_DEST_COLOR },
+	{ "InvDestColor", D3D12_BLEND_INV_DEST_COLOR },
+	{ "SrcAlphaSat", D3D12_BLEND_SRC_ALPHA_SAT },
+});
+
+inline constexpr auto CullModes = MakeEnumTable<D3D12_CULL_MODE>({
+	{ "None", D3D12_CULL_MODE_NONE },
+	{ "Front", D3D12_CULL_MODE_FRONT },
+	{ "Back", D3D12_CULL_MODE_BACK },
+});
+
+inline constexpr auto ConservativeRasterizationModes = MakeEnumTable<D3D12_CONSERVATIVE_RASTERIZATION_MODE>({
+	{ "Off", D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF },
+	{ "On", D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON },
+});
+
+inline constexpr auto FillModes = MakeEnumTable<D3D12_FILL_MODE>({
+	{ "Wireframe", D3D12_FILL_MODE_WIREFRAME },
+	{ "Solid", D3D12_FILL_MODE_SOLID },
+});
+
+inline constexpr auto DepthWriteMasks = MakeEnumTable<D3D12_DEPTH_WRITE_MASK>({
+	{ "Zero", D3D12_DEPTH_WRITE_MASK_ZERO },
+	{ "All", D3D12_DEPTH_WRITE_MASK_ALL },
+});
+
+inline constexpr auto ComparisonFuncs = MakeEnumTable<D3D12_COMPARISON_FUNC>({
+	{ "Never", D3D12_COMPARISON_FUNC_NEVER },
+	{ "Less", D3D12_COMPARISON_FUNC_LESS },
+	{ "Equal", D3D12_COMPARISON_FUNC_EQUAL },
+	{ "LessEqual", D3D12_COMPARISON_FUNC_LESS_EQUAL },
+	{ "Greater", D3D12_COMPARISON_FUNC_GREATER },
+	{ "NotEqual", D3D12_COMPARISON_FUNC_NOT_EQUAL },
+	{ "GreaterEqual", D3D12_COMPARISON_FUNC_GREATER_EQUAL },
+	{ "Always", D3D12_COMPARISON_FUNC_ALWAYS },
+});
+
+inline constexpr auto StencilOps = MakeEnumTable<D3D12_STENCIL_OP>({
+	{ "Keep", D3D12_STENCIL_OP_KEEP },
+	{ "Zero", D3D12_STENCIL_OP_ZERO },
+	{ "Replace", D3D12_STENCIL_OP_REPLACE },
+	{ "IncrSat", D3D12_STENCIL_OP_INCR_SAT },
+	{ "DecrSat", D3D12_STENCIL_OP_DECR_SAT },
+	{ "Invert", D3D12_STENCIL_OP_INVERT },
+	{ "Incr", D3D12_STENCIL_OP_INCR },
+	{ "Decr", D3D12_STENCIL_OP_DECR },
+});
+
+inline constexpr auto ColorWriteEnables = MakeEnumTable<D3D12_COLOR_WRITE_ENABLE>({
+	{ "Red", D3D12_COLOR_WRITE_ENABLE_RED },
+	{ "Green", D3D12_COLOR_WRITE_ENABLE_GREEN },
+	{ "Blue", D3D12_COLOR_WRITE_ENABLE_BLUE },
+	{ "Alpha", D3D12_COLOR_WRITE_ENABLE_ALPHA },
+	{ "All", D3D12_COLOR_WRITE_ENABLE_ALL },
+});
+
+inline constexpr auto TopologyTypes = MakeEnumTable<D3D12_PRIMITIVE_TOPOLOGY_TYPE>({
+	{ "Point", D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT },
+	{ "Line", D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE },
+	{ "Triangle", D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE },
+	{ "Patch", D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH },
+});
+
+inline constexpr auto Formats = MakeEnumTable<DXGI_FORMAT>({
+	{ "R8G8B8A8_UNORM", DXGI_FORMAT_R8G8B8A8_UNORM },
+	{ "R8G8B8A8_UNORM_SRGB", DXGI_FORMAT_R8G8B8A8_UNORM_SRGB },
+	{ "R32G32B32A32_FLOAT", DXGI_FORMAT_R32G32B32A32_FLOAT },
+	{ "R16G16B16A16_FLOAT", DXGI_FORMAT_R16G16B16A16_FLOAT },
+	{ "R16G16B16A16_UNORM", DXGI_FORMAT_R16G16B16A16_UNORM },
+	{ "R16G16B16A16_UINT", DXGI_FORMAT_R16G16B16A16_UINT },
+	{ "D24_UNORM_S8_UINT", DXGI_FORMAT_D24_UNORM_S8_UINT },
+});
+
+inline constexpr auto PipelineStateFlags = MakeEnumTable<D3D12_PIPELINE_STATE_FLAGS>({
+	{ "None", D3D12_PIPELINE_STATE_FLAG_NONE },
+	{ "ToolDebug", D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG },
+});
+
+// Unknown names are reported and read as the Default
+template<typename TEnum, size_t N>
+TEnum Decode(const OEnumTable<TEnum, N>& Table, const string& Name, TEnum Default, const wchar_t* What)
+{
+	if (const auto value = Table.FromString(Name))
+	{
+		return *value;
+	}
+	WIN_LOG(Config, Error, "Unknown {}: {}", What, TEXT(Name));
+	return Default;
+}
+} // namespace PSOTables
@@ -1,18 +1,32 @@
 #include "RenderGraphReader.h"
 
-#include <ranges>
-
 vector<SNodeInfo> ORenderGraphReader::LoadRenderGraph()
 {
 	vector<SNodeInfo> result;
-	for (auto& node : GetRootChild("RenderGraph") | std::views::values)
+	for (const auto node : GetRootChild("RenderGraph"))
 	{
 		SNodeInfo info;
-		info.Name = node.get<string>("Name");
-		info.PSOType = node.get<string>("PSO");
-		info.NextNode = node.get<string>("NextNode");
-		info.RenderLayer = node.get<string>("RenderLayer");
+		info.Name = node.Get<string>("Name");
+		info.PSOType = node.Get<string>("PSO");
+		info.RenderLayer = node.Get<string>("RenderLayer");
+		info.Reads = LoadResourceList(node, "Reads");
+		info.Writes = LoadResourceList(node, "Writes");
+		info.bIsOutput = GetOptionalOr(node, "Output", false);
+		for (const auto state : node.Find("States"))
+		{
+			info.States[string(state.GetName())] = state.As<string>();
+		}
 		result.push_back(info);
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+vector<string> ORenderGraphReader::LoadResourceList(const SJsonValue& Node, const string& Key)
+{
+	vector<string> result;
+	for (const auto resource : Node.Find(Key))
+	{
+		result.push_back(resource.As<string>());
+	}
+	return result;
+}
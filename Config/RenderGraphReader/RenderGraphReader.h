@@ -1,4 +1,3 @@
-
 #pragma once
 #include "ConfigReader.h"
 #include "RenderNodeInfo.h"
@@ -8,4 +7,7 @@ public:
 	ORenderGraphReader(const string& FileName)
 	    : OConfigReader(FileName) {}
 	vector<SNodeInfo> LoadRenderGraph();
+
+private:
+	static vector<string> LoadResourceList(const SJsonValue& Node, const string& Key);
 };
@@ -4,25 +4,23 @@
 #include "Application.h"
 #include "GraphicsPipeline/GraphicsPipeline.h"
 
-#include <ranges>
-
 unordered_map<string, vector<SPipelineStage>> OShaderReader::LoadShaders()
 {
 	unordered_map<string, vector<SPipelineStage>> result;
-	for (auto& shader : PTree.get_child("Shaders") | std::views::values)
+	for (const auto shader : GetRootChild("Shaders"))
 	{
 		vector<SPipelineStage> currentPipeline;
 
 		SPipelineStage info;
-		info.ShaderPath = OApplication::Get()->GetResourcePath(UTF8ToWString(shader.get<string>("Path")));
+		info.ShaderPath = OApplication::Get()->GetResourcePath(UTF8ToWString(shader.Get<string>("Path")));
 
-		info.ShaderName = shader.get<string>("Name");
-		for (auto& val : shader.get_child("Pipeline") | std::views::values)
+		info.ShaderName = shader.Get<string>("Name");
+		for (const auto val : shader.GetChild("Pipeline"))
 		{
 			SShaderDefinition def;
-			def.TypeFromString(val.get<string>("Type"));
-			def.ShaderEntry = UTF8ToWString(val.get<string>("EntryPoint"));
-			def.TargetProfile = UTF8ToWString(val.get<string>("TargetProfile"));
+			def.TypeFromString(val.Get<string>("Type"));
+			def.ShaderEntry = UTF8ToWString(val.Get<string>("EntryPoint"));
+			def.TargetProfile = UTF8ToWString(val.Get<string>("TargetProfile"));
 			info.ShaderDefinition = def;
 			info.Defines = FindDefines(val);
 			currentPipeline.push_back(info);
@@ -31,19 +29,44 @@ unordered_map<string, vector<SPipelineStage>> OShaderReader::LoadShaders()
 	}
 	return result;
 }
-vector<D3D_SHADER_MACRO> OShaderReader::FindDefines(const boost::property_tree::ptree& Tree)
+unordered_map<string, OShaderPermutationSpace> OShaderReader::LoadPermutations()
 {
-	if (const auto Optional = Tree.get_child_optional("Defines"))
+	unordered_map<string, OShaderPermutationSpace> result;
+	for (const auto shader : GetRootChild("Shaders"))
 	{
-		vector<D3D_SHADER_MACRO> result;
-		for (auto& val : Optional.get() | std::views::values)
+		const auto permutations = shader.Find("Permutations");
+		if (!permutations)
+		{
+			continue;
+		}
+
+		const auto name = shader.Get<string>("Name");
+		OShaderPermutationSpace space;
+		for (const auto axisTree : permutations)
 		{
-			D3D_SHADER_MACRO macro;
-			macro.Name = val.get<string>("Name").c_str();
-			macro.Definition = val.get<string>("Value").c_str();
-			result.push_back(macro);
+			SShaderPermutationAxis axis;
+			axis.Name = axisTree.Get<string>("Name");
+			for (const auto value : axisTree.Find("Values"))
+			{
+				axis.Values.push_back(value.As<string>());
+			}
+
+			if (!space.AddAxis(axis))
+			{
+				LOG(Render, Error, "Permutation axis {} of {} is duplicated or doesn't fit into the key", TEXT(axis.Name), TEXT(name));
+			}
 		}
-		return result;
+		result[name] = std::move(space);
+	}
+	return result;
+}
+
+vector<pair<string, string>> OShaderReader::FindDefines(const SJsonValue& Tree)
+{
+	vector<pair<string, string>> result;
+	for (const auto val : Tree.Find("Defines"))
+	{
+		result.emplace_back(val.Get<string>("Name"), val.Get<string>("Value"));
 	}
-	return {};
+	return result;
 }
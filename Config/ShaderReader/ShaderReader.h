@@ -1,6 +1,7 @@
 #pragma once
 #include "ConfigReader.h"
 #include "GraphicsPipeline/GraphicsPipeline.h"
+#include "ShaderCompiler/ShaderPermutation.h"
 #include "Types.h"
 class OShaderReader : public OConfigReader
 {
@@ -11,6 +12,9 @@ public:
 	}
 	unordered_map<string, vector<SPipelineStage>> LoadShaders();
 
+	// Feature axes declared under "Permutations" of every pipeline, pipelines without any are left out
+	unordered_map<string, OShaderPermutationSpace> LoadPermutations();
+
 private:
-	vector<D3D_SHADER_MACRO> FindDefines(const boost::property_tree::ptree& Tree);
+	vector<pair<string, string>> FindDefines(const SJsonValue& Tree);
 };
@@ -11,52 +11,46 @@ using namespace boost::property_tree;
 
 void OTexturesParser::AddTexture(STexture* Texture)
 {
-	auto& items = PTree.get_child("Textures");
-	auto name = Texture->Name;
-	auto path = WStringToUTF8(Texture->FileName);
-	bool hasfound = false;
+	AddTextures({ Texture });
+}
 
-	for (auto& val : items | std::views::values)
-	{
-		if (val.get<string>("Name") == name)
-		{
-			hasfound = true;
-			auto& texNode = val;
-			texNode.put("Path", path);
-			texNode.put("ViewDimensions", Texture->ViewType);
-		}
-	}
+void OTexturesParser::AddTextures(const vector<STexture*>& Textures)
+{
+	auto& items = GetWritableTree().get_child("Textures");
 
-	if (!hasfound)
+	// Indexed once per batch instead of scanning the whole list for every texture
+	unordered_map<string, ptree*> nodes;
+	for (auto& val : items | std::views::values)
 	{
-		ptree texNode;
-		texNode.put("Name", name);
-		texNode.put("Path", path);
-		texNode.put("ViewDimensions", Texture->ViewType);
-		items.push_back(std::make_pair("", texNode));
+		nodes.try_emplace(val.get<string>("Name"), &val);
 	}
 
-	write_json(FileName, PTree);
-}
-
-void OTexturesParser::AddTextures(const vector<STexture*>& Textures)
-{
-	for (auto tex : Textures)
+	BeginWriteBatch();
+	for (const auto texture : Textures)
 	{
-		AddTexture(tex);
+		auto& texNode = nodes[texture->Name];
+		if (!texNode)
+		{
+			texNode = &items.push_back(std::make_pair("", ptree()))->second;
+			texNode->put("Name", texture->Name);
+		}
+		texNode->put("Path", WStringToUTF8(texture->FileName));
+		texNode->put("ViewDimensions", texture->ViewType);
+		texNode->put("Type", ToString(texture->Type));
+		MarkDirty();
 	}
+	EndWriteBatch();
 }
 
 vector<STexture*> OTexturesParser::LoadTextures()
 {
 	vector<STexture*> textures;
-	auto& items = PTree.get_child("Textures");
-	for (auto& val : items | std::views::values)
+	for (const auto val : GetRootChild("Textures"))
 	{
 		auto tex = new STexture();
-		tex->Name = val.get<string>("Name");
-		tex->FileName = UTF8ToWString(val.get<string>("Path"));
-		tex->ViewType = val.get<string>("ViewDimensions");
+		tex->Name = val.Get<string>("Name");
+		tex->FileName = UTF8ToWString(val.Get<string>("Path"));
+		tex->ViewType = val.Get<string>("ViewDimensions");
 		tex->Type = GetTextureType(GetAttribute(val,"Type"));
 		textures.push_back(tex);
 	}
@@ -65,28 +59,10 @@ vector<STexture*> OTexturesParser::LoadTextures()
 
 ETextureType OTexturesParser::GetTextureType(const string& Type)
 {
-	if (Type == "Diffuse")
-	{
-		return ETextureType::Diffuse;
-	}
-	 if (Type == "Normal")
+	if (const auto type = FromString<ETextureType>(Type))
 	{
-		return ETextureType::Normal;
+		return *type;
 	}
-	 if (Type == "Roughness")
-	{
-		return ETextureType::Roughness;
-	}
-	 if (Type == "Height")
-	{
-		return ETextureType::Height;
-	}
-	if(Type == "Occlusion")
-	{
-		return ETextureType::Occlusion;
-	}
-
 	LOG(Config, Error, "Texture type not found! {}", TEXT(Type))
 	return ETextureType::Diffuse;
-
-}
\ No newline at end of file
+}
@@ -13,8 +13,10 @@ public:
 	}
 
 	void AddTexture(STexture* Texture);
+
+	// Adds or updates every texture and saves the file once
 	void AddTextures(const vector<STexture*>& Textures);
 	vector<STexture*> LoadTextures();
 private:
-	ETextureType GetTextureType(const string& Type);
+	static ETextureType GetTextureType(const string& Type);
 };
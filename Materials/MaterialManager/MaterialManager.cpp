@@ -95,6 +95,57 @@ void OMaterialManager::LoadMaterialsFromCache()
 	MaterialsRebuld.Broadcast();
 }
 
+void OMaterialManager::ReloadMaterials()
+{
+	const auto diff = MaterialsConfigParser->ReloadList("Materials", "Name");
+	if (!diff || diff->IsEmpty())
+	{
+		return;
+	}
+
+	auto loaded = MaterialsConfigParser->LoadMaterials();
+	for (const auto& name : diff->Changed)
+	{
+		const auto live = Materials.find(name);
+		auto& source = loaded[name];
+		if (live == Materials.end() || !source)
+		{
+			continue;
+		}
+
+		auto& material = live->second;
+		material->MaterialSurface = source->MaterialSurface;
+		material->DiffuseMaps = std::move(source->DiffuseMaps);
+		material->NormalMaps = std::move(source->NormalMaps);
+		material->HeightMaps = std::move(source->HeightMaps);
+		LoadTexturesFromPaths(material->DiffuseMaps);
+		LoadTexturesFromPaths(material->NormalMaps);
+		LoadTexturesFromPaths(material->HeightMaps);
+		material->NumFramesDirty = SRenderConstants::NumFrameResources;
+	}
+
+	for (const auto& name : diff->Added)
+	{
+		auto& material = loaded[name];
+		LoadTexturesFromPaths(material->DiffuseMaps);
+		LoadTexturesFromPaths(material->NormalMaps);
+		LoadTexturesFromPaths(material->HeightMaps);
+		material->MaterialCBIndex = Materials.size();
+		AddMaterial(name, material);
+	}
+
+	for (const auto& name : diff->Removed)
+	{
+		LOG(Material, Warning, "Material {} was removed from the config, it stays loaded until the next start", TEXT(name));
+	}
+
+	LOG(Material, Log, "Reloaded materials: {} changed, {} added", diff->Changed.size(), diff->Added.size());
+	if (!diff->Added.empty())
+	{
+		MaterialsRebuld.Broadcast();
+	}
+}
+
 void OMaterialManager::LoadTexturesFromPaths(vector<STexturePath>& OutTextures)
 {
 	for (auto& [Texture, Path] : OutTextures)
@@ -109,16 +160,13 @@ void OMaterialManager::LoadTexturesFromPaths(vector<STexturePath>& OutTextures)
 
 void OMaterialManager::SaveMaterials() const
 {
-	//TODO possible data run
-	std::unordered_map<string, SMaterial*> materials;
+	// One batched write is cheap enough to stay on this thread, the detached writer used to race with material edits
+	std::unordered_map<string, const SMaterial*> materials;
 	for (const auto& [fst, snd] : this->Materials)
 	{
 		materials[fst] = snd.get();
 	}
-
-	std::thread([&, localMat = std::move(materials)]() {
-		MaterialsConfigParser->AddMaterials(localMat);
-	}).detach();
+	MaterialsConfigParser->AddMaterials(materials);
 }
 
 void OMaterialManager::BuildMaterialsFromTextures(const std::unordered_map<string, unique_ptr<STexture>>& Textures)
@@ -27,6 +27,10 @@ public:
 	uint32_t GetNumMaterials();
 
 	void LoadMaterialsFromCache();
+
+	// Applies the materials changed in the config file to the live ones, which keep their constant buffer index. Added materials
+	// are appended, removed ones stay alive since render items may still reference them. Call between frames.
+	void ReloadMaterials();
 	static void LoadTexturesFromPaths(vector<STexturePath>& OutTextures);
 	void SaveMaterials() const;
 	void BuildMaterialsFromTextures(const std::unordered_map<string, unique_ptr<STexture>>& Textures);
@@ -24,7 +24,7 @@ VertexOut VS(VertexIn Vin, uint InstanceID
 {
 	VertexOut vout = (VertexOut)0.0f;
 
-	InstanceData inst = gInstanceData[InstanceID];
+	InstanceData inst = gInstanceData[gInstanceOffset + InstanceID];
 	float4x4 world = inst.World;
 	float4x4 texTransform = inst.TexTransform;
 	uint matIndex = inst.MaterialIndex;
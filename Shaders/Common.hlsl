@@ -39,7 +39,8 @@ struct MaterialData
 	float pad2;
 };
 
-Texture2D gTextureMaps[41] : register(t0);
+// Bindless table over the whole SRV heap, materials address textures by their heap index
+Texture2D gTextureMaps[] : register(t0);
 Texture2D gDisplacementMap : register(t0,space3);
 TextureCube gCubeMap : register(t1,space3);
 
@@ -50,6 +51,12 @@ StructuredBuffer<SpotLight> gSpotLights : register(t0, space2);
 StructuredBuffer<PointLight> gPointLights : register(t1, space2);
 StructuredBuffer<DirectionalLight> gDirectionalLights : register(t2, space2);
 
+// Set as root constants per draw, space7 is SRenderConstants::RootConstantsSpace
+cbuffer cbDrawConstants : register(b0, space7)
+{
+	uint gInstanceOffset;
+};
+
 cbuffer cbPass : register(b0)
 {
 	float4x4 gView;
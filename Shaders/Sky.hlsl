@@ -16,7 +16,7 @@ struct VertexOut
 VertexOut VS(VertexIn vin, uint InstanceID
              : SV_InstanceID)
 {
-	InstanceData inst = gInstanceData[InstanceID];
+	InstanceData inst = gInstanceData[gInstanceOffset + InstanceID];
 	VertexOut vout;
 	vout.PositionL = vin.Position;
 	float4 posW = mul(float4(vin.Position, 1.0f), inst.World);
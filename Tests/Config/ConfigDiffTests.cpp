@@ -0,0 +1,121 @@
+#include "ConfigDiff/ConfigDiff.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+OJsonDocument Parse(const string& Text)
+{
+	OJsonDocument document;
+	BOOST_REQUIRE_MESSAGE(document.Parse(Text), document.GetError());
+	return document;
+}
+
+bool Equals(const string& Lhs, const string& Rhs)
+{
+	const auto lhs = Parse(Lhs);
+	const auto rhs = Parse(Rhs);
+	return OConfigDiff::Equals(lhs.GetRoot(), rhs.GetRoot());
+}
+
+// Both versions keep their entries in the list named List, keyed by Name
+SConfigDiff Diff(const string& Old, const string& New, std::string_view List = "List")
+{
+	const auto oldDocument = Parse(Old);
+	const auto newDocument = Parse(New);
+	return OConfigDiff::Diff(oldDocument.GetRoot().Find(List), newDocument.GetRoot().Find(List), "Name");
+}
+
+string ReadConfig(const string& Name)
+{
+	std::ifstream file(RENDERER_SOURCE_DIR "/Resources/Config/" + Name);
+	std::stringstream stream;
+	stream << file.rdbuf();
+	return stream.str();
+}
+
+using SNames = vector<string>;
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ConfigDiff)
+
+BOOST_AUTO_TEST_CASE(MemberOrderAndWhitespaceDontMatter)
+{
+	BOOST_TEST(Equals(R"({"a":1,"b":[1,2],"c":{"x":"y"}})", R"({ "c" : {"x":"y"}, "b":[1, 2], "a":1 })"));
+	BOOST_TEST(Diff(R"({"List":[{"Name":"a","v":[1,{"k":true}]}]})", "{\n \"List\" : [ { \"v\" : [ 1 , { \"k\" : true } ] , \"Name\" : \"a\" } ]\n}").IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(ValuesCompareByTypeAndText)
+{
+	BOOST_TEST(!Equals(R"({"b":[1,2]})", R"({"b":[2,1]})"));
+	BOOST_TEST(!Equals(R"({"a":1})", R"({"a":"1"})"));
+	BOOST_TEST(!Equals(R"({"a":1})", R"({"a":1.0})"));
+	BOOST_TEST(!Equals(R"({"a":null})", R"({"a":false})"));
+	BOOST_TEST(!Equals(R"({"a":1})", R"({"a":1,"b":2})"));
+	BOOST_TEST(!Equals(R"({"a":1,"c":2})", R"({"a":1,"b":2})"));
+}
+
+BOOST_AUTO_TEST_CASE(EntriesAreAddedRemovedAndChanged)
+{
+	const auto diff = Diff(R"({"List":[{"Name":"a","v":1},{"Name":"b","v":1},{"Name":"c"}]})",
+	                       R"({"List":[{"Name":"d"},{"v":2,"Name":"a"},{"Name":"c"}]})");
+	BOOST_TEST(diff.Added == SNames{ "d" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.Removed == SNames{ "b" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.Changed == SNames{ "a" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.GetNumEntries() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(ReorderedEntriesArentChanged)
+{
+	BOOST_TEST(Diff(R"({"List":[{"Name":"a"},{"Name":"b"}]})", R"({"List":[{"Name":"b"},{"Name":"a"}]})").IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(LastDuplicateCounts)
+{
+	BOOST_TEST(Diff(R"({"List":[{"Name":"a","v":1},{"Name":"a","v":2}]})", R"({"List":[{"Name":"a","v":2}]})").IsEmpty());
+
+	const auto diff = Diff(R"({"List":[{"Name":"a","v":1},{"Name":"b"}]})", R"({"List":[{"Name":"a","v":1},{"Name":"b"},{"Name":"a","v":3}]})");
+	BOOST_TEST(diff.Changed == SNames{ "a" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.Added.empty());
+	BOOST_TEST(diff.Removed.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MissingListsAndKeysAreEmpty)
+{
+	auto diff = Diff(R"({})", R"({"List":[{"Name":"a"},{"x":1},5]})");
+	BOOST_TEST(diff.Added == SNames{ "a" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.Removed.empty());
+
+	diff = Diff(R"({"List":[{"Name":"a"}]})", R"({})");
+	BOOST_TEST(diff.Removed == SNames{ "a" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.Added.empty());
+	BOOST_TEST(Diff(R"({})", R"({})").IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(ShippedConfigsOnlyReportTheEditedEntry)
+{
+	for (const char* name : { "PSOConfig.json", "MaterialsConfig.json", "RenderGraphConfig.json" })
+	{
+		const auto text = ReadConfig(name);
+		BOOST_TEST(Equals(text, text), name);
+	}
+
+	// GrassSky is listed twice, the reader keeps the last one and an edit of the first one changes nothing
+	const auto materials = ReadConfig("MaterialsConfig.json");
+	auto shadowed = materials;
+	shadowed.replace(shadowed.find("grasscube1024.dds"), 5, "water");
+	BOOST_TEST(Diff(materials, shadowed, "Materials").IsEmpty());
+
+	auto edited = materials;
+	const auto position = edited.rfind("grasscube1024.dds");
+	BOOST_REQUIRE(position != string::npos);
+	edited.replace(position, 5, "water");
+
+	const auto diff = Diff(materials, edited, "Materials");
+	BOOST_TEST(diff.Changed == SNames{ "GrassSky" }, boost::test_tools::per_element());
+	BOOST_TEST(diff.GetNumEntries() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,322 @@
+#include "Json/JsonDocument.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+std::ostream& operator<<(std::ostream& Stream, EJsonType Type)
+{
+	return Stream << static_cast<int>(Type);
+}
+
+namespace
+{
+// Magic, version, source hash, buffer size and node count
+constexpr size_t SnapshotHeaderSize = 32;
+
+const string Config = R"({
+	"Name": "Water",
+	"Enabled": true,
+	"Scale": -12.5e+3,
+	"Count": 18446744073709551615,
+	"Empty": {},
+	"Passes": [ { "Shader": "Water.hlsl", "Defines": ["FOG", "ALPHA_TEST"] }, null, [] ],
+	"Tint": [0.1, 0.2, 0.3]
+})";
+
+string Unescape(const string& Literal)
+{
+	OJsonDocument document;
+	BOOST_REQUIRE_MESSAGE(document.Parse("[\"" + Literal + "\"]"), document.GetError());
+	return string((*document.GetRoot().begin()).GetText());
+}
+
+string GetError(const string& Text)
+{
+	OJsonDocument document;
+	BOOST_TEST(!document.Parse(Text), Text);
+	BOOST_TEST(!document.GetRoot().IsValid());
+	return document.GetError();
+}
+
+// Prints every node, which also checks that iteration stays inside the parent
+string Dump(const SJsonValue& Value)
+{
+	string result = string(Value.GetName()) + ":" + std::to_string(static_cast<int>(Value.GetType())) + ":" + string(Value.GetText());
+	uint32_t numChildren = 0;
+	for (const auto child : Value)
+	{
+		BOOST_REQUIRE(child.Index < Value.Document->GetNode(Value.Index).End);
+		result += "(" + Dump(child) + ")";
+		numChildren++;
+	}
+	BOOST_TEST(numChildren == Value.GetNumChildren());
+	return result;
+}
+
+/**
+ * @brief Parsed copy of Config and a snapshot of it in a fresh temporary directory.
+ */
+struct SSnapshotFixture
+{
+	SSnapshotFixture()
+	    : Directory(std::filesystem::temp_directory_path() / ("RendererTests" + std::to_string(std::random_device{}())))
+	    , Path(Directory / "Config.snapshot")
+	    , Hash(OJsonDocument::HashSource(Config))
+	{
+		BOOST_REQUIRE(Document.Parse(Config));
+		BOOST_REQUIRE(Document.SaveSnapshot(Path, Hash));
+
+		std::ifstream file(Path, std::ios::binary);
+		Snapshot.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	~SSnapshotFixture()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(Directory, error);
+	}
+
+	bool Load(const string& Data) const
+	{
+		{
+			std::ofstream file(Path, std::ios::binary | std::ios::trunc);
+			file.write(Data.data(), static_cast<std::streamsize>(Data.size()));
+		}
+		OJsonDocument document;
+		if (!document.LoadSnapshot(Path, Hash))
+		{
+			return false;
+		}
+		Dump(document.GetRoot());
+		return true;
+	}
+
+	// Snapshot with one node replaced
+	string WithNode(uint32_t Index, const std::function<void(SJsonNode&)>& Change) const
+	{
+		auto data = Snapshot;
+		SJsonNode node;
+		const size_t offset = SnapshotHeaderSize + Index * sizeof(SJsonNode);
+		memcpy(&node, data.data() + offset, sizeof(node));
+		Change(node);
+		memcpy(data.data() + offset, &node, sizeof(node));
+		return data;
+	}
+
+	std::filesystem::path Directory;
+	std::filesystem::path Path;
+	uint64_t Hash = 0;
+	OJsonDocument Document;
+	string Snapshot;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonDocument)
+
+BOOST_AUTO_TEST_CASE(EscapesAreUnescapedInPlace)
+{
+	BOOST_TEST(Unescape(R"(a\"b\\c\/d)") == "a\"b\\c/d");
+	BOOST_TEST(Unescape(R"(\b\f\n\r\t)") == "\b\f\n\r\t");
+	BOOST_TEST(Unescape(R"(A\u00E9\u20AC)") == "A\xC3\xA9\xE2\x82\xAC");
+	BOOST_TEST(Unescape(R"(x\u0000y)") == string("x\0y", 3));
+
+	// Escaped member names are found by their unescaped text
+	OJsonDocument document;
+	BOOST_REQUIRE(document.Parse(R"({"N\u0061me": "\uD83D\uDE00", "Next": 1})"));
+	BOOST_TEST(document.GetRoot().GetOr("Name", "") == "\xF0\x9F\x98\x80");
+	BOOST_TEST(document.GetRoot().GetOr("Next", 0) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(SurrogatesMustBePaired)
+{
+	BOOST_TEST(Unescape(R"(\uD800\uDC00)") == "\xF0\x90\x80\x80");
+	BOOST_TEST(Unescape(R"(\uDBFF\uDFFF)") == "\xF4\x8F\xBF\xBF");
+
+	BOOST_TEST(GetError(R"(["\uD83D"])").find("unpaired surrogate") != string::npos);
+	BOOST_TEST(GetError(R"(["\uD83Dx"])").find("unpaired surrogate") != string::npos);
+	BOOST_TEST(GetError(R"(["\uD83DA"])").find("unpaired surrogate") != string::npos);
+	BOOST_TEST(GetError(R"(["\uD83D\uD83D"])").find("unpaired surrogate") != string::npos);
+	BOOST_TEST(GetError(R"(["\uDE00"])").find("unpaired surrogate") != string::npos);
+	BOOST_TEST(GetError(R"(["\uD83D\u"])").find("truncated unicode escape") != string::npos);
+	BOOST_TEST(GetError(R"(["\u12G4"])").find("invalid unicode escape") != string::npos);
+	BOOST_TEST(GetError(R"(["\u12)").find("truncated unicode escape") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(MalformedDocumentsReportAnError)
+{
+	const vector<string> documents = {
+		"",
+		"   ",
+		"{",
+		"}",
+		R"({"a"})",
+		R"({"a":})",
+		R"({"a":1,})",
+		R"({a:1})",
+		"[1,]",
+		"[1 2]",
+		"tru",
+		"nul",
+		"-",
+		"1.",
+		"1e",
+		".5",
+		R"("abc)",
+		R"("a\x")",
+		"\"a\nb\"",
+		R"({"a":1} x)",
+		"[] []",
+	};
+	for (const auto& document : documents)
+	{
+		BOOST_TEST(!GetError(document).empty(), document);
+	}
+
+	BOOST_TEST(GetError("{\n  \"a\": ,\n}") == "line 2, column 8: unexpected character");
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedDocumentsReportAnError)
+{
+	for (size_t size = 0; size < Config.size(); size++)
+	{
+		BOOST_TEST(!GetError(Config.substr(0, size)).empty());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(NestingIsLimited)
+{
+	const auto nested = [](size_t Depth) { return string(Depth, '[') + string(Depth, ']'); };
+
+	OJsonDocument document;
+	BOOST_TEST(document.Parse(nested(257)));
+	BOOST_TEST(document.GetNumNodes() == 257);
+	BOOST_TEST(GetError(nested(258)).find("nesting is too deep") != string::npos);
+	BOOST_TEST(GetError(nested(100000)).find("nesting is too deep") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(NumbersKeepTheirText)
+{
+	OJsonDocument document;
+	BOOST_REQUIRE(document.Parse(Config));
+	const auto root = document.GetRoot();
+
+	BOOST_TEST(root.Find("Scale").GetType() == EJsonType::Number);
+	BOOST_TEST(root.Find("Scale").GetText() == "-12.5e+3");
+	BOOST_TEST(root.GetOr("Scale", 0.0) == -12500.0);
+	BOOST_TEST(!root.GetOptional<int32_t>("Scale").has_value());
+	BOOST_TEST(root.GetOr<uint64_t>("Count", 0) == UINT64_MAX);
+	BOOST_TEST(!root.GetOptional<uint32_t>("Count").has_value());
+	BOOST_TEST(!root.GetOptional<int32_t>("Name").has_value());
+	BOOST_TEST(root.GetOr("Enabled", false));
+
+	// Scalars convert on access, the way the property tree read them
+	BOOST_REQUIRE(document.Parse(R"({"Quoted": "1", "Bool": 0, "Plus": "+3"})"));
+	BOOST_TEST(document.GetRoot().GetOr("Quoted", 0) == 1);
+	BOOST_TEST(document.GetRoot().GetOr("Bool", true) == false);
+	BOOST_TEST(document.GetRoot().GetOr("Bool", "") == "0");
+	BOOST_TEST(document.GetRoot().GetOr("Plus", 0) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(NestedValuesAreSkippedAsSubtrees)
+{
+	OJsonDocument document;
+	BOOST_REQUIRE(document.Parse(Config));
+	const auto root = document.GetRoot();
+	BOOST_TEST(root.GetNumChildren() == 7);
+
+	vector<string> names;
+	for (const auto member : root)
+	{
+		names.emplace_back(member.GetName());
+	}
+	BOOST_TEST(names == vector<string>({ "Name", "Enabled", "Scale", "Count", "Empty", "Passes", "Tint" }), boost::test_tools::per_element());
+
+	const auto passes = root.Find("Passes");
+	BOOST_TEST(passes.GetType() == EJsonType::Array);
+	BOOST_TEST(passes.GetNumChildren() == 3);
+	const auto pass = *passes.begin();
+	BOOST_TEST(pass.GetOr("Shader", "") == "Water.hlsl");
+	BOOST_TEST(pass.Find("Defines").GetNumChildren() == 2);
+	BOOST_TEST(!pass.Find("Passes").IsValid());
+	BOOST_TEST(root.Find("Empty").GetType() == EJsonType::Object);
+	BOOST_TEST(root.Find("Empty").GetNumChildren() == 0);
+	BOOST_TEST((root.Find("Empty").begin() == root.Find("Empty").end()));
+
+	vector<float> tint;
+	for (const auto value : root.Find("Tint"))
+	{
+		tint.push_back(value.As<float>());
+	}
+	BOOST_TEST(tint == vector<float>({ 0.1f, 0.2f, 0.3f }), boost::test_tools::per_element());
+
+	// Missing members and scalars have no children and can be chained
+	BOOST_TEST(!root.Find("Missing").Find("Deeper").IsValid());
+	BOOST_TEST((root.Find("Name").begin() == root.Find("Name").end()));
+}
+
+BOOST_FIXTURE_TEST_CASE(SnapshotsLoadBack, SSnapshotFixture)
+{
+	OJsonDocument loaded;
+	BOOST_REQUIRE(loaded.LoadSnapshot(Path, Hash));
+	BOOST_TEST(loaded.GetNumNodes() == Document.GetNumNodes());
+	BOOST_TEST(Dump(loaded.GetRoot()) == Dump(Document.GetRoot()));
+	BOOST_TEST((*loaded.GetRoot().Find("Passes").begin()).GetOr("Shader", "") == "Water.hlsl");
+	BOOST_TEST(!std::filesystem::exists(Directory / "Config.snapshot.tmp"));
+}
+
+BOOST_FIXTURE_TEST_CASE(StaleSnapshotsAreRejected, SSnapshotFixture)
+{
+	OJsonDocument loaded;
+	BOOST_TEST(!loaded.LoadSnapshot(Path, Hash + 1));
+	BOOST_TEST(!loaded.LoadSnapshot(Directory / "Missing.snapshot", Hash));
+
+	// Any edit of the source changes the hash, including ones that keep the size
+	auto edited = Config;
+	edited[edited.find("Water")] = 'w';
+	BOOST_TEST(OJsonDocument::HashSource(edited) != Hash);
+	BOOST_TEST(OJsonDocument::HashSource(Config + " ") != Hash);
+	BOOST_TEST(OJsonDocument::HashSource(Config) == Hash);
+}
+
+BOOST_FIXTURE_TEST_CASE(TruncatedSnapshotsAreRejected, SSnapshotFixture)
+{
+	BOOST_REQUIRE(Load(Snapshot));
+	for (size_t size = 0; size < Snapshot.size(); size++)
+	{
+		BOOST_TEST(!Load(Snapshot.substr(0, size)));
+	}
+	BOOST_TEST(!Load(Snapshot + '\0'));
+}
+
+BOOST_FIXTURE_TEST_CASE(CorruptSnapshotsAreRejected, SSnapshotFixture)
+{
+	auto magic = Snapshot;
+	magic[0] ^= 1;
+	BOOST_TEST(!Load(magic));
+
+	auto version = Snapshot;
+	version[sizeof(uint32_t)] ^= 1;
+	BOOST_TEST(!Load(version));
+
+	BOOST_TEST(!Load(WithNode(0, [](SJsonNode& Node) { Node.End++; })));
+	BOOST_TEST(!Load(WithNode(1, [](SJsonNode& Node) { Node.End = 0; })));
+	BOOST_TEST(!Load(WithNode(1, [](SJsonNode& Node) { Node.TextOffset = UINT32_MAX; })));
+	BOOST_TEST(!Load(WithNode(1, [](SJsonNode& Node) { Node.NameLength = UINT32_MAX; })));
+	BOOST_TEST(!Load(WithNode(1, [](SJsonNode& Node) { Node.Type = static_cast<EJsonType>(6); })));
+	BOOST_TEST(!Load(WithNode(0, [](SJsonNode& Node) { Node.NumChildren++; })));
+
+	// A scalar claiming children would let iteration leave its parent
+	BOOST_TEST(!Load(WithNode(1, [](SJsonNode& Node) { Node.End = 3; })));
+
+	// Any flipped byte is either rejected or still loads into a document that can be walked safely
+	for (size_t i = 0; i < Snapshot.size(); i++)
+	{
+		auto data = Snapshot;
+		data[i] ^= 0xFF;
+		Load(data);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+#include "Engine/DescriptorHeap/DescriptorAllocator.h"
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(DescriptorAllocator)
+
+BOOST_AUTO_TEST_CASE(CountsAreRoundedToSizeClasses)
+{
+	BOOST_TEST(ODescriptorAllocator::GetSizeClass(1) == 0u);
+	BOOST_TEST(ODescriptorAllocator::GetSizeClass(2) == 1u);
+	BOOST_TEST(ODescriptorAllocator::GetSizeClass(3) == 2u);
+	BOOST_TEST(ODescriptorAllocator::GetSizeClass(8) == 3u);
+	BOOST_TEST(ODescriptorAllocator::GetSizeClass(9) == 4u);
+
+	ODescriptorAllocator allocator(64, 8, 3);
+	const auto range = allocator.Allocate(3);
+	BOOST_TEST(range.Index == 0u);
+	BOOST_TEST(range.Count == 3u);
+	BOOST_TEST(allocator.GetNumAllocated() == 4u);
+	BOOST_TEST(allocator.Allocate(1).Index == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(FreesAreDeferredUntilTheFenceCompleted)
+{
+	ODescriptorAllocator allocator(64, 0, 0);
+	const auto range = allocator.Allocate(3);
+	allocator.Allocate(1);
+
+	allocator.Free(range, 5);
+	allocator.ReleaseCompleted(4);
+	BOOST_TEST(allocator.GetNumPendingFrees() == 1u);
+
+	// The GPU may still read the freed block, a new one is taken from the top
+	BOOST_TEST(allocator.Allocate(4).Index == 5u);
+
+	allocator.ReleaseCompleted(5);
+	BOOST_TEST(allocator.GetNumPendingFrees() == 0u);
+	BOOST_TEST(allocator.Allocate(4).Index == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(LargerBlocksAreSplit)
+{
+	ODescriptorAllocator allocator(16, 0, 0);
+	const auto block = allocator.Allocate(16);
+	BOOST_TEST(block.Index == 0u);
+	BOOST_TEST(!allocator.Allocate(1).IsValid());
+
+	allocator.Free(block, 1);
+	allocator.ReleaseCompleted(1);
+	BOOST_TEST(allocator.Allocate(1).Index == 0u);
+	BOOST_TEST(allocator.Allocate(2).Index == 2u);
+	BOOST_TEST(allocator.Allocate(8).Index == 8u);
+	BOOST_TEST(allocator.Allocate(4).Index == 4u);
+	BOOST_TEST(allocator.Allocate(1).Index == 1u);
+	BOOST_TEST(!allocator.Allocate(1).IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(TransientRegionsWrapPerFrame)
+{
+	ODescriptorAllocator allocator(64, 8, 3);
+	BOOST_TEST(allocator.GetCapacity() == 64u + 3 * 8);
+	BOOST_TEST(allocator.GetPersistentCapacity() == 64u);
+
+	// Frame 1 owns [72, 80)
+	allocator.BeginFrame(1);
+	BOOST_TEST(allocator.AllocateTransient(5).Index == 72u);
+	BOOST_TEST(!allocator.AllocateTransient(4).IsValid());
+	BOOST_TEST(allocator.AllocateTransient(3).Index == 77u);
+
+	// Frame indices wrap around the frames in flight and start their region over
+	allocator.BeginFrame(4);
+	BOOST_TEST(allocator.AllocateTransient(8).Index == 72u);
+	allocator.BeginFrame(2);
+	BOOST_TEST(allocator.AllocateTransient(1).Index == 80u);
+
+	// Transient allocations never touch the persistent region
+	BOOST_TEST(allocator.GetNumAllocated() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(WithoutTransientRegionNothingIsHandedOut)
+{
+	ODescriptorAllocator allocator(16, 0, 0);
+	BOOST_TEST(!allocator.AllocateTransient(1).IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(LiveBlocksNeverOverlap)
+{
+	constexpr uint32_t capacity = 4096;
+	std::mt19937 random(3);
+	ODescriptorAllocator allocator(capacity, 0, 0);
+	std::vector<SDescriptorRange> live;
+	std::vector<SDescriptorRange> pending;
+	std::vector<bool> used(capacity, false);
+	uint64_t fence = 0;
+	size_t numAllocations = 0;
+
+	const auto mark = [&](const SDescriptorRange& Range, bool bUsed) {
+		const uint32_t blockSize = 1u << ODescriptorAllocator::GetSizeClass(Range.Count);
+		BOOST_REQUIRE(Range.Index + blockSize <= capacity);
+		// One check per block, asserting every descriptor makes the test take seconds
+		bool bIsConsistent = true;
+		for (uint32_t i = Range.Index; i < Range.Index + blockSize; i++)
+		{
+			bIsConsistent &= used[i] != bUsed;
+			used[i] = bUsed;
+		}
+		BOOST_REQUIRE(bIsConsistent);
+	};
+
+	for (int iteration = 0; iteration < 200000; iteration++)
+	{
+		if (random() % 2 || live.empty())
+		{
+			// Mostly small tables with the occasional large one
+			const uint32_t count = 1 + (random() % 2 ? random() % 4 : random() % 100);
+			const auto range = allocator.Allocate(count);
+			if (range.IsValid())
+			{
+				numAllocations++;
+				mark(range, true);
+				live.push_back(range);
+			}
+		}
+		else
+		{
+			const size_t index = random() % live.size();
+			allocator.Free(live[index], fence + 1);
+			pending.push_back(live[index]);
+			live[index] = live.back();
+			live.pop_back();
+		}
+
+		if (random() % 16 == 0)
+		{
+			allocator.ReleaseCompleted(++fence);
+			for (const auto& range : pending)
+			{
+				mark(range, false);
+			}
+			pending.clear();
+		}
+	}
+	BOOST_TEST(numAllocations > 50000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#include "Engine/UploadBuffer/RingAllocator.h"
+
+#include <boost/test/unit_test.hpp>
+#include <deque>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(RingAllocator)
+
+BOOST_AUTO_TEST_CASE(AllocationsAreAligned)
+{
+	ORingAllocator ring(4096);
+	BOOST_TEST(ring.Allocate(10, 1) == 0);
+	BOOST_TEST(ring.Allocate(16, 256) == 256);
+	BOOST_TEST(ring.Allocate(1, 16) == 272);
+
+	// Padding counts as used until the frame is released
+	BOOST_TEST(ring.GetUsedSize() == 273);
+}
+
+BOOST_AUTO_TEST_CASE(WrapsAroundOnceOlderFramesAreReleased)
+{
+	ORingAllocator ring(1024);
+	BOOST_TEST(ring.Allocate(600, 1) == 0);
+	ring.FinishFrame(1);
+	BOOST_TEST(ring.Allocate(300, 1) == 600);
+	ring.FinishFrame(2);
+
+	// 124 bytes left at the end and nothing free at the start
+	BOOST_TEST(ring.Allocate(200, 1) == ORingAllocator::InvalidOffset);
+	BOOST_TEST(ring.HasPendingFrames());
+	BOOST_TEST(ring.GetOldestPendingFence() == 1);
+
+	ring.ReleaseCompletedFrames(1);
+	BOOST_TEST(ring.GetOldestPendingFence() == 2);
+
+	// Skips [900, 1024) and restarts at zero, which satisfies any alignment
+	BOOST_TEST(ring.Allocate(200, 256) == 0);
+	BOOST_TEST(ring.Allocate(400, 1) == 200);
+
+	// The tail of frame 2 is at 600
+	BOOST_TEST(ring.Allocate(1, 1) == ORingAllocator::InvalidOffset);
+
+	ring.FinishFrame(3);
+	ring.ReleaseCompletedFrames(3);
+	BOOST_TEST(ring.GetUsedSize() == 0);
+	BOOST_TEST(!ring.HasPendingFrames());
+
+	// An empty ring starts over from the beginning and hands out the whole range
+	BOOST_TEST(ring.Allocate(1024, 1) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(AlignedAllocationMayNotFitAtTheEnd)
+{
+	ORingAllocator ring(1024);
+	BOOST_TEST(ring.Allocate(300, 1) == 0);
+	ring.FinishFrame(1);
+	BOOST_TEST(ring.Allocate(500, 1) == 300);
+	ring.FinishFrame(2);
+	ring.ReleaseCompletedFrames(1);
+
+	// 224 bytes are left at the end, aligning to 256 pushes the allocation past it so it wraps to zero
+	BOOST_TEST(ring.Allocate(100, 256) == 0);
+	BOOST_TEST(ring.Allocate(256, 256) == ORingAllocator::InvalidOffset);
+}
+
+BOOST_AUTO_TEST_CASE(EmptyFramesDontMoveTheTailBack)
+{
+	ORingAllocator ring(1024);
+	BOOST_TEST(ring.Allocate(500, 1) == 0);
+	ring.FinishFrame(1);
+	ring.FinishFrame(2);
+	ring.ReleaseCompletedFrames(1);
+
+	// Nothing is alive, the ring restarts at zero while the marker of the empty frame 2 still points to 500
+	BOOST_TEST(ring.Allocate(800, 1) == 0);
+	ring.ReleaseCompletedFrames(2);
+	BOOST_TEST(ring.GetUsedSize() == 800);
+	BOOST_TEST(ring.Allocate(300, 1) == ORingAllocator::InvalidOffset);
+}
+
+BOOST_AUTO_TEST_CASE(LiveAllocationsNeverOverlap)
+{
+	struct SLiveAllocation
+	{
+		uint64_t Offset;
+		uint64_t Size;
+		uint64_t Fence;
+	};
+
+	std::mt19937 random(7);
+	ORingAllocator ring(1 << 16);
+	std::deque<SLiveAllocation> live;
+	uint64_t fence = 0;
+	uint64_t completed = 0;
+	size_t numAllocations = 0;
+	for (int frame = 0; frame < 20000; frame++)
+	{
+		const uint32_t numFrameAllocations = random() % 8;
+		for (uint32_t i = 0; i < numFrameAllocations; i++)
+		{
+			const uint64_t size = 1 + random() % 4000;
+			const uint64_t alignment = uint64_t(1) << (random() % 9);
+			const uint64_t offset = ring.Allocate(size, alignment);
+			if (offset == ORingAllocator::InvalidOffset)
+			{
+				continue;
+			}
+
+			numAllocations++;
+			BOOST_REQUIRE(offset % alignment == 0);
+			BOOST_REQUIRE(offset + size <= ring.GetSize());
+			BOOST_REQUIRE(std::ranges::all_of(live, [&](const auto& Other) { return offset + size <= Other.Offset || Other.Offset + Other.Size <= offset; }));
+			live.push_back({ offset, size, fence + 1 });
+		}
+		ring.FinishFrame(++fence);
+
+		// The GPU completes up to two frames at a time and sometimes none
+		if (random() % 3)
+		{
+			completed = std::min(fence, completed + 1 + random() % 2);
+			ring.ReleaseCompletedFrames(completed);
+			while (!live.empty() && live.front().Fence <= completed)
+			{
+				live.pop_front();
+			}
+		}
+	}
+	BOOST_TEST(numAllocations > 10000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
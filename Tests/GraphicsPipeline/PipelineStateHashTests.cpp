@@ -0,0 +1,244 @@
+#include "DirectXUtils.h"
+#include "GraphicsPipeline/PipelineStateHash.h"
+#include "ShaderCompiler/RootSignatureCache.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+/**
+ * @brief Root signature with a descriptor table, a root CBV, root constants and a static sampler. Every instance keeps its
+ * parameters in its own arrays, and the bytes the parameter unions don't use are filled with Garbage.
+ */
+struct SRootSignature
+{
+	explicit SRootSignature(UINT TableRegister = 0, uint8_t Garbage = 0)
+	{
+		Ranges.push_back({ D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 4, TableRegister, 0, D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE | D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE, 0 });
+
+		Parameters.resize(3);
+		for (auto& parameter : Parameters)
+		{
+			std::memset(&parameter, Garbage, sizeof(parameter));
+		}
+		Parameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		Parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+		Parameters[0].DescriptorTable = { 1, Ranges.data() };
+		Parameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+		Parameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+		Parameters[1].Descriptor = { 0, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE };
+		Parameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		Parameters[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+		Parameters[2].Constants = { 1, 0, 4 };
+
+		D3D12_STATIC_SAMPLER_DESC sampler{};
+		sampler.Filter = D3D12_FILTER_ANISOTROPIC;
+		sampler.AddressU = sampler.AddressV = sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+		sampler.MaxAnisotropy = 8;
+		sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+		sampler.BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_WHITE;
+		sampler.MaxLOD = 1000.0f;
+		Samplers.push_back(sampler);
+	}
+
+	D3D12_VERSIONED_ROOT_SIGNATURE_DESC GetDesc() const
+	{
+		D3D12_VERSIONED_ROOT_SIGNATURE_DESC desc{};
+		desc.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+		desc.Desc_1_1 = { static_cast<UINT>(Parameters.size()), Parameters.data(), static_cast<UINT>(Samplers.size()), Samplers.data(), D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT };
+		return desc;
+	}
+
+	vector<D3D12_DESCRIPTOR_RANGE1> Ranges;
+	vector<D3D12_ROOT_PARAMETER1> Parameters;
+	vector<D3D12_STATIC_SAMPLER_DESC> Samplers;
+};
+
+/**
+ * @brief Graphics pipeline drawing positions into one target. The description is filled with Garbage first, as a stack
+ * variable that isn't zeroed would be, then every field the runtime reads is set.
+ */
+struct SPipeline
+{
+	explicit SPipeline(uint8_t Garbage = 0)
+	    : VertexShader(64, 7), PixelShader(32, 9), Semantic("POSITION")
+	{
+		std::memset(&Desc, Garbage, sizeof(Desc));
+		Element = { Semantic.c_str(), 0, 6, 0, 0, 0, 0 };
+
+		Desc.pRootSignature = nullptr;
+		Desc.VS = { VertexShader.data(), VertexShader.size() };
+		Desc.PS = { PixelShader.data(), PixelShader.size() };
+		Desc.DS = Desc.HS = Desc.GS = {};
+		Desc.StreamOutput = {};
+		Desc.BlendState = {};
+		Desc.SampleMask = ~0u;
+		Desc.RasterizerState = {};
+		Desc.DepthStencilState = {};
+		Desc.InputLayout = { &Element, 1 };
+		Desc.IBStripCutValue = 0;
+		Desc.PrimitiveTopologyType = 3;
+		Desc.NumRenderTargets = 1;
+		Desc.RTVFormats[0] = 28;
+		Desc.DSVFormat = 0;
+		Desc.SampleDesc = { 1, 0 };
+		Desc.NodeMask = 0;
+		Desc.Flags = 0;
+	}
+
+	SPipeline(const SPipeline&) = delete;
+
+	vector<uint8_t> VertexShader;
+	vector<uint8_t> PixelShader;
+	string Semantic;
+	D3D12_INPUT_ELEMENT_DESC Element;
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(PipelineStateHash)
+
+BOOST_AUTO_TEST_CASE(IdenticalLayoutsInSeparateArraysAreEqual)
+{
+	// Pointers to the ranges and the bytes the unions leave unused differ, the layouts don't
+	const SRootSignature lhs;
+	const SRootSignature rhs(0, 0xCD);
+	BOOST_TEST((lhs.GetDesc() == rhs.GetDesc()));
+	BOOST_TEST(HashRootSignature(lhs.GetDesc()) == HashRootSignature(rhs.GetDesc()));
+}
+
+BOOST_AUTO_TEST_CASE(EveryPartOfTheLayoutIsCompared)
+{
+	const SRootSignature base;
+
+	SRootSignature range(3);
+	SRootSignature sampler;
+	sampler.Samplers[0].MaxAnisotropy = 16;
+	SRootSignature visibility;
+	visibility.Parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	SRootSignature constants;
+	constants.Parameters[2].Constants.Num32BitValues = 8;
+	SRootSignature parameters;
+	parameters.Parameters.pop_back();
+
+	for (const auto* other : { &range, &sampler, &visibility, &constants, &parameters })
+	{
+		BOOST_TEST(!(base.GetDesc() == other->GetDesc()));
+		BOOST_TEST(HashRootSignature(base.GetDesc()) != HashRootSignature(other->GetDesc()));
+	}
+
+	auto flags = base.GetDesc();
+	flags.Desc_1_1.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+	BOOST_TEST(!(base.GetDesc() == flags));
+}
+
+BOOST_AUTO_TEST_CASE(Version10IsNormalized)
+{
+	// The same layout described as version 1.0 gets the volatile flags the runtime assumes for it
+	const SRootSignature base;
+	const D3D12_DESCRIPTOR_RANGE range = { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 4, 0, 0, 0 };
+	D3D12_ROOT_PARAMETER parameters[3] = {};
+	parameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	parameters[0].DescriptorTable = { 1, &range };
+	parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	parameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	parameters[1].Descriptor = { 0, 0 };
+	parameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	parameters[2].Constants = { 1, 0, 4 };
+
+	D3D12_VERSIONED_ROOT_SIGNATURE_DESC desc{};
+	desc.Version = D3D_ROOT_SIGNATURE_VERSION_1_0;
+	desc.Desc_1_0 = { 3, parameters, 1, base.Samplers.data(), D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT };
+	BOOST_TEST((desc == base.GetDesc()));
+	BOOST_TEST(HashRootSignature(desc) == HashRootSignature(base.GetDesc()));
+}
+
+BOOST_AUTO_TEST_CASE(LayoutOutlivesItsSource)
+{
+	SRootSignatureLayout layout;
+	{
+		const SRootSignature source;
+		layout = SRootSignatureLayout(source.GetDesc());
+	}
+
+	const SRootSignature base;
+	BOOST_TEST((layout == SRootSignatureLayout(base.GetDesc())));
+	BOOST_TEST(HashRootSignature(layout) == HashRootSignature(base.GetDesc()));
+	BOOST_TEST(layout.Parameters[0].DescriptorTable.pDescriptorRanges == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(RootSignaturesAreShared)
+{
+	ORootSignatureCache cache;
+	ID3D12Device device;
+	const SRootSignature base;
+	const SRootSignature same(0, 0xCD);
+	const SRootSignature other(3);
+
+	const auto first = cache.FindOrBuild(&device, base.GetDesc());
+	const auto second = cache.FindOrBuild(&device, same.GetDesc());
+	const auto third = cache.FindOrBuild(&device, other.GetDesc());
+	BOOST_TEST(first.RootSignature.Get() == second.RootSignature.Get());
+	BOOST_TEST(first.RootSignature.Get() != third.RootSignature.Get());
+	BOOST_TEST(first.Hash == second.Hash);
+	BOOST_TEST(first.Hash != third.Hash);
+	BOOST_TEST(cache.GetNumRootSignatures() == 2);
+	BOOST_TEST(cache.GetNumShared() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentRequestsBuildEachLayoutOnce)
+{
+	ORootSignatureCache cache;
+	ID3D12Device device;
+	vector<std::thread> threads;
+	for (int thread = 0; thread < 8; thread++)
+	{
+		threads.emplace_back([&cache, &device]() {
+			for (UINT i = 0; i < 100; i++)
+			{
+				const SRootSignature signature(i % 4);
+				cache.FindOrBuild(&device, signature.GetDesc());
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	BOOST_TEST(cache.GetNumRootSignatures() == 4);
+	BOOST_TEST(cache.GetNumShared() == 796);
+}
+
+BOOST_AUTO_TEST_CASE(PipelinesAreHashedByContent)
+{
+	// Byte code and semantic names are equal in content only, unused render target slots and the cached blob differ
+	const SPipeline lhs;
+	SPipeline rhs(0xAB);
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) == HashPipelineState(rhs.Desc, 1));
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) != HashPipelineState(lhs.Desc, 2));
+
+	rhs.VertexShader[10] = 8;
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) != HashPipelineState(rhs.Desc, 1));
+	rhs.VertexShader[10] = 7;
+
+	rhs.Semantic[0] = 'Q';
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) != HashPipelineState(rhs.Desc, 1));
+	rhs.Semantic[0] = 'P';
+
+	rhs.Desc.RasterizerState.CullMode = 3;
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) != HashPipelineState(rhs.Desc, 1));
+	rhs.Desc.RasterizerState.CullMode = 0;
+	BOOST_TEST(HashPipelineState(lhs.Desc, 1) == HashPipelineState(rhs.Desc, 1));
+}
+
+BOOST_AUTO_TEST_CASE(ComputeAndGraphicsPipelinesDiffer)
+{
+	const SPipeline graphics;
+	D3D12_COMPUTE_PIPELINE_STATE_DESC compute{};
+	compute.CS = graphics.Desc.VS;
+	BOOST_TEST(HashPipelineState(compute, 1) != HashPipelineState(graphics.Desc, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
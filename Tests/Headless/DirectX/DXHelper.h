@@ -0,0 +1,478 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Stand-in for DirectX/DXHelper.h in the test targets. Declares the D3D12 structs the pipeline state hashing and the root
+ * signature cache read and the values the PSO config tables decode, with the member names and order of d3d12.h. Enumerator values only matter for comparisons, the ones
+ * the tests use keep their SDK values.
+ */
+typedef int BOOL;
+typedef int INT;
+typedef uint8_t UINT8;
+typedef uint32_t UINT;
+typedef uint64_t UINT64;
+typedef float FLOAT;
+typedef const char* LPCSTR;
+
+enum D3D12_DESCRIPTOR_RANGE_TYPE
+{
+	D3D12_DESCRIPTOR_RANGE_TYPE_SRV = 0,
+	D3D12_DESCRIPTOR_RANGE_TYPE_UAV = 1,
+	D3D12_DESCRIPTOR_RANGE_TYPE_CBV = 2,
+	D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER = 3
+};
+
+enum D3D12_DESCRIPTOR_RANGE_FLAGS
+{
+	D3D12_DESCRIPTOR_RANGE_FLAG_NONE = 0,
+	D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE = 0x1,
+	D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE = 0x2
+};
+
+inline D3D12_DESCRIPTOR_RANGE_FLAGS operator|(D3D12_DESCRIPTOR_RANGE_FLAGS Lhs, D3D12_DESCRIPTOR_RANGE_FLAGS Rhs)
+{
+	return static_cast<D3D12_DESCRIPTOR_RANGE_FLAGS>(static_cast<int>(Lhs) | static_cast<int>(Rhs));
+}
+
+enum D3D12_ROOT_DESCRIPTOR_FLAGS
+{
+	D3D12_ROOT_DESCRIPTOR_FLAG_NONE = 0,
+	D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE = 0x2
+};
+
+enum D3D12_ROOT_PARAMETER_TYPE
+{
+	D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE = 0,
+	D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS = 1,
+	D3D12_ROOT_PARAMETER_TYPE_CBV = 2,
+	D3D12_ROOT_PARAMETER_TYPE_SRV = 3,
+	D3D12_ROOT_PARAMETER_TYPE_UAV = 4
+};
+
+enum D3D12_SHADER_VISIBILITY
+{
+	D3D12_SHADER_VISIBILITY_ALL = 0,
+	D3D12_SHADER_VISIBILITY_VERTEX = 1,
+	D3D12_SHADER_VISIBILITY_PIXEL = 5
+};
+
+enum D3D12_ROOT_SIGNATURE_FLAGS
+{
+	D3D12_ROOT_SIGNATURE_FLAG_NONE = 0,
+	D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT = 0x1
+};
+
+enum D3D_ROOT_SIGNATURE_VERSION
+{
+	D3D_ROOT_SIGNATURE_VERSION_1 = 0x1,
+	D3D_ROOT_SIGNATURE_VERSION_1_0 = 0x1,
+	D3D_ROOT_SIGNATURE_VERSION_1_1 = 0x2
+};
+
+enum D3D12_FILTER
+{
+	D3D12_FILTER_MIN_MAG_MIP_POINT = 0,
+	D3D12_FILTER_ANISOTROPIC = 0x55
+};
+
+enum D3D12_TEXTURE_ADDRESS_MODE
+{
+	D3D12_TEXTURE_ADDRESS_MODE_WRAP = 1,
+	D3D12_TEXTURE_ADDRESS_MODE_CLAMP = 3
+};
+
+enum D3D12_COMPARISON_FUNC
+{
+	D3D12_COMPARISON_FUNC_NEVER = 1,
+	D3D12_COMPARISON_FUNC_LESS = 2,
+	D3D12_COMPARISON_FUNC_EQUAL = 3,
+	D3D12_COMPARISON_FUNC_LESS_EQUAL = 4,
+	D3D12_COMPARISON_FUNC_GREATER = 5,
+	D3D12_COMPARISON_FUNC_NOT_EQUAL = 6,
+	D3D12_COMPARISON_FUNC_GREATER_EQUAL = 7,
+	D3D12_COMPARISON_FUNC_ALWAYS = 8
+};
+
+enum D3D12_STATIC_BORDER_COLOR
+{
+	D3D12_STATIC_BORDER_COLOR_OPAQUE_WHITE = 2
+};
+
+struct D3D12_DESCRIPTOR_RANGE
+{
+	D3D12_DESCRIPTOR_RANGE_TYPE RangeType;
+	UINT NumDescriptors;
+	UINT BaseShaderRegister;
+	UINT RegisterSpace;
+	UINT OffsetInDescriptorsFromTableStart;
+};
+
+struct D3D12_DESCRIPTOR_RANGE1
+{
+	D3D12_DESCRIPTOR_RANGE_TYPE RangeType;
+	UINT NumDescriptors;
+	UINT BaseShaderRegister;
+	UINT RegisterSpace;
+	D3D12_DESCRIPTOR_RANGE_FLAGS Flags;
+	UINT OffsetInDescriptorsFromTableStart;
+};
+
+struct D3D12_ROOT_DESCRIPTOR_TABLE
+{
+	UINT NumDescriptorRanges;
+	const D3D12_DESCRIPTOR_RANGE* pDescriptorRanges;
+};
+
+struct D3D12_ROOT_DESCRIPTOR_TABLE1
+{
+	UINT NumDescriptorRanges;
+	const D3D12_DESCRIPTOR_RANGE1* pDescriptorRanges;
+};
+
+struct D3D12_ROOT_CONSTANTS
+{
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+	UINT Num32BitValues;
+};
+
+struct D3D12_ROOT_DESCRIPTOR
+{
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+};
+
+struct D3D12_ROOT_DESCRIPTOR1
+{
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+	D3D12_ROOT_DESCRIPTOR_FLAGS Flags;
+};
+
+struct D3D12_ROOT_PARAMETER
+{
+	D3D12_ROOT_PARAMETER_TYPE ParameterType;
+	union
+	{
+		D3D12_ROOT_DESCRIPTOR_TABLE DescriptorTable;
+		D3D12_ROOT_CONSTANTS Constants;
+		D3D12_ROOT_DESCRIPTOR Descriptor;
+	};
+	D3D12_SHADER_VISIBILITY ShaderVisibility;
+};
+
+struct D3D12_ROOT_PARAMETER1
+{
+	D3D12_ROOT_PARAMETER_TYPE ParameterType;
+	union
+	{
+		D3D12_ROOT_DESCRIPTOR_TABLE1 DescriptorTable;
+		D3D12_ROOT_CONSTANTS Constants;
+		D3D12_ROOT_DESCRIPTOR1 Descriptor;
+	};
+	D3D12_SHADER_VISIBILITY ShaderVisibility;
+};
+
+struct D3D12_STATIC_SAMPLER_DESC
+{
+	D3D12_FILTER Filter;
+	D3D12_TEXTURE_ADDRESS_MODE AddressU;
+	D3D12_TEXTURE_ADDRESS_MODE AddressV;
+	D3D12_TEXTURE_ADDRESS_MODE AddressW;
+	FLOAT MipLODBias;
+	UINT MaxAnisotropy;
+	D3D12_COMPARISON_FUNC ComparisonFunc;
+	D3D12_STATIC_BORDER_COLOR BorderColor;
+	FLOAT MinLOD;
+	FLOAT MaxLOD;
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+	D3D12_SHADER_VISIBILITY ShaderVisibility;
+};
+
+struct D3D12_ROOT_SIGNATURE_DESC
+{
+	UINT NumParameters;
+	const D3D12_ROOT_PARAMETER* pParameters;
+	UINT NumStaticSamplers;
+	const D3D12_STATIC_SAMPLER_DESC* pStaticSamplers;
+	D3D12_ROOT_SIGNATURE_FLAGS Flags;
+};
+
+struct D3D12_ROOT_SIGNATURE_DESC1
+{
+	UINT NumParameters;
+	const D3D12_ROOT_PARAMETER1* pParameters;
+	UINT NumStaticSamplers;
+	const D3D12_STATIC_SAMPLER_DESC* pStaticSamplers;
+	D3D12_ROOT_SIGNATURE_FLAGS Flags;
+};
+
+struct D3D12_VERSIONED_ROOT_SIGNATURE_DESC
+{
+	D3D_ROOT_SIGNATURE_VERSION Version;
+	union
+	{
+		D3D12_ROOT_SIGNATURE_DESC Desc_1_0;
+		D3D12_ROOT_SIGNATURE_DESC1 Desc_1_1;
+	};
+};
+
+// Pipeline state enums are only hashed and decoded by name, plain integers are enough
+typedef int D3D12_BLEND;
+typedef int D3D12_BLEND_OP;
+typedef int D3D12_LOGIC_OP;
+typedef int D3D12_FILL_MODE;
+typedef int D3D12_CULL_MODE;
+typedef int D3D12_CONSERVATIVE_RASTERIZATION_MODE;
+typedef int D3D12_DEPTH_WRITE_MASK;
+typedef int D3D12_STENCIL_OP;
+typedef int D3D12_INPUT_CLASSIFICATION;
+typedef int D3D12_INDEX_BUFFER_STRIP_CUT_VALUE;
+typedef int D3D12_PRIMITIVE_TOPOLOGY_TYPE;
+typedef int D3D12_PIPELINE_STATE_FLAGS;
+typedef int DXGI_FORMAT;
+typedef int D3D12_COLOR_WRITE_ENABLE;
+
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_CLEAR = 0;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_SET = 1;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_COPY = 2;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_COPY_INVERTED = 3;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_NOOP = 4;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_INVERT = 5;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_AND = 6;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_NAND = 7;
+constexpr D3D12_LOGIC_OP D3D12_LOGIC_OP_OR = 8;
+
+constexpr D3D12_BLEND_OP D3D12_BLEND_OP_ADD = 1;
+constexpr D3D12_BLEND_OP D3D12_BLEND_OP_SUBTRACT = 2;
+constexpr D3D12_BLEND_OP D3D12_BLEND_OP_REV_SUBTRACT = 3;
+constexpr D3D12_BLEND_OP D3D12_BLEND_OP_MIN = 4;
+constexpr D3D12_BLEND_OP D3D12_BLEND_OP_MAX = 5;
+
+constexpr D3D12_BLEND D3D12_BLEND_ZERO = 1;
+constexpr D3D12_BLEND D3D12_BLEND_ONE = 2;
+constexpr D3D12_BLEND D3D12_BLEND_SRC_COLOR = 3;
+constexpr D3D12_BLEND D3D12_BLEND_INV_SRC_COLOR = 4;
+constexpr D3D12_BLEND D3D12_BLEND_SRC_ALPHA = 5;
+constexpr D3D12_BLEND D3D12_BLEND_INV_SRC_ALPHA = 6;
+constexpr D3D12_BLEND D3D12_BLEND_DEST_ALPHA = 7;
+constexpr D3D12_BLEND D3D12_BLEND_INV_DEST_ALPHA = 8;
+constexpr D3D12_BLEND D3D12_BLEND_DEST_COLOR = 9;
+constexpr D3D12_BLEND D3D12_BLEND_INV_DEST_COLOR = 10;
+constexpr D3D12_BLEND D3D12_BLEND_SRC_ALPHA_SAT = 11;
+
+constexpr D3D12_CULL_MODE D3D12_CULL_MODE_NONE = 1;
+constexpr D3D12_CULL_MODE D3D12_CULL_MODE_FRONT = 2;
+constexpr D3D12_CULL_MODE D3D12_CULL_MODE_BACK = 3;
+
+constexpr D3D12_CONSERVATIVE_RASTERIZATION_MODE D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF = 0;
+constexpr D3D12_CONSERVATIVE_RASTERIZATION_MODE D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON = 1;
+
+constexpr D3D12_FILL_MODE D3D12_FILL_MODE_WIREFRAME = 2;
+constexpr D3D12_FILL_MODE D3D12_FILL_MODE_SOLID = 3;
+
+constexpr D3D12_DEPTH_WRITE_MASK D3D12_DEPTH_WRITE_MASK_ZERO = 0;
+constexpr D3D12_DEPTH_WRITE_MASK D3D12_DEPTH_WRITE_MASK_ALL = 1;
+
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_KEEP = 1;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_ZERO = 2;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_REPLACE = 3;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_INCR_SAT = 4;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_DECR_SAT = 5;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_INVERT = 6;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_INCR = 7;
+constexpr D3D12_STENCIL_OP D3D12_STENCIL_OP_DECR = 8;
+
+constexpr D3D12_COLOR_WRITE_ENABLE D3D12_COLOR_WRITE_ENABLE_RED = 1;
+constexpr D3D12_COLOR_WRITE_ENABLE D3D12_COLOR_WRITE_ENABLE_GREEN = 2;
+constexpr D3D12_COLOR_WRITE_ENABLE D3D12_COLOR_WRITE_ENABLE_BLUE = 4;
+constexpr D3D12_COLOR_WRITE_ENABLE D3D12_COLOR_WRITE_ENABLE_ALPHA = 8;
+constexpr D3D12_COLOR_WRITE_ENABLE D3D12_COLOR_WRITE_ENABLE_ALL = 15;
+
+constexpr D3D12_PRIMITIVE_TOPOLOGY_TYPE D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT = 1;
+constexpr D3D12_PRIMITIVE_TOPOLOGY_TYPE D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE = 2;
+constexpr D3D12_PRIMITIVE_TOPOLOGY_TYPE D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE = 3;
+constexpr D3D12_PRIMITIVE_TOPOLOGY_TYPE D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH = 4;
+
+constexpr DXGI_FORMAT DXGI_FORMAT_R32G32B32A32_FLOAT = 2;
+constexpr DXGI_FORMAT DXGI_FORMAT_R16G16B16A16_FLOAT = 10;
+constexpr DXGI_FORMAT DXGI_FORMAT_R16G16B16A16_UNORM = 11;
+constexpr DXGI_FORMAT DXGI_FORMAT_R16G16B16A16_UINT = 12;
+constexpr DXGI_FORMAT DXGI_FORMAT_R8G8B8A8_UNORM = 28;
+constexpr DXGI_FORMAT DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29;
+constexpr DXGI_FORMAT DXGI_FORMAT_D24_UNORM_S8_UINT = 45;
+
+constexpr D3D12_PIPELINE_STATE_FLAGS D3D12_PIPELINE_STATE_FLAG_NONE = 0;
+constexpr D3D12_PIPELINE_STATE_FLAGS D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG = 1;
+
+constexpr UINT D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT = 8;
+
+struct D3D12_SHADER_BYTECODE
+{
+	const void* pShaderBytecode;
+	size_t BytecodeLength;
+};
+
+struct D3D12_SO_DECLARATION_ENTRY
+{
+	UINT Stream;
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	UINT8 StartComponent;
+	UINT8 ComponentCount;
+	UINT8 OutputSlot;
+};
+
+struct D3D12_STREAM_OUTPUT_DESC
+{
+	const D3D12_SO_DECLARATION_ENTRY* pSODeclaration;
+	UINT NumEntries;
+	const UINT* pBufferStrides;
+	UINT NumStrides;
+	UINT RasterizedStream;
+};
+
+struct D3D12_RENDER_TARGET_BLEND_DESC
+{
+	BOOL BlendEnable;
+	BOOL LogicOpEnable;
+	D3D12_BLEND SrcBlend;
+	D3D12_BLEND DestBlend;
+	D3D12_BLEND_OP BlendOp;
+	D3D12_BLEND SrcBlendAlpha;
+	D3D12_BLEND DestBlendAlpha;
+	D3D12_BLEND_OP BlendOpAlpha;
+	D3D12_LOGIC_OP LogicOp;
+	UINT8 RenderTargetWriteMask;
+};
+
+struct D3D12_BLEND_DESC
+{
+	BOOL AlphaToCoverageEnable;
+	BOOL IndependentBlendEnable;
+	D3D12_RENDER_TARGET_BLEND_DESC RenderTarget[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT];
+};
+
+struct D3D12_RASTERIZER_DESC
+{
+	D3D12_FILL_MODE FillMode;
+	D3D12_CULL_MODE CullMode;
+	BOOL FrontCounterClockwise;
+	INT DepthBias;
+	FLOAT DepthBiasClamp;
+	FLOAT SlopeScaledDepthBias;
+	BOOL DepthClipEnable;
+	BOOL MultisampleEnable;
+	BOOL AntialiasedLineEnable;
+	UINT ForcedSampleCount;
+	D3D12_CONSERVATIVE_RASTERIZATION_MODE ConservativeRaster;
+};
+
+struct D3D12_DEPTH_STENCILOP_DESC
+{
+	D3D12_STENCIL_OP StencilFailOp;
+	D3D12_STENCIL_OP StencilDepthFailOp;
+	D3D12_STENCIL_OP StencilPassOp;
+	D3D12_COMPARISON_FUNC StencilFunc;
+};
+
+struct D3D12_DEPTH_STENCIL_DESC
+{
+	BOOL DepthEnable;
+	D3D12_DEPTH_WRITE_MASK DepthWriteMask;
+	D3D12_COMPARISON_FUNC DepthFunc;
+	BOOL StencilEnable;
+	UINT8 StencilReadMask;
+	UINT8 StencilWriteMask;
+	D3D12_DEPTH_STENCILOP_DESC FrontFace;
+	D3D12_DEPTH_STENCILOP_DESC BackFace;
+};
+
+struct D3D12_INPUT_ELEMENT_DESC
+{
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	DXGI_FORMAT Format;
+	UINT InputSlot;
+	UINT AlignedByteOffset;
+	D3D12_INPUT_CLASSIFICATION InputSlotClass;
+	UINT InstanceDataStepRate;
+};
+
+struct D3D12_INPUT_LAYOUT_DESC
+{
+	const D3D12_INPUT_ELEMENT_DESC* pInputElementDescs;
+	UINT NumElements;
+};
+
+struct DXGI_SAMPLE_DESC
+{
+	UINT Count;
+	UINT Quality;
+};
+
+struct D3D12_CACHED_PIPELINE_STATE
+{
+	const void* pCachedBlob;
+	size_t CachedBlobSizeInBytes;
+};
+
+struct ID3D12RootSignature
+{
+	int Id = 0;
+};
+
+struct ID3D12Device
+{
+};
+
+struct D3D12_GRAPHICS_PIPELINE_STATE_DESC
+{
+	ID3D12RootSignature* pRootSignature;
+	D3D12_SHADER_BYTECODE VS;
+	D3D12_SHADER_BYTECODE PS;
+	D3D12_SHADER_BYTECODE DS;
+	D3D12_SHADER_BYTECODE HS;
+	D3D12_SHADER_BYTECODE GS;
+	D3D12_STREAM_OUTPUT_DESC StreamOutput;
+	D3D12_BLEND_DESC BlendState;
+	UINT SampleMask;
+	D3D12_RASTERIZER_DESC RasterizerState;
+	D3D12_DEPTH_STENCIL_DESC DepthStencilState;
+	D3D12_INPUT_LAYOUT_DESC InputLayout;
+	D3D12_INDEX_BUFFER_STRIP_CUT_VALUE IBStripCutValue;
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimitiveTopologyType;
+	UINT NumRenderTargets;
+	DXGI_FORMAT RTVFormats[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT];
+	DXGI_FORMAT DSVFormat;
+	DXGI_SAMPLE_DESC SampleDesc;
+	UINT NodeMask;
+	D3D12_CACHED_PIPELINE_STATE CachedPSO;
+	D3D12_PIPELINE_STATE_FLAGS Flags;
+};
+
+struct D3D12_COMPUTE_PIPELINE_STATE_DESC
+{
+	ID3D12RootSignature* pRootSignature;
+	D3D12_SHADER_BYTECODE CS;
+	UINT NodeMask;
+	D3D12_CACHED_PIPELINE_STATE CachedPSO;
+	D3D12_PIPELINE_STATE_FLAGS Flags;
+};
+
+// Shared ownership is enough to check which objects the cache hands out
+template<typename T>
+class ComPtr
+{
+public:
+	T* Get() const
+	{
+		return Pointer.get();
+	}
+
+	std::shared_ptr<T> Pointer;
+};
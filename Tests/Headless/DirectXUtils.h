@@ -0,0 +1,19 @@
+#pragma once
+
+#include "DirectX/DXHelper.h"
+
+#include <atomic>
+
+/**
+ * @brief Stand-in for Utils/DirectXUtils.h in the test targets. Root signatures are numbered instead of created on a device,
+ * NumBuiltRootSignatures counts how often the cache asked for one.
+ */
+namespace Utils
+{
+inline std::atomic<int> NumBuiltRootSignatures = 0;
+
+inline void BuildRootSignature(ID3D12Device* /*Device*/, ComPtr<ID3D12RootSignature>& RootSignature, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& /*Desc*/)
+{
+	RootSignature.Pointer = std::make_shared<ID3D12RootSignature>(ID3D12RootSignature{ ++NumBuiltRootSignatures });
+}
+} // namespace Utils
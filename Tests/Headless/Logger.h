@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief Stand-in for Types/Logger.h in the test targets. The engine logger pulls in the D3D12 headers and breaks into the
+ * debugger on errors, tests only count the messages so they can check that a failure was reported.
+ */
+struct STestLog
+{
+	inline static int NumWarnings = 0;
+	inline static int NumErrors = 0;
+
+	// Benchmarks log thousands of saves, only the counts are kept then
+	inline static bool bIsQuiet = false;
+
+	static void Reset()
+	{
+		NumWarnings = 0;
+		NumErrors = 0;
+	}
+
+	// Arguments are only taken so that the values logged by the engine count as used
+	template<typename... TArgs>
+	static void Log(const char* Type, const char* Message, const TArgs&...)
+	{
+		const std::string type = Type;
+		NumWarnings += type == "Warning";
+		NumErrors += type == "Error" || type == "Critical";
+		if (!bIsQuiet)
+		{
+			std::printf("%s: %s\n", Type, Message);
+		}
+	}
+};
+
+#if defined(TEXT)
+#undef TEXT
+#endif
+
+// Only the format string is printed, the arguments are ignored
+#define LOG(Category, LogType, String, ...) STestLog::Log(#LogType, String __VA_OPT__(, ) __VA_ARGS__);
+#define WIN_LOG(Category, LogType, String, ...) STestLog::Log(#LogType, String __VA_OPT__(, ) __VA_ARGS__);
+#define CWIN_LOG(Condition, Category, LogType, String, ...)         \
+	if (Condition)                                                  \
+	{                                                               \
+		STestLog::Log(#LogType, String __VA_OPT__(, ) __VA_ARGS__); \
+	}
+#define TEXT(Argument) Argument
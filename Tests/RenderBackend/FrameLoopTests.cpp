@@ -0,0 +1,178 @@
+#include "RenderBackend/FrameLoop.h"
+#include "RenderBackend/NullRenderDevice.h"
+#include "RenderGraphReader/RenderGraphReader.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+SNodeInfo MakeNode(const string& Name, const vector<string>& Reads, const vector<string>& Writes, const unordered_map<string, string>& States = {}, bool bIsOutput = false)
+{
+	SNodeInfo node;
+	node.Name = Name;
+	node.PSOType = Name;
+	node.Reads = Reads;
+	node.Writes = Writes;
+	node.States = States;
+	node.bIsOutput = bIsOutput;
+	return node;
+}
+
+vector<SNodeInfo> LoadShippedGraph()
+{
+	ORenderGraphReader reader(RENDERER_SOURCE_DIR "/Resources/Config/RenderGraphConfig.json");
+	return reader.LoadRenderGraph();
+}
+
+struct SFrameLoopFixture
+{
+	SFrameLoopFixture()
+	{
+		STestLog::Reset();
+	}
+
+	uint64_t Count(ECommandType Type) const
+	{
+		return Device.GetCommandLog().Get(Type);
+	}
+
+	ONullRenderDevice Device;
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FrameLoop, SFrameLoopFixture)
+
+BOOST_AUTO_TEST_CASE(ShippedGraphRunsWithoutValidationErrors)
+{
+	SFrameLoopDesc desc;
+	desc.NumDrawsPerNode = 4;
+	OFrameLoop loop(&Device, desc);
+	const auto nodes = LoadShippedGraph();
+	BOOST_REQUIRE(loop.Initialize(nodes));
+
+	constexpr uint64_t numFrames = 10;
+	for (uint64_t frame = 0; frame < numFrames; frame++)
+	{
+		loop.DrawFrame();
+	}
+	BOOST_TEST(loop.GetNumFrames() == numFrames);
+	BOOST_TEST(Device.GetCommandLog().GetValidationErrors() == 0);
+	BOOST_TEST(STestLog::NumWarnings == 0);
+	BOOST_TEST(STestLog::NumErrors == 0);
+
+	// One submission, presentation and fence per frame, the plan's batches become one barrier call each
+	const auto& graph = loop.GetCompiledGraph();
+	BOOST_TEST(Count(ECommandType::ExecuteCommandList) == numFrames);
+	BOOST_TEST(Count(ECommandType::Present) == numFrames);
+	BOOST_TEST(Count(ECommandType::Signal) == numFrames);
+	BOOST_TEST(Count(ECommandType::ResourceBarrier) == numFrames * loop.GetBarrierPlan().NumBatches);
+	BOOST_TEST(Count(ECommandType::SetResource) == numFrames * (graph.Order.size() - 1));
+
+	uint64_t numDrawingNodes = 0;
+	for (const auto index : graph.Order)
+	{
+		const auto& node = nodes[index];
+		numDrawingNodes += std::ranges::any_of(node.Writes, [&](const string& Resource) {
+			const uint32_t access = OBarrierPlanner::GetAccess(node, Resource, true);
+			return access == SResourceAccess::RenderTarget || access == SResourceAccess::DepthWrite;
+		});
+	}
+	BOOST_TEST(numDrawingNodes > 0);
+	BOOST_TEST(Count(ECommandType::Draw) == numFrames * numDrawingNodes * desc.NumDrawsPerNode);
+	BOOST_TEST(Count(ECommandType::Dispatch) == numFrames * 2);
+
+	// Every back buffer has been presented and is ready for the next frame
+	const auto* swapChain = loop.GetSwapChain();
+	BOOST_TEST(swapChain->GetCurrentBackBufferIndex() == numFrames % desc.NumBackBuffers);
+	for (uint32_t i = 0; i < swapChain->GetNumBackBuffers(); i++)
+	{
+		BOOST_TEST(Device.GetResourceState(swapChain->GetBackBuffer(i)) == SResourceAccess::Present);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(PassConstantsAreUploadedEveryFrame)
+{
+	const auto nodes = LoadShippedGraph();
+
+	// Room for exactly one frame, every frame reuses the memory the previous one released
+	const size_t numPasses = ORenderGraphCompiler::Compile(nodes).Order.size() - 1;
+	SFrameLoopDesc desc;
+	desc.UploadRingSize = numPasses * OFrameLoop::ConstantBufferAlignment;
+	OFrameLoop loop(&Device, desc);
+	BOOST_REQUIRE(loop.Initialize(nodes));
+	for (uint32_t frame = 0; frame < 8; frame++)
+	{
+		loop.DrawFrame();
+	}
+	BOOST_TEST(Device.GetCommandLog().GetValidationErrors() == 0);
+
+	// A stall would be logged as a warning
+	BOOST_TEST(STestLog::NumWarnings == 0);
+
+	// A ring too small for one frame reports the passes left without constants instead of writing past its end
+	ONullRenderDevice device;
+	desc.UploadRingSize -= OFrameLoop::ConstantBufferAlignment;
+	OFrameLoop small(&device, desc);
+	BOOST_REQUIRE(small.Initialize(nodes));
+	STestLog::bIsQuiet = true;
+	small.DrawFrame();
+	STestLog::bIsQuiet = false;
+	BOOST_TEST(device.GetCommandLog().GetValidationErrors() == 1);
+	BOOST_TEST(STestLog::NumErrors == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ComputeOnlyNodesDispatch)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Simulate", {}, { "Particles" }, { { "Particles", "UnorderedAccess" } }),
+		MakeNode("Draw", { "Particles" }, { "BackBuffer" }),
+		MakeNode("Present", { "BackBuffer" }, {}, { { "BackBuffer", "Present" } }, true),
+	};
+
+	SFrameLoopDesc desc;
+	desc.NumBackBuffers = 2;
+	OFrameLoop loop(&Device, desc);
+	BOOST_REQUIRE(loop.Initialize(nodes));
+	loop.DrawFrame();
+	loop.DrawFrame();
+	BOOST_TEST(Device.GetCommandLog().GetValidationErrors() == 0);
+	BOOST_TEST(Count(ECommandType::Dispatch) == 2);
+	BOOST_TEST(Count(ECommandType::Draw) == 2);
+	BOOST_TEST(Count(ECommandType::SetPipelineState) == 4);
+
+	// Particles go back to unordered access at the end of the frame, the back buffer to present
+	BOOST_TEST(Count(ECommandType::ResourceBarrier) == 2 * loop.GetBarrierPlan().NumBatches);
+	BOOST_TEST(loop.GetBarrierPlan().NumBarriers == 4);
+}
+
+BOOST_AUTO_TEST_CASE(GraphsItCantPresentAreRejected)
+{
+	STestLog::bIsQuiet = true;
+	OFrameLoop cyclic(&Device, {});
+	BOOST_TEST(!cyclic.Initialize({
+	    MakeNode("A", { "Y" }, { "X" }),
+	    MakeNode("B", { "X" }, { "Y" }),
+	    MakeNode("Present", { "Y" }, {}, {}, true),
+	}));
+
+	OFrameLoop withoutOutput(&Device, {});
+	BOOST_TEST(!withoutOutput.Initialize({ MakeNode("A", {}, { "BackBuffer" }) }));
+
+	OFrameLoop twoOutputs(&Device, {});
+	BOOST_TEST(!twoOutputs.Initialize({
+	    MakeNode("A", {}, { "BackBuffer" }),
+	    MakeNode("Present", { "BackBuffer" }, {}, {}, true),
+	    MakeNode("Capture", { "BackBuffer" }, {}, {}, true),
+	}));
+
+	SFrameLoopDesc desc;
+	desc.NumBackBuffers = 0;
+	OFrameLoop withoutBackBuffers(&Device, desc);
+	BOOST_TEST(!withoutBackBuffers.Initialize({ MakeNode("Present", {}, { "BackBuffer" }, {}, true) }));
+	STestLog::bIsQuiet = false;
+
+	BOOST_TEST(STestLog::NumErrors >= 4);
+	BOOST_TEST(Device.GetCommandLog().GetTotal() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,239 @@
+#include "Logger.h"
+#include "RenderBackend/NullRenderDevice.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+namespace
+{
+/**
+ * @brief Fresh device with a render target, a depth buffer, a texture and a PSO, and one recorder into it.
+ */
+struct SDeviceFixture
+{
+	SDeviceFixture()
+	{
+		STestLog::Reset();
+		STestLog::bIsQuiet = true;
+		Recorder = Device.CreateCommandRecorder();
+	}
+
+	~SDeviceFixture()
+	{
+		STestLog::bIsQuiet = false;
+	}
+
+	uint64_t Count(ECommandType Type) const
+	{
+		return Device.GetCommandLog().Get(Type);
+	}
+
+	uint64_t NumErrors() const
+	{
+		return Device.GetCommandLog().GetValidationErrors();
+	}
+
+	void Transition(TRenderHandle Resource, uint32_t Before, uint32_t After, EBarrierSplit Split = EBarrierSplit::Full)
+	{
+		const SResourceBarrierDesc barrier = { .Resource = Resource, .Before = Before, .After = After, .Split = Split };
+		Recorder->ResourceBarriers({ &barrier, 1 });
+	}
+
+	ONullRenderDevice Device;
+	const TRenderHandle SceneColor = Device.CreateResource("SceneColor", SResourceAccess::RenderTarget);
+	const TRenderHandle SceneDepth = Device.CreateResource("SceneDepth", SResourceAccess::DepthWrite);
+	const TRenderHandle Texture = Device.CreateResource("Texture", SResourceAccess::ShaderResource);
+	const TRenderHandle PSO = Device.CreatePipelineState("Opaque");
+	unique_ptr<ICommandRecorder> Recorder;
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(NullRenderDevice, SDeviceFixture)
+
+BOOST_AUTO_TEST_CASE(UploadBuffersAreCPUMemory)
+{
+	const auto first = Device.CreateUploadBuffer(1024);
+	const auto second = Device.CreateUploadBuffer(16);
+	BOOST_REQUIRE(first.MappedData != nullptr);
+	BOOST_REQUIRE(second.MappedData != nullptr);
+	BOOST_TEST(first.Size == 1024);
+	BOOST_TEST(Device.IsValid(first.Handle, ENullObjectType::UploadBuffer));
+	BOOST_TEST(!Device.IsValid(first.Handle, ENullObjectType::Resource));
+
+	// Addresses don't overlap, whatever is written reads back
+	BOOST_TEST(first.GPUAddress != 0);
+	BOOST_TEST(second.GPUAddress >= first.GPUAddress + first.Size);
+	const uint64_t value = 0x1234'5678'9ABC'DEF0;
+	memcpy(first.MappedData + 1016, &value, sizeof(value));
+	uint64_t read = 0;
+	memcpy(&read, first.MappedData + 1016, sizeof(read));
+	BOOST_TEST(read == value);
+
+	// Creating more objects doesn't move the memory handed out before
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		Device.CreateResource("Resource" + std::to_string(i), SResourceAccess::Common);
+	}
+	memcpy(&read, first.MappedData + 1016, sizeof(read));
+	BOOST_TEST(read == value);
+}
+
+BOOST_AUTO_TEST_CASE(CommandsAreCounted)
+{
+	Recorder->Begin();
+	Recorder->SetPipelineState(PSO);
+	Recorder->SetPipelineState(PSO);
+	Recorder->SetResource(0, 0x100);
+	Recorder->SetRenderTarget(SceneColor);
+	Recorder->DrawIndexedInstanced(36, 1);
+	Recorder->DrawIndexedInstanced(36, 4);
+	Recorder->Dispatch(8, 8, 1);
+	Recorder->End();
+	Device.Submit(Recorder.get());
+
+	// Rebinding the bound PSO is skipped like in OCommandQueue
+	BOOST_TEST(Count(ECommandType::SetPipelineState) == 1);
+	BOOST_TEST(Count(ECommandType::SetResource) == 1);
+	BOOST_TEST(Count(ECommandType::SetRenderTarget) == 1);
+	BOOST_TEST(Count(ECommandType::Draw) == 2);
+	BOOST_TEST(Count(ECommandType::Dispatch) == 1);
+	BOOST_TEST(Count(ECommandType::ExecuteCommandList) == 1);
+	BOOST_TEST(Device.GetCommandLog().GetTotal() == 7);
+	BOOST_TEST(NumErrors() == 0);
+	BOOST_TEST(STestLog::NumWarnings == 0);
+
+	Device.ResetCommandLog();
+	BOOST_TEST(Device.GetCommandLog().GetTotal() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCommandsAreReported)
+{
+	// Nothing may be recorded into a closed recorder
+	Recorder->SetPipelineState(PSO);
+	BOOST_TEST(NumErrors() == 1);
+	Recorder->End();
+	BOOST_TEST(NumErrors() == 2);
+
+	Recorder->Begin();
+	Recorder->DrawIndexedInstanced(36, 1);
+	BOOST_TEST(NumErrors() == 4);
+
+	Recorder->SetPipelineState(Texture);
+	Recorder->SetResource(1, 0);
+	BOOST_TEST(NumErrors() == 6);
+
+	Recorder->SetRenderTarget(Texture);
+	Recorder->DrawIndexedInstanced(0, 1);
+	BOOST_TEST(NumErrors() == 8);
+
+	// A fresh Begin forgets the bindings
+	Device.Submit(Recorder.get());
+	Recorder->End();
+	Recorder->Begin();
+	Recorder->Dispatch(1, 1, 1);
+	BOOST_TEST(NumErrors() == 10);
+	BOOST_TEST(STestLog::NumWarnings == 10);
+
+	// Failed checks are counted on top of the command
+	BOOST_TEST(Count(ECommandType::Draw) == 2);
+	BOOST_TEST(Count(ECommandType::Dispatch) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(BarriersFollowResourceStates)
+{
+	Recorder->Begin();
+	Transition(SceneColor, SResourceAccess::RenderTarget, SResourceAccess::ShaderResource | SResourceAccess::CopySource);
+	BOOST_TEST(Device.GetResourceState(SceneColor) == (SResourceAccess::ShaderResource | SResourceAccess::CopySource));
+
+	// One call per batch
+	const SResourceBarrierDesc batch[] = {
+		{ .Resource = SceneDepth, .Before = SResourceAccess::DepthWrite, .After = SResourceAccess::DepthRead, .Split = EBarrierSplit::Full },
+		{ .Resource = Texture, .Before = SResourceAccess::ShaderResource, .After = SResourceAccess::CopyDest, .Split = EBarrierSplit::Full },
+	};
+	Recorder->ResourceBarriers(batch);
+	Recorder->ResourceBarriers({});
+	BOOST_TEST(Count(ECommandType::ResourceBarrier) == 2);
+
+	Recorder->CopyResource(Texture, SceneColor);
+	BOOST_TEST(NumErrors() == 0);
+	Recorder->CopyResource(SceneColor, Texture);
+	BOOST_TEST(NumErrors() == 2);
+
+	// The state a barrier starts from has to be the current one
+	Transition(SceneDepth, SResourceAccess::DepthWrite, SResourceAccess::ShaderResource);
+	BOOST_TEST(NumErrors() == 3);
+	Transition(SceneDepth, SResourceAccess::ShaderResource, SResourceAccess::ShaderResource);
+	BOOST_TEST(NumErrors() == 4);
+	Transition(PSO, SResourceAccess::Common, SResourceAccess::RenderTarget);
+	BOOST_TEST(NumErrors() == 5);
+	Recorder->End();
+}
+
+BOOST_AUTO_TEST_CASE(SplitBarriersChangeTheStateOnceEnded)
+{
+	Recorder->Begin();
+	Transition(SceneColor, SResourceAccess::RenderTarget, SResourceAccess::ShaderResource, EBarrierSplit::Begin);
+	BOOST_TEST(Device.GetResourceState(SceneColor) == SResourceAccess::RenderTarget);
+	Transition(SceneColor, SResourceAccess::RenderTarget, SResourceAccess::ShaderResource, EBarrierSplit::End);
+	BOOST_TEST(Device.GetResourceState(SceneColor) == SResourceAccess::ShaderResource);
+	BOOST_TEST(NumErrors() == 0);
+
+	Transition(SceneColor, SResourceAccess::ShaderResource, SResourceAccess::RenderTarget, EBarrierSplit::End);
+	BOOST_TEST(NumErrors() == 1);
+	Transition(SceneColor, SResourceAccess::RenderTarget, SResourceAccess::CopySource, EBarrierSplit::Begin);
+	Transition(SceneColor, SResourceAccess::RenderTarget, SResourceAccess::CopyDest);
+	BOOST_TEST(NumErrors() == 2);
+	Recorder->End();
+}
+
+BOOST_AUTO_TEST_CASE(SwapChainsRotateTheirBackBuffers)
+{
+	BOOST_TEST(!Device.CreateSwapChain(0, 1920, 1080));
+	BOOST_TEST(STestLog::NumErrors == 1);
+
+	const auto swapChain = Device.CreateSwapChain(3, 1920, 1080);
+	BOOST_REQUIRE(swapChain);
+	BOOST_TEST(swapChain->GetNumBackBuffers() == 3);
+	BOOST_TEST(swapChain->GetBackBuffer(3) == InvalidRenderHandle);
+	for (uint32_t frame = 0; frame < 7; frame++)
+	{
+		const auto backBuffer = swapChain->GetBackBuffer(swapChain->GetCurrentBackBufferIndex());
+		BOOST_TEST(Device.GetResourceState(backBuffer) == SResourceAccess::Present);
+		BOOST_TEST(swapChain->GetCurrentBackBufferIndex() == frame % 3);
+		swapChain->Present();
+	}
+	BOOST_TEST(Count(ECommandType::Present) == 7);
+	BOOST_TEST(NumErrors() == 0);
+
+	// Presenting or resizing while a back buffer is rendered to
+	const auto backBuffer = swapChain->GetBackBuffer(swapChain->GetCurrentBackBufferIndex());
+	Recorder->Begin();
+	Transition(backBuffer, SResourceAccess::Present, SResourceAccess::RenderTarget);
+	swapChain->Present();
+	swapChain->Resize(1280, 720);
+	BOOST_TEST(NumErrors() == 2);
+	BOOST_TEST(swapChain->GetCurrentBackBufferIndex() == 0);
+	BOOST_TEST(static_cast<ONullSwapChain*>(swapChain.get())->GetWidth() == 1280);
+}
+
+BOOST_AUTO_TEST_CASE(FencesCompleteOnceSignaled)
+{
+	BOOST_TEST(Device.GetCompletedFenceValue() == 0);
+	Device.WaitForFenceValue(0);
+	BOOST_TEST(Device.Signal() == 1);
+	BOOST_TEST(Device.Signal() == 2);
+	BOOST_TEST(Device.GetCompletedFenceValue() == 2);
+	Device.WaitForFenceValue(2);
+	BOOST_TEST(NumErrors() == 0);
+
+	Device.WaitForFenceValue(3);
+	BOOST_TEST(NumErrors() == 1);
+
+	// Submitting an open recorder
+	Recorder->Begin();
+	Device.Submit(Recorder.get());
+	BOOST_TEST(NumErrors() == 2);
+	BOOST_TEST(Count(ECommandType::Signal) == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
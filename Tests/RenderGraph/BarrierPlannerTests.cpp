@@ -0,0 +1,231 @@
+#include "RenderGraph/Graph/BarrierPlanner.h"
+#include "RenderGraphReader/RenderGraphReader.h"
+
+#include <boost/test/unit_test.hpp>
+
+// Failed checks print the enumerator name
+std::ostream& operator<<(std::ostream& Stream, EBarrierSplit Split)
+{
+	return Stream << ToString(Split);
+}
+
+namespace
+{
+SNodeInfo MakeNode(const string& Name, const vector<string>& Reads, const vector<string>& Writes, const unordered_map<string, string>& States = {}, bool bIsOutput = false)
+{
+	SNodeInfo node;
+	node.Name = Name;
+	node.Reads = Reads;
+	node.Writes = Writes;
+	node.States = States;
+	node.bIsOutput = bIsOutput;
+	return node;
+}
+
+vector<SPlannedBarrier> FindBarriers(const SBarrierPlan& Plan, size_t Position, const string& Resource)
+{
+	vector<SPlannedBarrier> result;
+	for (const auto& barrier : Plan.Batches[Position])
+	{
+		if (barrier.Resource == Resource)
+		{
+			result.push_back(barrier);
+		}
+	}
+	return result;
+}
+
+// Replays the plan over a frame: every barrier starts from the state the previous one left, begins are followed by their end
+// and the frame leaves each resource in its initial state. Returns the state every node finds its resources in.
+vector<unordered_map<string, uint32_t>> ReplayFrame(const SBarrierPlan& Plan)
+{
+	auto states = Plan.InitialStates;
+	unordered_map<string, SPlannedBarrier> pending;
+	vector<unordered_map<string, uint32_t>> result;
+	for (const auto& batch : Plan.Batches)
+	{
+		for (const auto& barrier : batch)
+		{
+			BOOST_TEST_CONTEXT(barrier.Resource)
+			{
+				BOOST_TEST(barrier.Before != barrier.After);
+				BOOST_TEST(barrier.Before == states.at(barrier.Resource));
+				switch (barrier.Split)
+				{
+				case EBarrierSplit::Begin:
+					BOOST_TEST(pending.emplace(barrier.Resource, barrier).second);
+					break;
+				case EBarrierSplit::End:
+					BOOST_REQUIRE(pending.contains(barrier.Resource));
+					BOOST_TEST(pending.at(barrier.Resource).Before == barrier.Before);
+					BOOST_TEST(pending.at(barrier.Resource).After == barrier.After);
+					pending.erase(barrier.Resource);
+					states[barrier.Resource] = barrier.After;
+					break;
+				default:
+					BOOST_TEST(!pending.contains(barrier.Resource));
+					states[barrier.Resource] = barrier.After;
+					break;
+				}
+			}
+		}
+		result.push_back(states);
+	}
+
+	BOOST_TEST(pending.empty());
+	for (const auto& [resource, state] : states)
+	{
+		BOOST_TEST(state == Plan.InitialStates.at(resource), resource << " doesn't end the frame in its initial state");
+	}
+	return result;
+}
+
+// Every node finds its resources in the declared state
+void CheckDeclaredStates(const vector<SNodeInfo>& Nodes, const SCompiledRenderGraph& Graph, const SBarrierPlan& Plan)
+{
+	const auto states = ReplayFrame(Plan);
+	for (size_t position = 0; position < Graph.Order.size(); position++)
+	{
+		const auto& node = Nodes[Graph.Order[position]];
+		for (const auto& resource : node.Reads)
+		{
+			const bool bIsWritten = std::ranges::find(node.Writes, resource) != node.Writes.end();
+			const uint32_t access = OBarrierPlanner::GetAccess(node, resource, bIsWritten);
+			BOOST_TEST((states[position].at(resource) & access) == access, node.Name << " reads " << resource << " in the wrong state");
+		}
+		for (const auto& resource : node.Writes)
+		{
+			BOOST_TEST(states[position].at(resource) == OBarrierPlanner::GetAccess(node, resource, true), node.Name << " writes " << resource << " in the wrong state");
+		}
+	}
+}
+
+struct SLogFixture
+{
+	SLogFixture()
+	{
+		STestLog::Reset();
+	}
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(BarrierPlanner, SLogFixture)
+
+BOOST_AUTO_TEST_CASE(StatesAreParsed)
+{
+	BOOST_TEST(SResourceAccess::FromString("RenderTarget") == SResourceAccess::RenderTarget);
+	BOOST_TEST(SResourceAccess::FromString("CopySource|ShaderResource") == (SResourceAccess::CopySource | SResourceAccess::ShaderResource));
+	BOOST_TEST(STestLog::NumWarnings == 0);
+
+	BOOST_TEST(SResourceAccess::FromString("Unknown") == SResourceAccess::Common);
+	BOOST_TEST(SResourceAccess::FromString("CopySource|Unknown") == SResourceAccess::Common);
+	BOOST_TEST(SResourceAccess::FromString("RenderTarget|CopySource") == SResourceAccess::Common);
+	BOOST_TEST(STestLog::NumWarnings == 3);
+}
+
+BOOST_AUTO_TEST_CASE(ReadsAreMergedIntoOneState)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "SceneColor" }),
+		MakeNode("Copy", { "SceneColor" }, { "History" }, { { "SceneColor", "CopySource" }, { "History", "CopyDest" } }),
+		MakeNode("Sobel", { "SceneColor" }, { "Edges" }, { { "Edges", "UnorderedAccess" } }),
+		MakeNode("Present", { "History", "Edges" }, {}, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	const auto plan = OBarrierPlanner::Plan(nodes, graph);
+	BOOST_REQUIRE(graph.bIsValid);
+
+	// One transition into the combined read state ahead of the first reader, none for the second one
+	const auto copy = FindBarriers(plan, 1, "SceneColor");
+	BOOST_REQUIRE(copy.size() == 1);
+	BOOST_TEST(copy[0].After == (SResourceAccess::CopySource | SResourceAccess::ShaderResource));
+	BOOST_TEST(FindBarriers(plan, 2, "SceneColor").empty());
+	CheckDeclaredStates(nodes, graph, plan);
+}
+
+BOOST_AUTO_TEST_CASE(TransitionsBeforeANodeAreBatched)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "SceneColor", "SceneDepth" }, { { "SceneDepth", "DepthWrite" } }),
+		MakeNode("Fog", { "SceneColor", "SceneDepth" }, { "BackBuffer" }, { { "SceneDepth", "DepthRead" } }),
+		MakeNode("Present", { "BackBuffer" }, {}, { { "BackBuffer", "Present" } }, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	const auto plan = OBarrierPlanner::Plan(nodes, graph);
+	BOOST_TEST(plan.Batches[1].size() == 3);
+	BOOST_TEST(plan.NumBatches == 3);
+	BOOST_TEST(plan.NumBarriers == 6);
+	BOOST_TEST(plan.NumBarriers <= plan.NumNaiveBarriers);
+	CheckDeclaredStates(nodes, graph, plan);
+}
+
+BOOST_AUTO_TEST_CASE(TransitionsAcrossUnrelatedNodesAreSplit)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Shadow", {}, { "ShadowMap" }, { { "ShadowMap", "DepthWrite" } }),
+		MakeNode("Reflections", {}, { "CubeMap" }),
+		MakeNode("Particles", {}, { "Particles" }, { { "Particles", "UnorderedAccess" } }),
+		MakeNode("Opaque", { "ShadowMap", "CubeMap", "Particles" }, { "SceneColor" }),
+		MakeNode("Present", { "SceneColor" }, {}, { { "SceneColor", "Present" } }, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	const auto plan = OBarrierPlanner::Plan(nodes, graph);
+	const auto position = [&](const string& Name) {
+		return std::ranges::find(graph.Order, std::ranges::find(nodes, Name, &SNodeInfo::Name) - nodes.begin()) - graph.Order.begin();
+	};
+
+	// The shadow map is done after the first node, its transition to shader resource starts right after it
+	const auto begin = FindBarriers(plan, position("Shadow") + 1, "ShadowMap");
+	const auto end = FindBarriers(plan, position("Opaque"), "ShadowMap");
+	BOOST_REQUIRE(begin.size() == 1);
+	BOOST_REQUIRE(end.size() == 1);
+	BOOST_TEST(begin[0].Split == EBarrierSplit::Begin);
+	BOOST_TEST(end[0].Split == EBarrierSplit::End);
+	BOOST_TEST(plan.NumSplitBarriers >= 1);
+	CheckDeclaredStates(nodes, graph, plan);
+}
+
+BOOST_AUTO_TEST_CASE(SingleStateResourcesNeedNoBarriers)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Compute", {}, { "Particles" }, { { "Particles", "UnorderedAccess" } }),
+		MakeNode("Simulate", { "Particles" }, { "Particles" }, { { "Particles", "UnorderedAccess" } }, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	const auto plan = OBarrierPlanner::Plan(nodes, graph);
+	BOOST_TEST(plan.NumBarriers == 0);
+	BOOST_TEST(plan.NumBatches == 0);
+	BOOST_TEST(plan.InitialStates.at("Particles") == SResourceAccess::UnorderedAccess);
+}
+
+BOOST_AUTO_TEST_CASE(ShippedGraphDeclaresConsistentStates)
+{
+	ORenderGraphReader reader(RENDERER_SOURCE_DIR "/Resources/Config/RenderGraphConfig.json");
+	const auto nodes = reader.LoadRenderGraph();
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	const auto plan = OBarrierPlanner::Plan(nodes, graph);
+	BOOST_REQUIRE(graph.bIsValid);
+	BOOST_TEST(STestLog::NumWarnings == 0);
+	CheckDeclaredStates(nodes, graph, plan);
+
+	// The blur filters copy the back buffer out and back in, they leave it as a copy destination
+	const auto position = [&](const string& Name) {
+		return std::ranges::find(graph.Order, std::ranges::find(nodes, Name, &SNodeInfo::Name) - nodes.begin()) - graph.Order.begin();
+	};
+	const auto blur = FindBarriers(plan, position("Blur"), "BackBuffer");
+	BOOST_REQUIRE(blur.size() == 1);
+	BOOST_TEST(blur[0].Before == SResourceAccess::RenderTarget);
+	BOOST_TEST(blur[0].After == SResourceAccess::CopyDest);
+	BOOST_TEST(FindBarriers(plan, position("BilateralBlur"), "BackBuffer").empty());
+
+	const auto ui = FindBarriers(plan, position("UI"), "BackBuffer");
+	BOOST_REQUIRE(ui.size() == 1);
+	BOOST_TEST(ui[0].Before == SResourceAccess::CopyDest);
+	BOOST_TEST(plan.InitialStates.at("BackBuffer") == SResourceAccess::Present);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+#include "RenderGraph/Graph/RenderGraphCompiler.h"
+#include "RenderGraphReader/RenderGraphReader.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+SNodeInfo MakeNode(const string& Name, const vector<string>& Reads, const vector<string>& Writes, bool bIsOutput = false)
+{
+	SNodeInfo node;
+	node.Name = Name;
+	node.Reads = Reads;
+	node.Writes = Writes;
+	node.bIsOutput = bIsOutput;
+	return node;
+}
+
+size_t Find(const vector<SNodeInfo>& Nodes, const string& Name)
+{
+	return std::ranges::find(Nodes, Name, &SNodeInfo::Name) - Nodes.begin();
+}
+
+size_t GetPosition(const SCompiledRenderGraph& Graph, size_t Node)
+{
+	return std::ranges::find(Graph.Order, Node) - Graph.Order.begin();
+}
+
+// Every dependency of a scheduled node is scheduled ahead of it, in a lower level
+void CheckSchedule(const SCompiledRenderGraph& Graph)
+{
+	vector<size_t> levels(Graph.Dependencies.size(), 0);
+	for (size_t level = 0; level < Graph.Levels.size(); level++)
+	{
+		for (const auto node : Graph.Levels[level])
+		{
+			levels[node] = level;
+		}
+	}
+
+	for (const auto node : Graph.Order)
+	{
+		for (const auto dependency : Graph.Dependencies[node])
+		{
+			if (std::ranges::find(Graph.Culled, dependency) != Graph.Culled.end())
+			{
+				continue;
+			}
+			BOOST_TEST(GetPosition(Graph, dependency) < GetPosition(Graph, node));
+			BOOST_TEST(levels[dependency] < levels[node]);
+		}
+	}
+}
+
+struct SLogFixture
+{
+	SLogFixture()
+	{
+		STestLog::Reset();
+	}
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(RenderGraphCompiler, SLogFixture)
+
+BOOST_AUTO_TEST_CASE(UnusedNodesAreCulled)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Shadow", {}, { "ShadowMap" }),
+		MakeNode("Opaque", { "ShadowMap" }, { "SceneColor" }),
+		MakeNode("Debug", { "SceneColor" }, { "DebugView" }),
+		MakeNode("Post", { "SceneColor" }, { "BackBuffer" }),
+		MakeNode("Present", { "BackBuffer" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(graph.Culled == vector<size_t>{ Find(nodes, "Debug") }, boost::test_tools::per_element());
+	BOOST_TEST(graph.Order.size() == 4);
+	CheckSchedule(graph);
+}
+
+BOOST_AUTO_TEST_CASE(GraphWithoutOutputsIsCulled)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "SceneColor" }),
+		MakeNode("Post", { "SceneColor" }, { "BackBuffer" }),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(graph.Order.empty());
+	BOOST_TEST(graph.Culled.size() == 2);
+	BOOST_TEST(STestLog::NumWarnings == 1);
+}
+
+BOOST_AUTO_TEST_CASE(IndependentNodesShareALevel)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Shadow", {}, { "ShadowMap" }),
+		MakeNode("Reflections", {}, { "CubeMap" }),
+		MakeNode("Opaque", { "ShadowMap", "CubeMap" }, { "SceneColor" }),
+		MakeNode("Present", { "SceneColor" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_REQUIRE(graph.Levels.size() == 3);
+	BOOST_TEST(graph.Levels[0] == (vector<size_t>{ 0, 1 }), boost::test_tools::per_element());
+	BOOST_TEST(graph.Levels[1] == vector<size_t>{ 2 }, boost::test_tools::per_element());
+	BOOST_TEST(graph.Levels[2] == vector<size_t>{ 3 }, boost::test_tools::per_element());
+	CheckSchedule(graph);
+}
+
+BOOST_AUTO_TEST_CASE(WritersAreOrderedByDeclaration)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "SceneColor" }),
+		MakeNode("Sky", {}, { "SceneColor" }),
+		MakeNode("Transparent", {}, { "SceneColor" }),
+		MakeNode("Present", { "SceneColor" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(graph.Order == (vector<size_t>{ 0, 1, 2, 3 }), boost::test_tools::per_element());
+	BOOST_TEST(graph.Levels.size() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(ReadersRunBeforeTheNextWriter)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "SceneColor" }),
+		MakeNode("Sobel", { "SceneColor" }, { "SobelOutput" }),
+		MakeNode("Overlay", {}, { "SceneColor" }),
+		MakeNode("Present", { "SceneColor", "SobelOutput" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(GetPosition(graph, Find(nodes, "Sobel")) < GetPosition(graph, Find(nodes, "Overlay")));
+	CheckSchedule(graph);
+}
+
+BOOST_AUTO_TEST_CASE(ProducersDontDependOnDeclarationOrder)
+{
+	// Present is declared first and still reads the output of Post
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Present", { "BackBuffer" }, {}, true),
+		MakeNode("Post", { "SceneColor" }, { "BackBuffer" }),
+		MakeNode("Opaque", {}, { "SceneColor" }),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(graph.Culled.empty());
+	BOOST_TEST(graph.Order == (vector<size_t>{ 2, 1, 0 }), boost::test_tools::per_element());
+	CheckSchedule(graph);
+}
+
+BOOST_AUTO_TEST_CASE(ReadsWithoutProducerAreRejected)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", { "ShadowMap" }, { "SceneColor" }),
+		MakeNode("Present", { "SceneColor" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(!graph.bIsValid);
+	BOOST_TEST(STestLog::NumErrors == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ReadingTheOwnFirstWriteIsRejected)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Accumulate", { "History" }, { "History" }),
+		MakeNode("Present", { "History" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(!graph.bIsValid);
+	BOOST_TEST(STestLog::NumErrors == 1);
+}
+
+BOOST_AUTO_TEST_CASE(CyclesAreRejected)
+{
+	// A consumes the first version of X written by B, B consumes Y written by A
+	const vector<SNodeInfo> nodes = {
+		MakeNode("A", { "X" }, { "Y" }),
+		MakeNode("B", { "Y" }, { "X" }),
+		MakeNode("Present", { "X" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(!graph.bIsValid);
+	BOOST_TEST(STestLog::NumErrors == 1);
+	BOOST_TEST(graph.Order.size() + graph.Culled.size() < nodes.size());
+}
+
+BOOST_AUTO_TEST_CASE(ShippedGraphCompiles)
+{
+	ORenderGraphReader reader(RENDERER_SOURCE_DIR "/Resources/Config/RenderGraphConfig.json");
+	const auto nodes = reader.LoadRenderGraph();
+	BOOST_REQUIRE(!nodes.empty());
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_TEST(graph.bIsValid);
+	BOOST_TEST(graph.Culled.empty());
+	BOOST_TEST(STestLog::NumErrors == 0);
+	BOOST_TEST(nodes[graph.Order.back()].Name == "Present");
+	CheckSchedule(graph);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
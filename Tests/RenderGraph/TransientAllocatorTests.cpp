@@ -0,0 +1,164 @@
+#include "RenderGraph/Graph/TransientAllocator.h"
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+namespace
+{
+constexpr uint64_t MB = 1 << 20;
+constexpr uint64_t PlacementAlignment = 64 * 1024;
+
+bool OverlapInMemory(const STransientResourceDesc& A, const STransientPlacement& PA, const STransientResourceDesc& B, const STransientPlacement& PB)
+{
+	return PA.Offset < PB.Offset + B.Size && PB.Offset < PA.Offset + A.Size;
+}
+
+SNodeInfo MakeNode(const string& Name, const vector<string>& Reads, const vector<string>& Writes, bool bIsOutput = false)
+{
+	SNodeInfo node;
+	node.Name = Name;
+	node.Reads = Reads;
+	node.Writes = Writes;
+	node.bIsOutput = bIsOutput;
+	return node;
+}
+
+void CheckLayout(const vector<STransientResourceDesc>& Resources, const STransientHeapLayout& Layout)
+{
+	BOOST_REQUIRE_EQUAL(Layout.Placements.size(), Resources.size());
+	for (size_t i = 0; i < Resources.size(); i++)
+	{
+		const auto& placement = Layout.Placements[i];
+		BOOST_TEST(placement.Offset % Resources[i].Alignment == 0);
+		BOOST_TEST(placement.Offset + Resources[i].Size <= Layout.HeapSize);
+
+		for (size_t j = i + 1; j < Resources.size(); j++)
+		{
+			if (Resources[i].Lifetime.Overlaps(Resources[j].Lifetime))
+			{
+				BOOST_TEST(!OverlapInMemory(Resources[i], placement, Resources[j], Layout.Placements[j]),
+				           Resources[i].Name << " and " << Resources[j].Name << " are alive together but share memory");
+			}
+		}
+	}
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(TransientAllocator)
+
+BOOST_AUTO_TEST_CASE(DisjointLifetimesShareMemory)
+{
+	const vector<STransientResourceDesc> resources = {
+		{ "Sobel", 4 * MB, PlacementAlignment, { 0, 1 } },
+		{ "Blur", 4 * MB, PlacementAlignment, { 2, 3 } },
+		{ "Bilateral", 4 * MB, PlacementAlignment, { 4, 5 } },
+	};
+
+	const auto layout = OTransientAllocator::Allocate(resources);
+	CheckLayout(resources, layout);
+	BOOST_TEST(layout.HeapSize == 4 * MB);
+	BOOST_TEST(layout.UnaliasedSize == 12 * MB);
+	BOOST_TEST(layout.GetSavedBytes() == 8 * MB);
+	BOOST_TEST(layout.Placements[0].Slot == layout.Placements[1].Slot);
+	BOOST_TEST(layout.Placements[1].Slot == layout.Placements[2].Slot);
+}
+
+BOOST_AUTO_TEST_CASE(OverlappingLifetimesDontAlias)
+{
+	const vector<STransientResourceDesc> resources = {
+		{ "BlurIn", 4 * MB, PlacementAlignment, { 0, 2 } },
+		{ "BlurOut", 4 * MB, PlacementAlignment, { 2, 3 } },
+		{ "Sobel", 4 * MB, PlacementAlignment, { 1, 2 } },
+	};
+
+	const auto layout = OTransientAllocator::Allocate(resources);
+	CheckLayout(resources, layout);
+	BOOST_TEST(layout.HeapSize == 12 * MB);
+	BOOST_TEST(layout.GetSavedBytes() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(SlotIsSizedForItsLargestResource)
+{
+	const vector<STransientResourceDesc> resources = {
+		{ "Small", 1 * MB, PlacementAlignment, { 0, 0 } },
+		{ "Large", 10 * MB, PlacementAlignment, { 1, 1 } },
+		{ "Medium", 3 * MB, PlacementAlignment, { 2, 2 } },
+	};
+
+	const auto layout = OTransientAllocator::Allocate(resources);
+	CheckLayout(resources, layout);
+	BOOST_TEST(layout.HeapSize == 10 * MB);
+	BOOST_TEST(layout.HeapAlignment == PlacementAlignment);
+}
+
+BOOST_AUTO_TEST_CASE(OffsetsRespectAlignment)
+{
+	const vector<STransientResourceDesc> resources = {
+		{ "Odd", 1000, 1, { 0, 3 } },
+		{ "Buffer", 4096, 256, { 0, 3 } },
+		{ "Texture", 2 * MB, PlacementAlignment, { 1, 2 } },
+		{ "Msaa", MB, 4 * MB, { 2, 3 } },
+	};
+
+	const auto layout = OTransientAllocator::Allocate(resources);
+	CheckLayout(resources, layout);
+	BOOST_TEST(layout.HeapAlignment == 4 * MB);
+}
+
+BOOST_AUTO_TEST_CASE(RandomLifetimesNeverOverlap)
+{
+	std::mt19937 random(42);
+	for (int iteration = 0; iteration < 200; iteration++)
+	{
+		vector<STransientResourceDesc> resources(random() % 24 + 1);
+		for (size_t i = 0; i < resources.size(); i++)
+		{
+			const size_t first = random() % 16;
+			resources[i].Name = "Resource" + std::to_string(i);
+			resources[i].Size = (random() % 64 + 1) * 4096;
+			resources[i].Alignment = uint64_t(1) << (random() % 17);
+			resources[i].Lifetime = { first, first + random() % 6 };
+		}
+
+		const auto layout = OTransientAllocator::Allocate(resources);
+		CheckLayout(resources, layout);
+		BOOST_TEST(layout.HeapSize <= layout.UnaliasedSize + layout.Placements.size() * layout.HeapAlignment);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(LifetimesFollowTheCompiledOrder)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "BackBuffer" }),
+		MakeNode("Sobel", { "BackBuffer" }, { "SobelOutput" }),
+		MakeNode("Composite", { "SobelOutput" }, { "BackBuffer" }),
+		MakeNode("Present", { "BackBuffer" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_REQUIRE(graph.bIsValid);
+
+	const auto lifetimes = OTransientAllocator::ComputeLifetimes(nodes, graph);
+	BOOST_TEST(lifetimes.at("BackBuffer").FirstUse == 0);
+	BOOST_TEST(lifetimes.at("BackBuffer").LastUse == 3);
+	BOOST_TEST(lifetimes.at("SobelOutput").FirstUse == 1);
+	BOOST_TEST(lifetimes.at("SobelOutput").LastUse == 2);
+}
+
+BOOST_AUTO_TEST_CASE(CulledNodesDontExtendLifetimes)
+{
+	const vector<SNodeInfo> nodes = {
+		MakeNode("Opaque", {}, { "BackBuffer" }),
+		MakeNode("Debug", { "BackBuffer" }, { "DebugOutput" }),
+		MakeNode("Present", { "BackBuffer" }, {}, true),
+	};
+
+	const auto graph = ORenderGraphCompiler::Compile(nodes);
+	BOOST_REQUIRE(graph.bIsValid);
+
+	const auto lifetimes = OTransientAllocator::ComputeLifetimes(nodes, graph);
+	BOOST_TEST(!lifetimes.contains("DebugOutput"));
+	BOOST_TEST(lifetimes.at("BackBuffer").LastUse == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,242 @@
+#include "ShaderCompiler/ShaderCache.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <random>
+
+namespace
+{
+void WriteFile(const std::filesystem::path& Path, const string& Content)
+{
+	std::filesystem::create_directories(Path.parent_path());
+	std::ofstream file(Path, std::ios::binary | std::ios::trunc);
+	file << Content;
+}
+
+std::filesystem::path MakeTempDirectory()
+{
+	auto directory = std::filesystem::temp_directory_path() / ("RendererTests" + std::to_string(std::random_device{}()));
+	std::filesystem::remove_all(directory);
+	return directory;
+}
+
+/**
+ * @brief Shader sources in a fresh temporary directory. Water includes Common from the shader directory and Fog from the
+ * include directory, Common includes LightingUtils. Reversed includes the same two files the other way round.
+ */
+struct SShaderSources
+{
+	SShaderSources()
+	    : Directory(MakeTempDirectory())
+	{
+		Write(Directory);
+	}
+
+	~SShaderSources()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(Directory, error);
+	}
+
+	static void Write(const std::filesystem::path& Root)
+	{
+		WriteFile(Root / "Shaders" / "Water.hlsl", "#include \"Common.hlsl\"\n#include <Fog.hlsl>\nfloat4 PS() : SV_Target { return 0; }\n");
+		WriteFile(Root / "Shaders" / "Reversed.hlsl", "#include <Fog.hlsl>\n#include \"Common.hlsl\"\nfloat4 PS() : SV_Target { return 0; }\n");
+		WriteFile(Root / "Shaders" / "Common.hlsl", "#include \"LightingUtils.hlsl\"\n");
+		WriteFile(Root / "Shaders" / "LightingUtils.hlsl", "float3 Lighting() { return 0; }\n");
+		WriteFile(Root / "Include" / "Fog.hlsl", "float Fog() { return 0; }\n");
+	}
+
+	SShaderCacheKeyDesc GetDesc(const std::filesystem::path& Root) const
+	{
+		SShaderCacheKeyDesc desc;
+		desc.SourcePath = Root / "Shaders" / "Water.hlsl";
+		desc.IncludeDirs = { Root / "Include" };
+		desc.Defines = { { "FOG", "1" }, { "ALPHA_TEST", "0" } };
+		desc.EntryPoint = "PS";
+		desc.TargetProfile = "ps_6_0";
+		desc.CompilerVersion = "1.7.2308";
+		desc.Arguments = { "-O3" };
+		return desc;
+	}
+
+	SShaderCacheKeyDesc GetDesc() const
+	{
+		return GetDesc(Directory);
+	}
+
+	uint64_t GetKey(const SShaderCacheKeyDesc& Desc) const
+	{
+		const auto key = OShaderCache::ComputeKey(Desc);
+		BOOST_REQUIRE(key.has_value());
+		return *key;
+	}
+
+	std::filesystem::path Directory;
+};
+
+SShaderCacheEntry MakeEntry()
+{
+	SShaderCacheEntry entry;
+	entry.ByteCode = { 0x44, 0x58, 0x42, 0x43, 1, 2, 3, 4, 5 };
+	entry.Reflection.BoundResources = {
+		{ .Name = "cbPass", .Type = 0, .BindPoint = 0, .BindCount = 1, .Space = 0, .ByteSize = 336 },
+		{ .Name = "gTextureMaps", .Type = 2, .BindPoint = 0, .BindCount = 0, .Space = 1, .ByteSize = 0 },
+	};
+	entry.Reflection.InputParameters = { { .SemanticName = "POSITION", .SemanticIndex = 0, .Mask = 7 }, { .SemanticName = "TEXCOORD", .SemanticIndex = 1, .Mask = 3 } };
+	return entry;
+}
+
+void CheckEqual(const SShaderCacheEntry& Lhs, const SShaderCacheEntry& Rhs)
+{
+	BOOST_TEST(Lhs.ByteCode == Rhs.ByteCode, boost::test_tools::per_element());
+	BOOST_REQUIRE(Lhs.Reflection.BoundResources.size() == Rhs.Reflection.BoundResources.size());
+	for (size_t i = 0; i < Lhs.Reflection.BoundResources.size(); i++)
+	{
+		const auto& lhs = Lhs.Reflection.BoundResources[i];
+		const auto& rhs = Rhs.Reflection.BoundResources[i];
+		BOOST_TEST(lhs.Name == rhs.Name);
+		BOOST_TEST(lhs.Type == rhs.Type);
+		BOOST_TEST(lhs.BindPoint == rhs.BindPoint);
+		BOOST_TEST(lhs.BindCount == rhs.BindCount);
+		BOOST_TEST(lhs.Space == rhs.Space);
+		BOOST_TEST(lhs.ByteSize == rhs.ByteSize);
+	}
+	BOOST_REQUIRE(Lhs.Reflection.InputParameters.size() == Rhs.Reflection.InputParameters.size());
+	for (size_t i = 0; i < Lhs.Reflection.InputParameters.size(); i++)
+	{
+		const auto& lhs = Lhs.Reflection.InputParameters[i];
+		const auto& rhs = Rhs.Reflection.InputParameters[i];
+		BOOST_TEST(lhs.SemanticName == rhs.SemanticName);
+		BOOST_TEST(lhs.SemanticIndex == rhs.SemanticIndex);
+		BOOST_TEST(lhs.Mask == rhs.Mask);
+	}
+}
+
+constexpr uint64_t Key = 0x0123456789ABCDEF;
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ShaderCache, SShaderSources)
+
+BOOST_AUTO_TEST_CASE(KeyIsStableAcrossRunsAndDirectories)
+{
+	const auto key = GetKey(GetDesc());
+	BOOST_TEST(GetKey(GetDesc()) == key);
+
+	// A checkout in another directory, as a later run on another machine would see it
+	const auto other = MakeTempDirectory();
+	Write(other);
+	BOOST_TEST(GetKey(GetDesc(other)) == key);
+	std::filesystem::remove_all(other);
+}
+
+BOOST_AUTO_TEST_CASE(IncludesDontDependOnDiscoveryOrder)
+{
+	const vector<std::filesystem::path> includeDirs = { Directory / "Include" };
+	const auto includes = OShaderCache::CollectIncludes(Directory / "Shaders" / "Water.hlsl", includeDirs);
+	BOOST_TEST(includes.size() == 3);
+	BOOST_TEST(std::ranges::is_sorted(includes));
+	BOOST_TEST(OShaderCache::CollectIncludes(Directory / "Shaders" / "Reversed.hlsl", includeDirs) == includes, boost::test_tools::per_element());
+
+	// Include directories that don't resolve anything else don't change the key
+	auto desc = GetDesc();
+	const auto key = GetKey(desc);
+	desc.IncludeDirs.insert(desc.IncludeDirs.begin(), Directory / "Missing");
+	BOOST_TEST(GetKey(desc) == key);
+}
+
+BOOST_AUTO_TEST_CASE(KeyChangesWithEveryInput)
+{
+	const auto base = GetDesc();
+	const auto key = GetKey(base);
+
+	WriteFile(Directory / "Shaders" / "LightingUtils.hlsl", "float3 Lighting() { return 1; }\n");
+	const auto include = GetKey(base);
+	BOOST_TEST(include != key);
+
+	WriteFile(Directory / "Shaders" / "Water.hlsl", "#include \"Common.hlsl\"\n#include <Fog.hlsl>\nfloat4 PS() : SV_Target { return 1; }\n");
+	const auto source = GetKey(base);
+	BOOST_TEST(source != key);
+	BOOST_TEST(source != include);
+
+	auto desc = base;
+	desc.Defines[0].second = "0";
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.Defines[1].first = "ALPHA_TESTED";
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.Defines.push_back({ "SHADOWS", "" });
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.EntryPoint = "VS";
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.TargetProfile = "ps_6_6";
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.CompilerVersion = "1.8.2403";
+	BOOST_TEST(GetKey(desc) != source);
+	desc = base;
+	desc.Arguments.push_back("-Zi");
+	BOOST_TEST(GetKey(desc) != source);
+}
+
+BOOST_AUTO_TEST_CASE(MissingSourceHasNoKey)
+{
+	auto desc = GetDesc();
+	desc.SourcePath = Directory / "Shaders" / "Missing.hlsl";
+	BOOST_TEST(!OShaderCache::ComputeKey(desc).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(StoredEntriesLoadBack)
+{
+	const OShaderCache cache(Directory / "Cache");
+	BOOST_TEST(!cache.Load(Key).has_value());
+
+	const auto entry = MakeEntry();
+	BOOST_REQUIRE(cache.Store(Key, entry));
+	const auto loaded = cache.Load(Key);
+	BOOST_REQUIRE(loaded.has_value());
+	CheckEqual(*loaded, entry);
+	BOOST_TEST(!cache.Load(Key + 1).has_value());
+
+	// Only the entry itself is left behind, the temporary file was renamed
+	BOOST_TEST(std::distance(std::filesystem::directory_iterator(Directory / "Cache"), std::filesystem::directory_iterator()) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ForeignEntriesAreRejected)
+{
+	const auto data = OShaderCache::Serialize(Key, MakeEntry());
+	BOOST_REQUIRE(OShaderCache::Deserialize(Key, data).has_value());
+	BOOST_TEST(!OShaderCache::Deserialize(Key + 1, data).has_value());
+
+	auto magic = data;
+	magic[0] ^= 1;
+	BOOST_TEST(!OShaderCache::Deserialize(Key, magic).has_value());
+
+	auto version = data;
+	version[sizeof(uint32_t)] ^= 1;
+	BOOST_TEST(!OShaderCache::Deserialize(Key, version).has_value());
+
+	auto trailing = data;
+	trailing.push_back(0);
+	BOOST_TEST(!OShaderCache::Deserialize(Key, trailing).has_value());
+
+	auto entry = MakeEntry();
+	entry.ByteCode.clear();
+	BOOST_TEST(!OShaderCache::Deserialize(Key, OShaderCache::Serialize(Key, entry)).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedEntriesAreRejected)
+{
+	const auto data = OShaderCache::Serialize(Key, MakeEntry());
+	bool bAllRejected = true;
+	for (size_t size = 0; size < data.size(); size++)
+	{
+		bAllRejected = bAllRejected && !OShaderCache::Deserialize(Key, std::span(data.data(), size)).has_value();
+	}
+	BOOST_TEST(bAllRejected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+#include "FileWatcher/FileWatcher.h"
+#include "ShaderCompiler/ShaderCache.h"
+#include "ShaderCompiler/ShaderDependencyGraph.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <random>
+#include <thread>
+
+namespace
+{
+void WriteFile(const std::filesystem::path& Path, const string& Content)
+{
+	std::filesystem::create_directories(Path.parent_path());
+	std::ofstream file(Path, std::ios::binary | std::ios::trunc);
+	file << Content;
+}
+
+/**
+ * @brief Shader tree in a fresh temporary directory: Water includes Common which includes LightingUtils, Blur stands alone.
+ */
+struct SShaderDirectory
+{
+	SShaderDirectory()
+	    : Directory(std::filesystem::temp_directory_path() / ("RendererTests" + std::to_string(std::random_device{}())))
+	{
+		std::filesystem::remove_all(Directory);
+		WriteFile(Directory / "Common.hlsl", "#include \"LightingUtils.hlsl\"\n");
+		WriteFile(Directory / "LightingUtils.hlsl", "float3 Lighting() { return 0; }\n");
+		WriteFile(Directory / "Water.hlsl", "  #  include \"Common.hlsl\"\n");
+		WriteFile(Directory / "Blur.hlsl", "float4 PS() : SV_Target { return 0; }\n");
+		WriteFile(Directory / "Sub" / "Notes.txt", "notes");
+	}
+
+	~SShaderDirectory()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(Directory, error);
+	}
+
+	// The source followed by every file it includes, the way the pipeline loader records a stage
+	vector<std::filesystem::path> GetFiles(const string& Source) const
+	{
+		auto files = OShaderCache::CollectIncludes(Directory / Source, {});
+		files.insert(files.begin(), Directory / Source);
+		return files;
+	}
+
+	std::filesystem::path Directory;
+};
+
+const SShaderStageId WaterVS = { "Water", 0 };
+const SShaderStageId WaterPS = { "Water", 1 };
+const SShaderStageId BlurPS = { "Blur", 0 };
+} // namespace
+
+// Failed checks print the stage
+std::ostream& operator<<(std::ostream& Stream, const SShaderStageId& Stage)
+{
+	return Stream << Stage.Pipeline << ':' << Stage.StageIndex;
+}
+
+BOOST_FIXTURE_TEST_SUITE(ShaderDependencyGraph, SShaderDirectory)
+
+BOOST_AUTO_TEST_CASE(NestedIncludesAreCollected)
+{
+	const auto files = GetFiles("Water.hlsl");
+	BOOST_REQUIRE(files.size() == 3);
+	BOOST_TEST(OShaderDependencyGraph::NormalizePath(files[1]) == OShaderDependencyGraph::NormalizePath(Directory / "Common.hlsl"));
+	BOOST_TEST(OShaderDependencyGraph::NormalizePath(files[2]) == OShaderDependencyGraph::NormalizePath(Directory / "LightingUtils.hlsl"));
+	BOOST_TEST(GetFiles("Blur.hlsl").size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(NestedIncludeInvalidatesEveryStage)
+{
+	OShaderDependencyGraph graph;
+	graph.SetDependencies(WaterVS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(WaterPS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(BlurPS, GetFiles("Blur.hlsl"));
+	BOOST_TEST(graph.GetNumFiles() == 4);
+
+	// Spelled differently from the recorded path, normalization still finds it
+	const auto affected = graph.GetAffectedStages({ Directory / "./Sub/../LightingUtils.hlsl" });
+	BOOST_TEST(affected == (vector<SShaderStageId>{ WaterVS, WaterPS }), boost::test_tools::per_element());
+	BOOST_TEST(graph.GetAffectedStages({ Directory / "Sub" / "Notes.txt" }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(PipelinesAreListedOnce)
+{
+	OShaderDependencyGraph graph;
+	graph.SetDependencies(WaterVS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(WaterPS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(BlurPS, GetFiles("Blur.hlsl"));
+
+	const auto pipelines = graph.GetAffectedPipelines({ Directory / "Blur.hlsl", Directory / "Common.hlsl", Directory / "Water.hlsl" });
+	BOOST_TEST(pipelines == (vector<string>{ "Blur", "Water" }), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(DependenciesAreReplaced)
+{
+	OShaderDependencyGraph graph;
+	graph.SetDependencies(WaterVS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(WaterPS, GetFiles("Water.hlsl"));
+
+	// The include was removed from the source of one stage, a change to it no longer reaches that stage
+	graph.SetDependencies(WaterVS, { Directory / "Water.hlsl" });
+	BOOST_TEST(graph.GetAffectedStages({ Directory / "Common.hlsl" }) == vector<SShaderStageId>{ WaterPS }, boost::test_tools::per_element());
+	BOOST_TEST(graph.GetDependencies(WaterVS).size() == 1);
+
+	graph.RemoveStage(WaterPS);
+	BOOST_TEST(graph.GetAffectedStages({ Directory / "Common.hlsl" }).empty());
+	BOOST_TEST(graph.GetAffectedStages({ Directory / "Water.hlsl" }) == vector<SShaderStageId>{ WaterVS }, boost::test_tools::per_element());
+	BOOST_TEST(graph.GetNumFiles() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(FileWatcher, SShaderDirectory)
+
+BOOST_AUTO_TEST_CASE(FirstPollTakesTheSnapshot)
+{
+	OFileWatcher watcher(Directory, { ".hlsl" });
+	BOOST_TEST(watcher.Poll().empty());
+	BOOST_TEST(watcher.Poll().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ChangesAreReportedOnce)
+{
+	OFileWatcher watcher(Directory, { ".hlsl" });
+	watcher.Poll();
+
+	// Sizes change as well, file systems with coarse write times still see the modification
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	WriteFile(Directory / "LightingUtils.hlsl", "float3 Lighting() { return 1.0f; }\n");
+	WriteFile(Directory / "Sub" / "Notes.txt", "more notes");
+	WriteFile(Directory / "Sub" / "New.hlsl", "");
+	std::filesystem::remove(Directory / "Blur.hlsl");
+
+	const auto changed = watcher.Poll();
+	BOOST_REQUIRE(changed.size() == 3);
+	BOOST_TEST(std::ranges::is_sorted(changed));
+	for (const auto& file : { Directory / "LightingUtils.hlsl", Directory / "Sub" / "New.hlsl", Directory / "Blur.hlsl" })
+	{
+		BOOST_TEST(std::ranges::count(changed, file) == 1, file << " isn't reported");
+	}
+	BOOST_TEST(watcher.Poll().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ChangesReachTheAffectedPipelines)
+{
+	OShaderDependencyGraph graph;
+	graph.SetDependencies(WaterPS, GetFiles("Water.hlsl"));
+	graph.SetDependencies(BlurPS, GetFiles("Blur.hlsl"));
+
+	OFileWatcher watcher(Directory, { ".hlsl" });
+	watcher.Poll();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	WriteFile(Directory / "LightingUtils.hlsl", "float3 Lighting() { return 1.0f; }\n");
+
+	BOOST_TEST(graph.GetAffectedPipelines(watcher.Poll()) == vector<string>{ "Water" }, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+#include "ShaderCompiler/ShaderCache.h"
+#include "ShaderCompiler/ShaderPermutation.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <random>
+#include <set>
+
+namespace
+{
+using SDefines = vector<pair<string, string>>;
+
+const vector<string> Switches = { "FOG", "CARTOON", "ALPHA_TEST" };
+
+SShaderPermutationAxis MakeAxis(const string& Name, const vector<string>& Values = {})
+{
+	return { .Name = Name, .Values = Values };
+}
+
+// Defines in the order they are passed to the compiler, failed checks print them readably
+string Join(const SDefines& Defines)
+{
+	string result;
+	for (const auto& [name, value] : Defines)
+	{
+		result += (result.empty() ? "" : " ") + name + "=" + value;
+	}
+	return result;
+}
+
+OShaderPermutationSpace MakeSpace()
+{
+	OShaderPermutationSpace space;
+	for (const auto& name : Switches)
+	{
+		BOOST_REQUIRE(space.AddAxis(MakeAxis(name)));
+	}
+	BOOST_REQUIRE(space.AddAxis(MakeAxis("SHADOW_QUALITY", { "LOW", "MEDIUM", "HIGH" })));
+	return space;
+}
+
+/**
+ * @brief Opaque.hlsl in a fresh temporary directory, and the cache key descs the compiler builds for its pixel stage.
+ */
+struct SShaderFixture
+{
+	SShaderFixture()
+	    : Directory(std::filesystem::temp_directory_path() / ("RendererTests" + std::to_string(std::random_device{}())))
+	{
+		std::filesystem::create_directories(Directory);
+		std::ofstream(Directory / "Opaque.hlsl") << "float4 PS() : SV_Target { return 0; }\n";
+	}
+
+	~SShaderFixture()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(Directory, error);
+	}
+
+	// Same inputs as OShaderCompiler::MakeCacheKeyDesc, the command line is laid out like BuildCompilationArgs
+	SShaderCacheKeyDesc MakeDesc(const SDefines& Defines) const
+	{
+		SShaderCacheKeyDesc desc;
+		desc.SourcePath = Directory / "Opaque.hlsl";
+		desc.IncludeDirs = { Directory };
+		desc.EntryPoint = "PS";
+		desc.TargetProfile = "ps_6_0";
+		desc.CompilerVersion = "1.7.2308";
+		desc.Defines = Defines;
+
+		vector<string> commandLine = { "-E", "PS", "-T", "ps_6_0", "-WX", "-I", Directory.string(), "-O3" };
+		for (const auto& [name, value] : Defines)
+		{
+			commandLine.push_back("-D");
+			commandLine.push_back(name + "=" + value);
+		}
+		desc.SetArguments(commandLine);
+		return desc;
+	}
+
+	std::filesystem::path Directory;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ShaderPermutation)
+
+BOOST_AUTO_TEST_CASE(EveryFeatureBitMapsToItsDefine)
+{
+	const auto space = MakeSpace();
+	BOOST_TEST(space.GetNumBits() == 5);
+	BOOST_TEST(space.GetNumPermutations() == 24);
+
+	for (size_t i = 0; i < Switches.size(); i++)
+	{
+		const auto key = space.MakeKey({ { Switches[i], 1 } });
+		BOOST_TEST(key == 1ull << i);
+		BOOST_TEST(space.GetValue(key, i) == 1);
+
+		BOOST_TEST(Join(space.GetDefines(key)) == Switches[i] + "=1 SHADOW_QUALITY=LOW");
+	}
+
+	const vector<string> qualities = { "LOW", "MEDIUM", "HIGH" };
+	for (uint32_t value = 0; value < qualities.size(); value++)
+	{
+		const auto key = space.MakeKey({ { "SHADOW_QUALITY", value } });
+		BOOST_TEST(key == static_cast<TShaderPermutationKey>(value) << 3);
+		BOOST_TEST(Join(space.GetDefines(key)) == "SHADOW_QUALITY=" + qualities[value]);
+	}
+
+	// Every switch at once, values past the last one are clamped
+	const auto key = space.MakeKey({ { "FOG", 1 }, { "CARTOON", 1 }, { "ALPHA_TEST", 7 }, { "SHADOW_QUALITY", 9 }, { "UNKNOWN", 1 } });
+	BOOST_TEST(key == 0b10111);
+	BOOST_TEST(space.IsValid(key));
+	BOOST_TEST(space.ToString(key) == "FOG=1 CARTOON=1 ALPHA_TEST=1 SHADOW_QUALITY=HIGH");
+	BOOST_TEST(!space.IsValid(0b11000));
+	BOOST_TEST(!space.IsValid(1ull << 5));
+}
+
+BOOST_AUTO_TEST_CASE(AxesAreDeclaredOnce)
+{
+	auto space = MakeSpace();
+	BOOST_TEST(!space.AddAxis(MakeAxis("FOG")));
+	BOOST_TEST(space.GetAxes().size() == 4);
+
+	OShaderPermutationSpace full;
+	for (uint32_t i = 0; i < 64; i++)
+	{
+		BOOST_REQUIRE(full.AddAxis(MakeAxis("SWITCH_" + std::to_string(i))));
+	}
+	BOOST_TEST(!full.AddAxis(MakeAxis("SWITCH_64")));
+	BOOST_TEST(full.GetValue(full.MakeKey({ { "SWITCH_63", 1 } }), 63) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(StageDefinesArePreserved)
+{
+	const auto space = MakeSpace();
+	const SDefines stage = { { "ALPHA_TEST", "1" }, { "NUM_LIGHTS", "4" } };
+
+	// A permutation only adds to what the stage declares in ShaderConfig.json
+	BOOST_TEST(Join(space.GetDefines(space.MakeKey({ { "FOG", 1 } }), stage)) == "ALPHA_TEST=1 NUM_LIGHTS=4 FOG=1 SHADOW_QUALITY=LOW");
+
+	// An axis named like a stage define replaces its value instead of passing the macro twice
+	BOOST_TEST(Join(space.GetDefines(space.MakeKey({ { "SHADOW_QUALITY", 2 } }), stage)) == "ALPHA_TEST=1 NUM_LIGHTS=4 SHADOW_QUALITY=HIGH");
+	BOOST_TEST(Join(space.GetDefines(space.MakeKey({ { "ALPHA_TEST", 0 } }), stage)) == "ALPHA_TEST=1 NUM_LIGHTS=4 SHADOW_QUALITY=LOW");
+	BOOST_TEST(Join(space.GetDefines(0, { { "SHADOW_QUALITY", "MEDIUM" } })) == "SHADOW_QUALITY=LOW");
+}
+
+BOOST_FIXTURE_TEST_CASE(CommandLineDefinesAndIncludesArentArguments, SShaderFixture)
+{
+	const auto desc = MakeDesc({ { "FOG", "1" }, { "ALPHA_TEST", "1" } });
+	BOOST_TEST(desc.Arguments == vector<string>({ "-E", "PS", "-T", "ps_6_0", "-WX", "-O3" }), boost::test_tools::per_element());
+	BOOST_TEST(desc.Defines.size() == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(DistinctFeatureSetsHaveDistinctCacheKeys, SShaderFixture)
+{
+	const auto space = MakeSpace();
+	const SDefines stage = { { "NUM_LIGHTS", "4" } };
+
+	std::set<uint64_t> cacheKeys;
+	for (uint32_t fog = 0; fog < 2; fog++)
+	{
+		for (uint32_t cartoon = 0; cartoon < 2; cartoon++)
+		{
+			for (uint32_t alphaTest = 0; alphaTest < 2; alphaTest++)
+			{
+				for (uint32_t quality = 0; quality < 3; quality++)
+				{
+					const auto key = space.MakeKey({ { "FOG", fog }, { "CARTOON", cartoon }, { "ALPHA_TEST", alphaTest }, { "SHADOW_QUALITY", quality } });
+					const auto cacheKey = OShaderCache::ComputeKey(MakeDesc(space.GetDefines(key, stage)));
+					BOOST_REQUIRE(cacheKey.has_value());
+					cacheKeys.insert(*cacheKey);
+
+					// The same features always produce the same key
+					BOOST_TEST(*OShaderCache::ComputeKey(MakeDesc(space.GetDefines(key, stage))) == *cacheKey);
+				}
+			}
+		}
+	}
+	BOOST_TEST(cacheKeys.size() == space.GetNumPermutations());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
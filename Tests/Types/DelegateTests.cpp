@@ -0,0 +1,308 @@
+#include "Delegate.h"
+
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+namespace
+{
+/**
+ * @brief Callable counting its live instances and move constructions. Payload pads it to the requested size, moves only
+ * happen to callables stored inline, heap allocated ones are handed over by pointer.
+ */
+template<size_t Size>
+struct STrackedCallable
+{
+	inline static int NumAlive = 0;
+	inline static int NumMoves = 0;
+
+	STrackedCallable(int* InCalls)
+	    : Calls(InCalls)
+	{
+		NumAlive++;
+	}
+
+	STrackedCallable(const STrackedCallable& Other)
+	    : Calls(Other.Calls)
+	{
+		NumAlive++;
+	}
+
+	STrackedCallable(STrackedCallable&& Other) noexcept
+	    : Calls(Other.Calls)
+	{
+		NumAlive++;
+		NumMoves++;
+	}
+
+	~STrackedCallable()
+	{
+		NumAlive--;
+	}
+
+	int operator()(int Value)
+	{
+		(*Calls)++;
+		return Value + static_cast<int>(Size);
+	}
+
+	static void Reset()
+	{
+		NumAlive = 0;
+		NumMoves = 0;
+	}
+
+	int* Calls = nullptr;
+	std::array<std::byte, Size - sizeof(int*)> Payload{};
+};
+
+using TFunction = TInlineFunction<int(int)>;
+using SInlineCallable = STrackedCallable<TFunction::InlineSize>;
+using SHeapCallable = STrackedCallable<TFunction::InlineSize + sizeof(void*)>;
+
+static_assert(sizeof(SInlineCallable) == TFunction::InlineSize);
+static_assert(!std::is_copy_constructible_v<TFunction> && !std::is_copy_assignable_v<TFunction>);
+
+DECLARE_DELEGATE(SOnTick)
+DECLARE_DELEGATE(SOnValue, int)
+DECLARE_SINGLE_DELEGATE(SOnDone)
+
+struct SCounter
+{
+	void Add(int Value)
+	{
+		Sum += Value;
+	}
+
+	int Sum = 0;
+};
+
+struct SDelegateFixture
+{
+	SDelegateFixture()
+	{
+		SInlineCallable::Reset();
+		SHeapCallable::Reset();
+	}
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(Delegate, SDelegateFixture)
+
+BOOST_AUTO_TEST_CASE(InlineCallablesMoveWithTheFunction)
+{
+	int calls = 0;
+	{
+		TFunction function = SInlineCallable(&calls);
+		BOOST_TEST(SInlineCallable::NumAlive == 1);
+		const int moves = SInlineCallable::NumMoves;
+
+		TFunction moved = std::move(function);
+		BOOST_TEST(!function);
+		BOOST_TEST(SInlineCallable::NumMoves == moves + 1);
+		BOOST_TEST(SInlineCallable::NumAlive == 1);
+		BOOST_TEST(moved(1) == 1 + static_cast<int>(TFunction::InlineSize));
+
+		TFunction assigned;
+		assigned = std::move(moved);
+		BOOST_TEST(SInlineCallable::NumMoves == moves + 2);
+		BOOST_TEST(assigned(0) == static_cast<int>(TFunction::InlineSize));
+		BOOST_TEST(calls == 2);
+	}
+	BOOST_TEST(SInlineCallable::NumAlive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(LargeCallablesAreAllocatedOnce)
+{
+	int calls = 0;
+	{
+		TFunction function = SHeapCallable(&calls);
+		BOOST_TEST(SHeapCallable::NumAlive == 1);
+		const int moves = SHeapCallable::NumMoves;
+
+		// Only the pointer changes hands
+		TFunction moved = std::move(function);
+		TFunction assigned;
+		assigned = std::move(moved);
+		BOOST_TEST(!function);
+		BOOST_TEST(!moved);
+		BOOST_TEST(SHeapCallable::NumMoves == moves);
+		BOOST_TEST(SHeapCallable::NumAlive == 1);
+		BOOST_TEST(assigned(1) == 1 + static_cast<int>(sizeof(SHeapCallable)));
+		BOOST_TEST(calls == 1);
+
+		// Assigning over a bound function releases the callable it held
+		assigned = SInlineCallable(&calls);
+		BOOST_TEST(SHeapCallable::NumAlive == 0);
+	}
+	BOOST_TEST(SInlineCallable::NumAlive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(CallablesThrowingOnMoveAreAllocated)
+{
+	struct SThrowingMove
+	{
+		SThrowingMove() = default;
+		SThrowingMove(SThrowingMove&&) noexcept(false) {}
+		int operator()(int Value) { return Value; }
+	};
+
+	// The move constructor is never called, the function stays noexcept
+	TFunction function = SThrowingMove();
+	TFunction moved = std::move(function);
+	BOOST_TEST(moved(5) == 5);
+	BOOST_TEST(std::is_nothrow_move_constructible_v<TFunction>);
+}
+
+BOOST_AUTO_TEST_CASE(MoveOnlyCallablesAreAccepted)
+{
+	auto value = std::make_unique<int>(7);
+	TFunction function = [value = std::move(value)](int Offset) { return *value + Offset; };
+	TFunction moved = std::move(function);
+	BOOST_TEST(moved(1) == 8);
+}
+
+BOOST_AUTO_TEST_CASE(AddedDuringBroadcastRunsNextTime)
+{
+	SOnValue delegate;
+	vector<int> calls;
+	delegate.Add([&](int Value) {
+		calls.push_back(Value);
+		if (Value == 1)
+		{
+			delegate.Add([&](int Value) { calls.push_back(Value * 10); });
+		}
+	});
+
+	delegate.Broadcast(1);
+	BOOST_TEST(calls == vector<int>({ 1 }), boost::test_tools::per_element());
+	BOOST_TEST(delegate.Num() == 2);
+
+	delegate.Broadcast(2);
+	BOOST_TEST(calls == vector<int>({ 1, 2, 20 }), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(RemovedDuringBroadcastIsSkipped)
+{
+	SOnValue delegate;
+	vector<int> calls;
+	SDelegateHandle self;
+	SDelegateHandle later;
+	delegate.Add([&](int) { calls.push_back(0); });
+	self = delegate.Add([&](int) {
+		calls.push_back(1);
+		BOOST_TEST(delegate.Remove(self));
+		BOOST_TEST(delegate.Remove(later));
+	});
+	later = delegate.Add([&](int) { calls.push_back(2); });
+
+	delegate.Broadcast(0);
+	BOOST_TEST(calls == vector<int>({ 0, 1 }), boost::test_tools::per_element());
+	BOOST_TEST(delegate.Num() == 1);
+
+	delegate.Broadcast(0);
+	BOOST_TEST(calls == vector<int>({ 0, 1, 0 }), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(PendingSlotsCanBeRemoved)
+{
+	SOnTick delegate;
+	int calls = 0;
+	delegate.Add([&]() {
+		const auto handle = delegate.Add([&]() { calls += 100; });
+		BOOST_TEST(delegate.Remove(handle));
+		BOOST_TEST(!delegate.Remove(handle));
+		calls++;
+	});
+
+	delegate.Broadcast();
+	delegate.Broadcast();
+	BOOST_TEST(calls == 2);
+	BOOST_TEST(delegate.Num() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(NestedBroadcastsApplyChangesAtTheEnd)
+{
+	SOnValue delegate;
+	vector<int> calls;
+	delegate.Add([&](int Depth) {
+		calls.push_back(Depth);
+		if (Depth == 0)
+		{
+			delegate.Add([&](int Depth) { calls.push_back(100 + Depth); });
+			delegate.Broadcast(1);
+		}
+	});
+
+	delegate.Broadcast(0);
+	BOOST_TEST(calls == vector<int>({ 0, 1 }), boost::test_tools::per_element());
+	BOOST_TEST(delegate.Num() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(HandlesAreRemovedOnce)
+{
+	SOnTick delegate;
+	const auto first = delegate.Add([]() {});
+	const auto second = delegate.Add([]() {});
+	BOOST_TEST(first.IsValid());
+	BOOST_TEST(!(first == second));
+
+	BOOST_TEST(delegate.Remove(first));
+	BOOST_TEST(!delegate.Remove(first));
+	BOOST_TEST(!delegate.Remove(SDelegateHandle()));
+	BOOST_TEST(delegate.Num() == 1);
+
+	// Ids aren't reused, a stale handle can't remove a newer binding
+	const auto third = delegate.Add([]() {});
+	BOOST_TEST(!(third == first));
+	BOOST_TEST(!delegate.Remove(first));
+	BOOST_TEST(delegate.Num() == 2);
+
+	delegate.RemoveAll();
+	BOOST_TEST(!delegate.IsBound());
+	BOOST_TEST(!delegate.Remove(second));
+}
+
+BOOST_AUTO_TEST_CASE(MembersAreBound)
+{
+	SCounter counter;
+	SOnValue delegate;
+	delegate.AddMember(&counter, &SCounter::Add);
+	delegate.Broadcast(3);
+	delegate.Broadcast(4);
+	BOOST_TEST(counter.Sum == 7);
+}
+
+BOOST_AUTO_TEST_CASE(SingleDelegatesHoldOneCallable)
+{
+	SOnDone delegate;
+	BOOST_TEST(!delegate.IsBound());
+	BOOST_CHECK_THROW(delegate.Execute(), std::runtime_error);
+	delegate.ExecuteIfBound();
+
+	int calls = 0;
+	delegate.Bind([&]() { calls++; });
+	delegate.Bind([&]() { calls += 10; });
+	delegate.Execute();
+	delegate.ExecuteIfBound();
+	BOOST_TEST(calls == 20);
+
+	delegate.Unbind();
+	delegate.ExecuteIfBound();
+	BOOST_TEST(calls == 20);
+
+	SSingleDelegate<int, int> single;
+	int heapCalls = 0;
+	single.Bind(SHeapCallable(&heapCalls));
+	BOOST_TEST(single.Execute(1) == 1 + static_cast<int>(sizeof(SHeapCallable)));
+	single.Unbind();
+	BOOST_TEST(SHeapCallable::NumAlive == 0);
+
+	SCounter counter;
+	SSingleDelegate<void, int> member;
+	member.BindMember(&counter, &SCounter::Add);
+	member.Execute(5);
+	BOOST_TEST(counter.Sum == 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+#include "PSOReader/PsoTables.h"
+#include "Stats/Stats.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+// Red and Green share a slot with the first seed, the table has to search for another one
+ENUM(ETestChannel, Red, Green, Stencil)
+
+ENUM(ESingle, Only)
+
+template<typename TEnum>
+void CheckRoundTrip(const vector<string>& Names)
+{
+	BOOST_REQUIRE(Names.size() == static_cast<size_t>(TEnum::Num) + 1);
+	for (size_t i = 0; i < Names.size(); i++)
+	{
+		const auto value = static_cast<TEnum>(i);
+		BOOST_TEST(ToString(value) == Names[i]);
+		BOOST_TEST((FromString<TEnum>(Names[i]) == value), Names[i]);
+	}
+}
+
+template<typename TValue, size_t N>
+void CheckTable(const OEnumTable<TValue, N>& Table)
+{
+	for (const auto& entry : Table.GetEntries())
+	{
+		BOOST_TEST((Table.FromString(entry.Name) == entry.Value), entry.Name);
+		BOOST_TEST(Table.ToString(entry.Value) == entry.Name);
+		BOOST_TEST(!Table.FromString(string(entry.Name) + "_").has_value());
+		BOOST_TEST(!Table.FromString(entry.Name.substr(1)).has_value());
+	}
+}
+
+struct SLogFixture
+{
+	SLogFixture()
+	{
+		STestLog::Reset();
+	}
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EnumReflection, SLogFixture)
+
+BOOST_AUTO_TEST_CASE(StatNamesRoundTrip)
+{
+	CheckRoundTrip<EStatCounter>({
+	    "DrawCalls",
+	    "InstancesVisible",
+	    "InstancesCulled",
+	    "UploadBytesCopied",
+	    "PSOSwitches",
+	    "RedundantResourceSetsSkipped",
+	    "TexturesLoaded",
+	    "InputEventsDispatched",
+	    "InputEventsCoalesced",
+	    "InputEventsDropped",
+	    "CommandsRecorded",
+	    "CommandValidationErrors",
+	    "BarriersRequested",
+	    "BarriersIssued",
+	    "BarrierBatches",
+	    "CPUWaitsOnGPU",
+	    "CommandAllocatorsCreated",
+	    "UploadRingStalls",
+	    "ShaderPermutationsLive",
+	    "ShaderPermutationsPending",
+	    "ShaderPermutationFallbacks",
+	    "RenderNodesSkipped",
+	    "BarrierStateMismatches",
+	    "Num",
+	});
+	CheckRoundTrip<EStatHistogram>({ "FrameTimeUs", "CPUFrameTimeUs", "InstancesPerDraw", "RecordingTimeUs", "CPUWaitTimeUs", "Num" });
+	BOOST_TEST(NumStatCounters == 23);
+	BOOST_TEST(NumStatHistograms == 5);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownNamesAndValuesFallBack)
+{
+	BOOST_TEST(!FromString<EStatCounter>("").has_value());
+	BOOST_TEST(!FromString<EStatCounter>("drawcalls").has_value());
+	BOOST_TEST(!FromString<EStatCounter>("DrawCall").has_value());
+	BOOST_TEST(!FromString<EStatCounter>("DrawCallsX").has_value());
+	BOOST_TEST(!FromString<EStatCounter>(" DrawCalls").has_value());
+	BOOST_TEST(!FromString<EStatCounter>("FrameTimeUs").has_value());
+	BOOST_TEST(!FromString<EStatCounter>(std::string_view("DrawCalls\0", 10)).has_value());
+
+	BOOST_TEST(ToString(static_cast<EStatCounter>(NumStatCounters + 1)) == "Unknown");
+	BOOST_TEST(ToString(static_cast<EStatHistogram>(-1)) == "Unknown");
+	BOOST_TEST(ToString(ESingle::Only) == "Only");
+	BOOST_TEST(!FromString<ESingle>("").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(CollidingNamesGetTheirOwnSlots)
+{
+	// Three names take eight slots, picked by the top three bits of the hash
+	const auto slot = [](std::string_view Name) { return ETestChannelTable.Hash(Name, 0) >> 29; };
+	BOOST_REQUIRE(slot("Red") == slot("Green"));
+
+	BOOST_TEST((FromString<ETestChannel>("Red") == ETestChannel::Red));
+	BOOST_TEST((FromString<ETestChannel>("Green") == ETestChannel::Green));
+	BOOST_TEST((FromString<ETestChannel>("Stencil") == ETestChannel::Stencil));
+
+	// Names outside the table that land in a taken slot are compared against its entry and rejected
+	for (const auto name : { "Blue", "Alpha", "Depth", "Additive", "Re", "Greens" })
+	{
+		BOOST_TEST(!FromString<ETestChannel>(name).has_value(), name);
+	}
+	CheckTable(ETestChannelTable);
+	CheckTable(EStatCounterTable);
+}
+
+BOOST_AUTO_TEST_CASE(PSOTablesDecodeEveryName)
+{
+	CheckTable(PSOTables::LogicOps);
+	CheckTable(PSOTables::BlendOps);
+	CheckTable(PSOTables::Blends);
+	CheckTable(PSOTables::CullModes);
+	CheckTable(PSOTables::ConservativeRasterizationModes);
+	CheckTable(PSOTables::FillModes);
+	CheckTable(PSOTables::DepthWriteMasks);
+	CheckTable(PSOTables::ComparisonFuncs);
+	CheckTable(PSOTables::StencilOps);
+	CheckTable(PSOTables::ColorWriteEnables);
+	CheckTable(PSOTables::TopologyTypes);
+	CheckTable(PSOTables::Formats);
+	CheckTable(PSOTables::PipelineStateFlags);
+
+	BOOST_TEST(PSOTables::Decode(PSOTables::Blends, "InvSrcAlpha", D3D12_BLEND_ZERO, L"blend") == D3D12_BLEND_INV_SRC_ALPHA);
+	BOOST_TEST(PSOTables::Decode(PSOTables::ComparisonFuncs, "LessEqual", D3D12_COMPARISON_FUNC_NEVER, L"comparison func") == D3D12_COMPARISON_FUNC_LESS_EQUAL);
+	BOOST_TEST(STestLog::NumErrors == 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownPSONamesAreReportedAndReadAsTheDefault)
+{
+	BOOST_TEST(PSOTables::Decode(PSOTables::CullModes, "back", D3D12_CULL_MODE_NONE, L"cull mode") == D3D12_CULL_MODE_NONE);
+	BOOST_TEST(PSOTables::Decode(PSOTables::StencilOps, "", D3D12_STENCIL_OP_KEEP, L"stencil op") == D3D12_STENCIL_OP_KEEP);
+	BOOST_TEST(STestLog::NumErrors == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #include "DDSTextureLoader/DDSTextureLoader.h"
 #include "Exception.h"
 #include "Logger.h"
+#include "Stats/Stats.h"
 
 #include <filesystem>
 #include <numeric>
@@ -55,6 +56,7 @@ void OTextureManager::LoadLocalTextures()
 	CommandQueue->TryResetCommandList();
 	RemoveAllTextures();
 
+	vector<SResourceTransition> transitions;
 	for (const auto& texture : Parser->LoadTextures())
 	{
 		texture->HeapIdx = Textures.size();
@@ -67,10 +69,13 @@ void OTextureManager::LoadLocalTextures()
 		texture->Resource.Init(this,D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		texture->Resource.Resource->SetName(texture->FileName.c_str());
 
-			CommandQueue->ResourceBarrier(&texture->Resource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
 		LOG(Engine, Log, "Texture created from config: Name : {}, Path: {}", TEXT(texture->Name), texture->FileName);
-		AddTexture(make_unique<STexture>(*texture));
+		STAT_INC(TexturesLoaded);
+		auto newTexture = make_unique<STexture>(*texture);
+		transitions.push_back({ &newTexture->Resource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE });
+		AddTexture(move(newTexture));
 	}
+	CommandQueue->ResourceBarriers(transitions);
 	CommandQueue->ExecuteCommandListAndWait();
 }
 
@@ -159,6 +164,7 @@ STexture* OTextureManager::CreateTexture(string Name, wstring FileName)
 	}
 
 	LOG(Engine, Log, "Texture created: Name : {}, Path: {}", TEXT(Name), FileName);
+	STAT_INC(TexturesLoaded);
 
 	auto result = texture.get();
 	AddTexture(std::move(texture));
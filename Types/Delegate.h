@@ -0,0 +1,366 @@
+#pragma once
+#include "Types.h"
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Stable identifier of a bound callable. Stays valid until the callable is removed, regardless of other bindings.
+ */
+struct SDelegateHandle
+{
+	uint64_t Id = 0;
+
+	bool IsValid() const
+	{
+		return Id != 0;
+	}
+
+	bool operator==(const SDelegateHandle& Other) const = default;
+};
+
+template<typename Signature>
+class TInlineFunction;
+
+/**
+ * @brief Move only type erased callable. Callables up to InlineSize bytes live in the object itself,
+ * larger ones are allocated once on bind. Invocation never allocates.
+ */
+template<typename ReturnType, typename... Args>
+class TInlineFunction<ReturnType(Args...)>
+{
+public:
+	static constexpr size_t InlineSize = 4 * sizeof(void*);
+
+	TInlineFunction() = default;
+
+	template<typename Func>
+	    requires(!std::is_same_v<std::decay_t<Func>, TInlineFunction> && std::is_invocable_r_v<ReturnType, std::decay_t<Func>&, Args...>)
+	TInlineFunction(Func&& Callable)
+	{
+		using TCallable = std::decay_t<Func>;
+		if constexpr (FitsInline<TCallable>())
+		{
+			new (Storage) TCallable(std::forward<Func>(Callable));
+		}
+		else
+		{
+			*reinterpret_cast<TCallable**>(Storage) = new TCallable(std::forward<Func>(Callable));
+		}
+		Ops = GetOps<TCallable>();
+	}
+
+	TInlineFunction(TInlineFunction&& Other) noexcept
+	{
+		MoveFrom(Other);
+	}
+
+	TInlineFunction& operator=(TInlineFunction&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Reset();
+			MoveFrom(Other);
+		}
+		return *this;
+	}
+
+	TInlineFunction(const TInlineFunction&) = delete;
+	TInlineFunction& operator=(const TInlineFunction&) = delete;
+
+	~TInlineFunction()
+	{
+		Reset();
+	}
+
+	ReturnType operator()(Args... Arguments)
+	{
+		return Ops->Invoke(Storage, std::forward<Args>(Arguments)...);
+	}
+
+	explicit operator bool() const
+	{
+		return Ops != nullptr;
+	}
+
+	void Reset()
+	{
+		if (Ops)
+		{
+			Ops->Destroy(Storage);
+			Ops = nullptr;
+		}
+	}
+
+private:
+	struct SOperations
+	{
+		ReturnType (*Invoke)(void* Storage, Args&&... Arguments);
+		void (*Move)(void* Dest, void* Src);
+		void (*Destroy)(void* Storage);
+	};
+
+	template<typename TCallable>
+	static constexpr bool FitsInline()
+	{
+		return sizeof(TCallable) <= InlineSize && alignof(TCallable) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<TCallable>;
+	}
+
+	template<typename TCallable>
+	static TCallable* GetCallable(void* Storage)
+	{
+		if constexpr (FitsInline<TCallable>())
+		{
+			return std::launder(reinterpret_cast<TCallable*>(Storage));
+		}
+		else
+		{
+			return *reinterpret_cast<TCallable**>(Storage);
+		}
+	}
+
+	template<typename TCallable>
+	static const SOperations* GetOps()
+	{
+		static constexpr SOperations operations = {
+			[](void* Storage, Args&&... Arguments) -> ReturnType {
+				return (*GetCallable<TCallable>(Storage))(std::forward<Args>(Arguments)...);
+			},
+			[](void* Dest, void* Src) {
+				if constexpr (FitsInline<TCallable>())
+				{
+					TCallable* source = GetCallable<TCallable>(Src);
+					new (Dest) TCallable(std::move(*source));
+					source->~TCallable();
+				}
+				else
+				{
+					*reinterpret_cast<TCallable**>(Dest) = *reinterpret_cast<TCallable**>(Src);
+				}
+			},
+			[](void* Storage) {
+				if constexpr (FitsInline<TCallable>())
+				{
+					GetCallable<TCallable>(Storage)->~TCallable();
+				}
+				else
+				{
+					delete GetCallable<TCallable>(Storage);
+				}
+			}
+		};
+		return &operations;
+	}
+
+	void MoveFrom(TInlineFunction& Other)
+	{
+		if (Other.Ops)
+		{
+			Other.Ops->Move(Storage, Other.Storage);
+			Ops = Other.Ops;
+			Other.Ops = nullptr;
+		}
+	}
+
+	alignas(std::max_align_t) std::byte Storage[InlineSize];
+	const SOperations* Ops = nullptr;
+};
+
+/**
+ * @brief Single cast delegate, holds at most one callable.
+ */
+template<typename ReturnType, typename... Args>
+struct SSingleDelegate
+{
+	template<typename Func>
+	void Bind(Func&& Function)
+	{
+		Callable = TInlineFunction<ReturnType(Args...)>(std::forward<Func>(Function));
+	}
+
+	template<typename Obj, typename Func>
+	void BindMember(Obj* Object, Func&& Function)
+	{
+		Bind([Object, Function](Args... Arguments) -> ReturnType {
+			return (Object->*Function)(std::forward<Args>(Arguments)...);
+		});
+	}
+
+	void Unbind()
+	{
+		Callable.Reset();
+	}
+
+	bool IsBound() const
+	{
+		return static_cast<bool>(Callable);
+	}
+
+	template<typename... LocArgs>
+	ReturnType Execute(LocArgs&&... Arguments)
+	{
+		if (!IsBound())
+		{
+			throw std::runtime_error("Executing unbound delegate!");
+		}
+		return Callable(std::forward<LocArgs>(Arguments)...);
+	}
+
+	template<typename... LocArgs>
+	void ExecuteIfBound(LocArgs&&... Arguments)
+	{
+		if (IsBound())
+		{
+			Callable(std::forward<LocArgs>(Arguments)...);
+		}
+	}
+
+private:
+	TInlineFunction<ReturnType(Args...)> Callable;
+};
+
+template<typename ReturnType>
+struct SSingleDelegate<ReturnType, void> : SSingleDelegate<ReturnType>
+{
+};
+
+/**
+ * @brief Multicast delegate. Binding may allocate slot storage, broadcasting does not.
+ * Callables may add or remove bindings (including themselves) while being broadcast, such changes are applied once the broadcast ends.
+ */
+template<typename ReturnType, typename... Args>
+struct SDelegate
+{
+	template<typename Func>
+	SDelegateHandle Add(Func&& Function)
+	{
+		const SDelegateHandle handle{ NextId++ };
+		auto& slots = BroadcastDepth > 0 ? PendingSlots : Slots;
+		slots.push_back({ handle.Id, TInlineFunction<ReturnType(Args...)>(std::forward<Func>(Function)) });
+		return handle;
+	}
+
+	template<typename Obj, typename Func>
+	SDelegateHandle AddMember(Obj* Object, Func&& Function)
+	{
+		return Add([Object, Function](Args... Arguments) -> ReturnType {
+			return (Object->*Function)(std::forward<Args>(Arguments)...);
+		});
+	}
+
+	bool Remove(SDelegateHandle Handle)
+	{
+		if (!Handle.IsValid())
+		{
+			return false;
+		}
+
+		for (auto* slots : { &Slots, &PendingSlots })
+		{
+			for (auto& slot : *slots)
+			{
+				if (slot.Id == Handle.Id)
+				{
+					slot.Id = 0;
+					bHasRemovedSlots = true;
+					TryCompact();
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void RemoveAll()
+	{
+		for (auto& slot : Slots)
+		{
+			slot.Id = 0;
+		}
+		PendingSlots.clear();
+		bHasRemovedSlots = true;
+		TryCompact();
+	}
+
+	bool IsBound() const
+	{
+		return Num() > 0;
+	}
+
+	size_t Num() const
+	{
+		size_t result = 0;
+		for (const auto* slots : { &Slots, &PendingSlots })
+		{
+			for (const auto& slot : *slots)
+			{
+				result += slot.Id != 0;
+			}
+		}
+		return result;
+	}
+
+	template<typename... LocArgs>
+	void Broadcast(LocArgs&&... Arguments)
+	{
+		BroadcastDepth++;
+		const size_t count = Slots.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			if (Slots[i].Id != 0)
+			{
+				Slots[i].Function(Arguments...);
+			}
+		}
+		BroadcastDepth--;
+		TryCompact();
+	}
+
+private:
+	struct SSlot
+	{
+		uint64_t Id = 0;
+		TInlineFunction<ReturnType(Args...)> Function;
+	};
+
+	void TryCompact()
+	{
+		if (BroadcastDepth > 0)
+		{
+			return;
+		}
+
+		if (bHasRemovedSlots)
+		{
+			std::erase_if(Slots, [](const SSlot& Slot) { return Slot.Id == 0; });
+			std::erase_if(PendingSlots, [](const SSlot& Slot) { return Slot.Id == 0; });
+			bHasRemovedSlots = false;
+		}
+
+		for (auto& slot : PendingSlots)
+		{
+			Slots.push_back(std::move(slot));
+		}
+		PendingSlots.clear();
+	}
+
+	vector<SSlot> Slots;
+	vector<SSlot> PendingSlots;
+	uint64_t NextId = 1;
+	uint32_t BroadcastDepth = 0;
+	bool bHasRemovedSlots = false;
+};
+
+template<typename ReturnType>
+struct SDelegate<ReturnType, void> : SDelegate<ReturnType>
+{
+};
+
+#define DECLARE_DELEGATE(Type, ...) \
+	using Type = SDelegate<void, ##__VA_ARGS__>;
+
+#define DECLARE_SINGLE_DELEGATE(Type, ...) \
+	using Type = SSingleDelegate<void, ##__VA_ARGS__>;
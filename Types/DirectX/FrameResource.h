@@ -1,5 +1,5 @@
 #pragma once
-#include "Engine/UploadBuffer/UploadBuffer.h"
+#include "Engine/UploadBuffer/UploadRingBuffer.h"
 #include "InstanceData.h"
 #include "Logger.h"
 #include "MaterialData.h"
@@ -12,7 +12,7 @@
 
 struct SFrameResource
 {
-	SFrameResource(ID3D12Device* Device, IRenderObject* Owner);
+	SFrameResource(OUploadRingBuffer* Ring);
 
 	SFrameResource(const SFrameResource&) = delete;
 
@@ -21,7 +21,8 @@ struct SFrameResource
 	~SFrameResource();
 
 	// We cannot update a cbuffer until the GPU is done processing the
-	// commands that reference it. So each frame needs their own cbuffers.
+	// commands that reference it. So each frame sub allocates its buffers
+	// from the upload ring, the memory is reclaimed once the fence passed.
 
 	void SetPass(UINT PassCount);
 	void SetInstances(UINT InstanceCount);
@@ -29,19 +30,16 @@ struct SFrameResource
 	void SetDirectionalLight(UINT LightCount);
 	void SetPointLight(UINT LightCount);
 	void SetSpotLight(UINT LightCount);
-	unique_ptr<OUploadBuffer<SPassConstants>> PassCB = nullptr;
-	unique_ptr<OUploadBuffer<SMaterialData>> MaterialBuffer = nullptr;
-	std::unique_ptr<OUploadBuffer<SInstanceData>> InstanceBuffer = nullptr;
+	TUploadAllocation<SPassConstants> PassCB;
+	TUploadAllocation<SMaterialData> MaterialBuffer;
+	TUploadAllocation<SInstanceData> InstanceBuffer;
 
-	TUploadBuffer<SDirectionalLight> DirectionalLightBuffer;
-	TUploadBuffer<SPointLight> PointLightBuffer;
-	TUploadBuffer<SSpotLight> SpotLightBuffer;
+	TUploadAllocation<SDirectionalLight> DirectionalLightBuffer;
+	TUploadAllocation<SPointLight> PointLightBuffer;
+	TUploadAllocation<SSpotLight> SpotLightBuffer;
 
 	// Fence value to mark commands up to this fence point. This lets us
 	// check if these frame resources are still in use by the GPU.
 	UINT64 Fence = 0;
-	IRenderObject* Owner = nullptr;
-	ID3D12Device* Device = nullptr;
-
+	OUploadRingBuffer* Ring = nullptr;
 };
-
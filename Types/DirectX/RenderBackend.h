@@ -0,0 +1,21 @@
+#pragma once
+#include "Types.h"
+
+ENUM(ERenderBackend, D3D12, Headless)
+
+/**
+ * @brief Process wide render backend selection, has to be set before the engine is initialized.
+ * The headless backend still runs on D3D12, it creates the device on the WARP adapter and keeps the window hidden. Command
+ * lists are recorded into real upload heaps and descriptors but never submitted, fences are signaled from the CPU and
+ * presentation is stubbed, so the frame loop can be profiled on a Windows machine without a GPU. Without D3D12 at all,
+ * OFrameLoop runs the render graph through the CPU only ONullRenderDevice behind IRenderDevice, see RenderBackend/RenderDevice.h.
+ */
+struct SRenderBackend
+{
+	inline static ERenderBackend Backend = ERenderBackend::D3D12;
+
+	static bool IsHeadless()
+	{
+		return Backend == ERenderBackend::Headless;
+	}
+};
@@ -23,6 +23,17 @@ struct SRenderConstants
 	inline static constexpr DXGI_FORMAT BackBufferFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 	inline static constexpr DXGI_FORMAT DepthBufferFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
 	inline static constexpr uint32_t NumFrameResources = 3;
+	inline static constexpr uint64_t UploadRingSize = 64 * 1024 * 1024;
+
+	// Descriptor heaps are sized once, objects allocate from them at runtime
+	inline static constexpr uint32_t MaxSRVDescriptors = 16384;
+	inline static constexpr uint32_t TransientSRVDescriptorsPerFrame = 1024;
+	inline static constexpr uint32_t MaxRTVDescriptors = 1024;
+	inline static constexpr uint32_t MaxDSVDescriptors = 256;
+
+	// Constant buffers declared in this register space become root constants instead of root descriptors
+	inline static constexpr uint32_t RootConstantsSpace = 7;
+
 	inline static constexpr uint32_t MaxLights = 16;
 	inline static constexpr uint32_t RenderBuffersCount = 2;
 	inline static constexpr DirectX::XMUINT2 CubeMapDefaultResolution = { 1024, 1024 };
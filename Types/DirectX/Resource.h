@@ -1,6 +1,8 @@
 #pragma once
 #include "DXHelper.h"
 
+#include <optional>
+
 class IRenderObject;
 struct SResourceInfo
 {
@@ -14,3 +16,13 @@ struct SResourceInfo
 	ComPtr<ID3D12Resource> Resource;
 	IRenderObject* Context;
 };
+
+struct SResourceTransition
+{
+	SResourceInfo* Resource = nullptr;
+	D3D12_RESOURCE_STATES After = D3D12_RESOURCE_STATE_COMMON;
+	D3D12_RESOURCE_BARRIER_FLAGS Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+
+	// State the caller expects the resource in, the tracked state is used when unset
+	std::optional<D3D12_RESOURCE_STATES> Before;
+};
@@ -1 +1,56 @@
-#include "ShaderTypes.h"
\ No newline at end of file
+#include "ShaderTypes.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+namespace
+{
+struct SShaderSlotTable
+{
+	std::shared_mutex Mutex;
+	unordered_map<string, TShaderSlot> Slots;
+
+	// Deque keeps the names in place while the table grows, GetName hands out references
+	std::deque<string> Names;
+};
+
+SShaderSlotTable& GetSlotTable()
+{
+	static SShaderSlotTable table;
+	return table;
+}
+} // namespace
+
+TShaderSlot SShaderSlots::Intern(const string& Name)
+{
+	auto& table = GetSlotTable();
+	{
+		std::shared_lock lock(table.Mutex);
+		if (const auto it = table.Slots.find(Name); it != table.Slots.end())
+		{
+			return it->second;
+		}
+	}
+
+	std::unique_lock lock(table.Mutex);
+	const auto [it, bInserted] = table.Slots.try_emplace(Name, static_cast<TShaderSlot>(table.Names.size()));
+	if (bInserted)
+	{
+		table.Names.push_back(Name);
+	}
+	return it->second;
+}
+
+TShaderSlot SShaderSlots::Intern(const wstring& Name)
+{
+	return Intern(WStringToUTF8(Name));
+}
+
+const string& SShaderSlots::GetName(TShaderSlot Slot)
+{
+	static const string invalid = "INVALID";
+	auto& table = GetSlotTable();
+	std::shared_lock lock(table.Mutex);
+	return Slot < table.Names.size() ? table.Names[Slot] : invalid;
+}
@@ -3,6 +3,7 @@
 #include "Logger.h"
 #include "Types.h"
 
+class OPipelineLibrary;
 struct SRootSignatureParams;
 struct SShadersPipeline;
 struct SShaderPipelineDesc;
@@ -29,11 +30,7 @@ struct SShaderArrayText
 	string ComputeShaderName = "";
 };
 
-enum class EPSOType
-{
-	Graphics,
-	Compute
-};
+ENUM(EPSOType, Graphics, Compute)
 
 struct SPSODescriptionBase
 {
@@ -45,7 +42,17 @@ struct SPSODescriptionBase
 	shared_ptr<SShaderPipelineDesc> RootSignature;
 	ComPtr<ID3D12PipelineState> PSO;
 
-	virtual void BuildPipelineState(ID3D12Device* Device) = 0;
+	// Structural hash of the description PSO was built from, names it in the pipeline library
+	uint64_t Hash = 0;
+
+	// Library may be null, the pipeline state is then created on the device directly
+	virtual void BuildPipelineState(ID3D12Device* Device, OPipelineLibrary* Library) = 0;
+
+	// Copy that can be rebuilt off the render thread while this one is still in use
+	virtual unique_ptr<SPSODescriptionBase> Clone() const = 0;
+
+	// Takes over every field of Other, which has to be of the same type. Keeps the address render nodes hold on to.
+	virtual void CopyFrom(const SPSODescriptionBase& Other) = 0;
 
 	virtual void SetVertexByteCode(const D3D12_SHADER_BYTECODE& ByteCode) {}
 	virtual void SetPixelByteCode(const D3D12_SHADER_BYTECODE& ByteCode) {}
@@ -58,7 +65,9 @@ struct SPSODescriptionBase
 struct SPSOGraphicsDescription : SPSODescriptionBase
 {
 	SGraphicsPSODesc PSODesc;
-	void BuildPipelineState(ID3D12Device* Device) override;
+	void BuildPipelineState(ID3D12Device* Device, OPipelineLibrary* Library) override;
+	unique_ptr<SPSODescriptionBase> Clone() const override { return make_unique<SPSOGraphicsDescription>(*this); }
+	void CopyFrom(const SPSODescriptionBase& Other) override { *this = static_cast<const SPSOGraphicsDescription&>(Other); }
 	void SetVertexByteCode(const D3D12_SHADER_BYTECODE& ByteCode) override { PSODesc.VS = ByteCode; }
 	void SetPixelByteCode(const D3D12_SHADER_BYTECODE& ByteCode) override { PSODesc.PS = ByteCode; }
 	void SetGeometryByteCode(const D3D12_SHADER_BYTECODE& ByteCode) override { PSODesc.GS = ByteCode; }
@@ -70,7 +79,9 @@ struct SPSOComputeDescription : SPSODescriptionBase
 {
 	SComputePSODesc PSODesc;
 	void SetComputeByteCode(const D3D12_SHADER_BYTECODE& ByteCode) override { PSODesc.CS = ByteCode; }
-	void BuildPipelineState(ID3D12Device* Device) override;
+	void BuildPipelineState(ID3D12Device* Device, OPipelineLibrary* Library) override;
+	unique_ptr<SPSODescriptionBase> Clone() const override { return make_unique<SPSOComputeDescription>(*this); }
+	void CopyFrom(const SPSODescriptionBase& Other) override { *this = static_cast<const SPSOComputeDescription&>(Other); }
 };
 
 struct SShaderDefinition
@@ -82,6 +93,21 @@ struct SShaderDefinition
 	wstring ShaderEntry;
 };
 
+using TShaderSlot = uint32_t;
+
+/**
+ * @brief Process wide table interning shader resource names to dense integer slots. Names are interned once when shaders are
+ * reflected or by the caller up front, binding by slot avoids hashing strings while recording.
+ */
+struct SShaderSlots
+{
+	inline static constexpr TShaderSlot InvalidSlot = UINT32_MAX;
+
+	static TShaderSlot Intern(const string& Name);
+	static TShaderSlot Intern(const wstring& Name);
+	static const string& GetName(TShaderSlot Slot);
+};
+
 struct SRootParameter
 {
 	D3D12_ROOT_PARAMETER1 RootParameter;
@@ -97,10 +123,18 @@ struct SRootSignatureParams
 	std::unordered_map<wstring, uint32_t> RootParamIndexMap{};
 	vector<D3D12_DESCRIPTOR_RANGE1> DescriptorRanges{};
 	D3D12_VERSIONED_ROOT_SIGNATURE_DESC RootSignatureDesc{};
+	vector<CD3DX12_STATIC_SAMPLER_DESC> StaticSamplers{};
 	ComPtr<ID3D12RootSignature> RootSignature;
 
+	// Structural hash of the layout, equal for every pipeline sharing RootSignature
+	uint64_t RootSignatureHash = 0;
+
 private:
 	vector<D3D12_ROOT_PARAMETER1> RootParameters{};
+
+	// Indexed by TShaderSlot, -1 for resources the shaders don't declare
+	vector<int32_t> SlotToRootIndex{};
+	vector<D3D12_ROOT_PARAMETER_TYPE> RootParameterTypes{};
 };
 
 struct SShaderPipelineDesc
@@ -120,16 +154,23 @@ struct SShaderPipelineDesc
 	void SetResource(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList);
 	void SetResource(const string& Name, D3D12_GPU_DESCRIPTOR_HANDLE Handle, ID3D12GraphicsCommandList* CmdList);
 
+	void SetRootDescriptor(uint32_t Index, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList) const;
+	void SetRootDescriptorTable(uint32_t Index, D3D12_GPU_DESCRIPTOR_HANDLE Handle, ID3D12GraphicsCommandList* CmdList) const;
+	void SetRootConstant(uint32_t Index, uint32_t Value, ID3D12GraphicsCommandList* CmdList) const;
+
 	void ActivateRootSignature(ID3D12GraphicsCommandList* CmdList) const;
 
+	// Registers the root parameter index of a reflected resource under both its name and its slot
+	void SetRootParamIndex(const wstring& Name, uint32_t Index);
+	uint32_t GetNumRootParameters() const;
+
+	// -1 if none of the shaders declares the resource
+	int32_t GetRootIndex(TShaderSlot Slot) const;
+
 	unordered_map<wstring, uint32_t>& GetRootParamIndexMap();
 	int32_t GetIndexFromName(const string& Name);
 	SRootParameter& GetRootParameterFromName(const string& Name);
 	vector<D3D12_ROOT_PARAMETER1>& BuildParameterArray();
-
-private:
-	void SetComputeResourceCBView(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList);
-	void SetGraphicsResourceCBView(const string& Name, D3D12_GPU_VIRTUAL_ADDRESS Handle, ID3D12GraphicsCommandList* CmdList);
 };
 
 struct SPipelineStage
@@ -137,7 +178,7 @@ struct SPipelineStage
 	wstring ShaderPath;
 	string ShaderName;
 	SShaderDefinition ShaderDefinition;
-	vector<D3D_SHADER_MACRO> Defines;
+	vector<pair<string, string>> Defines;
 	class OShader* Shader;
 	D3D12_SHADER_BYTECODE GetShaderByteCode() const;
 };
@@ -0,0 +1,231 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+template<typename TValue>
+struct SEnumEntry
+{
+	// Points to a null terminated literal, ToString hands it out as a C string
+	std::string_view Name;
+	TValue Value;
+};
+
+/**
+ * @brief Name to value table built at compile time. Names are found through a perfect hash: the seed is searched while compiling
+ * so that every name lands in its own slot, a lookup hashes the name once and compares it against a single entry. Values are
+ * usually enumerators, any literal type comparable with == works.
+ */
+template<typename TValue, size_t N>
+class OEnumTable
+{
+public:
+	consteval OEnumTable(const std::array<SEnumEntry<TValue>, N>& InEntries)
+	    : Entries(InEntries)
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			for (size_t j = i + 1; j < N; j++)
+			{
+				if (Entries[i].Name == Entries[j].Name)
+				{
+					throw "Enum table has duplicated names";
+				}
+			}
+		}
+
+		for (Seed = 0; !TryBuildSlots(); Seed++)
+		{
+			if (Seed == MaxSeed)
+			{
+				throw "No perfect hash found for the enum table";
+			}
+		}
+	}
+
+	constexpr std::optional<TValue> FromString(std::string_view Name) const
+	{
+		if constexpr (N > 0)
+		{
+			const auto slot = Slots[GetSlot(Hash(Name, Seed))];
+			if (slot != 0 && Entries[slot - 1].Name == Name)
+			{
+				return Entries[slot - 1].Value;
+			}
+		}
+		return std::nullopt;
+	}
+
+	// Null for values without a name
+	constexpr const char* ToString(TValue Value) const
+	{
+		// Tables of ENUM list the enumerators in order, those are indexed directly
+		if constexpr (std::is_enum_v<TValue>)
+		{
+			if (const auto index = static_cast<size_t>(Value); index < N && Entries[index].Value == Value)
+			{
+				return Entries[index].Name.data();
+			}
+		}
+		for (const auto& entry : Entries)
+		{
+			if (entry.Value == Value)
+			{
+				return entry.Name.data();
+			}
+		}
+		return nullptr;
+	}
+
+	constexpr const std::array<SEnumEntry<TValue>, N>& GetEntries() const
+	{
+		return Entries;
+	}
+
+	// FNV-1a with the seed mixed into the offset basis
+	static constexpr uint32_t Hash(std::string_view Text, uint32_t Seed)
+	{
+		uint32_t hash = 2166136261u ^ (Seed * 0x9E3779B9u);
+		for (const char c : Text)
+		{
+			hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+		}
+		return hash;
+	}
+
+private:
+	// At most half of the slots are taken, a seed is found after a few dozen attempts for the largest enums
+	static constexpr size_t NumSlots = std::bit_ceil(N * 2 > 0 ? N * 2 : 1);
+	static constexpr uint32_t MaxSeed = 1 << 16;
+	static_assert(N < 255, "Slots store entry indices in a byte");
+
+	// The low bits of FNV only depend on the low bits of the characters, the high ones are used
+	static constexpr size_t GetSlot(uint32_t Hash)
+	{
+		return NumSlots > 1 ? Hash >> (32 - std::countr_zero(NumSlots)) : 0;
+	}
+
+	consteval bool TryBuildSlots()
+	{
+		Slots = {};
+		for (size_t i = 0; i < N; i++)
+		{
+			auto& slot = Slots[GetSlot(Hash(Entries[i].Name, Seed))];
+			if (slot != 0)
+			{
+				return false;
+			}
+			slot = static_cast<uint8_t>(i + 1);
+		}
+		return true;
+	}
+
+	std::array<SEnumEntry<TValue>, N> Entries;
+
+	// Index of the entry plus one, zero for empty slots
+	std::array<uint8_t, NumSlots> Slots{};
+	uint32_t Seed = 0;
+};
+
+template<typename TValue, size_t N>
+consteval OEnumTable<TValue, N> MakeEnumTable(const SEnumEntry<TValue> (&Entries)[N])
+{
+	std::array<SEnumEntry<TValue>, N> entries{};
+	for (size_t i = 0; i < N; i++)
+	{
+		entries[i] = Entries[i];
+	}
+	return OEnumTable<TValue, N>(entries);
+}
+
+namespace EnumReflection
+{
+consteval bool IsNameChar(char C)
+{
+	return (C >= 'a' && C <= 'z') || (C >= 'A' && C <= 'Z') || (C >= '0' && C <= '9') || C == '_';
+}
+
+consteval size_t CountNames(std::string_view List)
+{
+	size_t count = 0;
+	bool bInName = false;
+	for (const char c : List)
+	{
+		count += IsNameChar(c) && !bInName;
+		bInName = IsNameChar(c);
+	}
+	return count;
+}
+
+// Enumerator names of a stringized ENUM list, each followed by a null so they can be handed out as C strings
+template<size_t NumNames, size_t NumChars>
+struct SEnumNames
+{
+	std::array<char, NumChars> Chars{};
+	std::array<uint32_t, NumNames> Offsets{};
+	std::array<uint32_t, NumNames> Lengths{};
+};
+
+template<size_t NumNames, size_t NumChars>
+consteval SEnumNames<NumNames, NumChars> SplitNames(std::string_view List)
+{
+	SEnumNames<NumNames, NumChars> names;
+	size_t name = 0;
+	size_t length = 0;
+	for (size_t i = 0; i <= List.size(); i++)
+	{
+		const char c = i < List.size() ? List[i] : ',';
+		if (c == '=')
+		{
+			throw "ENUM enumerators can't have initializers";
+		}
+		if (IsNameChar(c))
+		{
+			names.Chars[i] = c;
+			length++;
+			continue;
+		}
+
+		// Separators are overwritten with nulls, the stringized list always has room for the terminator of the last name
+		if (length > 0)
+		{
+			names.Offsets[name] = static_cast<uint32_t>(i - length);
+			names.Lengths[name] = static_cast<uint32_t>(length);
+			name++;
+			length = 0;
+		}
+	}
+	return names;
+}
+
+template<typename TEnum, size_t NumNames, size_t NumChars>
+consteval OEnumTable<TEnum, NumNames> MakeTable(const SEnumNames<NumNames, NumChars>& Names)
+{
+	std::array<SEnumEntry<TEnum>, NumNames> entries{};
+	for (size_t i = 0; i < NumNames; i++)
+	{
+		entries[i] = { std::string_view(Names.Chars.data() + Names.Offsets[i], Names.Lengths[i]), static_cast<TEnum>(i) };
+	}
+	return OEnumTable<TEnum, NumNames>(entries);
+}
+} // namespace EnumReflection
+
+// Enums declared with ENUM provide their table through GetEnumTable, found by argument dependent lookup
+template<typename TEnum>
+concept CReflectedEnum = std::is_enum_v<TEnum> && requires(TEnum Value) { GetEnumTable(Value); };
+
+template<CReflectedEnum TEnum>
+constexpr const char* ToString(TEnum Value)
+{
+	const char* name = GetEnumTable(Value).ToString(Value);
+	return name ? name : "Unknown";
+}
+
+template<CReflectedEnum TEnum>
+constexpr std::optional<TEnum> FromString(std::string_view Name)
+{
+	return GetEnumTable(TEnum{}).FromString(Name);
+}
@@ -0,0 +1,70 @@
+#include "FileWatcher.h"
+
+OFileWatcher::OFileWatcher(std::filesystem::path Directory, vector<string> Extensions)
+    : Directory(std::move(Directory)), Extensions(std::move(Extensions))
+{
+}
+
+map<std::filesystem::path, OFileWatcher::SFileState> OFileWatcher::Scan() const
+{
+	map<std::filesystem::path, SFileState> result;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(Directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+	{
+		if (!it->is_regular_file(error))
+		{
+			continue;
+		}
+
+		const auto& path = it->path();
+		if (!Extensions.empty() && std::ranges::find(Extensions, path.extension().string()) == Extensions.end())
+		{
+			continue;
+		}
+
+		// A file deleted between listing and querying is simply reported on the next poll
+		SFileState state;
+		state.WriteTime = it->last_write_time(error);
+		state.Size = it->file_size(error);
+		if (!error)
+		{
+			result[path] = state;
+		}
+		error.clear();
+	}
+	return result;
+}
+
+vector<std::filesystem::path> OFileWatcher::Poll()
+{
+	auto current = Scan();
+	vector<std::filesystem::path> changed;
+	if (bHasSnapshot)
+	{
+		for (const auto& [path, state] : current)
+		{
+			const auto it = Snapshot.find(path);
+			if (it == Snapshot.end() || it->second != state)
+			{
+				changed.push_back(path);
+			}
+		}
+		for (const auto& path : Snapshot | std::views::keys)
+		{
+			if (!current.contains(path))
+			{
+				changed.push_back(path);
+			}
+		}
+		std::ranges::sort(changed);
+	}
+
+	Snapshot = std::move(current);
+	bHasSnapshot = true;
+	return changed;
+}
+
+const std::filesystem::path& OFileWatcher::GetDirectory() const
+{
+	return Directory;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Types.h"
+
+#include <filesystem>
+
+/**
+ * @brief Polls a directory tree for added, modified and removed files by comparing write times and sizes between calls.
+ * Polling keeps it free of platform APIs, a directory of a few dozen shader files takes microseconds to scan.
+ */
+class OFileWatcher
+{
+public:
+	// Only files with one of the Extensions are watched, an empty list watches every file
+	OFileWatcher(std::filesystem::path Directory, vector<string> Extensions = {});
+
+	// Files changed since the previous call, sorted. The first call only takes the snapshot and returns nothing.
+	vector<std::filesystem::path> Poll();
+
+	const std::filesystem::path& GetDirectory() const;
+
+private:
+	struct SFileState
+	{
+		std::filesystem::file_time_type WriteTime;
+		uintmax_t Size = 0;
+
+		bool operator==(const SFileState&) const = default;
+	};
+
+	map<std::filesystem::path, SFileState> Scan() const;
+
+	std::filesystem::path Directory;
+	vector<string> Extensions;
+	map<std::filesystem::path, SFileState> Snapshot;
+	bool bHasSnapshot = false;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include "Types.h"
+
+#include <type_traits>
+
+ENUM(EInputEventType,
+     None,
+     KeyPressed,
+     KeyReleased,
+     MouseMoved,
+     MouseButtonPressed,
+     MouseButtonReleased,
+     MouseWheel)
+
+/**
+ * @brief Platform neutral, trivially copyable input event. The OS layer fills it in, the engine converts it back to the *EventArgs on dispatch.
+ */
+struct SInputEvent
+{
+	static constexpr uint8_t LeftButton = 1 << 0;
+	static constexpr uint8_t MiddleButton = 1 << 1;
+	static constexpr uint8_t RightButton = 1 << 2;
+	static constexpr uint8_t Control = 1 << 3;
+	static constexpr uint8_t Shift = 1 << 4;
+	static constexpr uint8_t Alt = 1 << 5;
+
+	bool HasFlag(const uint8_t Flag) const
+	{
+		return (Flags & Flag) != 0;
+	}
+
+	/**
+	 * @brief Consecutive mouse moves with the same button state collapse into the latest position,
+	 * consecutive wheel events accumulate their delta.
+	 */
+	bool CanCoalesce(const SInputEvent& Next) const
+	{
+		if (Type != Next.Type || Window != Next.Window || Flags != Next.Flags)
+		{
+			return false;
+		}
+		return Type == EInputEventType::MouseMoved || Type == EInputEventType::MouseWheel;
+	}
+
+	void Coalesce(const SInputEvent& Next)
+	{
+		const float wheelDelta = WheelDelta + Next.WheelDelta;
+		*this = Next;
+		if (Type == EInputEventType::MouseWheel)
+		{
+			WheelDelta = wheelDelta;
+		}
+	}
+
+	EInputEventType Type = EInputEventType::None;
+	uint8_t Flags = 0;
+	uint8_t Button = 0;
+	uint16_t Padding0 = 0;
+	uint32_t Key = 0;
+	uint32_t Char = 0;
+	int32_t X = 0;
+	int32_t Y = 0;
+	float WheelDelta = 0.0f;
+	uint32_t Padding1 = 0;
+	uint64_t Window = 0;
+};
+
+// Replays store events as they are in memory, the padding is spelled out so every byte written is zeroed
+static_assert(std::is_trivially_copyable_v<SInputEvent>);
+static_assert(sizeof(SInputEvent) == 40);
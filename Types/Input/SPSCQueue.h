@@ -0,0 +1,76 @@
+#pragma once
+#include "Types.h"
+
+#include <atomic>
+#include <new>
+
+/**
+ * @brief Bounded lock free ring buffer for exactly one producer and one consumer thread.
+ * Capacity has to be a power of two, one slot is kept free to tell full from empty.
+ */
+template<typename Type, size_t Capacity>
+class TSPSCQueue
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static constexpr size_t Mask = Capacity - 1;
+	static constexpr size_t CacheLineSize = 64;
+
+public:
+	bool Push(const Type& Value)
+	{
+		const size_t head = Head.load(std::memory_order_relaxed);
+		const size_t next = (head + 1) & Mask;
+		if (next == Tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		Buffer[head] = Value;
+		Head.store(next, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(Type& OutValue)
+	{
+		const size_t tail = Tail.load(std::memory_order_relaxed);
+		if (tail == Head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		OutValue = Buffer[tail];
+		Tail.store((tail + 1) & Mask, std::memory_order_release);
+		return true;
+	}
+
+	bool Peek(Type& OutValue) const
+	{
+		const size_t tail = Tail.load(std::memory_order_relaxed);
+		if (tail == Head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		OutValue = Buffer[tail];
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return Tail.load(std::memory_order_acquire) == Head.load(std::memory_order_acquire);
+	}
+
+	size_t Num() const
+	{
+		return (Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire)) & Mask;
+	}
+
+	static constexpr size_t GetCapacity()
+	{
+		return Capacity - 1;
+	}
+
+private:
+	alignas(CacheLineSize) std::atomic<size_t> Head = 0;
+	alignas(CacheLineSize) std::atomic<size_t> Tail = 0;
+	alignas(CacheLineSize) std::array<Type, Capacity> Buffer = {};
+};
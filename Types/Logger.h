@@ -5,6 +5,7 @@
 #include <boost/uuid/uuid.hpp>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #ifndef DEBUG
 #define DEBUG 0
@@ -78,13 +79,18 @@ struct SLogUtils
 		{ SLogCategories::Config, true }
 	};
 
+	// Command lists are recorded on worker threads which log as well
+	static inline std::mutex LogMutex;
+
 	static void AddCategory(wstring Category)
 	{
+		std::lock_guard lock(LogMutex);
 		LogCategories.insert({ Category, true });
 	}
 
 	static void Log(wstring Category, const wstring& String, ELogType Type = ELogType::Log, const bool Debug = false) noexcept
 	{
+		std::lock_guard lock(LogMutex);
 		if (!LogCategories.contains(Category))
 		{
 			LogCategories.insert({ Category, true });
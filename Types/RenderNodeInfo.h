@@ -5,6 +5,15 @@ struct SNodeInfo
 {
 	string Name;
 	string PSOType;
-	string NextNode;
 	string RenderLayer;
-};
\ No newline at end of file
+
+	// Graph resources the node consumes and produces. Writing a resource also depends on its previous writer.
+	vector<string> Reads;
+	vector<string> Writes;
+
+	// Optional access state per resource (e.g. "CopySource", "Present"), reads default to ShaderResource and writes to RenderTarget
+	unordered_map<string, string> States;
+
+	// Output nodes are never culled, everything they don't (transitively) depend on is.
+	bool bIsOutput = false;
+};
@@ -0,0 +1,210 @@
+#include "Stats.h"
+
+#include "Logger.h"
+#include "boost/property_tree/json_parser.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+#include <bit>
+#include <filesystem>
+#include <fstream>
+
+using namespace boost::property_tree;
+
+void SStatHistogram::Sample(const uint64_t Value)
+{
+	Buckets[GetBucketIndex(Value)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	Sum.fetch_add(Value, std::memory_order_relaxed);
+
+	uint64_t max = Max.load(std::memory_order_relaxed);
+	while (Value > max && !Max.compare_exchange_weak(max, Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+void SStatHistogram::Reset()
+{
+	for (auto& bucket : Buckets)
+	{
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	Sum.store(0, std::memory_order_relaxed);
+	Max.store(0, std::memory_order_relaxed);
+}
+
+size_t SStatHistogram::GetBucketIndex(const uint64_t Value)
+{
+	return std::min<size_t>(std::bit_width(Value), NumBuckets - 1);
+}
+
+uint64_t SStatHistogram::GetBucketUpperBound(const size_t Index)
+{
+	return Index == 0 ? 0 : (uint64_t(1) << Index) - 1;
+}
+
+void OStatsRegistry::EndFrame(const float DeltaTime)
+{
+	Sample(EStatHistogram::FrameTimeUs, static_cast<uint64_t>(DeltaTime * 1000000.0f));
+
+	for (size_t i = 0; i < NumStatCounters; i++)
+	{
+		LastFrame[i] = Current[i].exchange(0, std::memory_order_relaxed);
+		Total[i] += LastFrame[i];
+	}
+	FrameIndex++;
+
+	if (DumpFrequency != 0 && FrameIndex % DumpFrequency == 0)
+	{
+		Dump();
+		ResetHistograms();
+	}
+}
+
+uint64_t OStatsRegistry::GetLastFrame(EStatCounter Counter) const
+{
+	return LastFrame[static_cast<size_t>(Counter)];
+}
+
+uint64_t OStatsRegistry::GetTotal(EStatCounter Counter) const
+{
+	return Total[static_cast<size_t>(Counter)];
+}
+
+double OStatsRegistry::GetAverage(EStatCounter Counter) const
+{
+	return FrameIndex == 0 ? 0.0 : static_cast<double>(GetTotal(Counter)) / static_cast<double>(FrameIndex);
+}
+
+const SStatHistogram& OStatsRegistry::GetHistogram(EStatHistogram Histogram) const
+{
+	return Histograms[static_cast<size_t>(Histogram)];
+}
+
+uint64_t OStatsRegistry::GetFrameIndex() const
+{
+	return FrameIndex;
+}
+
+void OStatsRegistry::SetDumpFrequency(const uint32_t Frames)
+{
+	DumpFrequency = Frames;
+}
+
+uint32_t OStatsRegistry::GetDumpFrequency() const
+{
+	return DumpFrequency;
+}
+
+void OStatsRegistry::SetDumpPath(const string& Path)
+{
+	DumpPath = Path;
+}
+
+void OStatsRegistry::DumpCSV(const string& Path) const
+{
+	const bool bWriteHeader = !std::filesystem::exists(Path);
+	std::ofstream file(Path, std::ios::app);
+	if (!file.is_open())
+	{
+		LOG(Debug, Warning, "Failed to open stats file {}", TEXT(Path));
+		return;
+	}
+
+	if (bWriteHeader)
+	{
+		file << "Frame";
+		for (size_t i = 0; i < NumStatCounters; i++)
+		{
+			file << "," << ToString(static_cast<EStatCounter>(i));
+		}
+		for (size_t i = 0; i < NumStatHistograms; i++)
+		{
+			const string name = ToString(static_cast<EStatHistogram>(i));
+			file << "," << name << "Avg," << name << "Max";
+		}
+		file << "\n";
+	}
+
+	file << FrameIndex;
+	for (size_t i = 0; i < NumStatCounters; i++)
+	{
+		file << "," << LastFrame[i];
+	}
+	for (const auto& histogram : Histograms)
+	{
+		const uint64_t count = histogram.Count.load(std::memory_order_relaxed);
+		const uint64_t sum = histogram.Sum.load(std::memory_order_relaxed);
+		file << "," << (count == 0 ? 0 : sum / count) << "," << histogram.Max.load(std::memory_order_relaxed);
+	}
+	file << "\n";
+}
+
+void OStatsRegistry::DumpJSON(const string& Path) const
+{
+	ptree root;
+	root.put("Frame", FrameIndex);
+
+	ptree counters;
+	for (size_t i = 0; i < NumStatCounters; i++)
+	{
+		const auto counter = static_cast<EStatCounter>(i);
+		ptree node;
+		node.put("LastFrame", GetLastFrame(counter));
+		node.put("Total", GetTotal(counter));
+		node.put("Average", GetAverage(counter));
+		counters.add_child(ToString(counter), node);
+	}
+	root.add_child("Counters", counters);
+
+	ptree histograms;
+	for (size_t i = 0; i < NumStatHistograms; i++)
+	{
+		const auto& histogram = Histograms[i];
+		ptree node;
+		node.put("Count", histogram.Count.load(std::memory_order_relaxed));
+		node.put("Sum", histogram.Sum.load(std::memory_order_relaxed));
+		node.put("Max", histogram.Max.load(std::memory_order_relaxed));
+
+		ptree buckets;
+		for (size_t j = 0; j < SStatHistogram::NumBuckets; j++)
+		{
+			const uint64_t value = histogram.Buckets[j].load(std::memory_order_relaxed);
+			if (value != 0)
+			{
+				buckets.put(std::to_string(SStatHistogram::GetBucketUpperBound(j)), value);
+			}
+		}
+		node.add_child("Buckets", buckets);
+		histograms.add_child(ToString(static_cast<EStatHistogram>(i)), node);
+	}
+	root.add_child("Histograms", histograms);
+
+	write_json(Path, root);
+}
+
+void OStatsRegistry::Dump() const
+{
+	if (DumpPath.empty())
+	{
+		LOG(Debug, Warning, "Stats dump path is not set!");
+		return;
+	}
+
+	const std::filesystem::path directory = std::filesystem::path(DumpPath).parent_path();
+	if (!directory.empty())
+	{
+		std::filesystem::create_directories(directory);
+	}
+
+	DumpCSV(DumpPath + ".csv");
+	DumpJSON(DumpPath + ".json");
+}
+
+void OStatsRegistry::ResetHistograms()
+{
+	for (auto& histogram : Histograms)
+	{
+		histogram.Reset();
+	}
+}
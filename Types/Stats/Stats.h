@@ -0,0 +1,118 @@
+#pragma once
+#include "Types.h"
+
+#include <array>
+#include <atomic>
+
+ENUM(EStatCounter,
+     DrawCalls,
+     InstancesVisible,
+     InstancesCulled,
+     UploadBytesCopied,
+     PSOSwitches,
+     RedundantResourceSetsSkipped,
+     TexturesLoaded,
+     InputEventsDispatched,
+     InputEventsCoalesced,
+     InputEventsDropped,
+     CommandsRecorded,
+     CommandValidationErrors,
+     BarriersRequested,
+     BarriersIssued,
+     BarrierBatches,
+     CPUWaitsOnGPU,
+     CommandAllocatorsCreated,
+     UploadRingStalls,
+     ShaderPermutationsLive,
+     ShaderPermutationsPending,
+     ShaderPermutationFallbacks,
+     RenderNodesSkipped,
+     BarrierStateMismatches,
+     Num)
+
+ENUM(EStatHistogram,
+     FrameTimeUs,
+     CPUFrameTimeUs,
+     InstancesPerDraw,
+     RecordingTimeUs,
+     CPUWaitTimeUs,
+     Num)
+
+inline constexpr size_t NumStatCounters = static_cast<size_t>(EStatCounter::Num);
+inline constexpr size_t NumStatHistograms = static_cast<size_t>(EStatHistogram::Num);
+
+/**
+ * @brief Lock free power of two histogram. Bucket N holds samples in range [2^(N-1), 2^N).
+ */
+struct SStatHistogram
+{
+	static constexpr size_t NumBuckets = 32;
+
+	void Sample(uint64_t Value);
+	void Reset();
+
+	static size_t GetBucketIndex(uint64_t Value);
+	static uint64_t GetBucketUpperBound(size_t Index);
+
+	std::array<std::atomic<uint64_t>, NumBuckets> Buckets = {};
+	std::atomic<uint64_t> Count = 0;
+	std::atomic<uint64_t> Sum = 0;
+	std::atomic<uint64_t> Max = 0;
+};
+
+/**
+ * @brief Per frame performance counters. Subsystems report via STAT_* macros from any thread,
+ * the engine closes the frame with EndFrame which latches the values and optionally dumps them to disk.
+ */
+class OStatsRegistry
+{
+public:
+	static OStatsRegistry* Get()
+	{
+		static OStatsRegistry registry;
+		return &registry;
+	}
+
+	void Add(EStatCounter Counter, uint64_t Value)
+	{
+		Current[static_cast<size_t>(Counter)].fetch_add(Value, std::memory_order_relaxed);
+	}
+
+	void Sample(EStatHistogram Histogram, uint64_t Value)
+	{
+		Histograms[static_cast<size_t>(Histogram)].Sample(Value);
+	}
+
+	void EndFrame(float DeltaTime);
+
+	uint64_t GetLastFrame(EStatCounter Counter) const;
+	uint64_t GetTotal(EStatCounter Counter) const;
+	double GetAverage(EStatCounter Counter) const;
+	const SStatHistogram& GetHistogram(EStatHistogram Histogram) const;
+	uint64_t GetFrameIndex() const;
+
+	void SetDumpFrequency(uint32_t Frames);
+	uint32_t GetDumpFrequency() const;
+	void SetDumpPath(const string& Path);
+
+	void DumpCSV(const string& Path) const;
+	void DumpJSON(const string& Path) const;
+	void Dump() const;
+	void ResetHistograms();
+
+private:
+	OStatsRegistry() = default;
+
+	std::array<std::atomic<uint64_t>, NumStatCounters> Current = {};
+	std::array<uint64_t, NumStatCounters> LastFrame = {};
+	std::array<uint64_t, NumStatCounters> Total = {};
+	std::array<SStatHistogram, NumStatHistograms> Histograms;
+
+	uint64_t FrameIndex = 0;
+	uint32_t DumpFrequency = 0;
+	string DumpPath;
+};
+
+#define STAT_ADD(Counter, Value) OStatsRegistry::Get()->Add(EStatCounter::Counter, static_cast<uint64_t>(Value))
+#define STAT_INC(Counter) STAT_ADD(Counter, 1)
+#define STAT_SAMPLE(Histogram, Value) OStatsRegistry::Get()->Sample(EStatHistogram::Histogram, static_cast<uint64_t>(Value))
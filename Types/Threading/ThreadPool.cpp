@@ -0,0 +1,91 @@
+#include "ThreadPool.h"
+
+OThreadPool::OThreadPool(uint32_t NumWorkers)
+{
+	Workers.reserve(NumWorkers);
+	for (uint32_t i = 0; i < NumWorkers; i++)
+	{
+		Workers.emplace_back(&OThreadPool::WorkerLoop, this);
+	}
+}
+
+OThreadPool::~OThreadPool()
+{
+	{
+		SLockGuard lock(Mutex);
+		bStop = true;
+	}
+	WorkAvailable.notify_all();
+	for (auto& worker : Workers)
+	{
+		worker.join();
+	}
+}
+
+void OThreadPool::ParallelFor(size_t InCount, const std::function<void(size_t)>& InBody)
+{
+	if (InCount == 0)
+	{
+		return;
+	}
+
+	{
+		SLockGuard lock(Mutex);
+		Body = &InBody;
+		Count = InCount;
+		NextIndex = 0;
+		NumCompleted = 0;
+		Generation++;
+	}
+	WorkAvailable.notify_all();
+
+	RunIterations();
+
+	SUniqueLock lock(Mutex);
+	WorkDone.wait(lock, [this]() { return NumCompleted == Count && NumActiveWorkers == 0; });
+	Body = nullptr;
+}
+
+uint32_t OThreadPool::GetNumWorkers() const
+{
+	return static_cast<uint32_t>(Workers.size());
+}
+
+void OThreadPool::WorkerLoop()
+{
+	uint64_t seenGeneration = 0;
+	while (true)
+	{
+		{
+			SUniqueLock lock(Mutex);
+			WorkAvailable.wait(lock, [&]() { return bStop || (Generation != seenGeneration && Body != nullptr); });
+			if (bStop)
+			{
+				return;
+			}
+			seenGeneration = Generation;
+			NumActiveWorkers++;
+		}
+
+		RunIterations();
+
+		{
+			SLockGuard lock(Mutex);
+			NumActiveWorkers--;
+		}
+		WorkDone.notify_all();
+	}
+}
+
+void OThreadPool::RunIterations()
+{
+	for (size_t index = NextIndex.fetch_add(1); index < Count; index = NextIndex.fetch_add(1))
+	{
+		(*Body)(index);
+		if (NumCompleted.fetch_add(1) + 1 == Count)
+		{
+			SLockGuard lock(Mutex);
+			WorkDone.notify_all();
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Async.h"
+#include "Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * @brief Fixed set of worker threads for fork-join work. ParallelFor blocks until every iteration ran,
+ * the calling thread takes iterations as well so a pool without workers runs everything inline.
+ */
+class OThreadPool
+{
+public:
+	explicit OThreadPool(uint32_t NumWorkers);
+	~OThreadPool();
+
+	OThreadPool(const OThreadPool&) = delete;
+	OThreadPool& operator=(const OThreadPool&) = delete;
+
+	void ParallelFor(size_t Count, const std::function<void(size_t)>& Body);
+	uint32_t GetNumWorkers() const;
+
+private:
+	void WorkerLoop();
+	void RunIterations();
+
+	vector<std::thread> Workers;
+
+	SMutex Mutex;
+	std::condition_variable WorkAvailable;
+	std::condition_variable WorkDone;
+
+	const std::function<void(size_t)>* Body = nullptr;
+	size_t Count = 0;
+	std::atomic<size_t> NextIndex = 0;
+	std::atomic<size_t> NumCompleted = 0;
+
+	// Workers still inside the current job, the job can't be replaced until they left
+	uint32_t NumActiveWorkers = 0;
+	uint64_t Generation = 0;
+	bool bStop = false;
+};
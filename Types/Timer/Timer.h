@@ -15,6 +15,10 @@ public:
 	void Stop();
 	void Tick();
 
+	// Overrides the performance counter, used to drive deterministic updates (e.g. replays).
+	void SetFixedTime(double Time, double Delta);
+	bool IsFixedTime() const;
+
 private:
 	double SecondsPerCount = 0.0;
 	double DeltaTime = -1.0;
@@ -26,6 +30,8 @@ private:
 	int64_t CurrTime = 0;
 
 	bool bIsStopped = false;
+	bool bIsFixedTime = false;
+	double FixedTime = 0.0;
 };
 
 inline STimer::STimer()
@@ -37,6 +43,11 @@ inline STimer::STimer()
 
 inline float STimer::GetTime() const
 {
+	if (bIsFixedTime)
+	{
+		return (float)FixedTime;
+	}
+
 	if (bIsStopped)
 	{
 		return (float)(((StopTime - PausedTime) - BaseTime) * SecondsPerCount);
@@ -109,4 +120,16 @@ inline void STimer::Tick()
 	{
 		DeltaTime = 0.0;
 	}
-}
\ No newline at end of file
+}
+
+inline void STimer::SetFixedTime(double Time, double Delta)
+{
+	bIsFixedTime = true;
+	FixedTime = Time;
+	DeltaTime = Delta;
+}
+
+inline bool STimer::IsFixedTime() const
+{
+	return bIsFixedTime;
+}
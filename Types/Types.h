@@ -1,18 +1,22 @@
 #pragma once
 
-#include "boost/signals2.hpp"
-
 #include <algorithm> // For std::min and std::max.
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <ranges>
 #include <string>
 #include <unordered_set>
 #include <vector>
+
+#include "EnumReflection.h"
+
 #if defined(min)
 #undef min
 #endif
@@ -41,45 +45,16 @@ using std::wstring;
 #include <string>
 #include <unordered_map>
 
-template<typename EnumType>
-struct SLitEnum
-{
-	SLitEnum(EnumType Value, const std::string& Name)
-	    : Value(Value), Name(Name) {}
-
-	EnumType Value;
-	std::string Name;
-};
-
-#define ENUM(Name, ...) \
-	enum class Name     \
-	{                   \
-		__VA_ARGS__     \
-	};
-
-#define DEFINE_LIT_ENUM(EnumType, ...)                                                              \
-	static const std::unordered_map<EnumType, std::string> EnumType##ToStringMap = { __VA_ARGS__ }; \
-	static const std::unordered_map<std::string, EnumType> StringTo##EnumType##Map = []() {         \
-		std::unordered_map<std::string, EnumType> map;                                              \
-		for (const auto& lit : EnumType##ToStringMap)                                               \
-		{                                                                                           \
-			map[lit.second] = lit.first;                                                            \
-		}                                                                                           \
-		return map;                                                                                 \
-	}();                                                                                            \
-	static const std::string& EnumType##ToString(EnumType Value)                                    \
-	{                                                                                               \
-		static const std::string unknown = "Unknown";                                               \
-		auto it = EnumType##ToStringMap.find(Value);                                                \
-		if (it != EnumType##ToStringMap.end())                                                      \
-			return it->second;                                                                      \
-		return unknown;                                                                             \
-	}                                                                                               \
-	static EnumType StringTo##EnumType(const std::string& Name)                                     \
-	{                                                                                               \
-		auto it = StringTo##EnumType##Map.find(Name);                                               \
-		if (it != StringTo##EnumType##Map.end())                                                    \
-			return it->second;                                                                      \
-		return static_cast<EnumType>(-1);                                                           \
+// Declares the enum with a table of its enumerator names, built at compile time. ToString and FromString work on it.
+#define ENUM(Name, ...)                                                                                                                           \
+	enum class Name                                                                                                                               \
+	{                                                                                                                                             \
+		__VA_ARGS__                                                                                                                               \
+	};                                                                                                                                            \
+	inline constexpr auto Name##Names = EnumReflection::SplitNames<EnumReflection::CountNames(#__VA_ARGS__), sizeof(#__VA_ARGS__)>(#__VA_ARGS__); \
+	inline constexpr auto Name##Table = EnumReflection::MakeTable<Name>(Name##Names);                                                             \
+	constexpr const auto& GetEnumTable(Name)                                                                                                      \
+	{                                                                                                                                             \
+		return Name##Table;                                                                                                                       \
 	}
 
@@ -2,6 +2,7 @@
 
 #include "Engine/RenderObject/RenderObject.h"
 #include "Logger.h"
+#include "Stats/Stats.h"
 
 UINT Utils::CalcBufferByteSize(const UINT ByteSize)
 {
@@ -158,6 +159,7 @@ vector<CD3DX12_STATIC_SAMPLER_DESC> Utils::GetStaticSamplers()
 void Utils::ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Resource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After)
 {
 	D3D12_RESOURCE_STATES localBefore = Resource->CurrentState;
+	STAT_INC(BarriersRequested);
 
 	if (localBefore != Before)
 	{
@@ -173,10 +175,13 @@ void Utils::ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Reso
 
 	const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(Resource->Resource.Get(), localBefore, After);
 	List->ResourceBarrier(1, &barrier);
+	STAT_INC(BarriersIssued);
+	STAT_INC(BarrierBatches);
 }
 
 void Utils::ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Resource, D3D12_RESOURCE_STATES After)
 {
+	STAT_INC(BarriersRequested);
 	if (Resource->CurrentState == After)
 	{
 		LOG(Debug, Warning, "ResourceBarrier: Resource states must be different {}!", Resource->Context->GetName());
@@ -186,6 +191,50 @@ void Utils::ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Reso
 	const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(Resource->Resource.Get(), Resource->CurrentState, After);
 	Resource->CurrentState = After;
 	List->ResourceBarrier(1, &barrier);
+	STAT_INC(BarriersIssued);
+	STAT_INC(BarrierBatches);
+}
+
+uint32_t Utils::ResourceBarriers(ID3D12GraphicsCommandList* List, std::span<const SResourceTransition> Transitions, std::span<ID3D12Resource* const> AliasedResources)
+{
+	STAT_ADD(BarriersRequested, Transitions.size() + AliasedResources.size());
+
+	vector<D3D12_RESOURCE_BARRIER> barriers;
+	barriers.reserve(Transitions.size() + AliasedResources.size());
+	for (const auto resource : AliasedResources)
+	{
+		barriers.push_back(CD3DX12_RESOURCE_BARRIER::Aliasing(nullptr, resource));
+	}
+
+	for (const auto& transition : Transitions)
+	{
+		auto resource = transition.Resource;
+		const auto before = transition.Before.value_or(resource->CurrentState);
+		if (before == transition.After)
+		{
+			continue;
+		}
+
+		barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource->Resource.Get(),
+		                                                        before,
+		                                                        transition.After,
+		                                                        D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+		                                                        transition.Flags));
+
+		// The resource can't be used until the matching end barrier, which is the one that changes the tracked state
+		if (transition.Flags != D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+		{
+			resource->CurrentState = transition.After;
+		}
+	}
+
+	if (!barriers.empty())
+	{
+		List->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+		STAT_ADD(BarriersIssued, barriers.size());
+		STAT_INC(BarrierBatches);
+	}
+	return static_cast<uint32_t>(barriers.size());
 }
 
 void Utils::BuildRootSignature(ID3D12Device* Device, ComPtr<ID3D12RootSignature>& RootSignature, const D3D12_ROOT_SIGNATURE_DESC& Desc)
@@ -6,6 +6,7 @@
 #include <d3dx12.h>
 
 #include <array>
+#include <span>
 
 class OCommandQueue;
 class IRenderObject;
@@ -31,6 +32,10 @@ vector<CD3DX12_STATIC_SAMPLER_DESC> GetStaticSamplers();
 void ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Resource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After);
 void ResourceBarrier(ID3D12GraphicsCommandList* List, SResourceInfo* Resource, D3D12_RESOURCE_STATES After);
 
+// Issues all non redundant transitions with a single ResourceBarrier call, returns the number of barriers issued.
+// Aliasing barriers for resources that take over placed memory are recorded first.
+uint32_t ResourceBarriers(ID3D12GraphicsCommandList* List, std::span<const SResourceTransition> Transitions, std::span<ID3D12Resource* const> AliasedResources = {});
+
 void BuildRootSignature(ID3D12Device* Device, ComPtr<ID3D12RootSignature>& RootSignature, const D3D12_ROOT_SIGNATURE_DESC& Desc);
 void BuildRootSignature(ID3D12Device* Device, ComPtr<ID3D12RootSignature>& RootSignature, const D3D12_VERSIONED_ROOT_SIGNATURE_DESC& Desc);
 
@@ -0,0 +1,44 @@
+#pragma once
+#include <Types.h>
+
+#include <string_view>
+#include <type_traits>
+
+namespace Utils
+{
+/**
+ * @brief 64 bit FNV-1a over a byte stream. The result only depends on the bytes fed in, so it stays stable
+ * between runs and machines and may be used for keys persisted on disk.
+ */
+struct SHasher
+{
+	static constexpr uint64_t OffsetBasis = 0xcbf29ce484222325ull;
+	static constexpr uint64_t Prime = 0x100000001b3ull;
+
+	uint64_t Value = OffsetBasis;
+
+	void AddBytes(const void* Data, size_t Size)
+	{
+		const auto bytes = static_cast<const uint8_t*>(Data);
+		for (size_t i = 0; i < Size; i++)
+		{
+			Value ^= bytes[i];
+			Value *= Prime;
+		}
+	}
+
+	// Length prefixed, so that ("ab", "c") and ("a", "bc") hash differently
+	void Add(std::string_view String)
+	{
+		Add(static_cast<uint64_t>(String.size()));
+		AddBytes(String.data(), String.size());
+	}
+
+	template<typename T>
+	    requires std::is_trivially_copyable_v<T>
+	void Add(const T& Data)
+	{
+		AddBytes(&Data, sizeof(T));
+	}
+};
+} // namespace Utils
@@ -24,6 +24,7 @@ int CALLBACK wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR lpCmdL
 	}
 
 	const auto application = OApplication::Get();
+	application->ParseCommandLine(lpCmdLine);
 	application->InitApplication(hInstance);
 
 	returnCode = application->Run<OCubeMapTest>();